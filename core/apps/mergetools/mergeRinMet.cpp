@@ -67,27 +67,26 @@ void MergeRinMet::process()
 {
    std::vector<std::string> files = inputFileOption.getValue();
 
-      // FFF will sort and merge the data using
-      // a simple time check
+      // FFF will merge the data from the files using a simple time
+      // check, without holding it all in memory
    FileFilterFrameWithHeader<RinexMetStream, RinexMetData, RinexMetHeader> 
-      fff(files);
+      fff;
+   fff.newHeaderSource(files);
 
       // get the header data
    RinexMetHeaderTouchHeaderMerge merged;
    fff.touchHeader(merged);
 
-      // sort and filter the data
-   fff.sort(RinexMetDataOperatorLessThanFull(merged.obsSet));
-   fff.unique(RinexMetDataOperatorEqualsSimple());
-   
       // set the pgm/runby/date field
    merged.theHeader.fileProgram = std::string("mergeRinMet");
    merged.theHeader.fileAgency = std::string("gpstk");
    merged.theHeader.date = CivilTime(SystemTime()).asString();
 
-      // write the header
+      // merge and filter the data, writing the file
    std::string outputFile = outputFileOption.getValue().front();
-   fff.writeFile(outputFile, merged.theHeader);
+   fff.mergeFiles(files, outputFile, merged.theHeader,
+                  RinexMetDataOperatorLessThanFull(merged.obsSet),
+                  RinexMetDataOperatorEqualsSimple());
 }
 
 int main(int argc, char* argv[])
@@ -65,19 +65,15 @@ void MergeRinNav::process()
 {
    std::vector<std::string> files = inputFileOption.getValue();
 
-      // FFF will sort and merge the obs data using
-      // a simple time check
-   FileFilterFrameWithHeader<Rinex3NavStream, Rinex3NavData, Rinex3NavHeader> fff(files);
+      // FFF will merge the nav data from the files, without holding
+      // it all in memory
+   FileFilterFrameWithHeader<Rinex3NavStream, Rinex3NavData, Rinex3NavHeader> fff;
+   fff.newHeaderSource(files);
 
       // get the header data
    Rinex3NavHeaderTouchHeaderMerge merged;
-
    fff.touchHeader(merged);
 
-      // sort and filter the data
-   fff.sort(Rinex3NavDataOperatorLessThanFull());
-   fff.unique(Rinex3NavDataOperatorEqualsFull());
-   
       // set the pgm/runby/date field
    merged.theHeader.fileType = string("NAVIGATION");
    merged.theHeader.fileProgram = std::string("mergeRinNav");
@@ -89,9 +85,11 @@ void MergeRinNav::process()
    merged.theHeader.valid |= gpstk::Rinex3NavHeader::validComment;
    merged.theHeader.valid |= gpstk::Rinex3NavHeader::validEoH;
 
-      // write the header
+      // merge and filter the data, writing the file
    std::string outputFile = outputFileOption.getValue().front();
-   fff.writeFile(outputFile, merged.theHeader);
+   fff.mergeFiles(files, outputFile, merged.theHeader,
+                  Rinex3NavDataOperatorLessThanFull(),
+                  Rinex3NavDataOperatorEqualsFull());
 }
 
 int main(int argc, char* argv[])
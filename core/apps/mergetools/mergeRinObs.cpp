@@ -50,6 +50,14 @@
 using namespace std;
 using namespace gpstk;
 
+   // Sets the time of the first obs in the header to that of the
+   // first record written.
+struct SetFirstObs
+{
+   void operator()(RinexObsHeader& h, const RinexObsData& first) const
+   { h.firstObs = first.time; }
+};
+
 class MergeRinObs : public MergeFrame
 {
 public:
@@ -67,30 +75,28 @@ void MergeRinObs::process()
 {
    std::vector<std::string> files = inputFileOption.getValue();
 
-      // FFF will sort and merge the obs data using
-      // a simple time check
+      // FFF will merge the obs data from the files using a simple
+      // time check, without holding it all in memory
    FileFilterFrameWithHeader<RinexObsStream, RinexObsData, RinexObsHeader> 
-      fff(files);
+      fff;
+   fff.newHeaderSource(files);
 
       // get the header data
    RinexObsHeaderTouchHeaderMerge merged;
    fff.touchHeader(merged);
 
-      // sort and filter the data using the obs set from the merged header
-   fff.sort(RinexObsDataOperatorLessThanFull(merged.obsSet));
-   fff.unique(RinexObsDataOperatorEqualsSimple());
-   
-      // set the time of first obs in the header
-   merged.theHeader.firstObs = fff.front().time;
-
       // set the pgm/runby/date field
    merged.theHeader.fileProgram = std::string("mergeRinObs");
    merged.theHeader.fileAgency = std::string("gpstk");
    merged.theHeader.date = CivilTime(SystemTime()).asString();
 
-      // write the file
+      // merge and filter the data using the obs set from the merged
+      // header, writing the file with the time of its first obs
    std::string outputFile = outputFileOption.getValue().front();
-   fff.writeFile(outputFile, merged.theHeader);
+   fff.mergeFiles(files, outputFile, merged.theHeader,
+                  RinexObsDataOperatorLessThanFull(merged.obsSet),
+                  RinexObsDataOperatorEqualsSimple(),
+                  fff.defaultMergeRecords, SetFirstObs());
 }
 
 int main(int argc, char* argv[])
@@ -45,6 +45,11 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // GPSTK
 #include "Exception.hpp"
@@ -198,6 +203,8 @@ public:
    int maxReject;             // Max number of sats to reject [-1 for no limit]
    int nIter;                 // Maximum iteration count in linearized LS
    double convLimit;          // Minimum convergence criterion in estimation (meters)
+   bool incRAIM;              // Screen RAIM combinations by downdating
+   int nthreads;              // number of threads preparing epochs
 
    string TropStr;            // temp used to parse --trop
 
@@ -475,6 +482,7 @@ public:
       ParseDescriptor();
 
       nepochs = 0;
+      Prepared = false;
 
       // for initialization of constants and PRSolution
       Configuration& C(Configuration::Instance());
@@ -485,6 +493,7 @@ public:
       prs.NSatsReject = C.maxReject;
       prs.MaxNIterations = C.nIter;
       prs.ConvergenceLimit = C.convLimit;
+      prs.IncrementalRAIM = C.incRAIM;
 
       // specify systems in PRSolution
       // sysChars ~ vec<1-char string> ~ G,R,E,C,S; must have at least one member
@@ -526,8 +535,12 @@ public:
                     const double& elev, const double& ER,
                     const vector<RinexDatum>& v) throw();
 
+   // Evaluate the ephemeris for the data of the given epoch, as ComputeSolution()
+   // would; call after CollectData(). Used to prepare epochs ahead (--threads).
+   void PrepareSolution(const CommonTime& t) throw();
+
    // Compute a solution for the given epoch; call after CollectData()
-   // same return value as RAIMCompute()
+   // [and PrepareSolution()]; same return value as RAIMCompute()
    int ComputeSolution(const CommonTime& t) throw(Exception);
 
    // Write out ORDs - call after ComputeSolution
@@ -537,6 +550,22 @@ public:
    // Output final results
    void FinalOutput(void) throw(Exception);
 
+   // The data of one epoch (from CollectData() and PrepareSolution()), so
+   // that it can be collected in one object and solved in another.
+   class EpochState {
+   public:
+      vector<SatID> Satellites;
+      vector<double> PRanges,Elevations,ERanges,RIono,R1,R2;
+      multimap<RinexSatID,string> UsedObsIDs;
+      bool Prepared;
+      int PrepN;
+      vector<SatID> PrepSats;
+      Matrix<double> PrepSVP;
+   };
+
+   // exchange the data of the current epoch with es
+   void SwapEpoch(EpochState& es) throw();
+
 // member data
 
    // true unless descriptor is not valid, or required ObsIDs are not available
@@ -566,6 +595,12 @@ public:
    vector<double> R1,R2;                     // raw ranges, parallel to Satellites
    multimap<RinexSatID,string> UsedObsIDs;   // valid or not; may be comma-sep. list
 
+   // output of PreparePRSolution(), if PrepareSolution() was called this epoch
+   bool Prepared;
+   int PrepN;                                // return value
+   vector<SatID> PrepSats;                   // Satellites, marked
+   Matrix<double> PrepSVP;                   // SVP matrix
+
    // the PRS itself
    PRSolution prs;
 
@@ -578,10 +613,42 @@ public:
 
 }; // end class SolutionObject
 
+//------------------------------------------------------------------------------------
+// One epoch of RINEX data, and what is computed for it before the solutions.
+// With --threads, epochs are read and prepared (PrepareEpoch()) ahead, on a pool of
+// threads, then solved (SolveEpoch()) in order on the main thread; LOG output from
+// reading and preparing is kept in log, and written out in order, so that the
+// output is the same as without threads.
+class EpochData {
+public:
+   EpochData() : process(false), prepared(false), failed(false) { }
+
+   Rinex3ObsData Rdata;                      // the data, corrected for DCB
+   bool process;                             // false if the epoch is skipped
+   bool prepared;                            // PrepareEpoch() is done
+   bool failed;                              // reading or preparing threw error
+   Exception error;
+   ostringstream log;                        // LOG output, with --threads
+   vector<SolutionObject::EpochState> sols;  // data prepared ahead, ~ C.SolObjs
+
+}; // end class EpochData
+
 //------------------------------------------------------------------------------------
 // prototypes
 int Initialize(string& errors) throw(Exception);
 int ProcessFiles(void) throw(Exception);
+bool ReadEpoch(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead, EpochData& ed,
+               int& iret) throw(Exception);
+void PrepareEpoch(EpochData& ed, vector<SolutionObject>& SolObjs,
+                  Rinex3ObsHeader& Rhead, const bool DCBcorr,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  const bool ahead) throw(Exception);
+void SolveEpoch(EpochData& ed, Rinex3ObsHeader& Rhead, Rinex3ObsStream& ostrm)
+   throw(Exception);
+int ProcessEpochsThreaded(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead,
+                          const bool DCBcorr, const map<string,int>& mapDCBindex,
+                          const Position& PrevPos, Rinex3ObsStream& ostrm)
+   throw(Exception);
 
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -1225,7 +1292,7 @@ int ProcessFiles(void) throw(Exception)
 try {
    Configuration& C(Configuration::Instance());
    bool firstepoch(true);
-   int k,iret,nfiles;
+   int iret,nfiles;
    size_t i,j,nfile;
    Position PrevPos(C.knownPos);
    Rinex3ObsStream ostrm;
@@ -1357,229 +1424,420 @@ try {
       }
 
       // loop over epochs ---------------------------------------------
-      while(1) {
-         try { istrm >> Rdata; }
-         catch(Exception& e) {
-            LOG(WARNING) << " Warning : Failed to read obs data (Exception "
-               << e.getText(0) << "); dump follows.";
-            Rdata.dump(LOGstrm,Rhead);
-            istrm.close();
-            iret = 3;
-            break;
-         }
-         catch(std::exception& e) {
-            Exception ge(string("Std excep: ") + e.what());
-            GPSTK_THROW(ge);
-         }
-         catch(...) {
-            Exception ue("Unknown exception while reading RINEX data.");
-            GPSTK_THROW(ue);
+      if(C.nthreads > 1)
+         iret = ProcessEpochsThreaded(istrm, Rhead, DCBcorr, mapDCBindex, PrevPos,
+                                      ostrm);
+      else {
+         EpochData ed;
+         while(ReadEpoch(istrm, Rhead, ed, iret)) {
+            if(!ed.process) continue;
+            PrepareEpoch(ed, C.SolObjs, Rhead, DCBcorr, mapDCBindex, PrevPos, false);
+            SolveEpoch(ed, Rhead, ostrm);
          }
+      }
 
-         // normal EOF
-         if(!istrm.good() || istrm.eof()) { iret = 0; break; }
+      istrm.close();
 
-         // if aux header data, or no data, skip it
-         if(Rdata.epochFlag > 1 || Rdata.obs.empty()) {
-            LOG(DEBUG) << " RINEX Data is aux header or empty.";
-            continue;
-         }
+      // failure due to critical error
+      if(iret < 0) break;
 
-         LOG(DEBUG) << "\n Read RINEX data: flag " << Rdata.epochFlag
-            << ", timetag " << printTime(Rdata.time,C.longfmt);
+      if(iret == 0) nfiles++;
 
-         // stay within time limits
-         if(Rdata.time < C.beginTime) {
-            LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
-               << " is before begin time.";
-            continue;
-         }
-         if(Rdata.time > C.endTime) {
-            LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
-               << " is after end time.";
-            break;
+   }  // end loop over files
+
+   if(!C.OutputObsFile.empty()) ostrm.close();
+
+   if(iret < 0) return iret;
+
+   return nfiles;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ProcessFiles()
+
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// Read the next epoch into ed, and decide whether to process it (ed.process).
+// Return false at the end of the data, with iret 0, or 3 if reading failed.
+bool ReadEpoch(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead, EpochData& ed,
+               int& iret) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   Rinex3ObsData& Rdata(ed.Rdata);
+
+   ed.process = false;
+
+   try { istrm >> Rdata; }
+   catch(Exception& e) {
+      LOG(WARNING) << " Warning : Failed to read obs data (Exception "
+         << e.getText(0) << "); dump follows.";
+      Rdata.dump(LOGstrm,Rhead);
+      istrm.close();
+      iret = 3;
+      return false;
+   }
+   catch(std::exception& e) {
+      Exception ge(string("Std excep: ") + e.what());
+      GPSTK_THROW(ge);
+   }
+   catch(...) {
+      Exception ue("Unknown exception while reading RINEX data.");
+      GPSTK_THROW(ue);
+   }
+
+   // normal EOF
+   if(!istrm.good() || istrm.eof()) { iret = 0; return false; }
+
+   // if aux header data, or no data, skip it
+   if(Rdata.epochFlag > 1 || Rdata.obs.empty()) {
+      LOG(DEBUG) << " RINEX Data is aux header or empty.";
+      return true;
+   }
+
+   LOG(DEBUG) << "\n Read RINEX data: flag " << Rdata.epochFlag
+      << ", timetag " << printTime(Rdata.time,C.longfmt);
+
+   // stay within time limits
+   if(Rdata.time < C.beginTime) {
+      LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
+         << " is before begin time.";
+      return true;
+   }
+   if(Rdata.time > C.endTime) {
+      LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
+         << " is after end time.";
+      return false;
+   }
+
+   // decimate
+   if(C.decimate > 0.0) {
+      double dt(::fabs(Rdata.time - C.decTime));
+      dt -= C.decimate * long(0.5 + dt/C.decimate);
+      if(::fabs(dt) > 0.25) {
+         LOG(DEBUG) << " Decimation rejects RINEX data timetag "
+            << printTime(Rdata.time,C.longfmt);
+         return true;
+      }
+   }
+
+   ed.process = true;
+   return true;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ReadEpoch()
+
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// Correct the data in ed for DCB, apply the elevation mask and collect the data for
+// each of SolObjs. If ahead, also evaluate the ephemeris for each, and move the data
+// from SolObjs into ed. Nothing used here changes between epochs, except the trop
+// model used for ORDs, so with ahead this may run on another thread, using copies
+// of C.SolObjs, provided ORDs are not output.
+void PrepareEpoch(EpochData& ed, vector<SolutionObject>& SolObjs,
+                  Rinex3ObsHeader& Rhead, const bool DCBcorr,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  const bool ahead) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   Rinex3ObsData& Rdata(ed.Rdata);
+   size_t i;
+
+   // reset solution objects for this epoch
+   for(i=0; i<SolObjs.size(); ++i)
+      SolObjs[i].EpochReset();
+
+   // loop over satellites -----------------------------
+   RinexSatID sat;
+   Rinex3ObsData::DataMap::iterator it;
+   for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
+      sat = it->first;
+      vector<RinexDatum>& vrdata(it->second);
+      string sys(asString(sat.systemChar()));
+
+      // is this system excluded?
+      if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
+            == C.allSystemChars.end())
+      {
+         LOG(DEBUG) << " Sat " << sat << " : system " << sys
+            << " is not needed.";
+         continue;
+      }
+
+      // has user excluded this satellite?
+      if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
+         LOG(DEBUG) << " Sat " << sat << " is excluded.";
+         continue;
+      }
+
+      // correct for DCB
+      map<string,int>::const_iterator jt;
+      if(DCBcorr && (jt = mapDCBindex.find(sys)) != mapDCBindex.end()) {
+         i = jt->second;
+         map<RinexSatID,double>::const_iterator kt(C.P1C1bias.find(sat));
+         if(kt != C.P1C1bias.end()) {
+            LOG(DEBUG) << "Correct data " << asString(Rhead.mapObsTypes[sys][i])
+               << " = " << fixed << setprecision(2) << vrdata[i].data
+               << " for DCB with " << kt->second;
+            vrdata[i].data += kt->second;
          }
+      }
 
-         // decimate
-         if(C.decimate > 0.0) {
-            double dt(::fabs(Rdata.time - C.decTime));
-            dt -= C.decimate * long(0.5 + dt/C.decimate);
-            if(::fabs(dt) > 0.25) {
-               LOG(DEBUG) << " Decimation rejects RINEX data timetag "
+      // elevation mask, azimuth and ephemeris range corrected with trop
+      // - pass elev to CollectData for m-cov matrix and ORDs
+      double elev(0), ER(0), tcorr;
+      if((C.elevLimit > 0 || C.weight || C.ORDout)
+                        && PrevPos.getCoordinateSystem() != Position::Unknown) {
+         CorrectedEphemerisRange CER;
+         try {
+            CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
+            elev = CER.elevation;
+            // const double azim = CER.azimuth;
+            if(C.ORDout) {
+               tcorr = C.pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
+               ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
+            }
+            if(elev < C.elevLimit) {         // TD add elev mask [azim]
+               LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
+                  << fixed << setprecision(2) << elev << " at time "
                   << printTime(Rdata.time,C.longfmt);
                continue;
             }
          }
+         catch(Exception& e) {
+            LOG(WARNING) << "WARNING : Failed to get elevation for sat "
+               << sat << " at time " << printTime(Rdata.time,C.longfmt);
+            continue;
+         }
+      }
 
-         // reset solution objects for this epoch
-         for(i=0; i<C.SolObjs.size(); ++i)
-            C.SolObjs[i].EpochReset();
+      // pick out data for each solution object
+      for(i=0; i<SolObjs.size(); ++i)
+         SolObjs[i].CollectData(sat,elev,ER,vrdata);
 
-         // loop over satellites -----------------------------
-         RinexSatID sat;
-         Rinex3ObsData::DataMap::iterator it;
-         for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
-            sat = it->first;
-            vector<RinexDatum>& vrdata(it->second);
-            string sys(asString(sat.systemChar()));
-
-            // is this system excluded?
-            if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
-                  == C.allSystemChars.end())
-            {
-               LOG(DEBUG) << " Sat " << sat << " : system " << sys
-                  << " is not needed.";
-               continue;
-            }
+   }  // end loop over satellites
 
-            // has user excluded this satellite?
-            if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
-               LOG(DEBUG) << " Sat " << sat << " is excluded.";
-               continue;
-            }
-
-            // correct for DCB
-            if(DCBcorr && mapDCBindex.find(sys) != mapDCBindex.end()) {
-               i = mapDCBindex[sys];
-               if(C.P1C1bias.find(sat) != C.P1C1bias.end()) {
-                  LOG(DEBUG) << "Correct data " << asString(Rhead.mapObsTypes[sys][i])
-                     << " = " << fixed << setprecision(2) << vrdata[i].data
-                     << " for DCB with " << C.P1C1bias[sat];
-                  vrdata[i].data += C.P1C1bias[sat];
-               }
-            }
+   // evaluate the ephemeris, and keep the data for SolveEpoch()
+   if(ahead) {
+      ed.sols.resize(SolObjs.size());
+      for(i=0; i<SolObjs.size(); ++i) {
+         SolObjs[i].PrepareSolution(Rdata.time);
+         SolObjs[i].SwapEpoch(ed.sols[i]);
+      }
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end PrepareEpoch()
 
-            // elevation mask, azimuth and ephemeris range corrected with trop
-            // - pass elev to CollectData for m-cov matrix and ORDs
-            double elev(0), ER(0), tcorr;
-            if((C.elevLimit > 0 || C.weight || C.ORDout)
-                              && PrevPos.getCoordinateSystem() != Position::Unknown) {
-               CorrectedEphemerisRange CER;
-               try {
-                  CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
-                  elev = CER.elevation;
-                  // const double azim = CER.azimuth;
-                  if(C.ORDout) {
-                     tcorr = C.pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
-                     ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
-                  }
-                  if(elev < C.elevLimit) {         // TD add elev mask [azim]
-                     LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
-                        << fixed << setprecision(2) << elev << " at time "
-                        << printTime(Rdata.time,C.longfmt);
-                     continue;
-                  }
-               }
-               catch(Exception& e) {
-                  LOG(WARNING) << "WARNING : Failed to get elevation for sat "
-                     << sat << " at time " << printTime(Rdata.time,C.longfmt);
-                  continue;
-               }
-            }
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// Compute and output the solutions for ed, after PrepareEpoch(), and write to the
+// output RINEX file. Epochs must be solved in time order.
+void SolveEpoch(EpochData& ed, Rinex3ObsHeader& Rhead, Rinex3ObsStream& ostrm)
+   throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   Rinex3ObsData& Rdata(ed.Rdata);
+   int k;
+   size_t i,j;
 
-            // pick out data for each solution object
-            for(i=0; i<C.SolObjs.size(); ++i)
-               C.SolObjs[i].CollectData(sat,elev,ER,vrdata);
+   // data prepared ahead
+   for(i=0; i<ed.sols.size(); ++i)
+      C.SolObjs[i].SwapEpoch(ed.sols[i]);
 
-         }  // end loop over satellites
+   // debug: dump the RINEX data object
+   if(C.debug > -1) Rdata.dump(LOGstrm,Rhead);
 
-         // debug: dump the RINEX data object
-         if(C.debug > -1) Rdata.dump(LOGstrm,Rhead);
+   // update the trop model's weather ------------------
+   if(C.MetStore.size() > 0) C.setWeather(Rdata.time);
 
-         // update the trop model's weather ------------------
-         if(C.MetStore.size() > 0) C.setWeather(Rdata.time);
+   // put a blank line here for readability
+   LOG(INFO) << "";
 
-         // put a blank line here for readability
-         LOG(INFO) << "";
+   // compute the solution(s) --------------------------
+   // tag for DAT - required for PRSplot
+   C.msg = printTime(Rdata.time,"DAT "+C.gpsfmt);
 
-         // compute the solution(s) --------------------------
-         // tag for DAT - required for PRSplot
-         C.msg = printTime(Rdata.time,"DAT "+C.gpsfmt);
+   // compute and print the solution(s) ----------------
+   for(i=0; i<C.SolObjs.size(); ++i) {
+      // skip invalid descriptors
+      if(!C.SolObjs[i].isValid) continue;
 
-         // compute and print the solution(s) ----------------
-         for(i=0; i<C.SolObjs.size(); ++i) {
-            // skip invalid descriptors
-            if(!C.SolObjs[i].isValid) continue;
+      // dump the "DAT" record
+      LOG(INFO) << C.SolObjs[i].dump((C.debug > -1 ? 2:1), "RPF", C.msg);
 
-            // dump the "DAT" record
-            LOG(INFO) << C.SolObjs[i].dump((C.debug > -1 ? 2:1), "RPF", C.msg);
+      // compute the solution
+      j = C.SolObjs[i].ComputeSolution(Rdata.time);
 
-            // compute the solution
-            j = C.SolObjs[i].ComputeSolution(Rdata.time);
+      // write ORDs, even if solution is not good
+      if(C.ORDout) C.SolObjs[i].WriteORDs(Rdata.time,j);
+   }
 
-            // write ORDs, even if solution is not good
-            if(C.ORDout) C.SolObjs[i].WriteORDs(Rdata.time,j);
+   // write to output RINEX ----------------------------
+   if(!C.OutputObsFile.empty()) {
+      Rinex3ObsData auxData;
+      auxData.time = Rdata.time;
+      auxData.clockOffset = Rdata.clockOffset;
+      auxData.epochFlag = 4;
+      ostringstream oss;
+      // loop over valid descriptors
+      for(k=0,i=0; i<C.SolObjs.size(); ++i) if(C.SolObjs[i].isValid) {
+         if(!C.SolObjs[i].prs.isValid())
+         {
+            LOG(ERROR) << "Invalid soution!";
+            break;
+         }
+         oss.str("");
+         oss << "XYZ" << fixed << setprecision(3)
+            << " " << setw(12) << C.SolObjs[i].prs.Solution(0)
+            << " " << setw(12) << C.SolObjs[i].prs.Solution(1)
+            << " " << setw(12) << C.SolObjs[i].prs.Solution(2);
+         oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+         oss.str("");
+         oss << "CLK" << fixed << setprecision(3);
+
+         for(j=0; j<C.SolObjs[i].prs.SystemIDs.size(); j++) {
+            RinexSatID sat(1,C.SolObjs[i].prs.SystemIDs[j]);
+            oss << " " << sat.systemString3()
+               << " " << setw(11) << C.SolObjs[i].prs.Solution(3+j);
          }
+         oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+         oss.str("");
+         oss << "DIA" << setw(2) << C.SolObjs[i].prs.Nsvs
+            << fixed << setprecision(2)
+            << " " << setw(4) << C.SolObjs[i].prs.PDOP
+            << " " << setw(4) << C.SolObjs[i].prs.GDOP
+            << " " << setw(8) << C.SolObjs[i].prs.RMSResidual
+            << " " << C.SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+      }
+      auxData.numSVs = k;            // number of lines to write
+      auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
+      ostrm << auxData;
 
-         // write to output RINEX ----------------------------
-         if(!C.OutputObsFile.empty()) {
-            Rinex3ObsData auxData;
-            auxData.time = Rdata.time;
-            auxData.clockOffset = Rdata.clockOffset;
-            auxData.epochFlag = 4;
-            ostringstream oss;
-            // loop over valid descriptors
-            for(k=0,i=0; i<C.SolObjs.size(); ++i) if(C.SolObjs[i].isValid) {
-               if(!C.SolObjs[i].prs.isValid())
-               {
-                  LOG(ERROR) << "Invalid soution!";
-                  break;
-               }
-               oss.str("");
-               oss << "XYZ" << fixed << setprecision(3)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(0)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(1)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(2);
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "CLK" << fixed << setprecision(3);
-
-               for(j=0; j<C.SolObjs[i].prs.SystemIDs.size(); j++) {
-                  RinexSatID sat(1,C.SolObjs[i].prs.SystemIDs[j]);
-                  oss << " " << sat.systemString3()
-                     << " " << setw(11) << C.SolObjs[i].prs.Solution(3+j);
-               }
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "DIA" << setw(2) << C.SolObjs[i].prs.Nsvs
-                  << fixed << setprecision(2)
-                  << " " << setw(4) << C.SolObjs[i].prs.PDOP
-                  << " " << setw(4) << C.SolObjs[i].prs.GDOP
-                  << " " << setw(8) << C.SolObjs[i].prs.RMSResidual
-                  << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-            }
-            auxData.numSVs = k;            // number of lines to write
-            auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
-            ostrm << auxData;
+      ostrm << Rdata;
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end SolveEpoch()
 
-            ostrm << Rdata;
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// Process the epochs of one file, as ProcessFiles() does without threads, but with
+// the epochs read ahead on this thread and prepared by a pool of C.nthreads threads.
+// Each thread collects data into its own copy of C.SolObjs, while this one solves
+// the epochs, in order, with C.SolObjs. Return iret as for ReadEpoch().
+int ProcessEpochsThreaded(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead,
+                          const bool DCBcorr, const map<string,int>& mapDCBindex,
+                          const Position& PrevPos, Rinex3ObsStream& ostrm)
+   throw(Exception)
+{
+   Configuration& C(Configuration::Instance());
+   const size_t maxAhead(16*C.nthreads);  // limit on epochs read but not solved
+   int iret(0);
+   bool endOfData(false), quit(false);
+
+   deque< unique_ptr<EpochData> > window; // epochs read, in order, not yet solved
+   deque<EpochData *> work;               // epochs to be prepared
+   mutex mtx;                             // protects work, quit and prepared
+   condition_variable workReady;          // an epoch was added to work, or quit
+   condition_variable epochReady;         // an epoch was prepared
+
+   // the copies must be made before this thread starts changing C.SolObjs
+   vector< vector<SolutionObject> > copies(C.nthreads, C.SolObjs);
+
+   auto preparer = [&](vector<SolutionObject>& SolObjs) {
+      while(1) {
+         EpochData *ped;
+         {
+            unique_lock<mutex> lock(mtx);
+            while(work.empty() && !quit) workReady.wait(lock);
+            if(quit) return;
+            ped = work.front();
+            work.pop_front();
          }
 
-      }  // end while loop over epochs
+         ConfigureLOGstream::ThreadStream() = &ped->log;
+         try {
+            PrepareEpoch(*ped, SolObjs, Rhead, DCBcorr, mapDCBindex, PrevPos, true);
+         }
+         catch(Exception& e) { ped->failed = true; ped->error = e; }
+         catch(std::exception& e) {
+            ped->failed = true;
+            ped->error = Exception(string("Std excep: ") + e.what());
+         }
+         ConfigureLOGstream::ThreadStream() = NULL;
 
-      istrm.close();
+         lock_guard<mutex> lock(mtx);
+         ped->prepared = true;
+         epochReady.notify_all();
+      }
+   };
 
-      // failure due to critical error
-      if(iret < 0) break;
+   vector<thread> pool;
+   for(int n=0; n<C.nthreads; n++)
+      pool.push_back(thread(preparer, ref(copies[n])));
 
-      if(iret == 0) nfiles++;
+   // stop the pool, on the way out
+   auto stop = [&]() {
+      {
+         lock_guard<mutex> lock(mtx);
+         quit = true;
+      }
+      workReady.notify_all();
+      for(size_t n=0; n<pool.size(); n++) pool[n].join();
+   };
 
-   }  // end loop over files
+   try {
+      while(1) {
+         // read ahead, keeping the LOG output of each epoch with it
+         while(!endOfData && window.size() < maxAhead) {
+            unique_ptr<EpochData> ped(new EpochData());
+            ConfigureLOGstream::ThreadStream() = &ped->log;
+            try {
+               endOfData = !ReadEpoch(istrm, Rhead, *ped, iret);
+            }
+            catch(Exception& e) {
+               endOfData = ped->failed = true;
+               ped->error = e;
+            }
+            ConfigureLOGstream::ThreadStream() = NULL;
 
-   if(!C.OutputObsFile.empty()) ostrm.close();
+            if(ped->process) {
+               lock_guard<mutex> lock(mtx);
+               work.push_back(ped.get());
+               workReady.notify_one();
+            }
+            window.push_back(move(ped));
+         }
 
-   if(iret < 0) return iret;
+         if(window.empty()) break;
 
-   return nfiles;
-}
-catch(Exception& e) { GPSTK_RETHROW(e); }
-}  // end ProcessFiles()
+         // solve the oldest epoch, once it is prepared
+         EpochData& ed(*window.front());
+         if(ed.process) {
+            unique_lock<mutex> lock(mtx);
+            while(!ed.prepared) epochReady.wait(lock);
+         }
+         if(pLOGstrm) LOGstrm << ed.log.str() << flush;
+         if(ed.failed) GPSTK_THROW(ed.error);
+         if(ed.process) SolveEpoch(ed, Rhead, ostrm);
+
+         window.pop_front();
+      }
+   }
+   catch(Exception& e) { stop(); GPSTK_RETHROW(e); }
+
+   stop();
+   return iret;
+
+}  // end ProcessEpochsThreaded()
 
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -1628,8 +1886,11 @@ void Configuration::SetDefaults(void) throw()
       maxReject = dummy.NSatsReject;
       nIter = dummy.MaxNIterations;
       convLimit = dummy.ConvergenceLimit;
+      incRAIM = dummy.IncrementalRAIM;
    }
 
+   nthreads = 1;
+
    userfmt = gpsfmt;
    help = verbose = false;
    debug = -1;
@@ -1911,6 +2172,8 @@ string Configuration::BuildCommandLine(void) throw()
             "Maximum iteration count in linearized LS");
    opts.Add(0, "conv", "lim", false, false, &convLimit, "",
             "Maximum convergence criterion in estimation in meters");
+   opts.Add(0, "incRAIM", "", false, false, &incRAIM, "",
+            "Screen RAIM combinations by downdating the all-satellite solution");
    opts.Add(0, "Trop", "m,T,P,H", false, false, &TropStr, "",
             "Trop model <m> [one of Zero,Black,Saas,NewB,Neill,GG,GGHt,Global\n"
             "                      with optional weather T(C),P(mb),RH(%)]");
@@ -1933,6 +2196,9 @@ string Configuration::BuildCommandLine(void) throw()
    opts.Add(0, "timefmt", "f", false, false, &userfmt, "",
             "Format for time tags in output");
 
+   opts.Add(0, "threads", "n", false, false, &nthreads, "# Processing:",
+            "Number of threads to prepare epochs (ephemeris, etc.) [1: none]");
+
    opts.Add(0, "SOLhelp", "", false, false, &SOLhelp, "# Help",
             "Show more information and examples for --sol <Solution Descriptor>");
 
@@ -2098,6 +2364,15 @@ int Configuration::ExtraProcessing(string& errors, string& extras) throw()
    if(InputNavFiles.size() > 0 && InputSP3Files.size() > 0)
       oss << "Error : Both --nav and --eph appear: provide only one.\n";
 
+   // epochs are prepared ahead; the ORDs use the trop model, which depends on
+   // earlier epochs, and debug output from ephemeris would be out of order
+   if(nthreads < 1)
+      oss << "Error : --threads must be at least 1\n";
+   else if(nthreads > 1 && (!OutputORDFile.empty() || debug > -1)) {
+      ossx << "   Warning : --threads is ignored with --ORDs or --debug.\n";
+      nthreads = 1;
+   }
+
    //
    if(LOGlevel != 2)
       ossx << "   LOG level is " << ConfigureLOG::ToString(LOGlevel) << "\n";
@@ -2356,6 +2631,24 @@ void SolutionObject::EpochReset(void) throw()
    R1.clear();
    R2.clear();
    UsedObsIDs.clear();
+   Prepared = false;
+}
+
+//------------------------------------------------------------------------------------
+void SolutionObject::SwapEpoch(EpochState& es) throw()
+{
+   Satellites.swap(es.Satellites);
+   PRanges.swap(es.PRanges);
+   Elevations.swap(es.Elevations);
+   ERanges.swap(es.ERanges);
+   RIono.swap(es.RIono);
+   R1.swap(es.R1);
+   R2.swap(es.R2);
+   UsedObsIDs.swap(es.UsedObsIDs);
+   swap(Prepared,es.Prepared);
+   swap(PrepN,es.PrepN);
+   PrepSats.swap(es.PrepSats);
+   swap(PrepSVP,es.PrepSVP);
 }
 
 //------------------------------------------------------------------------------------
@@ -2383,6 +2676,20 @@ void SolutionObject::CollectData(const RinexSatID& sat,
    }
 }
 
+//------------------------------------------------------------------------------------
+// PreparePRSolution() changes nothing in prs, so this may be called on a copy
+void SolutionObject::PrepareSolution(const CommonTime& ttag) throw()
+{
+   Configuration& C(Configuration::Instance());
+
+   Prepared = false;
+   if(!isValid || Satellites.size() < 4) return;
+
+   PrepSats = Satellites;
+   PrepN = prs.PreparePRSolution(ttag, PrepSats, satSyss, PRanges, C.pEph, PrepSVP);
+   Prepared = true;
+}
+
 //------------------------------------------------------------------------------------
 // return 0 good, negative failure - same as RAIMCompute
 int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
@@ -2399,6 +2706,10 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
          return -3;
       }
 
+      // the ephemeris may already have been evaluated; mark Satellites as
+      // PreparePRSolution() would
+      if(Prepared) Satellites = PrepSats;
+
       // compute the inverse measurement covariance
       Matrix<double> invMCov;       // default is empty
       if(C.weight) {
@@ -2419,7 +2730,9 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
       // get the straight solution --------------------------------------
       if(C.SPSout) {
          Matrix<double> SVP;
-         iret=prs.PreparePRSolution(ttag, Satellites, satSyss, PRanges, C.pEph, SVP);
+         if(Prepared) { SVP = PrepSVP; iret = PrepN; }
+         else
+            iret=prs.PreparePRSolution(ttag,Satellites,satSyss,PRanges,C.pEph,SVP);
 
          if(iret > -3) {
             //Vector<double> APSol(5,0.0),Resid,Slopes;
@@ -2481,8 +2794,11 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
       }  // end if SPSout
 
       // get the RAIM solution ------------------------------------------
-      iret = prs.RAIMCompute(ttag, Satellites, satSyss, PRanges, invMCov, C.pEph,
-                             C.pTrop);
+      if(Prepared)
+         iret = prs.RAIMCompute(ttag, Satellites, satSyss, PrepSVP, invMCov, C.pTrop);
+      else
+         iret = prs.RAIMCompute(ttag, Satellites, satSyss, PRanges, invMCov, C.pEph,
+                                C.pTrop);
 
       if(iret < 0) {
          LOG(VERBOSE) << "RAIMCompute failed "
@@ -0,0 +1,211 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Benchmark.cpp
+ * Timing harness for the gpstk_bench program.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+#include "Exception.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   Benchmark ::
+   Benchmark(const std::string& benchName,
+             const std::string& desc,
+             const std::string& itemUnit)
+         : name(benchName),
+           description(desc),
+           unit(itemUnit),
+           sink(0)
+   {
+      registry().push_back(this);
+   }
+
+
+   std::vector<Benchmark*>& Benchmark ::
+   registry()
+   {
+      static std::vector<Benchmark*> benchmarks;
+      return benchmarks;
+   }
+
+
+      // Time n iterations of bench, returning the elapsed seconds and
+      // the number of items processed in the last iteration.
+   static double timeIterations(Benchmark& bench, unsigned long n,
+                                unsigned long& items)
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (unsigned long i = 0; i < n; i++)
+         items = bench.run();
+      chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+      return chrono::duration<double>(stop - start).count();
+   }
+
+
+   BenchResult runBenchmark(Benchmark& bench,
+                            const std::string& dataDir,
+                            double minTime,
+                            unsigned repeats)
+   {
+      BenchResult rv;
+      rv.name = bench.name;
+      rv.description = bench.description;
+      rv.unit = bench.unit;
+      try
+      {
+         bench.setUp(dataDir);
+            // warm up caches and find the number of iterations
+         unsigned long n = 1;
+         double elapsed = timeIterations(bench, 1, rv.items);
+         while (elapsed < minTime)
+         {
+            n *= 2;
+            elapsed = timeIterations(bench, n, rv.items);
+         }
+         rv.iterations = n;
+         for (unsigned i = 0; i < std::max(repeats, 1U); i++)
+         {
+            rv.samples.push_back(timeIterations(bench, n, rv.items) / n);
+         }
+         bench.tearDown();
+      }
+      catch (Exception& exc)
+      {
+         rv.error = exc.getText();
+         rv.samples.clear();
+      }
+      catch (std::exception& exc)
+      {
+         rv.error = exc.what();
+         rv.samples.clear();
+      }
+      if (rv.samples.empty())
+         return rv;
+
+      vector<double> sorted(rv.samples);
+      sort(sorted.begin(), sorted.end());
+      size_t mid = sorted.size() / 2;
+      rv.minTime = sorted.front();
+      rv.maxTime = sorted.back();
+      rv.medianTime = (sorted.size() % 2) ? sorted[mid]
+         : 0.5 * (sorted[mid-1] + sorted[mid]);
+      rv.meanTime = 0;
+      for (size_t i = 0; i < sorted.size(); i++)
+         rv.meanTime += sorted[i];
+      rv.meanTime /= sorted.size();
+      return rv;
+   }
+
+
+   void BenchResult ::
+   writeJSON(std::ostream& s, const std::string& indent) const
+   {
+      ostringstream oss;
+      oss << setprecision(6);
+      oss << indent << "{" << endl
+          << indent << "  \"name\": " << jsonString(name) << "," << endl
+          << indent << "  \"description\": " << jsonString(description)
+          << "," << endl
+          << indent << "  \"unit\": " << jsonString(unit) << "," << endl;
+      if (!error.empty())
+      {
+         oss << indent << "  \"error\": " << jsonString(error) << endl
+             << indent << "}";
+         s << oss.str();
+         return;
+      }
+      double itemRate = (medianTime > 0) ? items / medianTime : 0;
+      oss << indent << "  \"items_per_iteration\": " << items << "," << endl
+          << indent << "  \"iterations_per_sample\": " << iterations << ","
+          << endl
+          << indent << "  \"time_ns\": {"
+          << "\"min\": " << minTime * 1e9
+          << ", \"median\": " << medianTime * 1e9
+          << ", \"mean\": " << meanTime * 1e9
+          << ", \"max\": " << maxTime * 1e9 << "}," << endl
+          << indent << "  \"samples_ns\": [";
+      for (size_t i = 0; i < samples.size(); i++)
+         oss << (i ? ", " : "") << samples[i] * 1e9;
+      oss << "]," << endl
+          << indent << "  \"items_per_second\": " << itemRate << endl
+          << indent << "}";
+      s << oss.str();
+   }
+
+
+   std::string jsonString(const std::string& str)
+   {
+      string rv("\"");
+      for (size_t i = 0; i < str.size(); i++)
+      {
+         unsigned char c = str[i];
+         switch (c)
+         {
+            case '"':  rv += "\\\""; break;
+            case '\\': rv += "\\\\"; break;
+            case '\n': rv += "\\n"; break;
+            case '\r': rv += "\\r"; break;
+            case '\t': rv += "\\t"; break;
+            default:
+               if (c < 0x20)
+               {
+                  char buf[8];
+                  snprintf(buf, sizeof(buf), "\\u%04x", c);
+                  rv += buf;
+               }
+               else
+               {
+                  rv += c;
+               }
+               break;
+         }
+      }
+      rv += "\"";
+      return rv;
+   }
+
+} // namespace gpstk
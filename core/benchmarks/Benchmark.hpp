@@ -0,0 +1,142 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Benchmark.hpp
+ * Timing harness for the gpstk_bench program.
+ */
+
+#ifndef GPSTK_BENCHMARK_HPP
+#define GPSTK_BENCHMARK_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gpstk
+{
+      /**
+       * Base class for the benchmarks run by gpstk_bench.
+       *
+       * A benchmark is constructed as a static object in one of the
+       * benchmark source files, which registers it so gpstk_bench
+       * can find it by name.  The input data are loaded by setUp(),
+       * which is not timed, then run() is timed repeatedly.  Each
+       * call to run() must do the same amount of work so that the
+       * results from different runs and different GPSTk versions
+       * are comparable.
+       */
+   class Benchmark
+   {
+   public:
+         /** Register a benchmark.
+          * @param[in] benchName unique name, e.g. "rinex3_obs_read".
+          * @param[in] desc one line description of what is timed.
+          * @param[in] itemUnit what run() counts, e.g. "epochs". */
+      Benchmark(const std::string& benchName,
+                const std::string& desc,
+                const std::string& itemUnit);
+
+      virtual ~Benchmark() {}
+
+         /** Load the input data, reading files from dataDir.
+          * @throw Exception if the data could not be loaded. */
+      virtual void setUp(const std::string& dataDir) {}
+
+         /** Perform one timed iteration.
+          * @return the number of items (epochs, records,
+          *   evaluations...) processed. */
+      virtual unsigned long run() = 0;
+
+         /// Release anything allocated by setUp().
+      virtual void tearDown() {}
+
+         /// All the benchmarks constructed so far, in order.
+      static std::vector<Benchmark*>& registry();
+
+      std::string name;          ///< Unique name of the benchmark.
+      std::string description;   ///< What is being timed.
+      std::string unit;          ///< What the items returned by run() are.
+
+         /** Benchmarks should accumulate their results here so the
+          * compiler can not discard the work being timed. */
+      double sink;
+   };
+
+
+      /// Timing statistics for one benchmark.
+   class BenchResult
+   {
+   public:
+      BenchResult()
+            : iterations(0), items(0), minTime(0), medianTime(0),
+              meanTime(0), maxTime(0)
+      {}
+
+         /// Write this result as a JSON object.
+      void writeJSON(std::ostream& s, const std::string& indent) const;
+
+      std::string name;          ///< Benchmark::name
+      std::string description;   ///< Benchmark::description
+      std::string unit;          ///< Benchmark::unit
+      std::string error;         ///< Set if the benchmark failed.
+      unsigned long iterations;  ///< Number of iterations per sample.
+      unsigned long items;       ///< Items per iteration.
+      std::vector<double> samples; ///< Seconds per iteration, each sample.
+      double minTime;            ///< Fastest sample, seconds per iteration.
+      double medianTime;         ///< Median sample, seconds per iteration.
+      double meanTime;           ///< Mean of the samples.
+      double maxTime;            ///< Slowest sample.
+   };
+
+
+      /** Time a benchmark.  The benchmark is run once to warm up,
+       * then the number of iterations per sample is doubled until a
+       * sample takes at least minTime seconds, then that many
+       * iterations are timed repeats times.
+       * Exceptions from the benchmark are caught and stored in the
+       * error member of the result. */
+   BenchResult runBenchmark(Benchmark& bench,
+                            const std::string& dataDir,
+                            double minTime,
+                            unsigned repeats);
+
+      /// Quote and escape a string for JSON output.
+   std::string jsonString(const std::string& str);
+
+} // namespace gpstk
+
+#endif // GPSTK_BENCHMARK_HPP
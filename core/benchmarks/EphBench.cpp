@@ -0,0 +1,192 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file EphBench.cpp
+ * Benchmarks of satellite position evaluation.
+ */
+
+#include <set>
+
+#include "GPSEphemerisStore.hpp"
+#include "Rinex3NavData.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavStream.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /// SP3 position and clock interpolation, one request at a time or
+   /// one satellite's time series at a time.
+class SP3Bench : public Benchmark
+{
+public:
+   SP3Bench(const string& benchName, const string& desc, bool useBatch)
+         : Benchmark(benchName, desc, "evaluations"),
+           batch(useBatch)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      store.clear();
+      store.loadFile(dataDir + "/test_input_sp3_nav_2015_200.sp3");
+      sats = store.getSatList();
+         // stay an hour away from the ends so every request is
+         // interpolated rather than rejected
+      times.clear();
+      CommonTime t = store.getInitialTime() + 3600.;
+      CommonTime tend = store.getFinalTime() - 3600.;
+      for ( ; t < tend; t += 120.)
+         times.push_back(t);
+   }
+
+   virtual unsigned long run()
+   {
+      unsigned long count = 0;
+      for (unsigned i = 0; i < sats.size(); i++)
+      {
+         if (batch)
+         {
+            store.computeXvt(sats[i], times, xvts);
+            for (unsigned j = 0; j < xvts.size(); j++)
+               sink += xvts[j].x[0];
+         }
+         else
+         {
+            for (unsigned j = 0; j < times.size(); j++)
+            {
+               try
+               {
+                  sink += store.getXvt(sats[i], times[j]).x[0];
+               }
+               catch (InvalidRequest&)
+               {
+               }
+            }
+         }
+         count += times.size();
+      }
+      return count;
+   }
+
+   virtual void tearDown()
+   { store.clear(); }
+
+private:
+   bool batch;
+   SP3EphemerisStore store;
+   vector<SatID> sats;
+   vector<CommonTime> times;
+   vector<Xvt> xvts;
+};
+
+static SP3Bench sp3Interp("sp3_interpolate",
+                          "SP3EphemerisStore::getXvt every 120 s for every"
+                          " satellite in a day of SP3 data", false);
+static SP3Bench sp3Batch("sp3_interpolate_batch",
+                         "SP3EphemerisStore::computeXvt for each"
+                         " satellite's 120 s time series", true);
+
+
+   /// Broadcast orbit evaluation from a GPS RINEX navigation file.
+class OrbitEphBench : public Benchmark
+{
+public:
+   OrbitEphBench()
+         : Benchmark("orbiteph_getxvt",
+                     "OrbitEphStore::getXvt every 60 s for every GPS"
+                     " satellite in a day of broadcast ephemerides",
+                     "evaluations")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      store.clear();
+      string fn(dataDir + "/arlm2000.15n");
+      Rinex3NavStream strm(fn.c_str());
+      if (!strm)
+      {
+         Exception exc("Unable to open " + fn);
+         GPSTK_THROW(exc);
+      }
+      Rinex3NavHeader hdr;
+      Rinex3NavData rnd;
+      strm >> hdr;
+      while (strm >> rnd)
+      {
+         if (rnd.sat.system == SatID::systemGPS)
+            store.addEphemeris(GPSEphemeris(rnd));
+      }
+      set<SatID> satSet(store.getIndexSet());
+      sats.assign(satSet.begin(), satSet.end());
+      times.clear();
+      for (CommonTime t = store.getInitialTime();
+           t < store.getFinalTime(); t += 60.)
+      {
+         times.push_back(t);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      for (unsigned i = 0; i < sats.size(); i++)
+      {
+         for (unsigned j = 0; j < times.size(); j++)
+         {
+            try
+            {
+               sink += store.getXvt(sats[i], times[j]).x[0];
+            }
+            catch (InvalidRequest&)
+            {
+            }
+         }
+      }
+      return sats.size() * times.size();
+   }
+
+   virtual void tearDown()
+   { store.clear(); }
+
+private:
+   GPSEphemerisStore store;
+   vector<SatID> sats;
+   vector<CommonTime> times;
+};
+
+static OrbitEphBench orbitEph;
@@ -0,0 +1,159 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FileBench.cpp
+ * Benchmarks of RINEX file parsing.
+ */
+
+#include "Rinex3NavData.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /// Read every epoch of a RINEX observation file.
+class ObsReadBench : public Benchmark
+{
+public:
+   ObsReadBench(const string& benchName, const string& desc,
+                const string& file, bool useMap)
+         : Benchmark(benchName, desc, "epochs"),
+           fileName(file),
+           memoryMap(useMap)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      path = dataDir + "/" + fileName;
+      Rinex3ObsStream strm(path.c_str());
+      if (!strm)
+      {
+         Exception exc("Unable to open " + path);
+         GPSTK_THROW(exc);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      Rinex3ObsStream strm(path.c_str());
+      strm.exceptions(fstream::failbit);
+      if (memoryMap)
+         strm.useMemoryMap(true);
+      Rinex3ObsHeader hdr;
+      Rinex3ObsData rod;
+      unsigned long count = 0;
+      strm >> hdr;
+      while (strm >> rod)
+      {
+         sink += rod.obs.size();
+         count++;
+      }
+      return count;
+   }
+
+private:
+   string fileName;
+   string path;
+   bool memoryMap;
+};
+
+static ObsReadBench rinex2Obs("rinex2_obs_read",
+                              "Rinex3ObsStream reading a RINEX 2.11 file",
+                              "arlm200a.15o", false);
+static ObsReadBench rinex3Obs("rinex3_obs_read",
+                              "Rinex3ObsStream reading a RINEX 3.03 file",
+                              "Rinex3ObsLoader303.obs", false);
+static ObsReadBench rinex3ObsMap("rinex3_obs_read_mapped",
+                                 "Rinex3ObsStream reading a RINEX 3.03 file"
+                                 " through a memory map",
+                                 "Rinex3ObsLoader303.obs", true);
+
+
+   /// Read every record of a RINEX navigation file.
+class NavReadBench : public Benchmark
+{
+public:
+   NavReadBench(const string& benchName, const string& desc,
+                const string& file)
+         : Benchmark(benchName, desc, "records"),
+           fileName(file)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      path = dataDir + "/" + fileName;
+      Rinex3NavStream strm(path.c_str());
+      if (!strm)
+      {
+         Exception exc("Unable to open " + path);
+         GPSTK_THROW(exc);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      Rinex3NavStream strm(path.c_str());
+      strm.exceptions(fstream::failbit);
+      Rinex3NavHeader hdr;
+      Rinex3NavData rnd;
+      unsigned long count = 0;
+      strm >> hdr;
+      while (strm >> rnd)
+      {
+         sink += rnd.af0;
+         count++;
+      }
+      return count;
+   }
+
+private:
+   string fileName;
+   string path;
+};
+
+static NavReadBench rinex2Nav("rinex2_nav_read",
+                              "Rinex3NavStream reading a RINEX 2.10 GPS"
+                              " navigation file", "nga002.15n");
+static NavReadBench rinex3Nav("rinex3_nav_read",
+                              "Rinex3NavStream reading a RINEX 3 mixed"
+                              " navigation file",
+                              "test_input_rinex3_76193040.14n");
@@ -0,0 +1,448 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file GeomaticsBench.cpp
+ * Benchmarks of the ext library's square root information filter,
+ * antenna phase center variations, Earth orientation, run time
+ * Expressions and robust statistics.
+ */
+
+#include "SRIFilter.hpp"
+#include "CompressedSparseMatrix.hpp"
+#include "AntennaStore.hpp"
+#include "EarthOrientationCache.hpp"
+#include "Expression.hpp"
+#include "RobustStats.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /// Measurement and time updates of a square root information filter.
+class SRIFilterBench : public Benchmark
+{
+public:
+   SRIFilterBench()
+         : Benchmark("srifilter_update",
+                     "SRIFilter measurement update (12 data) and time"
+                     " update of a 10 state filter, 100 steps",
+                     "steps")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      unsigned long seed = 54321;
+      partials.clear();
+      data.clear();
+      for (unsigned k = 0; k < numSteps; k++)
+      {
+         Matrix<double> H(numData, numStates);
+         Vector<double> D(numData);
+         for (unsigned i = 0; i < numData; i++)
+         {
+            for (unsigned j = 0; j < numStates; j++)
+            {
+               seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+               H(i,j) = double(seed) / 0x7fffffff - 0.5;
+            }
+            D(i) = double(i) - 0.5 * numData;
+         }
+         partials.push_back(H);
+         data.push_back(D);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      SRIFilter srif(numStates);
+      Matrix<double> PhiInv(numStates, numStates), G(numStates, numStates);
+      Matrix<double> Rw(numStates, numStates), Rwx(numStates, numStates);
+      Vector<double> D, Zw(numStates);
+      for (unsigned k = 0; k < numSteps; k++)
+      {
+         D = data[k];
+         srif.measurementUpdate(partials[k], D);
+
+            // the time update destroys its inputs
+         ident(PhiInv);
+         ident(G);
+         ident(Rw);
+         Rw *= 10.0;
+         Zw = 0.0;
+         srif.timeUpdate(PhiInv, Rw, G, Zw, Rwx);
+      }
+      Vector<double> X;
+      srif.getState(X);
+      sink += X(0);
+      return numSteps;
+   }
+
+private:
+   static const unsigned numStates = 10;
+   static const unsigned numData = 12;
+   static const unsigned numSteps = 100;
+   vector< Matrix<double> > partials;
+   vector< Vector<double> > data;
+};
+
+static SRIFilterBench sriFilter;
+
+
+   /** Measurement update with sparse partials like those of double
+    * differences from many stations: each datum depends on a few common
+    * states and on the states of its own station. */
+class SparseSRIFBench : public Benchmark
+{
+public:
+   SparseSRIFBench(const string& benchName, const string& desc,
+                   bool useCompressed)
+         : Benchmark(benchName, desc, "updates"),
+           compressed(useCompressed)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      unsigned long seed = 13579;
+      unsigned nrows = numStations*perStation;
+      unsigned ncols = numCommon + 2*numStations;
+      SparseBuilder<double> B(nrows, ncols);
+      data = Vector<double>(nrows);
+      for (unsigned s = 0; s < numStations; s++)
+      {
+         for (unsigned r = 0; r < perStation; r++)
+         {
+            unsigned i = s*perStation + r;
+            for (unsigned j = 0; j < numCommon; j++)
+            {
+               seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+               B.add(i, j, double(seed) / 0x7fffffff - 0.5);
+            }
+            B.add(i, numCommon + 2*s, 1.0);
+            B.add(i, numCommon + 2*s + 1, 0.1*r);
+            data(i) = double(r) - 0.5*s;
+         }
+      }
+      partialsCSC = B.toCSC();
+      partials = SparseMatrix<double>(Matrix<double>(partialsCSC));
+   }
+
+   virtual unsigned long run()
+   {
+      Matrix<double> R;
+      Vector<double> Z, D(data);
+      if (compressed)
+         SrifMU(R, Z, partialsCSC, D);
+      else
+         SrifMU(R, Z, partials, D, 0);
+      sink += Z(0);
+      return 1;
+   }
+
+private:
+   static const unsigned numStations = 20;
+   static const unsigned perStation = 8;
+   static const unsigned numCommon = 5;
+   bool compressed;
+   SparseMatrix<double> partials;
+   CSCMatrix<double> partialsCSC;
+   Vector<double> data;
+};
+
+static SparseSRIFBench sparseSRIF("srifmu_sparse",
+                                  "SrifMU with SparseMatrix partials, 160 data"
+                                  " and 45 states from 20 stations",
+                                  false);
+static SparseSRIFBench compressedSRIF("srifmu_csc",
+                                      "srifmu_sparse with the partials in"
+                                      " CSCMatrix form",
+                                      true);
+
+   /** Receiver antenna phase center variations at every azimuth and
+    * elevation on a half degree grid, from the regular grid built when
+    * the ANTEX file is read, or from the maps it is built from. */
+class AntennaPCVBench : public Benchmark
+{
+public:
+   AntennaPCVBench(const string& benchName, const string& desc,
+                   bool useGrid)
+         : Benchmark(benchName, desc, "lookups"),
+           grid(useGrid)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      AntennaStore store;
+      string antexFile(dataDir + "/test_input_antex.atx");
+      store.addANTEXfile(antexFile);
+      if (!store.getAntenna("AOAD/M_B        NONE", antenna))
+      {
+         Exception exc("No receiver antenna in " + antexFile);
+         GPSTK_THROW(exc);
+      }
+      if (!grid)
+      {
+         map<string, AntexData::antennaPCOandPCVData>::iterator it;
+         for (it = antenna.freqPCVmap.begin(); it != antenna.freqPCVmap.end();
+              it++)
+            it->second.PCVgrid.clear();
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      unsigned long count = 0;
+      for (double az = 0.25; az < 360.; az += 0.5)
+      {
+         for (double el = 0.25; el < 90.; el += 0.5)
+         {
+            sink += antenna.getPhaseCenterVariation("G01", az, el);
+            count++;
+         }
+      }
+      return count;
+   }
+
+private:
+   bool grid;
+   AntexData antenna;
+};
+
+static AntennaPCVBench antennaPCVMap("antenna_pcv_map",
+                                     "AntexData::getPhaseCenterVariation"
+                                     " interpolating the PCV maps",
+                                     false);
+static AntennaPCVBench antennaPCVGrid("antenna_pcv_grid",
+                                      "antenna_pcv_map interpolating the"
+                                      " regular PCV grid",
+                                      true);
+
+   /** IERS 2010 ECEF-to-inertial rotations every 30 seconds over a day,
+    * evaluating the full nutation and CIO series at every epoch, or
+    * interpolating them with an EarthOrientationCache. */
+class EarthOrientationBench : public Benchmark
+{
+public:
+   EarthOrientationBench(const string& benchName, const string& desc,
+                         bool useCache)
+         : Benchmark(benchName, desc, "rotations"),
+           cached(useCache)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      eo.convention = IERSConvention::IERS2010;
+      eo.xp = 0.0349282;
+      eo.yp = 0.4833163;
+      eo.UT1mUTC = -0.072073685;
+      times.clear();
+      for (int i = 0; i < 2880; i++)
+      {
+         EphTime t;
+         t.setMJD(static_cast<long double>(54195.0 + i/2880.0));
+         t.setTimeSystem(TimeSystem::UTC);
+         times.push_back(t);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+         // a new cache, so that every iteration tabulates the series
+      EarthOrientationCache cache(IERSConvention::IERS2010);
+      for (unsigned i = 0; i < times.size(); i++)
+      {
+         if (cached)
+            sink += cache.ECEFtoInertial(eo, times[i])(0,0);
+         else
+            sink += eo.ECEFtoInertial(times[i])(0,0);
+      }
+      return times.size();
+   }
+
+private:
+   bool cached;
+   EarthOrientation eo;
+   vector<EphTime> times;
+};
+
+static EarthOrientationBench eopDirect("ecef_to_inertial",
+                                       "EarthOrientation::ECEFtoInertial"
+                                       " (IERS2010) every 30s for a day",
+                                       false);
+static EarthOrientationBench eopCached("ecef_to_inertial_cached",
+                                       "ecef_to_inertial using an"
+                                       " EarthOrientationCache",
+                                       true);
+
+
+   /// Evaluate a linear combination of observables for a day of data.
+class ExpressionBench : public Benchmark
+{
+public:
+   ExpressionBench(const string& benchName, const string& desc, bool batch)
+         : Benchmark(benchName, desc, "evaluations"),
+           useBatch(batch)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+         // wide lane minus narrow lane, in meters
+      expr = Expression("(f1*wl1*L1-f2*wl2*L2)/(f1-f2)"
+                        " - (f1*P1+f2*P2)/(f1+f2)");
+      expr.setGPSConstants();
+      iL1 = expr.getVariableIndex("L1");
+      iL2 = expr.getVariableIndex("L2");
+      iP1 = expr.getVariableIndex("P1");
+      iP2 = expr.getVariableIndex("P2");
+      cols.assign(expr.getVariableNames().size(), vector<double>());
+      for (int i = 0; i < 2880; i++)
+      {
+         double rho = 2.2e7 + 300.0*i;
+         cols[iL1].push_back(rho/0.1903 + 0.01*(i%7));
+         cols[iL2].push_back(rho/0.2442 - 0.02*(i%5));
+         cols[iP1].push_back(rho + 0.3*(i%3));
+         cols[iP2].push_back(rho + 0.5);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      size_t n = cols[iL1].size();
+      if (useBatch)
+      {
+         expr.evaluate(cols, result);
+         sink += result[n-1];
+      }
+      else
+      {
+         for (size_t i = 0; i < n; i++)
+         {
+            expr.set("L1", cols[iL1][i]);
+            expr.set("L2", cols[iL2][i]);
+            expr.set("P1", cols[iP1][i]);
+            expr.set("P2", cols[iP2][i]);
+            sink += expr.evaluate();
+         }
+      }
+      return n;
+   }
+
+private:
+   bool useBatch;
+   Expression expr;
+   int iL1, iL2, iP1, iP2;
+   vector< vector<double> > cols;
+   vector<double> result;
+};
+
+static ExpressionBench exprSet("expression_evaluate",
+                               "Expression::set and evaluate of the"
+                               " Melbourne-Wubbena combination, 2880 epochs",
+                               false);
+static ExpressionBench exprBatch("expression_evaluate_batch",
+                                 "expression_evaluate using the batch"
+                                 " Expression::evaluate",
+                                 true);
+
+
+   /** Median and MAD of a series, either of the whole series or of a
+    * window sliding along it. */
+class RobustBench : public Benchmark
+{
+public:
+   RobustBench(const string& benchName, const string& desc,
+               unsigned window, bool sliding)
+         : Benchmark(benchName, desc, "data"),
+           width(window),
+           useSliding(sliding)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      data.clear();
+      unsigned long seed = 12345;
+      for (int i = 0; i < 10000; i++)
+      {
+         seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+         data.push_back(double(seed) / 0x7fffffff - 0.5 + 1.e-4*i);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      if (width == 0)
+      {
+         double M;
+         sink += Robust::MedianAbsoluteDeviation(&data[0], data.size(), M);
+         return data.size();
+      }
+
+      Robust::SlidingQuantile<double> sq;
+      for (unsigned i = width-1; i < data.size(); i++)
+      {
+         if (useSliding)
+         {
+            if (i == width-1)
+               for (unsigned j = 0; j < width-1; j++)
+                  sq.add(data[j]);
+            else
+               sq.remove(data[i-width]);
+            sq.add(data[i]);
+            sink += sq.value();
+         }
+         else
+            sink += Robust::Median(&data[i+1-width], width);
+      }
+      return data.size();
+   }
+
+private:
+   unsigned width;
+   bool useSliding;
+   vector<double> data;
+};
+
+static RobustBench robustMAD("robust_mad",
+                             "Robust::MedianAbsoluteDeviation of 10000 data",
+                             0, false);
+static RobustBench robustWindow("robust_median_window",
+                                "Robust::Median of each 100 point window"
+                                " of 10000 data",
+                                100, false);
+static RobustBench robustSliding("robust_median_sliding",
+                                 "robust_median_window using"
+                                 " Robust::SlidingQuantile",
+                                 100, true);
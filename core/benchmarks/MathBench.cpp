@@ -0,0 +1,195 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MathBench.cpp
+ * Benchmarks of the Matrix class.
+ */
+
+#include "Matrix.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /** Fill a square matrix with a well conditioned symmetric positive
+    * definite matrix, the same one every time. */
+static Matrix<double> makeSPD(unsigned n)
+{
+   Matrix<double> b(n, n);
+   unsigned long seed = 12345;
+   for (unsigned i = 0; i < n; i++)
+   {
+      for (unsigned j = 0; j < n; j++)
+      {
+         seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+         b(i,j) = double(seed) / 0x7fffffff - 0.5;
+      }
+   }
+   Matrix<double> a(transpose(b) * b);
+   for (unsigned i = 0; i < n; i++)
+      a(i,i) += n;
+   return a;
+}
+
+
+   /// Invert a symmetric positive definite matrix.
+class InverseBench : public Benchmark
+{
+public:
+   enum Method { GaussJordan, LUD, Cholesky };
+
+   InverseBench(const string& benchName, const string& desc,
+                Method how, unsigned size)
+         : Benchmark(benchName, desc, "inversions"),
+           method(how),
+           n(size)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { a = makeSPD(n); }
+
+   virtual unsigned long run()
+   {
+      switch (method)
+      {
+         case GaussJordan: ainv = inverse(a); break;
+         case LUD:         ainv = inverseLUD(a); break;
+         case Cholesky:    ainv = inverseChol(a); break;
+      }
+      sink += ainv(n-1,n-1);
+      return 1;
+   }
+
+private:
+   Method method;
+   unsigned n;
+   Matrix<double> a, ainv;
+};
+
+static InverseBench inverse8("matrix_inverse_8",
+                             "inverse() of an 8x8 matrix",
+                             InverseBench::GaussJordan, 8);
+static InverseBench inverse64("matrix_inverse_64",
+                              "inverse() of a 64x64 matrix",
+                              InverseBench::GaussJordan, 64);
+static InverseBench inverseLUD64("matrix_inverselud_64",
+                                 "inverseLUD() of a 64x64 matrix",
+                                 InverseBench::LUD, 64);
+static InverseBench inverseChol64("matrix_inversechol_64",
+                                  "inverseChol() of a 64x64 matrix",
+                                  InverseBench::Cholesky, 64);
+
+
+   /// Multiply two square matrices.
+class MultiplyBench : public Benchmark
+{
+public:
+   MultiplyBench(const string& benchName, const string& desc,
+                 unsigned size)
+         : Benchmark(benchName, desc, "products"),
+           n(size)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      a = makeSPD(n);
+      b = transpose(a) * 0.5;
+   }
+
+   virtual unsigned long run()
+   {
+      c = a * b;
+      sink += c(0,n-1);
+      return 1;
+   }
+
+private:
+   unsigned n;
+   Matrix<double> a, b, c;
+};
+
+static MultiplyBench multiply64("matrix_multiply_64",
+                                "operator*() of two 64x64 matrices", 64);
+static MultiplyBench multiply256("matrix_multiply_256",
+                                 "operator*() of two 256x256 matrices", 256);
+
+
+   /// Decompose a symmetric positive definite matrix.
+class DecomposeBench : public Benchmark
+{
+public:
+   enum Method { Chol, QR };
+
+   DecomposeBench(const string& benchName, const string& desc,
+                  Method how, unsigned size)
+         : Benchmark(benchName, desc, "decompositions"),
+           method(how),
+           n(size)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { a = makeSPD(n); }
+
+   virtual unsigned long run()
+   {
+      if (method == Chol)
+      {
+         gpstk::Cholesky<double> ch;
+         ch(a);
+         sink += ch.L(n-1,n-1);
+      }
+      else
+      {
+         Householder<double> hh;
+         hh(a);
+         sink += hh.A(n-1,n-1);
+      }
+      return 1;
+   }
+
+private:
+   Method method;
+   unsigned n;
+   Matrix<double> a;
+};
+
+static DecomposeBench cholesky256("matrix_cholesky_256",
+                                  "Cholesky of a 256x256 matrix",
+                                  DecomposeBench::Chol, 256);
+static DecomposeBench householder256("matrix_householder_256",
+                                     "Householder of a 256x256 matrix",
+                                     DecomposeBench::QR, 256);
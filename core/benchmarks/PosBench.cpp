@@ -0,0 +1,176 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file PosBench.cpp
+ * Benchmarks of pseudorange positioning.
+ */
+
+#include "GPSEphemerisStore.hpp"
+#include "PRSolution.hpp"
+#include "Rinex3NavData.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "TropModel.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /** RAIM solutions for every epoch of a RINEX 2 observation file.
+    * Optionally, a different satellite in each epoch is given a range
+    * error, and every third epoch a second one, so that RAIM must
+    * reject one or two satellites. */
+class RAIMBench : public Benchmark
+{
+public:
+   RAIMBench(const string& benchName, const string& desc,
+             bool outliers, bool incremental)
+         : Benchmark(benchName, desc, "solutions"),
+           addOutliers(outliers),
+           incrementalRAIM(incremental)
+   {}
+
+   virtual void setUp(const string& dataDir)
+   {
+      store.clear();
+      epochs.clear();
+      string navFile(dataDir + "/arlm200a.15n");
+      Rinex3NavStream navStrm(navFile.c_str());
+      if (!navStrm)
+      {
+         Exception exc("Unable to open " + navFile);
+         GPSTK_THROW(exc);
+      }
+      Rinex3NavHeader navHdr;
+      Rinex3NavData rnd;
+      navStrm >> navHdr;
+      while (navStrm >> rnd)
+      {
+         if (rnd.sat.system == SatID::systemGPS)
+            store.addEphemeris(GPSEphemeris(rnd));
+      }
+
+      string obsFile(dataDir + "/arlm200a.15o");
+      Rinex3ObsStream obsStrm(obsFile.c_str());
+      if (!obsStrm)
+      {
+         Exception exc("Unable to open " + obsFile);
+         GPSTK_THROW(exc);
+      }
+      Rinex3ObsHeader obsHdr;
+      Rinex3ObsData rod;
+      obsStrm >> obsHdr;
+      size_t c1 = obsHdr.getObsIndex("G", RinexObsID("GC1C"));
+      while (obsStrm >> rod)
+      {
+         Epoch epoch;
+         epoch.time = rod.time;
+         Rinex3ObsData::DataMap::const_iterator i;
+         for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+         {
+            if (i->first.system != SatID::systemGPS ||
+                i->second[c1].data == 0)
+               continue;
+            epoch.sats.push_back(i->first);
+            epoch.ranges.push_back(i->second[c1].data);
+         }
+         if (addOutliers && epoch.ranges.size() > 6)
+         {
+            size_t n = epochs.size();
+            epoch.ranges[n % epoch.ranges.size()] += 250. + 10.*(n % 50);
+            if (n % 3 == 0)
+               epoch.ranges[(n/3+1) % epoch.ranges.size()] += 75.;
+         }
+         epochs.push_back(epoch);
+      }
+   }
+
+   virtual unsigned long run()
+   {
+      PRSolution prs;
+         // every iteration must do the same work
+      prs.hasMemory = false;
+      prs.IncrementalRAIM = incrementalRAIM;
+      ZeroTropModel trop;
+      Matrix<double> invMC;
+      for (unsigned i = 0; i < epochs.size(); i++)
+      {
+         vector<SatID> sats(epochs[i].sats);
+         vector<SatID::SatelliteSystem> systems;
+         prs.RAIMCompute(epochs[i].time, sats, systems, epochs[i].ranges,
+                         invMC, &store, &trop);
+         if (prs.isValid())
+            sink += prs.Solution(0);
+      }
+      return epochs.size();
+   }
+
+   virtual void tearDown()
+   {
+      store.clear();
+      epochs.clear();
+   }
+
+private:
+      /// The pseudoranges from one epoch.
+   struct Epoch
+   {
+      CommonTime time;
+      vector<SatID> sats;
+      vector<double> ranges;
+   };
+
+   bool addOutliers, incrementalRAIM;
+   GPSEphemerisStore store;
+   vector<Epoch> epochs;
+};
+
+static RAIMBench raim("prsolution_raim",
+                      "PRSolution::RAIMCompute with GPS C1 pseudoranges for"
+                      " every epoch of a RINEX observation file",
+                      false, false);
+static RAIMBench raimOutlier("prsolution_raim_outlier",
+                             "prsolution_raim with range errors on one or two"
+                             " satellites per epoch",
+                             true, false);
+static RAIMBench raimOutlierInc("prsolution_raim_outlier_inc",
+                                "prsolution_raim_outlier with"
+                                " PRSolution::IncrementalRAIM",
+                                true, true);
@@ -0,0 +1,195 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file TimeBench.cpp
+ * Benchmarks of CommonTime arithmetic and time representation
+ * conversions.
+ */
+
+#include "CivilTime.hpp"
+#include "CommonTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "MJD.hpp"
+#include "NanoTime.hpp"
+#include "TimeString.hpp"
+#include "YDSTime.hpp"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /// Number of times processed by each iteration.
+static const unsigned long timeCount = 86400;
+
+   /// Add, subtract and compare CommonTime objects.
+class TimeArithBench : public Benchmark
+{
+public:
+   TimeArithBench()
+         : Benchmark("commontime_arithmetic",
+                     "CommonTime +=, - and < over a day at 1 s",
+                     "operations")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { start = GPSWeekSecond(1854, 0.0); }
+
+   virtual unsigned long run()
+   {
+      CommonTime t(start), prev(start);
+      for (unsigned long i = 0; i < timeCount; i++)
+      {
+         t += 1.0;
+         sink += t - prev;
+         if (prev < t)
+            prev = t;
+      }
+      return timeCount;
+   }
+
+private:
+   CommonTime start;
+};
+
+static TimeArithBench timeArith;
+
+
+   /// The same loop as TimeArithBench using the integer NanoTime.
+class NanoTimeArithBench : public Benchmark
+{
+public:
+   NanoTimeArithBench()
+         : Benchmark("nanotime_arithmetic",
+                     "NanoTime +=, - and < over a day at 1 s",
+                     "operations")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { start = NanoTime(GPSWeekSecond(1854, 0.0)); }
+
+   virtual unsigned long run()
+   {
+      NanoTime t(start), prev(start);
+      for (unsigned long i = 0; i < timeCount; i++)
+      {
+         t += 1.0;
+         sink += t - prev;
+         if (prev < t)
+            prev = t;
+      }
+      return timeCount;
+   }
+
+private:
+   NanoTime start;
+};
+
+static NanoTimeArithBench nanoTimeArith;
+
+
+   /// Convert CommonTime to another representation and back.
+template <class TimeRep>
+class TimeConvertBench : public Benchmark
+{
+public:
+   TimeConvertBench(const string& benchName, const string& desc)
+         : Benchmark(benchName, desc, "conversions")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { start = GPSWeekSecond(1854, 0.0); }
+
+   virtual unsigned long run()
+   {
+      CommonTime t(start);
+      for (unsigned long i = 0; i < timeCount; i += 10)
+      {
+         TimeRep rep(t);
+         sink += rep.convertToCommonTime() - start;
+         t += 10.0;
+      }
+      return timeCount / 10;
+   }
+
+private:
+   CommonTime start;
+};
+
+static TimeConvertBench<GPSWeekSecond> convertGPSWS(
+   "time_convert_gpsweeksecond",
+   "CommonTime to GPSWeekSecond and back every 10 s over a day");
+static TimeConvertBench<CivilTime> convertCivil(
+   "time_convert_civiltime",
+   "CommonTime to CivilTime and back every 10 s over a day");
+static TimeConvertBench<YDSTime> convertYDS(
+   "time_convert_ydstime",
+   "CommonTime to YDSTime and back every 10 s over a day");
+static TimeConvertBench<MJD> convertMJD(
+   "time_convert_mjd",
+   "CommonTime to MJD and back every 10 s over a day");
+
+
+   /// Format times as strings.
+class TimePrintBench : public Benchmark
+{
+public:
+   TimePrintBench()
+         : Benchmark("time_print",
+                     "printTime() in civil and GPS week formats every"
+                     " 60 s over a day", "conversions")
+   {}
+
+   virtual void setUp(const string& dataDir)
+   { start = GPSWeekSecond(1854, 0.0); }
+
+   virtual unsigned long run()
+   {
+      CommonTime t(start);
+      for (unsigned long i = 0; i < timeCount; i += 60)
+      {
+         sink += printTime(t, "%04Y/%02m/%02d %02H:%02M:%06.3f").size();
+         sink += printTime(t, "%4F %10.3g").size();
+         t += 60.0;
+      }
+      return 2 * timeCount / 60;
+   }
+
+private:
+   CommonTime start;
+};
+
+static TimePrintBench timePrint;
@@ -0,0 +1,213 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file gpstk_bench.cpp
+ * Run the GPSTk benchmarks and write the timing results as JSON.
+ */
+
+#include <ctime>
+#include <fstream>
+
+#include "BasicFramework.hpp"
+#include "StringUtils.hpp"
+#include "build_config.h"
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class GPSTkBench : public BasicFramework
+{
+public:
+   GPSTkBench(char* arg0);
+
+protected:
+   virtual void process();
+
+private:
+   CommandOptionWithAnyArg dataDirOption;
+   CommandOptionWithAnyArg outputOption;
+   CommandOptionWithAnyArg filterOption;
+   CommandOptionWithDecimalArg minTimeOption;
+   CommandOptionWithNumberArg repeatsOption;
+   CommandOptionNoArg listOption;
+
+      /// Return true if the benchmark is selected by the -f options.
+   bool selected(const Benchmark& bench) const;
+};
+
+
+GPSTkBench ::
+GPSTkBench(char* arg0)
+      : BasicFramework(arg0, "Time the GPSTk processing hot paths (file"
+                       " parsing, ephemeris evaluation, time handling,"
+                       " positioning and linear algebra) and write the"
+                       " results as JSON."),
+        dataDirOption('D', "data", "Directory containing the input data"
+                      " (default " + getPathData() + ")."),
+        outputOption('o', "output", "Write the JSON results to this file"
+                     " instead of standard output."),
+        filterOption('f', "filter", "Only run the benchmarks whose name"
+                     " contains this string (may be repeated)."),
+        minTimeOption('t', "min-time", "Minimum seconds per sample"
+                      " (default 0.25)."),
+        repeatsOption('r', "repeats", "Number of samples per benchmark"
+                      " (default 5)."),
+        listOption('l', "list", "List the benchmarks and exit.")
+{
+   dataDirOption.setMaxCount(1);
+   outputOption.setMaxCount(1);
+   minTimeOption.setMaxCount(1);
+   repeatsOption.setMaxCount(1);
+}
+
+
+bool GPSTkBench ::
+selected(const Benchmark& bench) const
+{
+   vector<string> filters = filterOption.getValue();
+   if (filters.empty())
+      return true;
+   for (unsigned i = 0; i < filters.size(); i++)
+   {
+      if (bench.name.find(filters[i]) != string::npos)
+         return true;
+   }
+   return false;
+}
+
+
+void GPSTkBench ::
+process()
+{
+   vector<Benchmark*>& benchmarks = Benchmark::registry();
+   if (listOption)
+   {
+      for (unsigned i = 0; i < benchmarks.size(); i++)
+      {
+         if (selected(*benchmarks[i]))
+         {
+            cout << benchmarks[i]->name << ": "
+                 << benchmarks[i]->description << endl;
+         }
+      }
+      return;
+   }
+
+   string dataDir = getPathData();
+   if (dataDirOption.getCount())
+      dataDir = dataDirOption.getValue()[0];
+   double minTime = 0.25;
+   if (minTimeOption.getCount())
+      minTime = StringUtils::asDouble(minTimeOption.getValue()[0]);
+   unsigned repeats = 5;
+   if (repeatsOption.getCount())
+      repeats = StringUtils::asUnsigned(repeatsOption.getValue()[0]);
+
+   ofstream outFile;
+   if (outputOption.getCount())
+   {
+      outFile.open(outputOption.getValue()[0].c_str());
+      if (!outFile)
+      {
+         cerr << "Unable to open " << outputOption.getValue()[0] << endl;
+         exitCode = BasicFramework::EXIST_ERROR;
+         return;
+      }
+   }
+   ostream& out(outFile.is_open() ? outFile : cout);
+
+   char timeBuf[32];
+   time_t now = time(NULL);
+   strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+   out << "{" << endl
+       << "  \"gpstk_version\": " << jsonString(getVersion()) << "," << endl
+#ifdef __VERSION__
+       << "  \"compiler\": " << jsonString(__VERSION__) << "," << endl
+#endif
+       << "  \"date\": " << jsonString(timeBuf) << "," << endl
+       << "  \"min_time\": " << minTime << "," << endl
+       << "  \"repeats\": " << repeats << "," << endl
+       << "  \"benchmarks\": [" << endl;
+   bool first = true;
+   for (unsigned i = 0; i < benchmarks.size(); i++)
+   {
+      if (!selected(*benchmarks[i]))
+         continue;
+      if (verboseLevel)
+         cerr << "Running " << benchmarks[i]->name << endl;
+      BenchResult result = runBenchmark(*benchmarks[i], dataDir, minTime,
+                                        repeats);
+      if (!result.error.empty())
+      {
+         cerr << benchmarks[i]->name << " failed: " << result.error << endl;
+         exitCode = BasicFramework::EXCEPTION_ERROR;
+      }
+      if (!first)
+         out << "," << endl;
+      result.writeJSON(out, "    ");
+      first = false;
+   }
+   out << endl << "  ]" << endl << "}" << endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+   try
+   {
+      GPSTkBench app(argv[0]);
+      if (!app.initialize(argc, argv))
+         return app.exitCode;
+      app.run();
+      return app.exitCode;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+   }
+   catch(exception& e)
+   {
+      cerr << e.what() << endl;
+   }
+   catch(...)
+   {
+      cerr << "unknown error" << endl;
+   }
+   return gpstk::BasicFramework::EXCEPTION_ERROR;
+}
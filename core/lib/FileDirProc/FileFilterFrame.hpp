@@ -42,10 +42,15 @@
 #ifndef GPSTK_FILEFILTERFRAME_HPP
 #define GPSTK_FILEFILTERFRAME_HPP
 
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
 #include "FileSpec.hpp"
 #include "FileFilter.hpp"
 #include "FileHunter.hpp"
 #include "FileUtils.hpp"
+#include "StringUtils.hpp"
 
 namespace gpstk
 {
@@ -65,6 +70,12 @@ namespace gpstk
        * getData() and run whatever other post processing tools you would like
        * to.  
        *
+       * Reading everything into memory needs memory in proportion to
+       * the amount of data.  When the input files are each already in
+       * order (as almost all data files are), mergeFiles() instead
+       * merges them into the output file as they are read, holding
+       * only one record per input file.
+       *
        * See the examples in FileFilterFrameTest.cpp for a demonstration.
        */
    template <class FileStream, class FileData>
@@ -166,7 +177,195 @@ namespace gpstk
       bool writeFile(FileStream& stream) const
          throw(gpstk::Exception);
 
+         /// Default number of out of order records mergeFiles() will
+         /// hold in memory.
+      static const unsigned long defaultMergeRecords = 100000;
+
+         /**
+          * Merges the data in the files in fileList into outputFile,
+          * truncating the output file if it already exists.  Unlike
+          * sort(), the data are not read into the filter; a record is
+          * read from each file and the least of them is written, then
+          * replaced with the next record from the same file, and so
+          * on.  Records for which eq is true with the last one
+          * written are skipped, as unique() would, and the number
+          * skipped is available from getFiltered().  Files are read
+          * in the order given, and records that compare equal are
+          * taken in the order of the files, and of the records within
+          * each file, which gives the same result as merge(), sort()
+          * and unique().
+          *
+          * If a file is not in order, the merge is started again.
+          * This time every record is written, to a temporary file next
+          * to outputFile, except those that belong before the last one
+          * written, which are set aside.  Up to maxRecords of these
+          * are kept in memory, then sorted and written to another
+          * temporary file.  Each temporary file is accompanied by a
+          * small file of the place of each record in the input, by
+          * which records that compare equal are ordered.  Those files
+          * are then merged, dropping duplicates, into outputFile, so
+          * the result is still the same as that of merge(), sort() and
+          * unique(), at the cost of reading the data twice and writing
+          * it a second time.
+          *
+          * @param[in] fileList the names of the files to merge.
+          *   These are not found with FileHunter and the filter's
+          *   data, start and end times are not used.
+          * @param[in] outputFile the file to write.
+          * @param[in] comp the order of the data, which MUST be a
+          *   strict weak ordering.
+          * @param[in] eq test for equality of records.
+          * @param[in] maxRecords the number of out of order records
+          *   to hold in memory.
+          * @return the number of records written.
+          * @warning This will not write out headers for files that
+          *   need them.  Use FileFilterFrameWithHeader for those file
+          *   types.
+          */
+      template <class Compare, class BinaryPredicate>
+      unsigned long mergeFiles(const std::vector<std::string>& fileList,
+                               const std::string& outputFile,
+                               Compare comp,
+                               BinaryPredicate eq,
+                               unsigned long maxRecords = defaultMergeRecords)
+         throw(gpstk::Exception)
+      {
+         return streamMerge(fileList, outputFile, comp, eq, NoHeader(),
+                            maxRecords);
+      }
+
    protected:
+         /// Writes the header, if any, of each file written by
+         /// streamMerge().  This one writes nothing.
+      struct NoHeader
+      {
+         void operator()(FileStream& s) const
+         {}
+         void operator()(FileStream& s, const FileData& first) const
+         {}
+      };
+
+         /**
+          * The merge behind mergeFiles().  hw(s) is called to write
+          * the header of each temporary file, and hw(s, first) that of
+          * the output file, given the first record that will be
+          * written to it (or hw(s) if there is none).
+          */
+      template <class Compare, class BinaryPredicate, class HeaderWriter>
+      unsigned long streamMerge(const std::vector<std::string>& fileList,
+                                const std::string& outputFile,
+                                Compare comp,
+                                BinaryPredicate eq,
+                                const HeaderWriter& hw,
+                                unsigned long maxRecords)
+         throw(gpstk::Exception);
+
+         /**
+          * A record read by streamMerge(), with its place in the input:
+          * the index of the file it came from and its number in that
+          * file.
+          */
+      struct MergeRecord
+      {
+         FileData data;
+         std::size_t file;
+         unsigned long seq;
+      };
+
+         /**
+          * RecordOrder orders MergeRecords by comp, then by their place
+          * in the input, so that records that compare equal are kept
+          * in the order that a stable sort of all the input would give.
+          */
+      template <class Compare>
+      class RecordOrder
+      {
+      public:
+         RecordOrder(const Compare& c)
+               : comp(c)
+         {}
+
+         bool operator()(const MergeRecord& l, const MergeRecord& r) const
+         {
+            if (comp(l.data, r.data))
+               return true;
+            if (comp(r.data, l.data))
+               return false;
+            if (l.file != r.file)
+               return l.file < r.file;
+            return l.seq < r.seq;
+         }
+      private:
+         Compare comp;
+      };
+
+         /**
+          * MergeOrder orders the indices of the files in the heap used
+          * by streamMerge() by their pending records.  The standard
+          * heap functions keep the greatest value first, so this is a
+          * "greater than".
+          */
+      template <class Compare>
+      class MergeOrder
+      {
+      public:
+         MergeOrder(const RecordOrder<Compare>& o,
+                    const std::vector<MergeRecord>& p)
+               : order(o), pending(p)
+         {}
+
+         bool operator()(std::size_t l, std::size_t r) const
+         { return order(pending[r], pending[l]); }
+      private:
+         RecordOrder<Compare> order;
+         const std::vector<MergeRecord>& pending;
+      };
+
+         /**
+          * Reads the next record from s into rec.  If keys is not
+          * null, the place of the record in the input is read from it,
+          * otherwise it is the given file and the next seq.
+          * @return false at the end of s.
+          */
+      static bool readRecord(FileStream& s,
+                             std::ifstream *keys,
+                             std::size_t file,
+                             unsigned long& seq,
+                             MergeRecord& rec)
+         throw(gpstk::Exception);
+
+         /// Writes the place of rec in the input to keys.
+      static void writeKey(std::ofstream& keys, const MergeRecord& rec)
+      {
+         keys.write(reinterpret_cast<const char*>(&rec.file),
+                    sizeof(rec.file));
+         keys.write(reinterpret_cast<const char*>(&rec.seq),
+                    sizeof(rec.seq));
+      }
+
+         /// Sorts data and writes it to the file fn, with the place of
+         /// each record in the input to fn.key.  Used by streamMerge()
+         /// to set aside out of order records.
+      template <class Compare, class HeaderWriter>
+      void writeRun(std::vector<MergeRecord>& data,
+                    const std::string& fn,
+                    const RecordOrder<Compare>& order,
+                    const HeaderWriter& hw)
+         throw(gpstk::Exception);
+
+         /// The input streams opened by streamMerge(), closed when it
+         /// is done.
+      template <class Stream>
+      class StreamList : public std::vector<Stream*>
+      {
+      public:
+         ~StreamList()
+         {
+            for (std::size_t i = 0; i < this->size(); i++)
+               delete (*this)[i];
+         }
+      };
+
          ///  Run init() to load the data into the filter.
       void init(const std::vector<FileHunter::FilterPair>& filter= 
                 std::vector<FileHunter::FilterPair>()) 
@@ -359,6 +558,242 @@ namespace gpstk
       return true;
    }
 
+   template <class FileStream, class FileData>
+   template <class Compare, class BinaryPredicate, class HeaderWriter>
+   unsigned long FileFilterFrame<FileStream,FileData> ::
+   streamMerge(const std::vector<std::string>& fileList,
+               const std::string& outputFile,
+               Compare comp,
+               BinaryPredicate eq,
+               const HeaderWriter& hw,
+               unsigned long maxRecords)
+      throw(gpstk::Exception)
+   {
+      if (maxRecords == 0)
+         maxRecords = 1;
+
+         // make the directory (if needed)
+      std::string::size_type pos = outputFile.rfind('/');
+      if (pos != std::string::npos)
+         gpstk::FileUtils::makeDir(outputFile.substr(0,pos).c_str(), 0755);
+
+      RecordOrder<Compare> order(comp);
+      unsigned long count = 0;
+      std::vector<std::string> inputs(fileList), tempFiles;
+
+         // pass 0 merges the files into outputFile, which is all that
+         // is needed if every record is in order.  Otherwise, pass 1
+         // merges them into a temporary file, keeping duplicates and
+         // setting aside records that are out of order, and pass 2
+         // merges those files into outputFile.
+      int pass = 0;
+
+      try
+      {
+         while (true)
+         {
+            const bool toTemp = (pass == 1);
+            const std::string outName(toTemp ? outputFile + ".merge0"
+                                      : outputFile);
+            std::vector<MergeRecord> late, pending(inputs.size());
+            std::vector<std::string> runs;
+            std::vector<std::size_t> heap;
+            MergeOrder<Compare> heapOrder(order, pending);
+            bool restart = false;
+            this->filtered = 0;
+            count = 0;
+
+            {
+                  // prime the heap with the first record of each file
+               StreamList<FileStream> streams;
+               StreamList<std::ifstream> keys;
+               std::vector<unsigned long> seqs(inputs.size(), 0);
+               for (std::size_t i = 0; i < inputs.size(); i++)
+               {
+                  streams.push_back(new FileStream(inputs[i].c_str()));
+                  keys.push_back(pass < 2 ? NULL :
+                                 new std::ifstream(
+                                    (inputs[i] + ".key").c_str(),
+                                    std::ios::in|std::ios::binary));
+                  if (streams[i]->good() &&
+                      readRecord(*streams[i], keys[i], i, seqs[i],
+                                 pending[i]))
+                     heap.push_back(i);
+               }
+               std::make_heap(heap.begin(), heap.end(), heapOrder);
+
+               FileStream out(outName.c_str(),
+                              std::ios::out|std::ios::trunc);
+               out.exceptions(std::ios::failbit);
+               std::ofstream outKeys;
+               if (toTemp)
+               {
+                  tempFiles.push_back(outName);
+                  tempFiles.push_back(outName + ".key");
+                  hw(out);
+                  outKeys.open((outName + ".key").c_str(),
+                               std::ios::out|std::ios::trunc|std::ios::binary);
+                  outKeys.exceptions(std::ios::failbit);
+               }
+
+                  // last is the last record taken from the heap, kept
+                  // the last one written to outputFile
+               MergeRecord last, kept;
+               while (!heap.empty() && !restart)
+               {
+                  std::pop_heap(heap.begin(), heap.end(), heapOrder);
+                  std::size_t i = heap.back();
+                  heap.pop_back();
+
+                  if (toTemp)
+                  {
+                     out << pending[i].data;
+                     writeKey(outKeys, pending[i]);
+                  }
+                  else if (count > 0 && eq(kept.data, pending[i].data))
+                     this->filtered++;
+                  else
+                  {
+                     if (count == 0)
+                        hw(out, pending[i].data);
+                     out << pending[i].data;
+                     kept = pending[i];
+                     count++;
+                  }
+                  last = pending[i];
+
+                     // Replace it with the next record from the same
+                     // file, setting aside those that belong before
+                     // what has already been written.
+                  while (readRecord(*streams[i], keys[i], i, seqs[i],
+                                    pending[i]))
+                  {
+                     if (!order(pending[i], last))
+                     {
+                        heap.push_back(i);
+                        std::push_heap(heap.begin(), heap.end(), heapOrder);
+                        break;
+                     }
+                     if (pass == 0)
+                     {
+                        restart = true;
+                        break;
+                     }
+                     if (pass == 2)
+                     {
+                        gpstk::InvalidRequest exc(
+                           "Merge order is not a strict weak ordering");
+                        GPSTK_THROW(exc);
+                     }
+                     late.push_back(pending[i]);
+                     if (late.size() >= maxRecords)
+                     {
+                        runs.push_back(outputFile + ".merge" +
+                                       StringUtils::asString(runs.size()+1));
+                        tempFiles.push_back(runs.back());
+                        tempFiles.push_back(runs.back() + ".key");
+                        writeRun(late, runs.back(), order, hw);
+                     }
+                  }
+               }
+
+               if (count == 0 && !toTemp && !restart)
+                  hw(out);
+            }
+
+            if (pass == 0 && !restart)
+               break;
+            if (pass == 2)
+               break;
+            if (pass == 0)
+            {
+               pass = 1;
+               continue;
+            }
+
+               // Merge what was written with the records set aside.
+            if (!late.empty())
+            {
+               runs.push_back(outputFile + ".merge" +
+                              StringUtils::asString(runs.size()+1));
+               tempFiles.push_back(runs.back());
+               tempFiles.push_back(runs.back() + ".key");
+               writeRun(late, runs.back(), order, hw);
+            }
+            inputs.clear();
+            inputs.push_back(outName);
+            inputs.insert(inputs.end(), runs.begin(), runs.end());
+            pass = 2;
+         }
+      }
+      catch (gpstk::Exception& e)
+      {
+         for (std::size_t i = 0; i < tempFiles.size(); i++)
+            std::remove(tempFiles[i].c_str());
+         GPSTK_RETHROW(e);
+      }
+
+      for (std::size_t i = 0; i < tempFiles.size(); i++)
+         std::remove(tempFiles[i].c_str());
+
+      return count;
+   }
+
+   template <class FileStream, class FileData>
+   bool FileFilterFrame<FileStream,FileData> ::
+   readRecord(FileStream& s,
+              std::ifstream *keys,
+              std::size_t file,
+              unsigned long& seq,
+              MergeRecord& rec)
+      throw(gpstk::Exception)
+   {
+      if (!(s >> rec.data))
+         return false;
+      if (keys == NULL)
+      {
+         rec.file = file;
+         rec.seq = seq++;
+         return true;
+      }
+      keys->read(reinterpret_cast<char*>(&rec.file), sizeof(rec.file));
+      keys->read(reinterpret_cast<char*>(&rec.seq), sizeof(rec.seq));
+      if (!keys->good())
+      {
+         gpstk::FileMissingException exc(
+            "Unable to read the merge order of a temporary file");
+         GPSTK_THROW(exc);
+      }
+      return true;
+   }
+
+   template <class FileStream, class FileData>
+   template <class Compare, class HeaderWriter>
+   void FileFilterFrame<FileStream,FileData> ::
+   writeRun(std::vector<MergeRecord>& data,
+            const std::string& fn,
+            const RecordOrder<Compare>& order,
+            const HeaderWriter& hw)
+      throw(gpstk::Exception)
+   {
+      std::sort(data.begin(), data.end(), order);
+
+      FileStream stream(fn.c_str(), std::ios::out|std::ios::trunc);
+      stream.exceptions(std::ios::failbit);
+      hw(stream);
+      std::ofstream keys((fn + ".key").c_str(),
+                         std::ios::out|std::ios::trunc|std::ios::binary);
+      keys.exceptions(std::ios::failbit);
+
+      typename std::vector<MergeRecord>::const_iterator index;
+      for (index = data.begin(); index != data.end(); index++)
+      {
+         stream << index->data;
+         writeKey(keys, *index);
+      }
+      data.clear();
+   }
+
 }  // namespace gpstk
 
 #endif // GPSTK_FILEFILTERFRAME_HPP
@@ -67,6 +67,11 @@ namespace gpstk
        * init() function to read the headers from those files. This
        * is a little inefficient, but the goal of these classes was never
        * efficiency.
+       *
+       * To merge files too large to hold in memory, construct the
+       * filter with no files, read just the headers with
+       * newHeaderSource(), combine them with touchHeader(), then write
+       * the merged data with mergeFiles().
        */
    template <class FileStream, class FileData, class FileHeader>
    class FileFilterFrameWithHeader :
@@ -179,8 +184,67 @@ namespace gpstk
          return *this;
       }
 
+         /// Reads only the headers of the files, e.g. to combine
+         /// them before calling mergeFiles().
+      FileFilterFrameWithHeader&
+      newHeaderSource(const std::vector<std::string>& fileList)
+         throw(gpstk::Exception)
+      {
+         typename std::vector<std::string>::const_iterator itr;
+         for (itr = fileList.begin(); itr != fileList.end(); itr++)
+         {
+            this->fs.newSpec(*itr);
+            init();
+         }
+         return *this;
+      }
+
       virtual ~FileFilterFrameWithHeader() {}
 
+         /**
+          * Merges the data in the files in fileList into outputFile
+          * with the header fh, without reading all the data into
+          * memory.  See FileFilterFrame::mergeFiles().
+          * @return the number of records written.
+          */
+      template <class Compare, class BinaryPredicate>
+      unsigned long mergeFiles(const std::vector<std::string>& fileList,
+                               const std::string& outputFile,
+                               const FileHeader& fh,
+                               Compare comp,
+                               BinaryPredicate eq,
+                               unsigned long maxRecords =
+                               FileFilterFrame<FileStream,
+                               FileData>::defaultMergeRecords)
+         throw(gpstk::Exception)
+      {
+         return this->streamMerge(fileList, outputFile, comp, eq,
+                                  HeaderWriter<NoUpdate>(fh, NoUpdate()),
+                                  maxRecords);
+      }
+
+         /**
+          * As mergeFiles() above, but the header of outputFile is a
+          * copy of fh updated by hu(header, first), where first is the
+          * first record written, e.g. to set the time of the first
+          * observation.
+          * @return the number of records written.
+          */
+      template <class Compare, class BinaryPredicate, class HeaderUpdate>
+      unsigned long mergeFiles(const std::vector<std::string>& fileList,
+                               const std::string& outputFile,
+                               const FileHeader& fh,
+                               Compare comp,
+                               BinaryPredicate eq,
+                               unsigned long maxRecords,
+                               HeaderUpdate hu)
+         throw(gpstk::Exception)
+      {
+         return this->streamMerge(fileList, outputFile, comp, eq,
+                                  HeaderWriter<HeaderUpdate>(fh, hu),
+                                  maxRecords);
+      }
+
          /**
           * Writes the data to the file outputFile with the given header.
           * This will overwrite any existing file with the same name.
@@ -285,6 +349,36 @@ namespace gpstk
          throw(gpstk::InvalidRequest);
 
    protected:
+         /// The header update of the mergeFiles() without one.
+      struct NoUpdate
+      {
+         void operator()(FileHeader& h, const FileData& first) const
+         {}
+      };
+
+         /// Writes the header of each file written by mergeFiles().
+      template <class HeaderUpdate>
+      class HeaderWriter
+      {
+      public:
+         HeaderWriter(const FileHeader& h, const HeaderUpdate& hu)
+               : header(h), update(hu)
+         {}
+
+         void operator()(FileStream& s) const
+         { s << header; }
+
+         void operator()(FileStream& s, const FileData& first) const
+         {
+            FileHeader h(header);
+            update(h, first);
+            s << h;
+         }
+      private:
+         const FileHeader& header;
+         HeaderUpdate update;
+      };
+
          ///  Run init() to load the data into the filter.  
       void init(const std::vector<FileHunter::FilterPair>& filter= 
                 std::vector<FileHunter::FilterPair>()) 
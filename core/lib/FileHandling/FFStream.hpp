@@ -110,6 +110,14 @@ namespace gpstk
        * RinexObsData::reallyGetRecord()
        * for an example of this.
        *
+       * Likewise, any state a format needs to carry from one record to
+       * the next belongs in the stream, never in static or global
+       * variables.  An FFStream object is not safe for use by more than
+       * one thread at a time, but when a format follows this rule
+       * (as gpstk::Rinex3ObsStream does), distinct streams may be read
+       * concurrently, e.g. one file per thread of a thread pool,
+       * without locking.
+       *
        * \sa FFData for more information
        * \sa RinexObsData::reallyGetRecord() and
        *     RinexObsHeader::reallyGetRecord() for more information for files
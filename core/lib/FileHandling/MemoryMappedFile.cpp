@@ -0,0 +1,152 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MemoryMappedFile.cpp
+ * Read-only view of the contents of a file mapped into memory.
+ */
+
+#include "MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace gpstk
+{
+   MemoryMappedFile ::
+   MemoryMappedFile()
+         : buffer(0), length(0), mapped(false)
+#ifdef _WIN32
+         , mapHandle(0)
+#endif
+   {
+   }
+
+
+   MemoryMappedFile ::
+   ~MemoryMappedFile()
+   {
+      close();
+   }
+
+
+   bool MemoryMappedFile ::
+   open(const std::string& fn)
+   {
+      close();
+#ifdef _WIN32
+      HANDLE fh = CreateFileA(fn.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      if (fh == INVALID_HANDLE_VALUE)
+         return false;
+      LARGE_INTEGER fsize;
+      if (!GetFileSizeEx(fh, &fsize))
+      {
+         CloseHandle(fh);
+         return false;
+      }
+      length = static_cast<std::string::size_type>(fsize.QuadPart);
+      if (length > 0)
+      {
+         HANDLE mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+         if (mh != NULL)
+         {
+            buffer = static_cast<const char*>(
+               MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0));
+            if (buffer == NULL)
+               CloseHandle(mh);
+            else
+               mapHandle = mh;
+         }
+      }
+      CloseHandle(fh);
+      mapped = ((length == 0) || (buffer != NULL));
+#else
+      int fd = ::open(fn.c_str(), O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat st;
+      if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+      {
+         ::close(fd);
+         return false;
+      }
+      length = static_cast<std::string::size_type>(st.st_size);
+      if (length > 0)
+      {
+         void *addr = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (addr != MAP_FAILED)
+         {
+               // records are read front to back
+            madvise(addr, length, MADV_SEQUENTIAL);
+            buffer = static_cast<const char*>(addr);
+         }
+      }
+         // the mapping remains valid after the descriptor is closed
+      ::close(fd);
+      mapped = ((length == 0) || (buffer != 0));
+#endif
+      if (!mapped)
+         length = 0;
+      return mapped;
+   }
+
+
+   void MemoryMappedFile ::
+   close()
+   {
+      if (buffer != 0)
+      {
+#ifdef _WIN32
+         UnmapViewOfFile(buffer);
+         CloseHandle(mapHandle);
+         mapHandle = 0;
+#else
+         munmap(const_cast<char*>(buffer), length);
+#endif
+      }
+      buffer = 0;
+      length = 0;
+      mapped = false;
+   }
+
+}  // End of namespace gpstk
@@ -0,0 +1,110 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MemoryMappedFile.hpp
+ * Read-only view of the contents of a file mapped into memory.
+ */
+
+#ifndef GPSTK_MEMORYMAPPEDFILE_HPP
+#define GPSTK_MEMORYMAPPEDFILE_HPP
+
+#include <string>
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Map the contents of a file into memory for read-only access.
+       * This is used by the text stream readers that parse records
+       * directly out of the file contents instead of copying lines
+       * through the std::fstream buffer.
+       *
+       * On POSIX systems the file is mapped with mmap().  On Windows
+       * a file mapping object is used.  Objects of this class are not
+       * copyable; the mapping is released on close() or destruction.
+       */
+   class MemoryMappedFile
+   {
+   public:
+         /// Create an object with nothing mapped.
+      MemoryMappedFile();
+
+         /// Unmap the file, if mapped.
+      ~MemoryMappedFile();
+
+         /** Map the file \a fn into memory, releasing any previously
+          * mapped file.
+          * @param[in] fn the name of the file to map.
+          * @return true if the file was successfully mapped.  Empty
+          *   files are considered to be successfully mapped with a
+          *   size of 0. */
+      bool open(const std::string& fn);
+
+         /// Release the mapped file.
+      void close();
+
+         /// Return true if a file is currently mapped.
+      bool isOpen() const
+      { return mapped; }
+
+         /// Return a pointer to the first byte of the mapped file.
+      const char* data() const
+      { return buffer; }
+
+         /// Return the number of bytes in the mapped file.
+      std::string::size_type size() const
+      { return length; }
+
+   private:
+         // Copying would result in a double unmap.
+      MemoryMappedFile(const MemoryMappedFile&);
+      MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+      const char* buffer;             ///< start of the mapped file
+      std::string::size_type length;  ///< number of bytes mapped
+      bool mapped;                    ///< true if open() succeeded
+#ifdef _WIN32
+      void* mapHandle;                ///< file mapping object handle
+#endif
+   }; // End of class 'MemoryMappedFile'
+
+      //@}
+
+}  // End of namespace gpstk
+#endif   // GPSTK_MEMORYMAPPEDFILE_HPP
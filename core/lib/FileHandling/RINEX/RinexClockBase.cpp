@@ -97,12 +97,12 @@ namespace gpstk
       int year, month, day, hour, min;
       double sec;
       
-      year = StringUtils::asInt( line.substr(0, 4) );
-      month = StringUtils::asInt( line.substr(4, 3) );
-      day = StringUtils::asInt( line.substr(7, 3) );
-      hour = StringUtils::asInt( line.substr(10, 3) );
-      min = StringUtils::asInt( line.substr(13, 3) );
-      sec = StringUtils::asDouble( line.substr(16, 10) );
+      year = StringUtils::asInt( line, 0, 4 );
+      month = StringUtils::asInt( line, 4, 3 );
+      day = StringUtils::asInt( line, 7, 3 );
+      hour = StringUtils::asInt( line, 10, 3 );
+      min = StringUtils::asInt( line, 13, 3 );
+      sec = StringUtils::asDouble( line, 16, 10 );
       
       return CivilTime(year, month, day, hour, min, sec);
 
@@ -185,7 +185,7 @@ namespace gpstk
 
       epochTime = parseTime(line.substr(8,26));
 
-      dvCount = asInt(line.substr(34,3));
+      dvCount = asInt(line, 34, 3);
       if ( dvCount < 1 || dvCount > 6 )
       {
             // invalid dvCount - throw
@@ -193,11 +193,11 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      clockData[0] = asDouble(line.substr(40,19));
+      clockData[0] = asDouble(line, 40, 19);
       
       if (dvCount >= 2)
       {
-         clockData[1] = asDouble(line.substr(60,19));
+         clockData[1] = asDouble(line, 60, 19);
       }
 
       if (dvCount > 2)
@@ -215,7 +215,7 @@ namespace gpstk
          
          for (int i = 2; i < dvCount; i++)
          {
-            clockData[i] = asDouble(line.substr( (i-2)*20, 19 ));
+            clockData[i] = asDouble(line, (i-2)*20, 19);
          }
       }
 
@@ -557,7 +557,7 @@ namespace gpstk
          // RINEX VERSION / TYPE
       if (label == versionString)
       {
-         version = asDouble(line.substr(0,9));
+         version = asDouble(line, 0, 9);
 
          fileType = strip(line.substr(20, 40));
          if ( fileType[0] != 'C' && fileType[0] != 'c' )
@@ -592,7 +592,7 @@ namespace gpstk
          // LEAP SECONDS
       else if (label == leapSecondsString)
       {
-         leapSeconds = asInt(line.substr(0,6));
+         leapSeconds = asInt(line, 0, 6);
 
          valid |= leapSecondsValid;
 
@@ -600,7 +600,7 @@ namespace gpstk
          // # / TYPES OF DATA
       else if (label == dataTypesString)
       {
-         numType = asInt(line.substr(0,6));
+         numType = asInt(line, 0, 6);
          if ( numType < 0 || numType > 5 )
          {
                // invalid number of data types - throw
@@ -657,11 +657,11 @@ namespace gpstk
       else if (label == numRefClkString)
       {
          RefClkRecord record;
-         record.numClkRef = asInt( line.substr(0,6) );
-         if( asInt(line.substr(7,4)) )
+         record.numClkRef = asInt( line, 0, 6 );
+         if( asInt(line, 7, 4) )
          {
             record.startEpoch = parseTime(line.substr(7,26));
-            if ( asInt(line.substr(34,26)) )
+            if ( asInt(line, 34, 26) )
             {
                record.stopEpoch = parseTime(line.substr(34,26));
                if ( record.startEpoch > record.stopEpoch )
@@ -683,7 +683,7 @@ namespace gpstk
          else
          {
             record.startEpoch = CommonTime::BEGINNING_OF_TIME;
-            if ( asInt(line.substr(34,26)) )
+            if ( asInt(line, 34, 26) )
             {  // stop epoch w/o start epoch
                FFStreamError e("Invalid Start/Stop Epoch start: " +
                                line.substr(7,26) + ", stop: " +
@@ -725,14 +725,14 @@ namespace gpstk
          RefClk refclk;
          refclk.name = line.substr(0,4);
          refclk.number = strip(line.substr(5,20));
-         refclk.clkConstraint = asDouble(line.substr(40,19));
+         refclk.clkConstraint = asDouble(line, 40, 19);
          itr->clocks.push_back(refclk);
 
       }
          /// # OF SOLN STA / TRF
       else if (label == numStationsString)
       {
-         numSta = asInt( line.substr(0,6) );
+         numSta = asInt( line, 0, 6 );
          trf = strip(line.substr(10,50));
 
          valid |= numStationsValid;
@@ -757,7 +757,7 @@ namespace gpstk
          // # OF SOLN SATS
       else if (label == numSatsString)
       {
-         numSats = asInt(line.substr(0,6));
+         numSats = asInt(line, 0, 6);
 
          valid |= numSatsValid;
 
@@ -772,12 +772,12 @@ namespace gpstk
          {
             if ( word[0] == 'G' || word[0] == 'g' )
             {
-               prnList.push_back(SatID(asInt(word.substr(1,2)),
+               prnList.push_back(SatID(asInt(word, 1, 2),
                                        SatID::systemGPS));
             }
             else if ( word[0] == 'R' || word[0] == 'r' )
             {
-               prnList.push_back(SatID(asInt(word.substr(1,2)),
+               prnList.push_back(SatID(asInt(word, 1, 2),
                                        SatID::systemGlonass));
             }
             else
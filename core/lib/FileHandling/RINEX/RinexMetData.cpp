@@ -166,7 +166,7 @@ namespace gpstk
               i++)
          {
             int currPos = 7*i + yrLen;
-            data[hdr.obsTypeList[i]] = asDouble(line.substr(currPos,7));
+            data[hdr.obsTypeList[i]] = asDouble(line, currPos, 7);
          }
       }
       catch (std::exception &e)
@@ -189,7 +189,7 @@ namespace gpstk
               i++)
          {
             int currPos = 7*((i - maxObsPerLine) % maxObsPerContinuationLine) + 4;
-            data[hdr.obsTypeList[i]] = asDouble(line.substr(currPos,7));
+            data[hdr.obsTypeList[i]] = asDouble(line, currPos, 7);
          }
       }
       catch (std::exception &e)
@@ -231,12 +231,12 @@ namespace gpstk
          int year, month, day, hour, min;
          double sec;
 
-         year  = asInt(line.substr(1, 2+addYrLen));
-         month = asInt(line.substr(3+addYrLen, 3));
-         day   = asInt(line.substr(6+addYrLen, 3));
-         hour  = asInt(line.substr(9+addYrLen, 3));
-         min   = asInt(line.substr(12+addYrLen,3));
-         sec   = asInt(line.substr(15+addYrLen,3));
+         year  = asInt(line, 1, 2+addYrLen);
+         month = asInt(line, 3+addYrLen, 3);
+         day   = asInt(line, 6+addYrLen, 3);
+         hour  = asInt(line, 9+addYrLen, 3);
+         min   = asInt(line, 12+addYrLen, 3);
+         sec   = asInt(line, 15+addYrLen, 3);
 
          if(!addYrLen)
          {
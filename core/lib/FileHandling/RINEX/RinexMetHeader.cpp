@@ -334,7 +334,7 @@ namespace gpstk
                // read the first line
             if (!(valid & validObsType))
             {
-               numObs = gpstk::StringUtils::asInt(line.substr(0,6));
+               numObs = gpstk::StringUtils::asInt(line, 0, 6);
                for (int i = 0; (i < numObs) && (i < maxObsPerLine); i++)
                {
                   int currPos = i * 6 + 6;
@@ -375,7 +375,7 @@ namespace gpstk
             sensorType st;
             st.model = strip(line.substr(0,20));
             st.type = strip(line.substr(20,20));
-            st.accuracy = asDouble(line.substr(46,9));
+            st.accuracy = asDouble(line, 46, 9);
             st.obsType = convertObsType(line.substr(57,2));
 
             sensorTypeList.push_back(st);
@@ -395,10 +395,10 @@ namespace gpstk
          {
                // read XYZ and H and obs type
             sensorPosType sp;
-            sp.position[0] = asDouble(line.substr(0,14));
-            sp.position[1] = asDouble(line.substr(14,14));
-            sp.position[2] = asDouble(line.substr(28,14));
-            sp.height = asDouble(line.substr(42,14));
+            sp.position[0] = asDouble(line, 0, 14);
+            sp.position[1] = asDouble(line, 14, 14);
+            sp.position[2] = asDouble(line, 28, 14);
+            sp.height = asDouble(line, 42, 14);
             
             sp.obsType = convertObsType(line.substr(57,2));
             
@@ -459,14 +459,14 @@ namespace gpstk
             if (currentLine[i] != ' ')
                throw(FFStreamError("Badly formatted line"));
 
-         PRNID = asInt(currentLine.substr(0,2));
+         PRNID = asInt(currentLine, 0, 2);
 
-         short yr = asInt(currentLine.substr(2,3));
-         short mo = asInt(currentLine.substr(5,3));
-         short day = asInt(currentLine.substr(8,3));
-         short hr = asInt(currentLine.substr(11,3));
-         short min = asInt(currentLine.substr(14,3));
-         double sec = asDouble(currentLine.substr(17,5));
+         short yr = asInt(currentLine, 2, 3);
+         short mo = asInt(currentLine, 5, 3);
+         short day = asInt(currentLine, 8, 3);
+         short hr = asInt(currentLine, 11, 3);
+         short min = asInt(currentLine, 14, 3);
+         double sec = asDouble(currentLine, 17, 5);
 
             // years 80-99 represent 1980-1999
          const int rolloverYear = 80;
@@ -485,9 +485,9 @@ namespace gpstk
          time = CivilTime(yr,mo,day,hr,min,sec,gpstk::TimeSystem::GPS).convertToCommonTime();
          if(ds != 0) time += ds;
 
-         af0 = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         af1 = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         af2 = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         af0 = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         af1 = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         af2 = gpstk::StringUtils::for2doub(currentLine, 60, 19);
       }
       catch (std::exception &e)
       {
@@ -502,10 +502,10 @@ namespace gpstk
    {
       try
       {
-         IODE = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         Crs = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         dn = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         M0 = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         IODE = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         Crs = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         dn = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         M0 = gpstk::StringUtils::for2doub(currentLine, 60, 19);
       }
       catch (std::exception &e)
       {
@@ -520,10 +520,10 @@ namespace gpstk
    {
       try
       {
-         Cuc = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         ecc = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         Cus = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         Ahalf = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         Cuc = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         ecc = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         Cus = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         Ahalf = gpstk::StringUtils::for2doub(currentLine, 60, 19);
       }
       catch (std::exception &e)
       {
@@ -538,10 +538,10 @@ namespace gpstk
    {
       try
       {
-         Toe = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         Cic = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         OMEGA0 = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         Cis = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         Toe = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         Cic = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         OMEGA0 = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         Cis = gpstk::StringUtils::for2doub(currentLine, 60, 19);
       }
       catch (std::exception &e)
       {
@@ -556,10 +556,10 @@ namespace gpstk
    {
       try
       {
-         i0 = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         Crc = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         w = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         OMEGAdot = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         i0 = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         Crc = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         w = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         OMEGAdot = gpstk::StringUtils::for2doub(currentLine, 60, 19);
       }
       catch (std::exception &e)
       {
@@ -576,10 +576,10 @@ namespace gpstk
       {
          double codeL2, L2P, toe_wn;
 
-         idot = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         codeL2 = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         toe_wn = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         L2P = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         idot = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         codeL2 = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         toe_wn = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         L2P = gpstk::StringUtils::for2doub(currentLine, 60, 19);
 
          codeflgs = (short) codeL2;
          L2Pdata = (short) L2P;
@@ -600,10 +600,10 @@ namespace gpstk
       {
          double SV_health;
 
-         accuracy = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
-         SV_health = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
-         Tgd = gpstk::StringUtils::for2doub(currentLine.substr(41,19));
-         IODC = gpstk::StringUtils::for2doub(currentLine.substr(60,19));
+         accuracy = gpstk::StringUtils::for2doub(currentLine, 3, 19);
+         SV_health = gpstk::StringUtils::for2doub(currentLine, 22, 19);
+         Tgd = gpstk::StringUtils::for2doub(currentLine, 41, 19);
+         IODC = gpstk::StringUtils::for2doub(currentLine, 60, 19);
 
 
          health = (short) SV_health;
@@ -623,14 +623,14 @@ namespace gpstk
       {
          double HOW_sec;
 
-         HOW_sec = gpstk::StringUtils::for2doub(currentLine.substr(3,19));
+         HOW_sec = gpstk::StringUtils::for2doub(currentLine, 3, 19);
             // leave it alone so round-trips are possible
             // (even though we're storing a double as a long, which
             //could lead to failures in round-trip testing, though if
             //that happens your transmit time is messed).
             //setXmitTime(HOW_sec);
          sf1XmitTime = HOW_sec;
-         fitint = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
+         fitint = gpstk::StringUtils::for2doub(currentLine, 22, 19);
       }
       catch (std::exception &e)
       {
@@ -208,7 +208,7 @@ namespace gpstk
          
          if (thisLabel == versionString)
          {
-            version = asDouble(line.substr(0,20));
+            version = asDouble(line, 0, 20);
             fileType = strip(line.substr(20,20));
             if ( (fileType[0] != 'N') &&
                  (fileType[0] != 'n'))
@@ -233,26 +233,26 @@ namespace gpstk
          else if (thisLabel == ionAlphaString)
          {
             for(int i = 0; i < 4; i++)
-               ionAlpha[i] = gpstk::StringUtils::for2doub(line.substr(2 + 12 * i,12));
+               ionAlpha[i] = gpstk::StringUtils::for2doub(line, 2 + 12 * i, 12);
             valid |= ionAlphaValid;
          }
          else if (thisLabel == ionBetaString)
          {
             for(int i = 0; i < 4; i++)
-               ionBeta[i] = gpstk::StringUtils::for2doub(line.substr(2 + 12 * i,12));
+               ionBeta[i] = gpstk::StringUtils::for2doub(line, 2 + 12 * i, 12);
             valid |= ionBetaValid;
          }
          else if (thisLabel == deltaUTCString)
          {
-            A0 = gpstk::StringUtils::for2doub(line.substr(3,19));
-            A1 = gpstk::StringUtils::for2doub(line.substr(22,19));
-            UTCRefTime = asInt(line.substr(41,9));
-            UTCRefWeek = asInt(line.substr(50,9));
+            A0 = gpstk::StringUtils::for2doub(line, 3, 19);
+            A1 = gpstk::StringUtils::for2doub(line, 22, 19);
+            UTCRefTime = asInt(line, 41, 9);
+            UTCRefWeek = asInt(line, 50, 9);
             valid |= deltaUTCValid;
          }
          else if (thisLabel == leapSecondsString)
          {
-            leapSeconds = asInt(line.substr(0,6));
+            leapSeconds = asInt(line, 0, 6);
             valid |= leapSecondsValid;
          }
          else if (thisLabel == endOfHeader)
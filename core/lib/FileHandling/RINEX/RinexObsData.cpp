@@ -221,7 +221,7 @@ namespace gpstk
             }
 
                // Check if it is a number; if not, an exception will be thrown
-            (void)asInt(line.substr(29,3));
+            (void)asInt(line, 29, 3);
          }
          catch(...)
          {
@@ -232,7 +232,7 @@ namespace gpstk
       }  // End of 'while( !isValidEpochLine )'
 
          // process the epoch line, including SV list and clock bias
-      epochFlag = asInt(line.substr(28,1));
+      epochFlag = asInt(line, 28, 1);
       if ((epochFlag < 0) || (epochFlag > 6))
       {
          FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
@@ -265,10 +265,10 @@ namespace gpstk
          previousTime = time;
       }
 
-      numSvs = asInt(line.substr(29,3));
+      numSvs = asInt(line, 29, 3);
 
       if( line.size() > 68 )
-         clockOffset = asDouble(line.substr(68, 12));
+         clockOffset = asDouble(line, 68, 12);
       else
          clockOffset = 0.0;
 
@@ -321,9 +321,9 @@ namespace gpstk
 
                line.resize(80, ' ');
 
-               obs[sat][obs_type].data = asDouble(line.substr(line_ndx*16,   14));
-               obs[sat][obs_type].lli = asInt(    line.substr(line_ndx*16+14, 1));
-               obs[sat][obs_type].ssi = asInt(    line.substr(line_ndx*16+15, 1));
+               obs[sat][obs_type].data = asDouble(line, line_ndx*16, 14);
+               obs[sat][obs_type].lli = asInt(    line, line_ndx*16+14, 1);
+               obs[sat][obs_type].ssi = asInt(    line, line_ndx*16+15, 1);
             }
          }
       }
@@ -385,12 +385,12 @@ namespace gpstk
          int yy = (static_cast<CivilTime>(hdr.firstObs)).year/100;
          yy *= 100;
 
-         year  = asInt(   line.substr(1,  2 ));
-         month = asInt(   line.substr(4,  2 ));
-         day   = asInt(   line.substr(7,  2 ));
-         hour  = asInt(   line.substr(10, 2 ));
-         min   = asInt(   line.substr(13, 2 ));
-         sec   = asDouble(line.substr(15, 11));
+         year  = asInt(   line, 1, 2);
+         month = asInt(   line, 4, 2);
+         day   = asInt(   line, 7, 2);
+         hour  = asInt(   line, 10, 2);
+         min   = asInt(   line, 13, 2);
+         sec   = asDouble(line, 15, 11);
 
          // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often....
          double ds=0;
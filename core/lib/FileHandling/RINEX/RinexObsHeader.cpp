@@ -522,7 +522,7 @@ namespace gpstk
 
       if (label == versionString)
       {
-         version = asDouble(line.substr(0,20));
+         version = asDouble(line, 0, 20);
 //         cout << "R2ObsHeader:ParseHeaderRecord:version = " << version << endl;
          fileType = strip(line.substr(20, 20));
          if ( (fileType[0] != 'O') &&
@@ -586,16 +586,16 @@ namespace gpstk
       }
       else if (label == antennaPositionString)
       {
-         antennaPosition[0] = asDouble(line.substr(0,  14));
-         antennaPosition[1] = asDouble(line.substr(14, 14));
-         antennaPosition[2] = asDouble(line.substr(28, 14));
+         antennaPosition[0] = asDouble(line, 0, 14);
+         antennaPosition[1] = asDouble(line, 14, 14);
+         antennaPosition[2] = asDouble(line, 28, 14);
          valid |= antennaPositionValid;
       }
       else if (label == antennaOffsetString)
       {
-         antennaOffset[0] = asDouble(line.substr(0,  14));
-         antennaOffset[1] = asDouble(line.substr(14, 14));
-         antennaOffset[2] = asDouble(line.substr(28, 14));
+         antennaOffset[0] = asDouble(line, 0, 14);
+         antennaOffset[1] = asDouble(line, 14, 14);
+         antennaOffset[2] = asDouble(line, 28, 14);
          valid |= antennaOffsetValid;
       }
       else if (label == waveFactString)
@@ -603,8 +603,8 @@ namespace gpstk
             // first time reading this
          if (! (valid & waveFactValid))
          {
-            wavelengthFactor[0] = asInt(line.substr(0,6));
-            wavelengthFactor[1] = asInt(line.substr(6,6));
+            wavelengthFactor[0] = asInt(line, 0, 6);
+            wavelengthFactor[1] = asInt(line, 6, 6);
             valid |= waveFactValid;
          }
             // additional wave fact lines
@@ -613,9 +613,9 @@ namespace gpstk
             const int maxSatsPerLine = 7;
             int Nsats;
             ExtraWaveFact ewf;
-            ewf.wavelengthFactor[0] = asInt(line.substr(0,6));
-            ewf.wavelengthFactor[1] = asInt(line.substr(6,6));
-            Nsats = asInt(line.substr(12,6));
+            ewf.wavelengthFactor[0] = asInt(line, 0, 6);
+            ewf.wavelengthFactor[1] = asInt(line, 6, 6);
+            Nsats = asInt(line, 12, 6);
 
             if (Nsats > maxSatsPerLine)   // > not >=
             {
@@ -644,7 +644,7 @@ namespace gpstk
             // process the first line
          if (! (valid & obsTypeValid))
          {
-            numObs = asInt(line.substr(0,6));
+            numObs = asInt(line, 0, 6);
 
             for (int i = 0; (i < numObs) && (i < maxObsPerLine); i++)
             {
@@ -669,7 +669,7 @@ namespace gpstk
       }
       else if (label == intervalString)
       {
-         interval = asDouble(line.substr(0, 10));
+         interval = asDouble(line, 0, 10);
          valid |= intervalValid;
       }
       else if (label == firstTimeString)
@@ -690,17 +690,17 @@ namespace gpstk
       }
       else if (label == receiverOffsetString)
       {
-         receiverOffset = asInt(line.substr(0,6));
+         receiverOffset = asInt(line, 0, 6);
          valid |= receiverOffsetValid;
       }
       else if (label == leapSecondsString)
       {
-         leapSeconds = asInt(line.substr(0,6));
+         leapSeconds = asInt(line, 0, 6);
          valid |= leapSecondsValid;
       }
       else if (label == numSatsString)
       {
-         numSVs = asInt(line.substr(0,6)) ;
+         numSVs = asInt(line, 0, 6) ;
          valid |= numSatsValid;
       }
       else if (label == prnObsString)
@@ -715,7 +715,7 @@ namespace gpstk
                 (i < int(obsTypeList.size())) &&
                    ( (i % maxObsPerLine) < maxObsPerLine); i++)
             {
-               numObsForSat[lastPRN].push_back(asInt(line.substr((i%maxObsPerLine)*6+6,6)));
+               numObsForSat[lastPRN].push_back(asInt(line, (i%maxObsPerLine)*6+6, 6));
             }
          }
          else
@@ -731,7 +731,7 @@ namespace gpstk
             for(int i = 0;
                    (i < int(obsTypeList.size())) && (i < maxObsPerLine); i++)
             {
-               numObsList.push_back(asInt(line.substr(i*6+6,6)));
+               numObsList.push_back(asInt(line, i*6+6, 6));
             }
 
             numObsForSat[lastPRN] = numObsList;
@@ -857,12 +857,12 @@ namespace gpstk
       int year, month, day, hour, min;
       double sec;
 
-      year  = asInt(   line.substr(0,  6 ));
-      month = asInt(   line.substr(6,  6 ));
-      day   = asInt(   line.substr(12, 6 ));
-      hour  = asInt(   line.substr(18, 6 ));
-      min   = asInt(   line.substr(24, 6 ));
-      sec   = asDouble(line.substr(30, 13));
+      year  = asInt(   line, 0, 6);
+      month = asInt(   line, 6, 6);
+      day   = asInt(   line, 12, 6);
+      hour  = asInt(   line, 18, 6);
+      min   = asInt(   line, 24, 6);
+      sec   = asDouble(line, 30, 13);
       return CivilTime(year, month, day, hour, min, sec).convertToCommonTime();
    }
 
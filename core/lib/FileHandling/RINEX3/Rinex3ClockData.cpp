@@ -136,7 +136,7 @@ namespace gpstk
       site = line.substr(3,4);
       if(datatype == string("AS")) {
          strip(site);
-         int prn(asInt(site.substr(1,2)));
+         int prn(asInt(site, 1, 2));
          if(site[0] == 'G') sat = RinexSatID(prn,RinexSatID::systemGPS);
          else if(site[0] == 'R') sat = RinexSatID(prn,RinexSatID::systemGlonass);
          else {
@@ -146,17 +146,17 @@ namespace gpstk
          site = string();
       }
 
-      time = CivilTime(asInt(line.substr( 8,4)),
-                     asInt(line.substr(12,3)),
-                     asInt(line.substr(15,3)),
-                     asInt(line.substr(18,3)),
-                     asInt(line.substr(21,3)),
-                     asDouble(line.substr(24,10)),
+      time = CivilTime(asInt(line, 8, 4),
+                     asInt(line, 12, 3),
+                     asInt(line, 15, 3),
+                     asInt(line, 18, 3),
+                     asInt(line, 21, 3),
+                     asDouble(line, 24, 10),
                      TimeSystem::Any);
 
-      int n(asInt(line.substr(34,3)));
-      bias = asDouble(line.substr(40,19));
-      if(n > 1 && line.length() >= 59) sig_bias = asDouble(line.substr(60,19));
+      int n(asInt(line, 34, 3));
+      bias = asDouble(line, 40, 19);
+      if(n > 1 && line.length() >= 59) sig_bias = asDouble(line, 60, 19);
 
       if(n > 2) {
          strm.formattedGetLine(line,true);
@@ -165,10 +165,10 @@ namespace gpstk
             FFStreamError e("Short line : " + line);
             GPSTK_THROW(e);
          }
-         drift =     asDouble(line.substr( 0,19));
-         if(n > 3) sig_drift = asDouble(line.substr(20,19));
-         if(n > 4) accel     = asDouble(line.substr(40,19));
-         if(n > 5) sig_accel = asDouble(line.substr(60,19));
+         drift =     asDouble(line, 0, 19);
+         if(n > 3) sig_drift = asDouble(line, 20, 19);
+         if(n > 4) accel     = asDouble(line, 40, 19);
+         if(n > 5) sig_accel = asDouble(line, 60, 19);
       }
 
    }   // end reallyGetRecord()
@@ -104,7 +104,7 @@ namespace gpstk
          try {
             string label(line, 60, 20);
             if(label == versionString) {
-               version = asDouble(line.substr(0,9));
+               version = asDouble(line, 0, 9);
                if(line[20] != 'C') {
                   FFStreamError e("Invalid file type: " + line.substr(20,1));
                   GPSTK_THROW(e);
@@ -126,7 +126,7 @@ namespace gpstk
                string satSys = strip(line.substr(0,1));
                if (satSys != "")
                {
-                  numObs = asInt(line.substr(3,3));
+                  numObs = asInt(line, 3, 3);
                   satSysPrev = satSys;
                }
                else
@@ -151,7 +151,7 @@ namespace gpstk
                valid |= timeSystemValid;
             }
             else if(label == leapSecondsString) {
-               leapSeconds = asInt(line.substr(0,6));
+               leapSeconds = asInt(line, 0, 6);
                valid |= leapSecondsValid;
             }
             else if(label == sysDCBString) {
@@ -173,7 +173,7 @@ namespace gpstk
                valid |= sysPCVValid;
             }
             else if(label == numDataString) {
-               int n(asInt(line.substr(0,6)));
+               int n(asInt(line, 0, 6));
                for(int i=0; i<n; ++i)
                   dataTypes.push_back(line.substr(10+i*6,2));
                valid |= numDataValid;
@@ -198,7 +198,7 @@ namespace gpstk
                valid |= analysisClkRefrValid;
             }
             else if(label == numReceiversString) {
-               numSolnStations = asInt(line.substr(0,6));
+               numSolnStations = asInt(line, 0, 6);
                terrRefFrame = strip(line.substr(10,50));
                valid |= numReceiversValid;
             }
@@ -211,7 +211,7 @@ namespace gpstk
                valid |= solnStateValid;
             }
             else if(label == numSolnSatsString) {
-               numSolnSatellites = asInt(line.substr(0,6));
+               numSolnSatellites = asInt(line, 0, 6);
                valid |= numSolnSatsValid;
             }
             else if(label == prnListString) {
@@ -220,7 +220,7 @@ namespace gpstk
                for(i=0; i<15; ++i) {
                   label = line.substr(4*i,3);
                   if(label == string("   ")) break;
-                  prn = asInt(line.substr(4*i+1,2));
+                  prn = asInt(line, 4*i+1, 2);
                   if(line[4*i] == 'G')
                      satList.push_back(RinexSatID(prn,RinexSatID::systemGPS));
                   else if(line[4*i] == 'R')
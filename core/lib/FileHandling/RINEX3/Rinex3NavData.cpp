@@ -1148,15 +1148,15 @@ namespace gpstk
                   throw(FFStreamError("Badly formatted epoch line"));
 
             satSys = line.substr(0,1);
-            PRNID = asInt(line.substr(1,2));
+            PRNID = asInt(line, 1, 2);
             sat.fromString(line.substr(0,3));
 
-            yr  = asInt(line.substr( 4,4));
-            mo  = asInt(line.substr( 9,2));
-            day = asInt(line.substr(12,2));
-            hr  = asInt(line.substr(15,2));
-            min = asInt(line.substr(18,2));
-            dsec = asDouble(line.substr(21,2));
+            yr  = asInt(line, 4, 4);
+            mo  = asInt(line, 9, 2);
+            day = asInt(line, 12, 2);
+            hr  = asInt(line, 15, 2);
+            min = asInt(line, 18, 2);
+            dsec = asDouble(line, 21, 2);
          }
          else {                  // RINEX 2
             for(i=2; i <= 17; i+=3)
@@ -1165,17 +1165,17 @@ namespace gpstk
                }
 
             satSys = string(1,strm.header.fileSys[0]);
-            PRNID = asInt(line.substr(0,2));
+            PRNID = asInt(line, 0, 2);
             sat.fromString(satSys + line.substr(0,2));
 
-            yr  = asInt(line.substr( 2,3));
+            yr  = asInt(line, 2, 3);
             if(yr < 80) yr += 100;     // rollover is at 1980
             yr += 1900;
-            mo  = asInt(line.substr( 5,3));
-            day = asInt(line.substr( 8,3));
-            hr  = asInt(line.substr(11,3));
-            min = asInt(line.substr(14,3));
-            dsec = asDouble(line.substr(17,5));
+            mo  = asInt(line, 5, 3);
+            day = asInt(line, 8, 3);
+            hr  = asInt(line, 11, 3);
+            min = asInt(line, 14, 3);
+            dsec = asDouble(line, 17, 5);
          }
 
          // Fix RINEX epochs of the form 'yy mm dd hr 59 60.0'
@@ -1199,28 +1199,28 @@ namespace gpstk
 
          if(strm.header.version < 3) {    // Rinex 2.*
             if(satSys == "G") {
-               af0 = StringUtils::for2doub(line.substr(22,19));
-               af1 = StringUtils::for2doub(line.substr(41,19));
-               af2 = StringUtils::for2doub(line.substr(60,19));
+               af0 = StringUtils::for2doub(line, 22, 19);
+               af1 = StringUtils::for2doub(line, 41, 19);
+               af2 = StringUtils::for2doub(line, 60, 19);
             }
             else if(satSys == "R" || satSys == "S") {
-               TauN   =      StringUtils::for2doub(line.substr(22,19));
-               GammaN =      StringUtils::for2doub(line.substr(41,19));
-               MFtime =(long)StringUtils::for2doub(line.substr(60,19));
+               TauN   =      StringUtils::for2doub(line, 22, 19);
+               GammaN =      StringUtils::for2doub(line, 41, 19);
+               MFtime =(long)StringUtils::for2doub(line, 60, 19);
                if(satSys == "R") {     // make MFtime consistent with R3.02
                   MFtime += int(Toc/86400) * 86400;
                }
             }
          }
          else if(satSys == "G" || satSys == "E" || satSys == "C" || satSys == "J") {
-            af0 = StringUtils::for2doub(line.substr(23,19));
-            af1 = StringUtils::for2doub(line.substr(42,19));
-            af2 = StringUtils::for2doub(line.substr(61,19));
+            af0 = StringUtils::for2doub(line, 23, 19);
+            af1 = StringUtils::for2doub(line, 42, 19);
+            af2 = StringUtils::for2doub(line, 61, 19);
          }
          else if(satSys == "R" || satSys == "S") {
-            TauN   =      StringUtils::for2doub(line.substr(23,19));
-            GammaN =      StringUtils::for2doub(line.substr(42,19));
-            MFtime =(long)StringUtils::for2doub(line.substr(61,19));
+            TauN   =      StringUtils::for2doub(line, 23, 19);
+            GammaN =      StringUtils::for2doub(line, 42, 19);
+            MFtime =(long)StringUtils::for2doub(line, 61, 19);
          }
       }
       catch (std::exception &e)
@@ -1246,111 +1246,111 @@ namespace gpstk
 
          if(nline == 1) {
             if(satSys == "G" || satSys == "J" || satSys == "C") {
-               IODE = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Crs  = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               dn   = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               M0   = StringUtils::for2doub(line.substr(n,19));
+               IODE = StringUtils::for2doub(line, n, 19); n+=19;
+               Crs  = StringUtils::for2doub(line, n, 19); n+=19;
+               dn   = StringUtils::for2doub(line, n, 19); n+=19;
+               M0   = StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "E") {
-               IODnav = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Crs    = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               dn     = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               M0     = StringUtils::for2doub(line.substr(n,19));
+               IODnav = StringUtils::for2doub(line, n, 19); n+=19;
+               Crs    = StringUtils::for2doub(line, n, 19); n+=19;
+               dn     = StringUtils::for2doub(line, n, 19); n+=19;
+               M0     = StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "R" || satSys == "S") {
-               px     =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               vx     =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               ax     =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               health = (short)StringUtils::for2doub(line.substr(n,19));
+               px     =        StringUtils::for2doub(line, n, 19); n+=19;
+               vx     =        StringUtils::for2doub(line, n, 19); n+=19;
+               ax     =        StringUtils::for2doub(line, n, 19); n+=19;
+               health = (short)StringUtils::for2doub(line, n, 19);
             }
          }
 
          else if(nline == 2) {
             if(satSys == "G" || satSys == "E" || satSys == "J" || satSys == "C") {
-               Cuc   = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               ecc   = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Cus   = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Ahalf = StringUtils::for2doub(line.substr(n,19));
+               Cuc   = StringUtils::for2doub(line, n, 19); n+=19;
+               ecc   = StringUtils::for2doub(line, n, 19); n+=19;
+               Cus   = StringUtils::for2doub(line, n, 19); n+=19;
+               Ahalf = StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "R" || satSys == "S") {
-               py      =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               vy      =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               ay      =        StringUtils::for2doub(line.substr(n,19)); n+=19;
+               py      =        StringUtils::for2doub(line, n, 19); n+=19;
+               vy      =        StringUtils::for2doub(line, n, 19); n+=19;
+               ay      =        StringUtils::for2doub(line, n, 19); n+=19;
                if(satSys == "R")
-                  freqNum = (short)StringUtils::for2doub(line.substr(n,19));
+                  freqNum = (short)StringUtils::for2doub(line, n, 19);
                else                       // GEO
-                  accCode = StringUtils::for2doub(line.substr(n,19));
+                  accCode = StringUtils::for2doub(line, n, 19);
             }
          }
 
          else if(nline == 3) {
             if(satSys == "G" || satSys == "E" || satSys == "J" || satSys == "C") {
-               Toe    = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Cic    = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               OMEGA0 = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Cis    = StringUtils::for2doub(line.substr(n,19));
+               Toe    = StringUtils::for2doub(line, n, 19); n+=19;
+               Cic    = StringUtils::for2doub(line, n, 19); n+=19;
+               OMEGA0 = StringUtils::for2doub(line, n, 19); n+=19;
+               Cis    = StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "R" || satSys == "S") {
-               pz        = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               vz        = StringUtils::for2doub(line.substr(n,19)); n+=19;
-               az        = StringUtils::for2doub(line.substr(n,19)); n+=19;
+               pz        = StringUtils::for2doub(line, n, 19); n+=19;
+               vz        = StringUtils::for2doub(line, n, 19); n+=19;
+               az        = StringUtils::for2doub(line, n, 19); n+=19;
                if(satSys == "R")
-                  ageOfInfo = StringUtils::for2doub(line.substr(n,19));
+                  ageOfInfo = StringUtils::for2doub(line, n, 19);
                else                       // GEO
-                  IODN = StringUtils::for2doub(line.substr(n,19));
+                  IODN = StringUtils::for2doub(line, n, 19);
             }
          }
 
          else if(nline == 4) {
-            i0       = StringUtils::for2doub(line.substr(n,19)); n+=19;
-            Crc      = StringUtils::for2doub(line.substr(n,19)); n+=19;
-            w        = StringUtils::for2doub(line.substr(n,19)); n+=19;
-            OMEGAdot = StringUtils::for2doub(line.substr(n,19));
+            i0       = StringUtils::for2doub(line, n, 19); n+=19;
+            Crc      = StringUtils::for2doub(line, n, 19); n+=19;
+            w        = StringUtils::for2doub(line, n, 19); n+=19;
+            OMEGAdot = StringUtils::for2doub(line, n, 19);
          }
 
          else if(nline == 5) {
             if(satSys == "G" || satSys == "J" || satSys == "C") {
-               idot     =        StringUtils::for2doub(line.substr(n,19)); n+=19;
-               codeflgs = (short)StringUtils::for2doub(line.substr(n,19)); n+=19;
-               weeknum  = (short)StringUtils::for2doub(line.substr(n,19)); n+=19;
-               L2Pdata  = (short)StringUtils::for2doub(line.substr(n,19));
+               idot     =        StringUtils::for2doub(line, n, 19); n+=19;
+               codeflgs = (short)StringUtils::for2doub(line, n, 19); n+=19;
+               weeknum  = (short)StringUtils::for2doub(line, n, 19); n+=19;
+               L2Pdata  = (short)StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "E") {
-               idot        =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               datasources =(short)StringUtils::for2doub(line.substr(n,19)); n+=19;
-               weeknum     =(short)StringUtils::for2doub(line.substr(n,19)); n+=19;
+               idot        =       StringUtils::for2doub(line, n, 19); n+=19;
+               datasources =(short)StringUtils::for2doub(line, n, 19); n+=19;
+               weeknum     =(short)StringUtils::for2doub(line, n, 19); n+=19;
             }
          }
 
          else if(nline == 6) {
             Tgd2 = 0.0;
             if(satSys == "G" || satSys == "J") {
-               accuracy =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               health   = short(StringUtils::for2doub(line.substr(n,19))); n+=19;
-               Tgd      =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               IODC     =       StringUtils::for2doub(line.substr(n,19));
+               accuracy =       StringUtils::for2doub(line, n, 19); n+=19;
+               health   = short(StringUtils::for2doub(line, n, 19)); n+=19;
+               Tgd      =       StringUtils::for2doub(line, n, 19); n+=19;
+               IODC     =       StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "E") {
-               accuracy =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               health   = short(StringUtils::for2doub(line.substr(n,19))); n+=19;
-               Tgd      =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Tgd2     =       StringUtils::for2doub(line.substr(n,19));
+               accuracy =       StringUtils::for2doub(line, n, 19); n+=19;
+               health   = short(StringUtils::for2doub(line, n, 19)); n+=19;
+               Tgd      =       StringUtils::for2doub(line, n, 19); n+=19;
+               Tgd2     =       StringUtils::for2doub(line, n, 19);
             }
             else if(satSys == "C") {
-               accuracy =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               health   = short(StringUtils::for2doub(line.substr(n,19))); n+=19;
-               Tgd      =       StringUtils::for2doub(line.substr(n,19)); n+=19;
-               Tgd2     =       StringUtils::for2doub(line.substr(n,19));
+               accuracy =       StringUtils::for2doub(line, n, 19); n+=19;
+               health   = short(StringUtils::for2doub(line, n, 19)); n+=19;
+               Tgd      =       StringUtils::for2doub(line, n, 19); n+=19;
+               Tgd2     =       StringUtils::for2doub(line, n, 19);
             }
          }
 
          else if(nline == 7) {
-            xmitTime = long(StringUtils::for2doub(line.substr(n,19))); n+=19;
+            xmitTime = long(StringUtils::for2doub(line, n, 19)); n+=19;
             if(satSys == "C") {
-               IODC    =        StringUtils::for2doub(line.substr(n,19)); n+=19;
+               IODC    =        StringUtils::for2doub(line, n, 19); n+=19;
             }
             else {
-               fitint  =        StringUtils::for2doub(line.substr(n,19)); n+=19;
+               fitint  =        StringUtils::for2doub(line, n, 19); n+=19;
             }
    
             // Some RINEX files have xmitTime < 0.
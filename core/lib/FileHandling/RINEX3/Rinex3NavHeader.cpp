@@ -191,7 +191,7 @@ namespace gpstk
          if(thisLabel == stringVersion) 
          {
                // "RINEX VERSION / TYPE"
-            version = asDouble(line.substr( 0,20));
+            version = asDouble(line, 0, 20);
 
             fileType = strip(line.substr(20,20));
             if(version >= 3) 
@@ -243,7 +243,7 @@ namespace gpstk
                // GPS alpha "ION ALPHA"  R2.11
             IonoCorr ic("GPSA");
             for(i=0; i < 4; i++)
-               ic.param[i] = for2doub(line.substr(2 + 12*i, 12));
+               ic.param[i] = for2doub(line, 2 + 12*i, 12);
             mapIonoCorr[ic.asString()] = ic;
             if(mapIonoCorr.find("GPSB") != mapIonoCorr.end())
                valid |= validIonoCorrGPS;
@@ -253,7 +253,7 @@ namespace gpstk
                // GPS beta "ION BETA"  R2.11
             IonoCorr ic("GPSB");
             for(i=0; i < 4; i++)
-               ic.param[i] = for2doub(line.substr(2 + 12*i, 12));
+               ic.param[i] = for2doub(line, 2 + 12*i, 12);
             mapIonoCorr[ic.asString()] = ic;
             if(mapIonoCorr.find("GPSA") != mapIonoCorr.end())
                valid |= validIonoCorrGPS;
@@ -272,7 +272,7 @@ namespace gpstk
                GPSTK_THROW(e);
             }
             for(i=0; i < 4; i++)
-               ic.param[i] = for2doub(line.substr(5 + 12*i, 12));
+               ic.param[i] = for2doub(line, 5 + 12*i, 12);
 
             if(ic.type == IonoCorr::GAL)
             {
@@ -295,10 +295,10 @@ namespace gpstk
          {
                // "DELTA-UTC: A0,A1,T,W" R2.11 GPS
             TimeSystemCorrection tc("GPUT");
-            tc.A0 = for2doub(line.substr(3,19));
-            tc.A1 = for2doub(line.substr(22,19));
-            tc.refSOW = asInt(line.substr(41,9));
-            tc.refWeek = asInt(line.substr(50,9));
+            tc.A0 = for2doub(line, 3, 19);
+            tc.A1 = for2doub(line, 22, 19);
+            tc.refSOW = asInt(line, 41, 9);
+            tc.refWeek = asInt(line, 50, 9);
             tc.geoProvider = string("    ");
             tc.geoUTCid = 0;
 
@@ -310,10 +310,10 @@ namespace gpstk
          {
                // "CORR TO SYSTEM TIME"  R2.10 GLO
             TimeSystemCorrection tc("GLUT");
-            tc.refYr = asInt(line.substr(0,6));
-            tc.refMon = asInt(line.substr(6,6));
-            tc.refDay = asInt(line.substr(12,6));
-            tc.A0 = -for2doub(line.substr(21,19));    // -TauC
+            tc.refYr = asInt(line, 0, 6);
+            tc.refMon = asInt(line, 6, 6);
+            tc.refDay = asInt(line, 12, 6);
+            tc.A0 = -for2doub(line, 21, 19);    // -TauC
 
                // convert to week,sow
             CivilTime ct(tc.refYr,tc.refMon,tc.refDay,0,0,0.0);
@@ -332,12 +332,12 @@ namespace gpstk
          {
                // "D-UTC A0,A1,T,W,S,U"  // R2.11 GEO
             TimeSystemCorrection tc("SBUT");
-            tc.A0 = for2doub(line.substr(0,19));
-            tc.A1 = for2doub(line.substr(19,19));
-            tc.refSOW = asInt(line.substr(38,7));
-            tc.refWeek = asInt(line.substr(45,5));
+            tc.A0 = for2doub(line, 0, 19);
+            tc.A1 = for2doub(line, 19, 19);
+            tc.refSOW = asInt(line, 38, 7);
+            tc.refWeek = asInt(line, 45, 5);
             tc.geoProvider = line.substr(51,5);
-            tc.geoUTCid = asInt(line.substr(57,2));
+            tc.geoUTCid = asInt(line, 57, 2);
 
             mapTimeCorr[tc.asString4()] = tc;
             valid |= validTimeSysCorr;
@@ -356,12 +356,12 @@ namespace gpstk
                GPSTK_THROW(e);
             }
 
-            tc.A0 = for2doub(line.substr(5,17));
-            tc.A1 = for2doub(line.substr(22,16));
-            tc.refSOW = asInt(line.substr(38,7));
-            tc.refWeek = asInt(line.substr(45,5));
+            tc.A0 = for2doub(line, 5, 17);
+            tc.A1 = for2doub(line, 22, 16);
+            tc.refSOW = asInt(line, 38, 7);
+            tc.refWeek = asInt(line, 45, 5);
             tc.geoProvider = strip(line.substr(51,6));
-            tc.geoUTCid = asInt(line.substr(57,2));
+            tc.geoUTCid = asInt(line, 57, 2);
 
             if(tc.type == TimeSystemCorrection::GLGP ||
                tc.type == TimeSystemCorrection::GLUT ||        // TD ?
@@ -403,10 +403,10 @@ namespace gpstk
          else if(thisLabel == stringLeapSeconds)
          {
                // "LEAP SECONDS"
-            leapSeconds = asInt(line.substr(0,6));
-            leapDelta = asInt(line.substr(6,6));      // R3 only
-            leapWeek = asInt(line.substr(12,6));      // R3 only
-            leapDay = asInt(line.substr(18,6));       // R3 only
+            leapSeconds = asInt(line, 0, 6);
+            leapDelta = asInt(line, 6, 6);      // R3 only
+            leapWeek = asInt(line, 12, 6);      // R3 only
+            leapDay = asInt(line, 18, 6);       // R3 only
             valid |= validLeapSeconds;
          }
          else if(thisLabel == stringEoH)
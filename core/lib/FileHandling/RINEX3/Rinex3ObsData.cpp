@@ -358,12 +358,33 @@ namespace gpstk
 
    }   // end Rinex3ObsData::reallyPutRecord
 
+
+      /* Return the entry of obs for sat, adding an empty one if
+       * needed.  The satellites of a record are usually in order,
+       * and so in the order of their handles, which is that of
+       * RinexSatID; while that holds, lastHandle (-1 to start) is the
+       * handle of the last satellite and the new entry goes at the
+       * end of obs without a search. */
+   static vector<RinexDatum>& obsEntry(Rinex3ObsData::DataMap& obs,
+                                       const RinexSatID& sat,
+                                       int& lastHandle)
+   {
+      int h(sat.handle());
+      if(h > lastHandle && lastHandle >= -1)
+      {
+         lastHandle = h;
+         return obs.insert(obs.end(), Rinex3ObsData::DataMap::value_type(
+                              sat, vector<RinexDatum>()))->second;
+      }
+         // out of order, or without a handle
+      lastHandle = -2;
+      return obs[sat];
+   }
+
    
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
       throw(Exception)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -377,7 +398,7 @@ namespace gpstk
       }
 
          // process the epoch line, including SV list and clock bias
-      rod.epochFlag = asInt(line.substr(28,1));
+      rod.epochFlag = asInt(line, 28, 1);
       if((rod.epochFlag < 0) || (rod.epochFlag > 6))
       {
          FFStreamError e("Invalid epoch flag: " + asString(rod.epochFlag));
@@ -399,7 +420,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -424,12 +445,12 @@ namespace gpstk
                int yy = (static_cast<CivilTime>(strm.header.firstObs)).year/100;
                yy *= 100;
 
-               year  = asInt(   line.substr(1,  2 ));
-               month = asInt(   line.substr(4,  2 ));
-               day   = asInt(   line.substr(7,  2 ));
-               hour  = asInt(   line.substr(10, 2 ));
-               min   = asInt(   line.substr(13, 2 ));
-               sec   = asDouble(line.substr(15, 11));
+               year  = asInt(   line, 1, 2);
+               month = asInt(   line, 4, 2);
+               day   = asInt(   line, 7, 2);
+               hour  = asInt(   line, 10, 2);
+               min   = asInt(   line, 13, 2);
+               sec   = asDouble(line, 15, 11);
 
                   // Real Rinex has epochs 'yy mm dd hr 59 60.0'
                   // surprisingly often....
@@ -459,16 +480,16 @@ namespace gpstk
          }
             // end rod.time = parseTime(line, strm.header);
 
-            // save for next call
-         previousTime = rod.time;
+            // save in the stream for the next call
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
-      rod.numSVs = asInt(line.substr(29,3));
+      rod.numSVs = asInt(line, 29, 3);
 
          // clock offset
       if(line.size() > 68 )
-         rod.clockOffset = asDouble(line.substr(68, 12));
+         rod.clockOffset = asDouble(line, 68, 12);
       else
          rod.clockOffset = 0.0;
 
@@ -511,11 +532,25 @@ namespace gpstk
             // number of R2 OTs in header
          unsigned numObs(strm.header.R2ObsTypes.size());
          rod.obs.clear();
+            // Which R2 OTs map into a valid R3 ObsID for each system,
+            // looked up in the header once per system per record
+            // rather than for each datum.
+         vector<bool> wanted[128];
+         int lastHandle(-1);
             // loop over all sats, reading obs data
          for(isv=0; isv < rod.numSVs; isv++)
          {
             sat = satIndex[isv];                   // sat for this data
-            satsys = asString(sat.systemChar());   // system for this sat
+            vector<bool>& want(wanted[sat.systemChar() & 0x7f]);
+            if(want.empty())
+            {
+               satsys = asString(sat.systemChar());   // system for this sat
+               map<string,RinexObsID>& r2r3(strm.header.mapSysR2toR3ObsID[satsys]);
+               want.resize(numObs);
+               for(ndx=0; ndx < numObs; ndx++)
+                  want[ndx] = (r2r3[strm.header.R2ObsTypes[ndx]].asString()
+                               != string("   "));
+            }
             vector<RinexDatum> data;
                // loop over data in the line
             for(ndx=0, line_ndx=0; ndx < numObs; ndx++, line_ndx++)
@@ -535,15 +570,13 @@ namespace gpstk
                }
 
                   // does this R2 OT map into a valid R3 ObsID?
-               string R2ot(strm.header.R2ObsTypes[ndx]);
-               string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
-               if(R3ot != string("   "))
+               if(want[ndx])
                {
                   RinexDatum tempData(line.substr(line_ndx*16, 16));
                   data.push_back(tempData);
                }
             }
-            rod.obs[sat] = data;
+            obsEntry(rod.obs, sat, lastHandle).swap(data);
 
          }  // end loop over sats to read obs data
       }
@@ -581,10 +614,14 @@ namespace gpstk
          // If the header hasn't been read, read it.
       if(!strm.headerRead) strm >> strm.header;
 
-      Rinex3ObsData rod;
-
-         // clear out this ObsData
-      *this = rod;
+         // clear out this ObsData, keeping the storage of obs and
+         // auxHeader rather than copying a default-constructed object
+      time = CommonTime::BEGINNING_OF_TIME;
+      epochFlag = -1;
+      numSVs = -1;
+      clockOffset = 0.;
+      obs.clear();
+      auxHeader.clear();
 
          // call the version for RINEX ver 2
       if(strm.header.version < 3)
@@ -601,40 +638,77 @@ namespace gpstk
       }
 
       string line;
+      const char *mline;
+      string::size_type mlen;
+      bool mapped = strm.isMemoryMapped();
 
          // read the first (epoch) line
-      strm.formattedGetLine(line, true);
-      StringUtils::stripTrailing(line, " ");
-
-         // Check and parse the epoch line -----------------------------------
-         // Check for epoch marker ('>') and following space.
-      if(line[0] != '>' || line[1] != ' ')
+      if(mapped)
       {
-         FFStreamError e("Bad epoch line: >" + line + "<");
-         GPSTK_THROW(e);
+            // pick up wherever the stream was left, e.g. after the header
+         strm.mapPos = strm.tellg();
+         strm.mappedGetLine(mline, mlen, true);
+         line.assign(mline, mlen);
       }
+      else
+         strm.formattedGetLine(line, true);
+      StringUtils::stripTrailing(line, " ");
 
-      epochFlag = asInt(line.substr(31,1));
-      if(epochFlag < 0 || epochFlag > 6)
+      parseEpochLine(line, strm.header, strm.timesystem,
+                     time, epochFlag, numSVs, clockOffset);
+
+         // Read the observations: SV ID and data ----------------------------
+      if(mapped && (epochFlag == 0 || epochFlag == 1 || epochFlag == 6))
       {
-         FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
-         GPSTK_THROW(e);
-      }
+            // Parse each satellite line in place in the mapped file.
+            // Fields past the end of a line are blank, exactly as if
+            // the line were padded with spaces.
+            // The number of obs for each system is looked up by
+            // system letter, so no strings are made per satellite.
+         int numObs['Z' - 'A' + 1] = { 0 };
+         Rinex3ObsHeader::RinexObsMap::const_iterator it;
+         for(it = strm.header.mapObsTypes.begin();
+             it != strm.header.mapObsTypes.end(); ++it)
+         {
+            if(it->first.size() == 1 &&
+               it->first[0] >= 'A' && it->first[0] <= 'Z')
+               numObs[it->first[0] - 'A'] = it->second.size();
+         }
 
-      time = parseTime(line, strm.header, strm.timesystem);
+         int lastHandle(-1);
+         for(int isv = 0; isv < numSVs; isv++)
+         {
+            strm.mappedGetLine(mline, mlen);
 
-      numSVs = asInt(line.substr(32,3));
+            RinexSatID sat;
+            try
+            {
+               sat.fromString(mline, std::min(mlen, string::size_type(3)));
+            }
+            catch (Exception& e)
+            {
+               FFStreamError ffse(e);
+               GPSTK_THROW(ffse);
+            }
 
-      if(line.size() > 41)
-         clockOffset = asDouble(line.substr(41,15));
-      else
-         clockOffset = 0.0;
+            char sys(sat.systemChar());
+            int size = (sys >= 'A' && sys <= 'Z') ? numObs[sys - 'A'] : 0;
 
-         // Read the observations: SV ID and data ----------------------------
-      if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
+            vector<RinexDatum>& data = obsEntry(obs, sat, lastHandle);
+            data.resize(size);
+            for(int i = 0; i < size; i++)
+            {
+               string::size_type pos = 3 + 16*i;
+               data[i].fromString(mline + pos, (pos < mlen ? mlen - pos : 0));
+            }
+         }
+      }
+      else if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
       {
          vector<RinexSatID> satIndex(numSVs);
-         map<RinexSatID, vector<RinexDatum> > tempDataMap;
+         char prevSys(0);
+         int size(0);
+         int lastHandle(-1);
 
          for(int isv = 0; isv < numSVs; isv++)
          {
@@ -653,9 +727,12 @@ namespace gpstk
             }
 
                // get the # data items (# entries in ObsType map of
-               // maps from header)
-            string gnss = asString(satIndex[isv].systemChar());
-            int size = strm.header.mapObsTypes[gnss].size();
+               // maps from header), when the system changes
+            if(satIndex[isv].systemChar() != prevSys)
+            {
+               prevSys = satIndex[isv].systemChar();
+               size = strm.header.mapObsTypes[string(1, prevSys)].size();
+            }
 
                // Some receivers leave blanks for missing Obs (which
                // is OK by RINEX 3).  If the last Obs are the ones
@@ -675,7 +752,7 @@ namespace gpstk
                RinexDatum tempData(line.substr(pos,16));
                data.push_back(tempData);
             }
-            obs[satIndex[isv]] = data;
+            obsEntry(obs, satIndex[isv], lastHandle).swap(data);
          }
       }
 
@@ -685,7 +762,13 @@ namespace gpstk
          auxHeader.clear();
          for(int i = 0; i < numSVs; i++)
          {
-            strm.formattedGetLine(line);
+            if(mapped)
+            {
+               strm.mappedGetLine(mline, mlen);
+               line.assign(mline, mlen);
+            }
+            else
+               strm.formattedGetLine(line);
             StringUtils::stripTrailing(line);
             try
             {
@@ -702,14 +785,53 @@ namespace gpstk
          }
       }
 
+         // leave the stream where the mapped reader stopped
+      if(mapped)
+         strm.seekg(strm.mapPos);
+
       return;
 
    } // end of reallyGetRecord()
 
 
+   void Rinex3ObsData::parseEpochLine(const string& line,
+                                      const Rinex3ObsHeader& hdr,
+                                      const TimeSystem& ts,
+                                      CommonTime& time,
+                                      short& epochFlag,
+                                      short& numSVs,
+                                      double& clockOffset)
+      throw(std::exception, FFStreamError, StringException)
+   {
+         // Check and parse the epoch line -----------------------------------
+         // Check for epoch marker ('>') and following space.
+      if(line[0] != '>' || line[1] != ' ')
+      {
+         FFStreamError e("Bad epoch line: >" + line + "<");
+         GPSTK_THROW(e);
+      }
+
+      epochFlag = asInt(line, 31, 1);
+      if(epochFlag < 0 || epochFlag > 6)
+      {
+         FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
+         GPSTK_THROW(e);
+      }
+
+      time = parseTime(line, hdr, ts);
+
+      numSVs = asInt(line, 32, 3);
+
+      if(line.size() > 41)
+         clockOffset = asDouble(line, 41, 15);
+      else
+         clockOffset = 0.0;
+   }  // end parseEpochLine
+
+
    CommonTime Rinex3ObsData::parseTime(const string& line,
                                        const Rinex3ObsHeader& hdr,
-                                       const TimeSystem& ts) const
+                                       const TimeSystem& ts)
       throw(FFStreamError)
    {
       try
@@ -731,12 +853,13 @@ namespace gpstk
          int year, month, day, hour, min;
          double sec;
 
-         year  = asInt(   line.substr( 2,  4));
-         month = asInt(   line.substr( 7,  2));
-         day   = asInt(   line.substr(10,  2));
-         hour  = asInt(   line.substr(13,  2));
-         min   = asInt(   line.substr(16,  2));
-         sec   = asDouble(line.substr(19, 11));
+         const char *cline = line.c_str();
+         year  = asInt(   cline +  2,  4);
+         month = asInt(   cline +  7,  2);
+         day   = asInt(   cline + 10,  2);
+         hour  = asInt(   cline + 13,  2);
+         min   = asInt(   cline + 16,  2);
+         sec   = asDouble(cline + 19, 11);
 
             // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often.
          double ds = 0;
@@ -212,12 +212,34 @@ namespace gpstk
           * @param hdr  The RINEX Observation Header object for the current
           *             RINEX file.
           */
-      CommonTime parseTime( const std::string& line,
-                            const Rinex3ObsHeader& hdr,
-                            const TimeSystem& ts) const
+      static CommonTime parseTime( const std::string& line,
+                                   const Rinex3ObsHeader& hdr,
+                                   const TimeSystem& ts)
          throw( FFStreamError );
 
 
+         /** Check and parse a RINEX 3 epoch line, the line beginning
+          * with '>'.  Shared with Rinex3ObsFlatData.
+          *
+          * @param line The epoch line, trailing blanks stripped.
+          * @param hdr  The RINEX Observation Header for the current file.
+          * @param ts   The time system of the file.
+          * @throw FFStreamError if the line is not a valid epoch line.
+          */
+      static void parseEpochLine( const std::string& line,
+                                  const Rinex3ObsHeader& hdr,
+                                  const TimeSystem& ts,
+                                  CommonTime& time,
+                                  short& epochFlag,
+                                  short& numSVs,
+                                  double& clockOffset )
+         throw( std::exception, FFStreamError,
+                gpstk::StringUtils::StringException );
+
+
+      friend class Rinex3ObsFlatData;
+
+
    }; // End of class 'Rinex3ObsData'
 
       //@}
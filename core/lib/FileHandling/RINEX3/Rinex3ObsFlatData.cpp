@@ -0,0 +1,347 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsFlatData.cpp
+ * RINEX observation epoch stored as flat arrays rather than a map of vectors.
+ */
+
+#include <algorithm>
+#include "StringUtils.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsFlatData.hpp"
+
+using namespace gpstk::StringUtils;
+using namespace std;
+
+namespace gpstk
+{
+   Rinex3ObsFlatData ::
+   Rinex3ObsFlatData()
+         : time(gpstk::CommonTime::BEGINNING_OF_TIME),
+           epochFlag(-1),
+           numSVs(-1),
+           clockOffset(0.),
+           satIndex(RinexSatID::numHandles, 0)
+   {
+      start.push_back(0);
+   }
+
+
+   void Rinex3ObsFlatData ::
+   clear()
+   {
+      time = CommonTime::BEGINNING_OF_TIME;
+      epochFlag = -1;
+      numSVs = -1;
+      clockOffset = 0.;
+      auxHeader.clear();
+      sats.clear();
+      start.resize(1);
+      start[0] = 0;
+      values.clear();
+      lli.clear();
+      ssi.clear();
+      blanks.clear();
+   }
+
+
+   size_t Rinex3ObsFlatData ::
+   addSat(const RinexSatID& sat, size_t nobs)
+   {
+      size_t end = values.size() + nobs;
+      int h = sat.handle();
+      if ((h >= 0) && (findSat(sat) == sats.size()))
+         satIndex[h] = sats.size();
+      sats.push_back(sat);
+      values.resize(end, 0.);
+      lli.resize(end, 0);
+      ssi.resize(end, 0);
+      blanks.resize(end, 0);
+      start.push_back(end);
+      return sats.size() - 1;
+   }
+
+
+   size_t Rinex3ObsFlatData ::
+   findSat(const RinexSatID& sat) const
+   {
+      int h = sat.handle();
+      if (h >= 0)
+      {
+         size_t isat = satIndex[h];
+         if ((isat < sats.size()) && (sats[isat] == sat))
+            return isat;
+      }
+      size_t isat;
+      for (isat = 0; isat < sats.size(); isat++)
+      {
+         if (sats[isat] == sat)
+            break;
+      }
+      return isat;
+   }
+
+
+   RinexDatum Rinex3ObsFlatData ::
+   datum(size_t isat, size_t iobs) const
+   {
+      size_t i = start[isat] + iobs;
+      RinexDatum rv;
+      rv.data = values[i];
+      rv.lli = lli[i];
+      rv.ssi = ssi[i];
+      rv.dataBlank = ((blanks[i] & dataBlankBit) != 0);
+      rv.lliBlank = ((blanks[i] & lliBlankBit) != 0);
+      rv.ssiBlank = ((blanks[i] & ssiBlankBit) != 0);
+      return rv;
+   }
+
+
+   void Rinex3ObsFlatData ::
+   setDatum(size_t isat, size_t iobs, const RinexDatum& rd)
+   {
+      size_t i = start[isat] + iobs;
+      values[i] = rd.data;
+      lli[i] = rd.lli;
+      ssi[i] = rd.ssi;
+      blanks[i] = ((rd.dataBlank ? dataBlankBit : 0) |
+                   (rd.lliBlank ? lliBlankBit : 0) |
+                   (rd.ssiBlank ? ssiBlankBit : 0));
+   }
+
+
+   RinexDatum Rinex3ObsFlatData ::
+   getObs(const RinexSatID& svID, size_t index) const
+      throw(InvalidRequest)
+   {
+      size_t isat = findSat(svID);
+      if (isat == sats.size())
+      {
+         InvalidRequest ir( svID.toString() + " is not available.");
+         GPSTK_THROW(ir);
+      }
+      if (index >= numObs(isat))
+      {
+         InvalidRequest ir( svID.toString() + " index " +
+                            StringUtils::asString(index) +
+                            " is not available.");
+         GPSTK_THROW(ir);
+      }
+      return datum(isat, index);
+   }
+
+
+   RinexDatum Rinex3ObsFlatData ::
+   getObs(const RinexSatID& svID,
+          const RinexObsID& obsID,
+          const Rinex3ObsHeader& hdr) const
+      throw(InvalidRequest)
+   {
+      string sys(1,svID.systemChar());
+      return getObs(svID, hdr.getObsIndex(sys, obsID));
+   }
+
+
+   void Rinex3ObsFlatData ::
+   toObsData(Rinex3ObsData& rod) const
+   {
+      rod.time = time;
+      rod.epochFlag = epochFlag;
+      rod.numSVs = numSVs;
+      rod.clockOffset = clockOffset;
+      rod.auxHeader = auxHeader;
+      rod.obs.clear();
+      for (size_t isat = 0; isat < sats.size(); isat++)
+      {
+         vector<RinexDatum>& data = rod.obs[sats[isat]];
+         data.resize(numObs(isat));
+         for (size_t iobs = 0; iobs < data.size(); iobs++)
+            data[iobs] = datum(isat, iobs);
+      }
+   }
+
+
+   void Rinex3ObsFlatData ::
+   fromObsData(const Rinex3ObsData& rod)
+   {
+      clear();
+      time = rod.time;
+      epochFlag = rod.epochFlag;
+      numSVs = rod.numSVs;
+      clockOffset = rod.clockOffset;
+      auxHeader = rod.auxHeader;
+      Rinex3ObsData::DataMap::const_iterator i;
+      for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+      {
+         size_t isat = addSat(i->first, i->second.size());
+         for (size_t iobs = 0; iobs < i->second.size(); iobs++)
+            setDatum(isat, iobs, i->second[iobs]);
+      }
+   }
+
+
+   void Rinex3ObsFlatData ::
+   dump(ostream& s) const
+   {
+      Rinex3ObsData rod;
+      toObsData(rod);
+      rod.dump(s);
+   }
+
+
+   void Rinex3ObsFlatData ::
+   reallyPutRecord(FFStream& ffs) const
+      throw(std::exception, FFStreamError, StringException)
+   {
+      Rinex3ObsData rod;
+      toObsData(rod);
+      rod.reallyPutRecord(ffs);
+   }
+
+
+   void Rinex3ObsFlatData ::
+   reallyGetRecord(FFStream& ffs)
+      throw(std::exception, FFStreamError, StringException)
+   {
+      Rinex3ObsStream& strm = dynamic_cast<Rinex3ObsStream&>(ffs);
+
+         // If the header hasn't been read, read it.
+      if(!strm.headerRead) strm >> strm.header;
+
+         // RINEX 2 records are mapped to RINEX 3 obs types by Rinex3ObsData
+      if(strm.header.version < 3)
+      {
+         Rinex3ObsData rod;
+         rod.reallyGetRecord(ffs);
+         fromObsData(rod);
+         return;
+      }
+
+      clear();
+
+      string line;
+      const char *mline;
+      string::size_type mlen;
+      bool mapped = strm.isMemoryMapped();
+
+         // read the first (epoch) line
+      if(mapped)
+      {
+         strm.mapPos = strm.tellg();
+         strm.mappedGetLine(mline, mlen, true);
+         line.assign(mline, mlen);
+      }
+      else
+         strm.formattedGetLine(line, true);
+      StringUtils::stripTrailing(line, " ");
+
+      Rinex3ObsData::parseEpochLine(line, strm.header, strm.timesystem,
+                                    time, epochFlag, numSVs, clockOffset);
+
+         // Read the observations: SV ID and data ----------------------------
+      if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
+      {
+         RinexDatum tempData;
+         for(int isv = 0; isv < numSVs; isv++)
+         {
+            if(mapped)
+               strm.mappedGetLine(mline, mlen);
+            else
+            {
+               strm.formattedGetLine(line);
+               mline = line.data();
+               mlen = line.size();
+            }
+
+            RinexSatID sat;
+            try
+            {
+               sat = RinexSatID(string(mline, std::min(mlen, string::size_type(3))));
+            }
+            catch (Exception& e)
+            {
+               FFStreamError ffse(e);
+               GPSTK_THROW(ffse);
+            }
+
+               // Fields missing from the end of the line are blank.
+            string gnss(1, sat.systemChar());
+            size_t size = strm.header.mapObsTypes[gnss].size();
+            size_t isat = addSat(sat, size);
+            for(size_t i = 0; i < size; i++)
+            {
+               string::size_type pos = 3 + 16*i;
+               tempData.fromString(mline + pos, (pos < mlen ? mlen - pos : 0));
+               setDatum(isat, i, tempData);
+            }
+         }
+      }
+
+         // ... or the auxiliary header information
+      else if(numSVs > 0)
+      {
+         for(int i = 0; i < numSVs; i++)
+         {
+            if(mapped)
+            {
+               strm.mappedGetLine(mline, mlen);
+               line.assign(mline, mlen);
+            }
+            else
+               strm.formattedGetLine(line);
+            StringUtils::stripTrailing(line);
+            try
+            {
+               auxHeader.parseHeaderRecord(line);
+            }
+            catch(FFStreamError& e)
+            {
+               GPSTK_RETHROW(e);
+            }
+            catch(StringException& e)
+            {
+               GPSTK_RETHROW(e);
+            }
+         }
+      }
+
+         // leave the stream where the mapped reader stopped
+      if(mapped)
+         strm.seekg(strm.mapPos);
+   }
+
+} // End of namespace gpstk
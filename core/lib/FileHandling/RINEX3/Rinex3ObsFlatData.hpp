@@ -0,0 +1,304 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsFlatData.hpp
+ * RINEX observation epoch stored as flat arrays rather than a map of vectors.
+ */
+
+#ifndef GPSTK_RINEX3OBSFLATDATA_HPP
+#define GPSTK_RINEX3OBSFLATDATA_HPP
+
+#include <vector>
+#include <utility>
+#include <iterator>
+
+#include "CommonTime.hpp"
+#include "FFStream.hpp"
+#include "Rinex3ObsBase.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "RinexDatum.hpp"
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class holds the same RINEX Observation Data Record as
+       * Rinex3ObsData, but in a struct-of-arrays layout.  All
+       * satellites of an epoch share one array each of values, LLI,
+       * SSI and blank flags, and a satellite's observations occupy a
+       * contiguous range in those arrays, in the order of the
+       * header's obs-type table (Rinex3ObsHeader::mapObsTypes) for
+       * its system.  Reading an epoch clears the arrays without
+       * releasing their storage, so when a single object is reused
+       * to read a file there is no heap allocation per satellite or
+       * per epoch once the arrays have grown to size.
+       *
+       * Satellites are kept in the order they appear in the file,
+       * not sorted as in Rinex3ObsData::obs.
+       *
+       * Code written for Rinex3ObsData that iterates over \c obs can
+       * iterate over obsView() instead, and the two representations
+       * can be converted with toObsData() and fromObsData().
+       *
+       * RINEX 3 records are parsed directly into the arrays
+       * (including by the memory-mapped reader of Rinex3ObsStream);
+       * RINEX 2 records, and all writing, go through Rinex3ObsData.
+       *
+       * @sa gpstk::Rinex3ObsData and gpstk::Rinex3ObsStream.
+       */
+   class Rinex3ObsFlatData : public Rinex3ObsBase
+   {
+   public:
+         /// Bits of #blanks indicating the fields that are blank in the file.
+      enum BlankBits
+      {
+         dataBlankBit = 1,   ///< RinexDatum::dataBlank
+         lliBlankBit = 2,    ///< RinexDatum::lliBlank
+         ssiBlankBit = 4     ///< RinexDatum::ssiBlank
+      };
+
+         /** Read-only view of the observations of one satellite,
+          * standing in for the std::vector<RinexDatum> of
+          * Rinex3ObsData::DataMap. */
+      class SatObs
+      {
+      public:
+         SatObs(const Rinex3ObsFlatData* d = 0, std::size_t i = 0)
+               : fd(d), isat(i)
+         {}
+            /// Number of observations for the satellite.
+         std::size_t size() const
+         { return fd->numObs(isat); }
+            /// Observation \a iobs, indexed as the header obs types.
+         RinexDatum operator[](std::size_t iobs) const
+         { return fd->datum(isat, iobs); }
+      private:
+         const Rinex3ObsFlatData *fd;
+         std::size_t isat;
+      };
+
+         /** Iterator over the satellites of an epoch, dereferencing to
+          * a (RinexSatID, SatObs) pair just as a
+          * Rinex3ObsData::DataMap::const_iterator dereferences to a
+          * (RinexSatID, std::vector<RinexDatum>) pair. */
+      class const_iterator
+      {
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef std::pair<RinexSatID, SatObs> value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const value_type* pointer;
+         typedef const value_type& reference;
+         const_iterator(const Rinex3ObsFlatData* d = 0, std::size_t i = 0)
+               : fd(d), isat(i)
+         { load(); }
+         const value_type& operator*() const
+         { return current; }
+         const value_type* operator->() const
+         { return &current; }
+         const_iterator& operator++()
+         { isat++; load(); return *this; }
+         const_iterator operator++(int)
+         { const_iterator rv(*this); ++(*this); return rv; }
+         bool operator==(const const_iterator& right) const
+         { return (isat == right.isat) && (fd == right.fd); }
+         bool operator!=(const const_iterator& right) const
+         { return !(*this == right); }
+      private:
+         void load()
+         {
+            if ((fd != 0) && (isat < fd->sats.size()))
+               current = value_type(fd->sats[isat], SatObs(fd, isat));
+         }
+         const Rinex3ObsFlatData *fd;
+         std::size_t isat;
+         value_type current;
+      };
+
+         /// Compatibility view of the epoch as a container of satellites.
+      class ObsView
+      {
+      public:
+         ObsView(const Rinex3ObsFlatData* d)
+               : fd(d)
+         {}
+         const_iterator begin() const
+         { return const_iterator(fd, 0); }
+         const_iterator end() const
+         { return const_iterator(fd, fd->sats.size()); }
+            /// Return the position of \a sat, or end() if not present.
+         const_iterator find(const RinexSatID& sat) const
+         { return const_iterator(fd, fd->findSat(sat)); }
+         std::size_t size() const
+         { return fd->sats.size(); }
+         bool empty() const
+         { return fd->sats.empty(); }
+      private:
+         const Rinex3ObsFlatData *fd;
+      };
+
+         /// Constructor.
+      Rinex3ObsFlatData();
+
+         /// Destructor
+      virtual ~Rinex3ObsFlatData() {}
+
+         /// Time corresponding to the observations
+      CommonTime time;
+
+         /// Epoch flag, see Rinex3ObsData::epochFlag.
+      short epochFlag;
+
+         /// Number of satellites in this observation, except when
+         /// epochFlag=2-5, then number of auxiliary header records to follow.
+      short numSVs;
+
+      double clockOffset;        ///< optional clock offset in seconds
+
+      Rinex3ObsHeader auxHeader; ///< auxiliary header records (epochFlag 2-5)
+
+         /// Satellites in this epoch, in the order of the file.
+      std::vector<RinexSatID> sats;
+
+         /** Index in #sats of each satellite added by addSat(),
+          * indexed by RinexSatID::handle(), so findSat() need not
+          * search.  Entries are not cleared, so each is checked
+          * against #sats before it is used. */
+      std::vector<std::size_t> satIndex;
+
+         /** Index in the value arrays of the first observation for
+          * each satellite.  There is one more entry than there are
+          * satellites, so that the observations of satellite \c i
+          * are in [start[i], start[i+1]). */
+      std::vector<std::size_t> start;
+
+      std::vector<double> values;         ///< observation values
+      std::vector<short> lli;             ///< loss of lock indicators
+      std::vector<short> ssi;             ///< signal strength indicators
+      std::vector<unsigned char> blanks;  ///< BlankBits for each value
+
+         /// Remove all satellites and reset the epoch, keeping storage.
+      void clear();
+
+         /// Number of satellites in the epoch.
+      std::size_t numSats() const
+      { return sats.size(); }
+
+         /// Number of observations stored for satellite index \a isat.
+      std::size_t numObs(std::size_t isat) const
+      { return start[isat+1] - start[isat]; }
+
+         /// Observation value \a iobs of satellite index \a isat.
+      double value(std::size_t isat, std::size_t iobs) const
+      { return values[start[isat] + iobs]; }
+
+         /** Append a satellite with \a nobs observations, initialized
+          * to the same values as a default RinexDatum.
+          * @return the index of the new satellite. */
+      std::size_t addSat(const RinexSatID& sat, std::size_t nobs);
+
+         /** Return the index of satellite \a sat in #sats, or
+          * numSats() if it is not in this epoch.  If it appears more
+          * than once, the first is returned. */
+      std::size_t findSat(const RinexSatID& sat) const;
+
+         /// Return observation \a iobs of satellite index \a isat.
+      RinexDatum datum(std::size_t isat, std::size_t iobs) const;
+
+         /// Set observation \a iobs of satellite index \a isat.
+      void setDatum(std::size_t isat, std::size_t iobs, const RinexDatum& rd);
+
+         /** This method returns the RinexDatum of a given observation
+          *
+          * @param svID    Satellite whose observation we want to fetch.
+          * @param index   Index representing the observation type. It is
+          *                obtained from corresponding RINEX Observation Header
+          *                using method 'Rinex3ObsHeader::getObsIndex()'.
+          */
+      RinexDatum getObs( const RinexSatID& svID, std::size_t index ) const
+         throw(InvalidRequest);
+
+         /** This method returns the RinexDatum of a given observation
+          *
+          * @param svID  RinexSatID of satellite
+          * @param obsID RinexObsID  of the observation type.
+          * @param hdr   Rinex3ObsHeader for current RINEX file.
+          */
+      RinexDatum getObs( const RinexSatID& svID,
+                         const RinexObsID& obsID,
+                         const Rinex3ObsHeader& hdr ) const
+         throw(InvalidRequest);
+
+         /// Compatibility view for code that iterates Rinex3ObsData::obs.
+      ObsView obsView() const
+      { return ObsView(this); }
+
+         /// Copy this epoch into \a rod.
+      void toObsData(Rinex3ObsData& rod) const;
+
+         /// Replace the contents of this epoch with those of \a rod.
+      void fromObsData(const Rinex3ObsData& rod);
+
+         /// A Debug output function, as Rinex3ObsData::dump().
+      virtual void dump(std::ostream& s) const;
+
+   protected:
+
+         /// Writes the record using Rinex3ObsData::reallyPutRecord().
+      virtual void reallyPutRecord(FFStream& s) const
+         throw( std::exception, FFStreamError,
+                gpstk::StringUtils::StringException );
+
+         /** Obtain a RINEX 3 Observation record from the given
+          * FFStream.  See Rinex3ObsData::reallyGetRecord(), which
+          * this matches in behavior and exceptions.  RINEX 2 records
+          * are read with Rinex3ObsData and converted.
+          */
+      virtual void reallyGetRecord(FFStream& s)
+         throw( std::exception, FFStreamError,
+                gpstk::StringUtils::StringException );
+
+   }; // End of class 'Rinex3ObsFlatData'
+
+      //@}
+
+} // End of namespace gpstk
+
+#endif   // GPSTK_RINEX3OBSFLATDATA_HPP
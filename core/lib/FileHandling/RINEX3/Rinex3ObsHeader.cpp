@@ -1007,7 +1007,7 @@ namespace gpstk
          
       if(label == hsVersion)
       {
-         version  = asDouble(line.substr( 0,20));
+         version  = asDouble(line, 0, 20);
          fileType = strip(   line.substr(20,20));
          fileSys  = strip(   line.substr(40,20));
 
@@ -1076,58 +1076,58 @@ namespace gpstk
       }
       else if(label == hsAntennaPosition)
       {
-         antennaPosition[0] = asDouble(line.substr( 0,14));
-         antennaPosition[1] = asDouble(line.substr(14,14));
-         antennaPosition[2] = asDouble(line.substr(28,14));
+         antennaPosition[0] = asDouble(line, 0, 14);
+         antennaPosition[1] = asDouble(line, 14, 14);
+         antennaPosition[2] = asDouble(line, 28, 14);
          valid |= validAntennaPosition;
       }
       else if(label == hsAntennaDeltaHEN)
       {
-         antennaDeltaHEN[0] = asDouble(line.substr( 0,14));
-         antennaDeltaHEN[1] = asDouble(line.substr(14,14));
-         antennaDeltaHEN[2] = asDouble(line.substr(28,14));
+         antennaDeltaHEN[0] = asDouble(line, 0, 14);
+         antennaDeltaHEN[1] = asDouble(line, 14, 14);
+         antennaDeltaHEN[2] = asDouble(line, 28, 14);
          valid |= validAntennaDeltaHEN;
       }
       else if(label == hsAntennaDeltaXYZ)
       {
-         antennaDeltaXYZ[0] = asDouble(line.substr( 0,14));
-         antennaDeltaXYZ[1] = asDouble(line.substr(14,14));
-         antennaDeltaXYZ[2] = asDouble(line.substr(28,14));
+         antennaDeltaXYZ[0] = asDouble(line, 0, 14);
+         antennaDeltaXYZ[1] = asDouble(line, 14, 14);
+         antennaDeltaXYZ[2] = asDouble(line, 28, 14);
          valid |= validAntennaDeltaXYZ;
       }
       else if(label == hsAntennaPhaseCtr)
       {
          antennaSatSys  = strip(line.substr(0,2));
          antennaObsCode = strip(line.substr(2,3));
-         antennaPhaseCtr[0] = asDouble(line.substr( 5, 9));
-         antennaPhaseCtr[1] = asDouble(line.substr(14,14));
-         antennaPhaseCtr[2] = asDouble(line.substr(28,14));
+         antennaPhaseCtr[0] = asDouble(line, 5, 9);
+         antennaPhaseCtr[1] = asDouble(line, 14, 14);
+         antennaPhaseCtr[2] = asDouble(line, 28, 14);
          valid |= validAntennaPhaseCtr;
       }
       else if(label == hsAntennaBsightXYZ)
       {
-         antennaBsightXYZ[0] = asDouble(line.substr( 0,14));
-         antennaBsightXYZ[1] = asDouble(line.substr(14,14));
-         antennaBsightXYZ[2] = asDouble(line.substr(28,14));
+         antennaBsightXYZ[0] = asDouble(line, 0, 14);
+         antennaBsightXYZ[1] = asDouble(line, 14, 14);
+         antennaBsightXYZ[2] = asDouble(line, 28, 14);
          valid |= validAntennaBsightXYZ;
       }
       else if(label == hsAntennaZeroDirAzi)
       {
-         antennaZeroDirAzi = asDouble(line.substr(0,14));
+         antennaZeroDirAzi = asDouble(line, 0, 14);
          valid |= validAntennaBsightXYZ;
       }
       else if(label == hsAntennaZeroDirXYZ)
       {
-         antennaZeroDirXYZ[0] = asDouble(line.substr( 0,14));
-         antennaZeroDirXYZ[1] = asDouble(line.substr(14,14));
-         antennaZeroDirXYZ[2] = asDouble(line.substr(28,14));
+         antennaZeroDirXYZ[0] = asDouble(line, 0, 14);
+         antennaZeroDirXYZ[1] = asDouble(line, 14, 14);
+         antennaZeroDirXYZ[2] = asDouble(line, 28, 14);
          valid |= validAntennaBsightXYZ;
       }
       else if(label == hsCenterOfMass)
       {
-         centerOfMass[0] = asDouble(line.substr( 0,14));
-         centerOfMass[1] = asDouble(line.substr(14,14));
-         centerOfMass[2] = asDouble(line.substr(28,14));
+         centerOfMass[0] = asDouble(line, 0, 14);
+         centerOfMass[1] = asDouble(line, 14, 14);
+         centerOfMass[2] = asDouble(line, 28, 14);
          valid |= validCenterOfMass;
       }
       else if(label == hsNumObs)        // R2 only
@@ -1141,7 +1141,7 @@ namespace gpstk
             // process the first line
          if(!(valid & validNumObs))
          {
-            numObs = asInt(line.substr(0,6));
+            numObs = asInt(line, 0, 6);
             valid |= validNumObs;
          }
          
@@ -1160,7 +1160,7 @@ namespace gpstk
          string satSys = strip(line.substr(0,1));
          if (satSys != "")
          {
-            numObs = asInt(line.substr(3,3));
+            numObs = asInt(line, 3, 3);
             valid |= validSystemNumObs;
             satSysPrev = satSys;
          }
@@ -1184,8 +1184,8 @@ namespace gpstk
             // first time reading this
          if(!(valid & validWaveFact))
          {
-            wavelengthFactor[0] = asInt(line.substr(0,6));
-            wavelengthFactor[1] = asInt(line.substr(6,6));
+            wavelengthFactor[0] = asInt(line, 0, 6);
+            wavelengthFactor[1] = asInt(line, 6, 6);
             valid |= validWaveFact;
          }
          else
@@ -1194,9 +1194,9 @@ namespace gpstk
             const int maxSatsPerLine = 7;
             int Nsats;
             ExtraWaveFact ewf;
-            ewf.wavelengthFactor[0] = asInt(line.substr(0,6));
-            ewf.wavelengthFactor[1] = asInt(line.substr(6,6));
-            Nsats = asInt(line.substr(12,6));
+            ewf.wavelengthFactor[0] = asInt(line, 0, 6);
+            ewf.wavelengthFactor[1] = asInt(line, 6, 6);
+            Nsats = asInt(line, 12, 6);
                
             if(Nsats > maxSatsPerLine)   // > not >=
             {
@@ -1228,7 +1228,7 @@ namespace gpstk
       }
       else if(label == hsInterval)
       {
-         interval = asDouble(line.substr(0,10));
+         interval = asDouble(line, 0, 10);
          valid |= validInterval;
       }
       else if(label == hsFirstTime)
@@ -1243,7 +1243,7 @@ namespace gpstk
       }
       else if(label == hsReceiverOffset)
       {
-         receiverOffset = asInt(line.substr(0,6));
+         receiverOffset = asInt(line, 0, 6);
          valid |= validReceiverOffset;
       }
 
@@ -1270,8 +1270,8 @@ namespace gpstk
          static const int maxObsPerLine = 12;
 
          satSysTemp = strip(line.substr(0,1));
-         factor     = asInt(line.substr(2,4));
-         numObs     = asInt(line.substr(8,2));
+         factor     = asInt(line, 2, 4);
+         numObs     = asInt(line, 8, 2);
 
          int startPosition = 0;
 
@@ -1424,12 +1424,12 @@ namespace gpstk
       }
       else if(label == hsLeapSeconds)
       {
-         leapSeconds = asInt(line.substr(0,6));
+         leapSeconds = asInt(line, 0, 6);
          valid |= validLeapSeconds;
       }
       else if(label == hsNumSats)
       {
-         numSVs = asInt(line.substr(0,6)) ;
+         numSVs = asInt(line, 0, 6) ;
          valid |= validNumSats;
       }
       else if(label == hsPrnObs)
@@ -1463,7 +1463,7 @@ namespace gpstk
             numObsList = numObsForSat[PRN]; // grab the existing list
 
             for(j=0,i=numObsList.size(); j<maxObsPerLine && i<otmax; i++,j++)
-               numObsList.push_back(asInt(line.substr(6*j+6,6)));
+               numObsList.push_back(asInt(line, 6*j+6, 6));
 
             numObsForSat[PRN] = numObsList;
          }
@@ -1484,7 +1484,7 @@ namespace gpstk
             }
 
             for(i=0; i<maxObsPerLine && i<otmax; i++)
-               numObsList.push_back(asInt(line.substr(6*i+6,6)));
+               numObsList.push_back(asInt(line, 6*i+6, 6));
 
             numObsForSat[PRN] = numObsList;
 
@@ -2028,12 +2028,12 @@ namespace gpstk
       string tsys;
       TimeSystem ts;
    
-      year  = asInt(   line.substr(0,   6));
-      month = asInt(   line.substr(6,   6));
-      day   = asInt(   line.substr(12,  6));
-      hour  = asInt(   line.substr(18,  6));
-      min   = asInt(   line.substr(24,  6));
-      sec   = asDouble(line.substr(30, 13));
+      year  = asInt(   line, 0, 6);
+      month = asInt(   line, 6, 6);
+      day   = asInt(   line, 12, 6);
+      hour  = asInt(   line, 18, 6);
+      min   = asInt(   line, 24, 6);
+      sec   = asDouble(line, 30, 13);
       tsys  =          line.substr(48,  3) ;
 
       ts.fromString(tsys);
@@ -39,12 +39,14 @@
  * File stream for RINEX 3 observation file data.
  */
 
+#include <cstring>
 #include "Rinex3ObsStream.hpp"
 
 namespace gpstk
 {
    Rinex3ObsStream ::
    Rinex3ObsStream()
+         : memoryMapRequested(false)
    {
       init();
    }
@@ -53,7 +55,8 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const char* fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn, mode)
+         : FFTextStream(fn, mode),
+           memoryMapRequested(false)
    {
       init();
    }
@@ -62,7 +65,8 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const std::string fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn.c_str(), mode)
+         : FFTextStream(fn.c_str(), mode),
+           memoryMapRequested(false)
    {
       init();
    }
@@ -78,7 +82,12 @@ namespace gpstk
    open( const char* fn,
          std::ios::openmode mode )
    {
+      mappedFile.close();
       FFTextStream::open(fn, mode);
+      previousTime = CommonTime::BEGINNING_OF_TIME;
+      mapPos = 0;
+      if (memoryMapRequested)
+         useMemoryMap(true);
    }
 
 
@@ -88,6 +97,8 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
+      mapPos = 0;
    }
 
 
@@ -114,4 +125,73 @@ namespace gpstk
       return true;
    }
 
+
+   bool Rinex3ObsStream ::
+   useMemoryMap(bool enable)
+   {
+      memoryMapRequested = enable;
+      mappedFile.close();
+      if (enable && is_open() && !filename.empty())
+         mappedFile.open(filename);
+      return mappedFile.isOpen();
+   }
+
+
+   void Rinex3ObsStream ::
+   mappedGetLine( const char*& line,
+                  std::string::size_type& len,
+                  const bool expectEOF )
+      throw(EndOfFile, FFStreamError)
+   {
+      if (mapPos >= mappedFile.size())
+      {
+            // Set the same state and line count formattedGetLine
+            // would at EOF.
+         lineNumber++;
+         try
+         {
+            setstate(std::ios::eofbit | std::ios::failbit);
+         }
+         catch (std::exception&)
+         {
+         }
+         if (expectEOF)
+         {
+            EndOfFile err("EOF encountered");
+            GPSTK_THROW(err);
+         }
+         FFStreamError err("Unexpected EOF encountered");
+         GPSTK_THROW(err);
+      }
+
+      line = mappedFile.data() + mapPos;
+      std::string::size_type avail = mappedFile.size() - mapPos;
+      const char *eol = static_cast<const char*>(std::memchr(line,'\n',avail));
+      if (eol == NULL)
+      {
+         len = avail;
+         mapPos += avail;
+      }
+      else
+      {
+         len = eol - line;
+         mapPos += len + 1;
+      }
+
+         // Remove CR characters left over from windows files
+      while ((len > 0) && (line[len-1] == '\r'))
+         len--;
+         // same test as isprint() in the "C" locale
+      for (std::string::size_type i = 0; i < len; i++)
+      {
+         unsigned char c = static_cast<unsigned char>(line[i]);
+         if ((c < 0x20) || (c > 0x7e))
+         {
+            FFStreamError err("Non-text data in file.");
+            GPSTK_THROW(err);
+         }
+      }
+      lineNumber++;
+   }
+
 } // namespace gpstk
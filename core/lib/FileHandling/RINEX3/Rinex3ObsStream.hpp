@@ -48,6 +48,7 @@
 #include <string>
 
 #include "FFTextStream.hpp"
+#include "MemoryMappedFile.hpp"
 #include "Rinex3ObsHeader.hpp"
 
 namespace gpstk
@@ -58,6 +59,14 @@ namespace gpstk
       /**
        * This class reads RINEX 3 Obs files.
        *
+       * All state carried from one record to the next (the header,
+       * the time of the previous epoch, the memory-mapped read
+       * position) is held in the stream, not in Rinex3ObsData or in
+       * static variables, so independent streams may be read
+       * concurrently from different threads without locking, and one
+       * thread may alternate between several streams.  A single
+       * stream must not be used by more than one thread at a time.
+       *
        * @sa Rinex3ObsData and Rinex3ObsHeader.
        */
    class Rinex3ObsStream : public FFTextStream
@@ -110,12 +119,64 @@ namespace gpstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the last epoch read from a RINEX 2 file, used
+          * for records with epoch flag 2-4 which may omit the time. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+         /** Read RINEX 3 observation records directly from a
+          * memory-mapped image of the file instead of through the
+          * std::fstream buffer.  Records are parsed in place with
+          * fixed-column numeric conversions, which avoids the
+          * per-line and per-field string copies of the stream
+          * reader, and result in the same Rinex3ObsData.  The header
+          * and RINEX 2 files are still read through the stream, and
+          * writing is not affected.  The setting is retained when
+          * another file is opened.
+          * @param[in] enable true to use the memory-mapped reader,
+          *   false to go back to reading through the stream.
+          * @return true if the memory-mapped reader is in use, false
+          *   if it was disabled or the file could not be mapped, in
+          *   which case records are read through the stream. */
+      bool useMemoryMap(bool enable = true);
+
+         /// Return true if records are read from a memory-mapped file.
+      bool isMemoryMapped() const
+      { return mappedFile.isOpen(); }
+
+         /** The memory-mapped equivalent of formattedGetLine().
+          * Returns the line starting at mapPos and advances mapPos
+          * past its terminator.  No copy of the line is made.
+          * @param[out] line set to the first character of the line,
+          *   which is not NUL-terminated.
+          * @param[out] len set to the length of the line, excluding
+          *   the new-line and any carriage returns.
+          * @param[in] expectEOF set true if finding EOF on this read
+          *   is acceptable.
+          * @throw EndOfFile if \a expectEOF is true and an EOF is
+          *   encountered.
+          * @throw FFStreamError if EOF is found and \a expectEOF is
+          *   false, or the line contains non-text data. */
+      void mappedGetLine( const char*& line,
+                          std::string::size_type& len,
+                          const bool expectEOF = false )
+         throw(EndOfFile, FFStreamError);
+
+         /// Offset in the memory-mapped file of the next line to be
+         /// returned by mappedGetLine().
+      std::string::size_type mapPos;
+
    private:
          /// Initialize internal data structures.
       void init();
+
+         /// The file contents when using the memory-mapped reader.
+      MemoryMappedFile mappedFile;
+
+         /// True if useMemoryMap() has been enabled.
+      bool memoryMapRequested;
    }; // class 'Rinex3ObsStream'
 
       //@}
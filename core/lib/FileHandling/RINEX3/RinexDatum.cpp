@@ -63,41 +63,29 @@ namespace gpstk
    void RinexDatum ::
    fromString(const std::string& str)
    {
-      std::string tmpStr;
       GPSTK_ASSERT(str.length() == 16);
-      tmpStr = str.substr(0, 14);
-      if (tmpStr.find_last_not_of(" ") == std::string::npos)
-      {
-         data = 0.;
-         dataBlank = true;
-      }
-      else
-      {
-         data = StringUtils::asDouble(tmpStr);
-         dataBlank = false;
-      }
-      tmpStr = str.substr(14, 1);
-      if (tmpStr == " ")
-      {
-         lli = 0.;
-         lliBlank = true;
-      }
-      else
-      {
-         lli = StringUtils::asInt(tmpStr);
-         lliBlank = false;
-      }
-      tmpStr = str.substr(15, 1);
-      if (tmpStr == " ")
-      {
-         ssi = 0.;
-         ssiBlank = true;
-      }
-      else
+      fromString(str.c_str(), str.length());
+   }
+
+
+   void RinexDatum ::
+   fromString(const char* str, std::string::size_type len)
+   {
+      std::string::size_type dataLen = (len < 14 ? len : 14);
+      dataBlank = true;
+      for (std::string::size_type i = 0; i < dataLen; i++)
       {
-         ssi = StringUtils::asInt(tmpStr);
-         ssiBlank = false;
+         if (str[i] != ' ')
+         {
+            dataBlank = false;
+            break;
+         }
       }
+      data = (dataBlank ? 0. : StringUtils::asDouble(str, dataLen));
+      lliBlank = ((len < 15) || (str[14] == ' '));
+      lli = (lliBlank ? 0 : StringUtils::asInt(str+14, 1));
+      ssiBlank = ((len < 16) || (str[15] == ' '));
+      ssi = (ssiBlank ? 0 : StringUtils::asInt(str+15, 1));
    }
 
 
@@ -68,6 +68,15 @@ namespace gpstk
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse a RINEX OBS datum in a character buffer into data
+          * members without making any temporary strings.
+          * @param[in] str pointer to a RINEX-formatted datum.
+          * @param[in] len the number of characters available at \a
+          *   str.  Only the first 16 are used; if fewer than 16 are
+          *   available, the remainder is treated as blank, as is the
+          *   case for trailing fields on a truncated RINEX 3 line. */
+      void fromString(const char* str, std::string::size_type len);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
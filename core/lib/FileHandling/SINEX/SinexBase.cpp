@@ -305,9 +305,9 @@ namespace Sinex
          Exception  err("Invalid time syntax: " + other);
          GPSTK_THROW(err);
       }
-      year = asInt(other.substr(0, 2) );
-      doy  = asInt(other.substr(3, 3) );
-      sod  = asInt(other.substr(7, 5) );
+      year = asInt(other, 0, 2 );
+      doy  = asInt(other, 3, 3 );
+      sod  = asInt(other, 7, 5 );
    }
 
 }  // namespace Sinex
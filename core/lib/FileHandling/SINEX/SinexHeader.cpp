@@ -102,7 +102,7 @@ namespace Sinex
          dataTimeEnd = line.substr(45,12);
          obsCode = line[58];
          isValidObsCode(obsCode);
-         paramCount = asInt(line.substr(60,5) );
+         paramCount = asInt(line, 60, 5 );
          constraintCode = line[66];
          isValidConstraintCode(constraintCode);
          if (line.size() > 67)
@@ -507,13 +507,13 @@ namespace Sinex
          obsCode      = line[19];
          isValidObsCode(obsCode);
          siteDesc     = line.substr(21, 22);
-         longitudeDeg = asUnsigned(line.substr(44, 3) );
-         longitudeMin = asUnsigned(line.substr(48, 2) );
+         longitudeDeg = asUnsigned(line, 44, 3 );
+         longitudeMin = asUnsigned(line, 48, 2 );
          longitudeSec = asFloat(line.substr(51, 4) );
-         latitudeDeg  = asInt(line.substr(56, 3) );
-         latitudeMin  = asUnsigned(line.substr(60, 2) );
+         latitudeDeg  = asInt(line, 56, 3 );
+         latitudeMin  = asUnsigned(line, 60, 2 );
          latitudeSec  = asFloat(line.substr(63, 4) );
-         height       = asDouble(line.substr(68, 7) );
+         height       = asDouble(line, 68, 7 );
       }
       catch (Exception& exc)
       {
@@ -783,12 +783,12 @@ namespace Sinex
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
          antennaType = line.substr(1, 20);
          antennaSerialNo = line.substr(22, 5);
-         offsetA[0] = asDouble(line.substr(28, 6) );
-         offsetA[1] = asDouble(line.substr(35, 6) );
-         offsetA[2] = asDouble(line.substr(42, 6) );
-         offsetB[0] = asDouble(line.substr(49, 6) );
-         offsetB[1] = asDouble(line.substr(56, 6) );
-         offsetB[2] = asDouble(line.substr(63, 6) );
+         offsetA[0] = asDouble(line, 28, 6 );
+         offsetA[1] = asDouble(line, 35, 6 );
+         offsetA[2] = asDouble(line, 42, 6 );
+         offsetB[0] = asDouble(line, 49, 6 );
+         offsetB[1] = asDouble(line, 56, 6 );
+         offsetB[2] = asDouble(line, 63, 6 );
          antennaCalibration = line.substr(70, 10);
       }
       catch (Exception& exc)
@@ -878,9 +878,9 @@ namespace Sinex
          timeSince = line.substr(16,12);
          timeUntil = line.substr(29,12);
          refSystem = line.substr(42, 3);
-         eccentricity[0] = asDouble(line.substr(46, 8) );
-         eccentricity[1] = asDouble(line.substr(55, 8) );
-         eccentricity[2] = asDouble(line.substr(64, 8) );
+         eccentricity[0] = asDouble(line, 46, 8 );
+         eccentricity[1] = asDouble(line, 55, 8 );
+         eccentricity[2] = asDouble(line, 64, 8 );
       }
       catch (Exception& exc)
       {
@@ -1007,13 +1007,13 @@ namespace Sinex
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
          svCode     = line.substr(1, 4);
          freqCodeA  = line[6];
-         offsetA[2] = asDouble(line.substr(8, 6) );
-         offsetA[0] = asDouble(line.substr(15, 6) );
-         offsetA[1] = asDouble(line.substr(22, 6) );
+         offsetA[2] = asDouble(line, 8, 6 );
+         offsetA[0] = asDouble(line, 15, 6 );
+         offsetA[1] = asDouble(line, 22, 6 );
          freqCodeB  = line[29];
-         offsetB[2] = asDouble(line.substr(31, 6) );
-         offsetB[0] = asDouble(line.substr(38, 6) );
-         offsetB[1] = asDouble(line.substr(45, 6) );
+         offsetB[2] = asDouble(line, 31, 6 );
+         offsetB[0] = asDouble(line, 38, 6 );
+         offsetB[1] = asDouble(line, 45, 6 );
          antennaCalibration = line.substr(52, 10);
          pcvType    = line[63];
          pcvModel   = line[65];
@@ -1251,7 +1251,7 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         paramIndex   = asUnsigned(line.substr(1, 5) );
+         paramIndex   = asUnsigned(line, 1, 5 );
          paramType    = line.substr(7, 6);
          siteCode     = line.substr(14, 4);
          pointCode    = line.substr(19, 2);
@@ -1259,8 +1259,8 @@ namespace Sinex
          epoch = line.substr(27,12);
          paramUnits     = line.substr(40, 4);
          constraintCode = line[45];
-         paramEstimate  = asDouble(line.substr(47, 21) );
-         paramStdDev    = asDouble(line.substr(69, 11) );
+         paramEstimate  = asDouble(line, 47, 21 );
+         paramStdDev    = asDouble(line, 69, 11 );
       }
       catch (Exception& exc)
       {
@@ -1321,7 +1321,7 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         paramIndex = asUnsigned(line.substr(1, 5) );
+         paramIndex = asUnsigned(line, 1, 5 );
          paramType  = line.substr(7, 6);
          siteCode   = line.substr(14, 4);
          pointCode  = line.substr(19, 2);
@@ -1329,8 +1329,8 @@ namespace Sinex
          epoch      = line.substr(27,12);
          paramUnits     = line.substr(40, 4);
          constraintCode = line[45];
-         paramApriori   = asDouble(line.substr(47, 21) );
-         paramStdDev    = asDouble(line.substr(69, 11) );
+         paramApriori   = asDouble(line, 47, 21 );
+         paramStdDev    = asDouble(line, 69, 11 );
       }
       catch (Exception& exc)
       {
@@ -1384,11 +1384,11 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         row  = asUnsigned(line.substr(1, 5) );
-         col  = asUnsigned(line.substr(7, 5) );
-         val1 = asDouble(line.substr(13, 21) );
-         val2 = asDouble(line.substr(35, 21) );
-         val3 = asDouble(line.substr(57, 21) );
+         row  = asUnsigned(line, 1, 5 );
+         col  = asUnsigned(line, 7, 5 );
+         val1 = asDouble(line, 13, 21 );
+         val2 = asDouble(line, 35, 21 );
+         val3 = asDouble(line, 57, 21 );
       }
       catch (Exception& exc)
       {
@@ -1497,11 +1497,11 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         row  = asUnsigned(line.substr(1, 5) );
-         col  = asUnsigned(line.substr(7, 5) );
-         val1 = asDouble(line.substr(13, 21) );
-         val2 = asDouble(line.substr(35, 21) );
-         val3 = asDouble(line.substr(57, 21) );
+         row  = asUnsigned(line, 1, 5 );
+         col  = asUnsigned(line, 7, 5 );
+         val1 = asDouble(line, 13, 21 );
+         val2 = asDouble(line, 35, 21 );
+         val3 = asDouble(line, 57, 21 );
       }
       catch (Exception& exc)
       {
@@ -1615,7 +1615,7 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         paramIndex = asUnsigned(line.substr(1, 5) );
+         paramIndex = asUnsigned(line, 1, 5 );
          paramType  = line.substr(7, 6);
          siteCode   = line.substr(14, 4);
          pointCode  = line.substr(19, 2);
@@ -1623,7 +1623,7 @@ namespace Sinex
          epoch      = line.substr(27,12);
          paramUnits     = line.substr(40, 4);
          constraintCode = line[45];
-         value          = asDouble(line.substr(47, 21) );
+         value          = asDouble(line, 47, 21 );
       }
       catch (Exception& exc)
       {
@@ -1677,11 +1677,11 @@ namespace Sinex
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
-         row  = asUnsigned(line.substr(1, 5) );
-         col  = asUnsigned(line.substr(7, 5) );
-         val1 = asDouble(line.substr(13, 21) );
-         val2 = asDouble(line.substr(35, 21) );
-         val3 = asDouble(line.substr(57, 21) );
+         row  = asUnsigned(line, 1, 5 );
+         col  = asUnsigned(line, 7, 5 );
+         val1 = asDouble(line, 13, 21 );
+         val2 = asDouble(line, 35, 21 );
+         val3 = asDouble(line, 57, 21 );
       }
       catch (Exception& exc)
       {
@@ -79,12 +79,12 @@ namespace gpstk
          else               containsVelocity = false;
 
          // parse the rest of the line
-         int year = asInt(line.substr(3,4));
-         int month = asInt(line.substr(8,2));
-         int dom = asInt(line.substr(11,2));
-         int hour = asInt(line.substr(14,2));
-         int minute = asInt(line.substr(17,2));
-         double second = asInt(line.substr(20,10));
+         int year = asInt(line, 3, 4);
+         int month = asInt(line, 8, 2);
+         int dom = asInt(line, 11, 2);
+         int hour = asInt(line, 14, 2);
+         int minute = asInt(line, 17, 2);
+         double second = asInt(line, 20, 10);
          try {
             time = CivilTime(year, month, dom, hour, minute, second);
          }
@@ -92,7 +92,7 @@ namespace gpstk
             FFStreamError fe("Invalid time:" + string(1, line[0]));
             GPSTK_THROW(fe);
          }
-         numberOfEpochs = asInt(line.substr(32,7));
+         numberOfEpochs = asInt(line, 32, 7);
          dataUsed = line.substr(40,5);
          coordSystem = line.substr(46,5);
          orbitType = line.substr(52,3);
@@ -108,7 +108,7 @@ namespace gpstk
       if(debug) std::cout << "SP3 Header Line 2 " << line << std::endl;
       if (line[0]=='#' && line[1]=='#')                           // line 2
       {
-         epochInterval = asDouble(line.substr(24,14));
+         epochInterval = asDouble(line, 24, 14);
       }
       else
       {
@@ -148,7 +148,7 @@ namespace gpstk
                    // get the total number of svs on line 3
                 if (svLineCount == 1)
                 {
-                   numSVs = asInt(line.substr(3,3));
+                   numSVs = asInt(line, 3, 3);
                    svsAsWritten.resize(numSVs);
                 }
                 for(index = 9; index < 60; index += 3)
@@ -199,7 +199,7 @@ namespace gpstk
             {
                if (readSVs < numSVs)
                {
-                  satList[svsAsWritten[readSVs]] = asInt(line.substr(index,3));
+                  satList[svsAsWritten[readSVs]] = asInt(line, index, 3);
                   readSVs++;
                }
             }
@@ -242,8 +242,8 @@ namespace gpstk
       if (version == SP3c || version == SP3d) {
          if (line[0]=='%' && line[1]=='f')
          {
-            basePV = asDouble(line.substr(3,10));
-            baseClk = asDouble(line.substr(14,12));
+            basePV = asDouble(line, 3, 10);
+            baseClk = asDouble(line, 14, 12);
          }
          else
          {
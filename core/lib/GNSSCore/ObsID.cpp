@@ -87,9 +87,12 @@ namespace gpstk
       if (!char2ot.count(ot) || !char2cb.count(cb) || !char2tc.count(tc))
          idCreator(strID.substr(i,3));
 
-      type = char2ot[ ot ];
-      band = char2cb[ cb ];
-      code = char2tc[ tc ];
+         // Use find() rather than operator[] so that known codes never
+         // modify the maps, which keeps this safe to call from several
+         // threads at once.
+      type = char2ot.find(ot)->second;
+      band = char2cb.find(cb)->second;
+      code = char2tc.find(tc)->second;
 
       /// This next block takes care of fixing up the codes that are reused
       /// between the various signals
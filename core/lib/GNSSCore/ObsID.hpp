@@ -298,7 +298,13 @@ namespace gpstk
           * exception is thrown and the existing definitions are not
           * touched. If not then each character of the specification
           * is examined and the new ones are created. The returned
-          * ObsID can then be examined for the assigned values. */
+          * ObsID can then be examined for the assigned values.
+          *
+          * The identifier tables are shared by all threads.  Creating
+          * ObsIDs from codes that are already defined only reads
+          * them, but newID() and the string constructor given an
+          * unknown code modify them, and must not run concurrently
+          * with any other use of ObsID. */
       static ObsID newID(const std::string& id,
                          const std::string& desc="")
          throw(InvalidParameter);
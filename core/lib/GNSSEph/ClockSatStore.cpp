@@ -69,51 +69,156 @@ namespace gpstk
    //  c) checkInterval is true and the interval is larger than maxInterval
    ClockRecord ClockSatStore::getValue(const SatID& sat, const CommonTime& ttag)
       const throw(InvalidRequest)
+   {
+      try {
+         ClockRecord rec;
+         InterpWork work;
+         interpolate(sat, ttag, rec, work);
+         return rec;
+      }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
+
+   // Return values for one satellite at each of several times, as getValue().
+   unsigned int ClockSatStore::getValues(const SatID& sat,
+                                         const vector<CommonTime>& ttags,
+                                         vector<ClockRecord>& recs,
+                                         vector<bool>& valid)
+      const throw()
+   {
+      unsigned int nvalid(0);
+      InterpWork work;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            interpolate(sat, ttags[i], recs[i], work);
+            valid[i] = true;
+            nvalid++;
+         }
+         catch(Exception& e) { }
+      }
+      return nvalid;
+   }
+
+   // Return values for each of several (satellite,time) pairs, as getValue().
+   unsigned int ClockSatStore::getValues(const vector<SatID>& sats,
+                                         const vector<CommonTime>& ttags,
+                                         vector<ClockRecord>& recs,
+                                         vector<bool>& valid)
+      const throw(InvalidRequest)
+   {
+      if(sats.size() != ttags.size()) {
+         InvalidRequest e("Satellite and time lists differ in size");
+         GPSTK_THROW(e);
+      }
+
+      unsigned int nvalid(0);
+      InterpWork work;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            interpolate(sats[i], ttags[i], recs[i], work);
+            valid[i] = true;
+            nvalid++;
+         }
+         catch(Exception& e) { }
+      }
+      return nvalid;
+   }
+
+   // Compute the interpolated record for sat at ttag, for getValue() and
+   // getValues(). The table interval is copied into work.data, one row of N
+   // points each for bias, drift and accel, and the Lagrange weights are
+   // computed once and applied to every row. The interval is kept in work, and
+   // used again while ttag stays between its central points, so that
+   // getValues() looks up the table once per interval rather than once per time.
+   void ClockSatStore::interpolate(const SatID& sat, const CommonTime& ttag,
+                                   ClockRecord& rec, InterpWork& work)
+      const throw(InvalidRequest)
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
 
-         bool isExact;
-         ClockRecord rec;
+         bool isExact(false);
          DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
-
-         isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveClockDrift);
-         if(isExact && haveClockDrift) {
-            rec = it1->second;
-            return rec;
+         size_t k,N,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+
+         // getTableInterval() would return the same interval, not exact
+         if(work.valid && work.sat == sat &&
+            (work.it1+Nlow)->first < ttag && ttag < (work.it1+Nhi)->first)
+         {
+            it1 = work.it1;
+            it2 = work.it2;
+            N = it2-it1+1;
          }
+         else {
+            work.valid = false;
+            isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveClockDrift);
+            if(isExact && haveClockDrift) {
+               rec = it1->second;
+               return;
+            }
 
-         // pull data out of the data table
-         size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
-         CommonTime ttag0(it1->first);
-         vector<double> times,biases,drifts,accels,sig_biases,sig_drifts,sig_accels;
+            N = it2-it1+1;
+            if(interpType == 2 && N < 4) {
+               InvalidRequest e("Lagrange interpolation needs at least 4 points,"
+                                " interpolation order is too small");
+               GPSTK_THROW(e);
+            }
 
-         kt=it1; n=0;
-         while(1) {
-            // find index of matching time tag
-            if(isExact && ABS(kt->first-ttag) < 1.e-8) Nmatch = n;
-            times.push_back(kt->first - ttag0);    // sec
-            biases.push_back(kt->second.bias);     // sec
-            drifts.push_back(kt->second.drift);    // sec/sec
-            accels.push_back(kt->second.accel);    // sec/sec^2
-            sig_biases.push_back(kt->second.sig_bias);     // sec
-            sig_drifts.push_back(kt->second.sig_drift);    // sec/sec
-            sig_accels.push_back(kt->second.sig_accel);    // sec/sec^2
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
+            // pull data out of the data table
+            CommonTime ttag0(it1->first);
+            work.times.resize(N);
+            work.data.resize(3*N);
+            double *times(&work.times[0]);
+            double *biases(&work.data[0]), *drifts(&work.data[N]),
+                   *accels(&work.data[2*N]);
+
+            for(k=0, kt=it1; k<N; k++, ++kt) {
+               // find index of matching time tag
+               if(isExact && ABS(kt->first-ttag) < 1.e-8) Nmatch = k;
+               times[k] = kt->first - ttag0;      // sec
+               biases[k] = kt->second.bias;       // sec
+               drifts[k] = kt->second.drift;      // sec/sec
+               accels[k] = kt->second.accel;      // sec/sec^2
+            }
+
+            // keep it for the next call, unless it is centered on ttag
+            if(!isExact) {
+               work.valid = true;
+               work.sat = sat;
+               work.it1 = it1;
+               work.it2 = it2;
+            }
+         }
+         CommonTime ttag0(it1->first);
+         const double *times(&work.times[0]);
+         const double *biases(&work.data[0]), *drifts(&work.data[N]),
+                      *accels(&work.data[2*N]);
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+         if(isExact && Nmatch == Nhalf-1) { Nlow++; Nhi++; }
+         const ClockRecord& recLow((it1+Nlow)->second);
+         const ClockRecord& recHi((it1+Nhi)->second);
+         const ClockRecord& recMatch((it1+Nmatch)->second);
 
          // interpolate
+         const double *L(0), *Lp(0);
+         double dt(ttag-ttag0), slope;
+         if(interpType == 2) {
+            // Lagrange interpolation weights, shared by all the data
+            LagrangeWeights(work.times, dt, work.L, work.Lp);
+            L = &work.L[0];
+            Lp = &work.Lp[0];
+         }
+
          rec.accel = rec.sig_accel = 0.0;              // defaults
-         double dt(ttag-ttag0), err, slope;
          if(haveClockDrift) {
             if(interpType == 2) {
                // Lagrange interpolation
-               rec.bias = LagrangeInterpolation(times,biases,dt,err);      // sec
-               rec.drift = LagrangeInterpolation(times,drifts,dt,err);     // sec/sec
+               rec.bias = WeightedSum(L, biases, N);      // sec
+               rec.drift = WeightedSum(L, drifts, N);     // sec/sec
             }
             else {
                // linear interpolation
@@ -126,15 +231,16 @@ namespace gpstk
 
             // sigmas
             if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
+               rec.sig_bias = recMatch.sig_bias;
             else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
-            rec.sig_drift = RSS(sig_drifts[Nhi],sig_drifts[Nlow]);
+               rec.sig_bias = RSS(recHi.sig_bias,recLow.sig_bias);
+            rec.sig_drift = RSS(recHi.sig_drift,recLow.sig_drift);
          }
          else {                              // must interpolate biases to get drift
             if(interpType == 2) {
                // Lagrange interpolation
-               LagrangeInterpolation(times,biases,dt,rec.bias,rec.drift);
+               rec.bias = WeightedSum(L, biases, N);      // sec
+               rec.drift = WeightedSum(Lp, biases, N);    // sec/sec
             }
             else {
                // linear interpolation
@@ -145,9 +251,9 @@ namespace gpstk
 
             // sigmas
             if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
+               rec.sig_bias = recMatch.sig_bias;
             else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
+               rec.sig_bias = RSS(recHi.sig_bias,recLow.sig_bias);
             // TD ?
             rec.sig_drift = rec.sig_bias/(times[Nhi]-times[Nlow]);
          }
@@ -155,7 +261,7 @@ namespace gpstk
          if(haveClockAccel) {
             if(interpType == 2) {
                // Lagrange interpolation
-               rec.accel = LagrangeInterpolation(times,accels,dt,err);  // sec/sec^2
+               rec.accel = WeightedSum(L, accels, N);     // sec/sec^2
             }
             else {
                // linear interpolation
@@ -166,14 +272,14 @@ namespace gpstk
 
             // sigma
             if(isExact)
-               rec.sig_accel = sig_accels[Nmatch];
+               rec.sig_accel = recMatch.sig_accel;
             else
-               rec.sig_accel = RSS(sig_accels[Nhi],sig_accels[Nlow]);
+               rec.sig_accel = RSS(recHi.sig_accel,recLow.sig_accel);
          }
          else if(haveClockDrift) {              // must interpolate drift to get accel
             if(interpType == 2) {
-               // Lagrange interpolation  (err is a dummy here)
-               LagrangeInterpolation(times,drifts,dt,err,rec.accel);
+               // Lagrange interpolation
+               rec.accel = WeightedSum(Lp, drifts, N);    // sec/sec^2
             }
             else {
                // linear interpolation                                  // sec/sec^2
@@ -184,8 +290,6 @@ namespace gpstk
             rec.sig_accel = rec.sig_drift/(times[Nhi]-times[Nlow]);
          }
          // else zero
-
-         return rec;
       }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
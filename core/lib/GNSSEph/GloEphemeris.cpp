@@ -97,58 +97,66 @@ namespace gpstk
       }
 
          // Get the data out of the GloRecord structure
-      double px( x[0] );   // X coordinate (km)
-      double vx( v[0] );   // X velocity   (km/s)
       double ax( a[0] );   // X acceleration (km/s^2)
-      double py( x[1] );   // Y coordinate
-      double vy( v[1] );   // Y velocity
       double ay( a[1] );   // Y acceleration
-      double pz( x[2] );   // Z coordinate
-      double vz( v[2] );   // Z velocity
       double az( a[2] );   // Z acceleration
+      double px, py, pz, vx, vy, vz;
 
          // We will need some PZ-90 ellipsoid parameters
       PZ90Ellipsoid pz90;
       double we( pz90.angVelocity() );
 
-         // Get sidereal time at Greenwich at 0 hours UT
-      double gst( getSidTime( ephTime ) );
-      double s0( gst*PI/12.0 );
-      YDSTime ytime( ephTime );
-      double numSeconds( ytime.sod );
-      double s( s0 + we*numSeconds );
-      double cs( std::cos(s) );
-      double ss( std::sin(s) );
-
-         // Initial state matrix
-      Vector<double> initialState(6), accel(3), dxt1(6), dxt2(6), dxt3(6),
-                     dxt4(6), tempRes(6);
-
-         // Get the reference state out of GloEphemeris object data. Values
-         // must be rotated from PZ-90 to an absolute coordinate system
-         // Initial x coordinate (m)
-      initialState(0)  = (px*cs - py*ss);
-         // Initial y coordinate
-      initialState(2)  = (px*ss + py*cs);
-         // Initial z coordinate
-      initialState(4)  = pz;
-
-         // Initial x velocity   (m/s)
-      initialState(1)  = (vx*cs - vy*ss - we*initialState(2) );
-         // Initial y velocity
-      initialState(3)  = (vx*ss + vy*cs + we*initialState(0) );
-         // Initial z velocity
-      initialState(5)  = vz;
-
+         // Get the reference state, rotated from PZ-90 to an absolute
+         // coordinate system, and the sidereal time at Greenwich at 0 hours
+         // UT; these are computed once for this data by initCache().
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      initCache();
 
          // Integrate satellite state to desired epoch using the given step
+      int dir( 0 );
       double rkStep( step );
 
-      if ( (epoch - ephTime) < 0.0 ) rkStep = step*(-1.0);
-      CommonTime workEpoch( ephTime );
+      if ( (epoch - ephTime) < 0.0 )
+      {
+         rkStep = step*(-1.0);
+         dir = 1;
+      }
+
+         // Start from the furthest saved state that the integration from
+         // ephTime passes through on its way to the desired epoch.
+      const std::vector<RKState>& cps( cache.checkpoints[dir] );
+      const RKState *start( &cps[0] );
+      for( size_t k = cps.size()-1; k > 0; k-- )
+      {
+         if( dir == 0 ? !(cps[k].epoch > epoch) : !(cps[k].epoch < epoch) )
+         {
+            start = &cps[k];
+            break;
+         }
+      }
+      const RKState& last( cache.lastState[dir] );
+      if( last.nsteps > start->nsteps &&
+          (dir == 0 ? !(last.epoch > epoch) : !(last.epoch < epoch)) )
+      {
+         start = &last;
+      }
+
+         // Initial state and auxiliary vectors
+      FixedVector<double,6> initialState( start->state ), dxt1, dxt2, dxt3,
+                            dxt4;
+      FixedVector<double,3> accel;
+      double numSeconds( start->numSeconds );
+      CommonTime workEpoch( start->epoch );
+      long nsteps( start->nsteps );
+      double s( cache.s0 + we*numSeconds );
+      double cs( std::cos(s) );
+      double ss( std::sin(s) );
 
       double tolerance( 1e-9 );
-      bool done( false );
+         // A saved state may already be at the desired epoch
+      bool done( nsteps > 0 && std::fabs(epoch - workEpoch) < tolerance );
+         // False once a partial step has been taken
+      bool onGrid( true );
       while (!done)
       {
 
@@ -157,56 +165,73 @@ namespace gpstk
          if( rkStep > 0.0 )
          {
             if( (workEpoch + rkStep) > epoch )
+            {
                rkStep = (epoch - workEpoch);
+               onGrid = false;
+            }
          }
          else
          {
             if ( (workEpoch + rkStep) < epoch )
+            {
                rkStep = (epoch - workEpoch);
+               onGrid = false;
+            }
          }
 
          numSeconds += rkStep;
-         s = s0 + we*( numSeconds );
+         s = cache.s0 + we*( numSeconds );
          cs = std::cos(s);
          ss = std::sin(s);
 
             // Accelerations are computed once per iteration
-         accel(0) = ax*cs - ay*ss;
-         accel(1) = ax*ss + ay*cs;
-         accel(2) = az;
+         accel[0] = ax*cs - ay*ss;
+         accel[1] = ax*ss + ay*cs;
+         accel[2] = az;
 
          dxt1 = derivative( initialState, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt1(j)/2.0;
-
-         dxt2 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt2(j)/2.0;
+         dxt2 = derivative( initialState + rkStep*dxt1/2.0, accel );
+         dxt3 = derivative( initialState + rkStep*dxt2/2.0, accel );
+         dxt4 = derivative( initialState + rkStep*dxt3, accel );
 
-         dxt3 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt3(j);
+         initialState = initialState + rkStep * ( dxt1
+                      + 2.0 * ( dxt2 + dxt3 ) + dxt4 ) / 6.0;
 
-         dxt4 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            initialState(j) = initialState(j) + rkStep * ( dxt1(j)
-                            + 2.0 * ( dxt2(j) + dxt3(j) ) + dxt4(j) ) / 6.0;
+         workEpoch += rkStep;
 
+            // Save the states on the grid of whole steps from ephTime
+         if( onGrid )
+         {
+            nsteps++;
+            RKState& ls( cache.lastState[dir] );
+            if( nsteps > ls.nsteps )
+            {
+               ls.state = initialState;
+               ls.numSeconds = numSeconds;
+               ls.epoch = workEpoch;
+               ls.nsteps = nsteps;
+               if( nsteps % checkpointSteps == 0 &&
+                   nsteps / checkpointSteps ==
+                   static_cast<long>(cache.checkpoints[dir].size()) )
+               {
+                  cache.checkpoints[dir].push_back(ls);
+               }
+            }
+         }
 
             // If we are within tolerance of the target time, we are done.
-         workEpoch += rkStep;
          if ( std::fabs(epoch - workEpoch ) < tolerance )
             done = true;
 
       }  // End of 'while (!done)...'
 
 
-      px = initialState(0);
-      py = initialState(2);
-      pz = initialState(4);
-      vx = initialState(1);
-      vy = initialState(3);
-      vz = initialState(5);
+      px = initialState[0];
+      py = initialState[2];
+      pz = initialState[4];
+      vx = initialState[1];
+      vy = initialState[3];
+      vz = initialState[5];
 
       sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
       sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
@@ -404,6 +429,78 @@ namespace gpstk
    }  // End of method 'GloEphemeris::setRecord()'
 
 
+      // Set up the integration cache for the current data, unless it
+      // already was.
+   void GloEphemeris::initCache() const
+   {
+
+      if( cache.valid && cache.ephTime == ephTime && cache.step == step &&
+          cache.x[0] == x[0] && cache.x[1] == x[1] && cache.x[2] == x[2] &&
+          cache.v[0] == v[0] && cache.v[1] == v[1] && cache.v[2] == v[2] &&
+          cache.a[0] == a[0] && cache.a[1] == a[1] && cache.a[2] == a[2] )
+      {
+         return;
+      }
+
+         // Get the data out of the GloRecord structure
+      double px( x[0] );   // X coordinate (km)
+      double vx( v[0] );   // X velocity   (km/s)
+      double py( x[1] );   // Y coordinate
+      double vy( v[1] );   // Y velocity
+      double pz( x[2] );   // Z coordinate
+      double vz( v[2] );   // Z velocity
+
+         // We will need some PZ-90 ellipsoid parameters
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+         // Get sidereal time at Greenwich at 0 hours UT
+      double gst( getSidTime( ephTime ) );
+      cache.s0 = gst*PI/12.0;
+      YDSTime ytime( ephTime );
+      double numSeconds( ytime.sod );
+      double s( cache.s0 + we*numSeconds );
+      double cs( std::cos(s) );
+      double ss( std::sin(s) );
+
+      RKState init;
+
+         // Get the reference state out of GloEphemeris object data. Values
+         // must be rotated from PZ-90 to an absolute coordinate system
+         // Initial x coordinate (m)
+      init.state[0]  = (px*cs - py*ss);
+         // Initial y coordinate
+      init.state[2]  = (px*ss + py*cs);
+         // Initial z coordinate
+      init.state[4]  = pz;
+
+         // Initial x velocity   (m/s)
+      init.state[1]  = (vx*cs - vy*ss - we*init.state[2] );
+         // Initial y velocity
+      init.state[3]  = (vx*ss + vy*cs + we*init.state[0] );
+         // Initial z velocity
+      init.state[5]  = vz;
+
+      init.numSeconds = numSeconds;
+      init.epoch = ephTime;
+      init.nsteps = 0;
+
+      for( int dir = 0; dir < 2; dir++ )
+      {
+         cache.checkpoints[dir].assign(1, init);
+         cache.lastState[dir] = init;
+      }
+
+      cache.x = x;
+      cache.v = v;
+      cache.a = a;
+      cache.ephTime = ephTime;
+      cache.step = step;
+      cache.valid = true;
+
+   }  // End of method 'GloEphemeris::initCache()'
+
+
       // Compute true sidereal time  (in hours) at Greenwich at 0 hours UT.
    double GloEphemeris::getSidTime( const CommonTime& time ) const
    {
@@ -438,9 +535,9 @@ namespace gpstk
 
 
       // Function implementing the derivative of GLONASS orbital model.
-   Vector<double> GloEphemeris::derivative( const Vector<double>& inState,
-                                            const Vector<double>& accel )
-      const
+   FixedVector<double,6>
+   GloEphemeris::derivative( const FixedVector<double,6>& inState,
+                             const FixedVector<double,3>& accel ) const
    {
 
          // We will need some important PZ90 ellipsoid values
@@ -450,12 +547,12 @@ namespace gpstk
       const double ae( pz90.a_km() );
 
          // Let's start getting the current satellite position and velocity
-      double  x( inState(0) );          // X coordinate
-      //double vx( inState(1) );          // X velocity
-      double  y( inState(2) );          // Y coordinate
-      //double vy( inState(3) );          // Y velocity
-      double  z( inState(4) );          // Z coordinate
-      //double vz( inState(5) );          // Z velocity
+      double  x( inState[0] );          // X coordinate
+      //double vx( inState[1] );          // X velocity
+      double  y( inState[2] );          // Y coordinate
+      //double vy( inState[3] );          // Y velocity
+      double  z( inState[4] );          // Z coordinate
+      //double vz( inState[5] );          // Z velocity
 
       double r2( x*x + y*y + z*z );
       double r( std::sqrt(r2) );
@@ -470,23 +567,23 @@ namespace gpstk
       double cmz( k1*(3.0-5.0*zr2) );
       double k2(cm-xmu);
 
-      double gloAx( k2*xr + accel(0) );
-      double gloAy( k2*yr + accel(1) );
-      double gloAz( (cmz-xmu)*zr + accel(2) );
+      double gloAx( k2*xr + accel[0] );
+      double gloAy( k2*yr + accel[1] );
+      double gloAz( (cmz-xmu)*zr + accel[2] );
 
-      Vector<double> dxt(6, 0.0);
+      FixedVector<double,6> dxt;
 
          // Let's insert data related to X coordinates
-      dxt(0) = inState(1);       // Set X'  = Vx
-      dxt(1) = gloAx;            // Set Vx' = gloAx
+      dxt[0] = inState[1];       // Set X'  = Vx
+      dxt[1] = gloAx;            // Set Vx' = gloAx
 
          // Let's insert data related to Y coordinates
-      dxt(2) = inState(3);       // Set Y'  = Vy
-      dxt(3) = gloAy;            // Set Vy' = gloAy
+      dxt[2] = inState[3];       // Set Y'  = Vy
+      dxt[3] = gloAy;            // Set Vy' = gloAy
 
          // Let's insert data related to Z coordinates
-      dxt(4) = inState(5);       // Set Z'  = Vz
-      dxt(5) = gloAz;            // Set Vz' = gloAz
+      dxt[4] = inState[5];       // Set Z'  = Vz
+      dxt[5] = gloAz;            // Set Vz' = gloAz
 
       return dxt;
 
@@ -41,11 +41,13 @@
 #define GPSTK_GLOEPHEMERIS_HPP
 
 #include <iostream>
+#include <mutex>
+#include <vector>
+#include "FixedVector.hpp"
 #include "Triple.hpp"
 #include "Xvt.hpp"
 #include "CommonTime.hpp"
 #include "PZ90Ellipsoid.hpp"
-#include "Vector.hpp"
 #include "YDSTime.hpp"
 
 namespace gpstk
@@ -58,6 +60,17 @@ namespace gpstk
        * Ephemeris information for a single GLONASS satellite.  This class
        * encapsulates the ephemeris navigation message and provides functions
        * to handle the ephemerides.
+       *
+       * The orbit is found by Runge-Kutta integration from the ephemeris
+       * epoch.  To avoid repeating the integration for every request, the
+       * object keeps the integrated state every few steps, and the last state
+       * reached, in each direction from the epoch, and continues from the
+       * nearest of them.  The states lie on the same grid of steps as an
+       * integration from the epoch, so the results are identical, whatever
+       * the order of the requests.  The saved states are updated by the
+       * const method svXvt() under a mutex, so one GloEphemeris object (e.g.
+       * in a store) may be evaluated by several threads at once.  A copy
+       * starts with no saved states.
        */
    class GloEphemeris : public Xvt
    {
@@ -249,9 +262,72 @@ namespace gpstk
       double getSidTime( const CommonTime& time ) const;
 
 
-         /// Function implementing the derivative of GLONASS orbital model.
-      Vector<double> derivative( const Vector<double>& inState,
-                                 const Vector<double>& accel ) const;
+         /** Function implementing the derivative of GLONASS orbital model.
+          *
+          * @param inState  State (x,vx,y,vy,z,vz) in the inertial frame.
+          * @param accel    Luni-solar accelerations (x,y,z).
+          * @return Derivative of inState.
+          */
+      FixedVector<double,6> derivative( const FixedVector<double,6>& inState,
+                                        const FixedVector<double,3>& accel )
+         const;
+
+
+         /// State of the Runge-Kutta integration at a point of its grid.
+      struct RKState
+      {
+         FixedVector<double,6> state; ///< x,vx,y,vy,z,vz, inertial frame
+         double numSeconds;   ///< seconds of day, for the Earth rotation
+         CommonTime epoch;    ///< epoch of the state
+         long nsteps;         ///< number of whole steps from ephTime
+      };
+
+         /// Number of steps between the states kept in #checkpoints.
+      static const long checkpointSteps = 30;
+
+         /** Set up (or check) the integration cache for the current data.
+          * The caller must hold cache.mtx. */
+      void initCache() const;
+
+         /** The integration cache: the states saved along the integration,
+          * with the data from which they were computed, and a mutex that
+          * serializes their use.  Copying or assigning a cache does not copy
+          * its contents, which the source may be updating in another thread;
+          * the copy is simply invalid, and is rebuilt when first used. */
+      struct IntegrationCache
+      {
+         IntegrationCache() : valid(false) {}
+         IntegrationCache(const IntegrationCache&) : valid(false) {}
+         IntegrationCache& operator=(const IntegrationCache&)
+         {
+            std::lock_guard<std::mutex> lock(mtx);
+            valid = false;
+            return *this;
+         }
+
+            /// True if the cache was computed from the current data.
+         bool valid;
+
+            /// Values of the data from which the cache was computed.
+         Triple x, v, a;
+         CommonTime ephTime;
+         double step;
+
+            /// Sidereal angle at 0h UT on the day of ephTime (radians).
+         double s0;
+
+            /** States at every checkpointSteps steps from ephTime
+             * (element k is after k*checkpointSteps steps); index 0 is
+             * forward in time and index 1 backward. */
+         std::vector<RKState> checkpoints[2];
+
+            /// The furthest state reached in each direction.
+         RKState lastState[2];
+
+            /// Serializes the use of all of the above.
+         std::mutex mtx;
+      };
+      mutable IntegrationCache cache;
 
 
 
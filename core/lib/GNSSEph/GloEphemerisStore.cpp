@@ -155,7 +155,9 @@ namespace gpstk
       }
 
          // We now have the proper reference data record. Let's use it
-      GloEphemeris data( i->second );
+         // in place, so that it continues its integration from the
+         // states it saved in earlier calls
+      const GloEphemeris& data( i->second );
 
          // Compute the satellite position, velocity and clock offset
       sv = data.svXvt( epoch );
@@ -229,7 +231,9 @@ namespace gpstk
          }
 
             // We now have the proper reference data record. Let's use it
-         GloEphemeris data(i->second);
+            // in place, so that it continues its integration from the
+            // states it saved in earlier calls
+         const GloEphemeris& data(i->second);
 
             // Compute the satellite position, velocity and clock offset
          rv = data.svXvt(epoch);
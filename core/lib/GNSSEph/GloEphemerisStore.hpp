@@ -64,6 +64,12 @@ namespace gpstk
 
       /**
        * This adds the interface to get GLONASS broadcast ephemeris information
+       *
+       * getXvt() and computeXvt() use the stored GloEphemeris objects in
+       * place, so each continues its orbit integration from the previous
+       * requests for its satellite (see GloEphemeris).  The saved states
+       * are guarded by a mutex in each GloEphemeris, so a store that is not
+       * being modified may be read by several threads at once.
        */
    class GloEphemerisStore : public XvtStore<SatID>
    {
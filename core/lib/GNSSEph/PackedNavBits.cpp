@@ -39,6 +39,7 @@
  * Engineering units navigation message abstraction.
  */
 #include <math.h>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -53,23 +54,27 @@ namespace gpstk
 {
    using namespace std;
    PackedNavBits::PackedNavBits()
-                 : transmitTime(CommonTime::BEGINNING_OF_TIME),
-                   parityStatus(psUnknown),
-                   bits(900),
-                   bits_used(0),
+                 : parityStatus(psUnknown),
                    rxID(""),
-                   xMitCoerced(false)
+                   transmitTime(CommonTime::BEGINNING_OF_TIME),
+                   bits((900+63)/64),
+                   bits_size(900),
+                   bits_used(0),
+                   xMitCoerced(false),
+                   bitsCacheValid(false)
    {
       transmitTime.setTimeSystem(TimeSystem::GPS);
    }
    PackedNavBits::PackedNavBits(const SatID& satSysArg, 
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
-                                  xMitCoerced(false)
+                                  bits((900+63)/64),
+                                  bits_size(900),
+                                  bits_used(0),
+                                  xMitCoerced(false),
+                                  bitsCacheValid(false)
    {
       satSys = satSysArg;
       obsID = obsIDArg;
@@ -81,11 +86,13 @@ namespace gpstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
-                                  xMitCoerced(false)
+                                  bits((900+63)/64),
+                                  bits_size(900),
+                                  bits_used(0),
+                                  xMitCoerced(false),
+                                  bitsCacheValid(false)
    {
       satSys = satSysArg;
       obsID = obsIDArg;
@@ -99,11 +106,13 @@ namespace gpstk
                                 const NavID& navIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
-                                  xMitCoerced(false)
+                                  bits((900+63)/64),
+                                  bits_size(900),
+                                  bits_used(0),
+                                  xMitCoerced(false),
+                                  bitsCacheValid(false)
    {
       satSys = satSysArg;
       obsID = obsIDArg;
@@ -115,6 +124,7 @@ namespace gpstk
 
       // Copy constructor
    PackedNavBits::PackedNavBits(const PackedNavBits& right)
+      : bitsCacheValid(false)
    {
       satSys = right.satSys; 
       obsID  = right.obsID;
@@ -122,12 +132,14 @@ namespace gpstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
+      bits_size = 0;
+      resizeBits(bits_used);
       parityStatus = right.parityStatus;
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
+      size_t numWords = std::min(bits.size(), right.bits.size());
+      std::copy(right.bits.begin(), right.bits.begin() + numWords,
+                bits.begin());
+         // re-establish the zero bits past the end
+      resizeBits(bits_used);
       xMitCoerced = right.xMitCoerced;
    }
  
@@ -185,7 +197,9 @@ namespace gpstk
    
    void PackedNavBits::clearBits()
    {
+      bitsCacheValid = false;
       bits.clear();
+      bits_size = 0;
       bits_used = 0;
    }
 
@@ -224,20 +238,81 @@ namespace gpstk
                                       const int numBits ) const
       throw(InvalidParameter)                                    
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (stop>bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GPSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
+      if (numBits<=0)
+         return 0;
+         // Only the last 64 bits of a longer field fit in the result.
+      if (numBits>64)
+         return peekBits(stop-64, 64);
+      return peekBits(startBit, numBits);
+   }
+
+   uint64_t PackedNavBits::peekBits(const size_t startBit,
+                                    const int numBits) const
+   {
+      size_t ndx = startBit >> 6;
+      unsigned offset = startBit & 63;
+         // Left justify the field, pulling in the rest from the next
+         // word if it spans a word boundary.
+      uint64_t temp = bits[ndx] << offset;
+      if (offset + numBits > 64)
+         temp |= bits[ndx+1] >> (64 - offset);
+      return temp >> (64 - numBits);
+   }
+
+   void PackedNavBits::putBits(const size_t startBit,
+                               const uint64_t value,
+                               const int numBits)
+   {
+      if (numBits<=0)
+         return;
+      bitsCacheValid = false;
+      size_t start = startBit;
+      int count = numBits;
+         // Bits beyond the 64 available in value are zero.
+      while (count>64)
+      {
+         int n = std::min(count-64, 64);
+         putBits(start, 0, n);
+         start += n;
+         count -= n;
+      }
+      if (start+count > bits_size)
+         resizeBits(start+count);
+
+      size_t ndx = start >> 6;
+      unsigned offset = start & 63;
+      uint64_t mask = (count==64) ? ~uint64_t(0)
+                                  : ((uint64_t(1) << count) - 1);
+      uint64_t val = value & mask;
+      if (offset + count <= 64)
       {
-         temp <<= 1;
-         if (bits[i]) temp++;
+         unsigned shift = 64 - offset - count;
+         bits[ndx] = (bits[ndx] & ~(mask << shift)) | (val << shift);
       }
-      return( temp ); 
+      else
+      {
+            // split across two words
+         unsigned nlow = offset + count - 64;
+         bits[ndx] = ((bits[ndx] >> (64 - offset)) << (64 - offset)) |
+            (val >> nlow);
+         bits[ndx+1] = (bits[ndx+1] & (~uint64_t(0) >> nlow)) |
+            (val << (64 - nlow));
+      }
+   }
+
+   void PackedNavBits::resizeBits(const size_t newSize)
+   {
+      bitsCacheValid = false;
+      bits.resize((newSize+63) >> 6, 0);
+      if (newSize & 63)
+         bits.back() &= ~(~uint64_t(0) >> (newSize & 63));
+      bits_size = newSize;
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit, 
@@ -456,7 +531,7 @@ namespace gpstk
 
    bool PackedNavBits::asBool( const unsigned bitNum) const
    {
-      return bits[bitNum]; 
+      return getBit(bitNum); 
    }
 
 
@@ -598,31 +673,18 @@ namespace gpstk
    {
       int old_bits_used = bits_used;
       bits_used += right.bits_used;
-      bits.resize(bits_used);
+      resizeBits(bits_used);
       
-      for (int i=0;i<right.bits_used;i++)
+      for (int i=0;i<right.bits_used;i+=64)
       {
-         bits[i+old_bits_used] = right.bits[i];
+         int n = std::min(right.bits_used-i, 64);
+         putBits(old_bits_used+i, right.peekBits(i,n), n);
       }
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
-
-      for (int i=0; i<numBits; ++i)
-      {
-         bits[ndx] = false;
-         if (value & mask) 
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
-      }
+      putBits(bits_used, value, numBits);
       bits_used += numBits;
    }
 
@@ -633,9 +695,8 @@ namespace gpstk
    // in which left has a FALSE whereas right has a TRUE starting at the 
    // lowest index and scanning to the maximum index.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation 
-   // is probably not the fastest.  Since we are scanning a bit array rather 
-   // than testing a series of unsigned ints.
+   // As the bits are stored left justified, comparing the words as
+   // unsigned integers gives the same result as the bit-by-bit scan.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -643,43 +704,64 @@ namespace gpstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should 
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<bits.size();i++)
       {
-         if (bits[i]==false && right.bits[i]==true)
-         //if (bits[i]<right.bits[i])
-         {
-            return true;
-         }
-         if (bits[i]==true && right.bits[i]==false)
+         if (bits[i]!=right.bits[i])
          {
-            return false;
+            return bits[i]<right.bits[i];
          }
       }
       return false;
    }
 
+   std::size_t PackedNavBits::hashBits() const
+   {
+         // FNV-1a over the words, folded to size_t
+      uint64_t hash = 14695981039346656037ULL;
+      hash = (hash ^ bits_size) * 1099511628211ULL;
+      for (size_t i=0;i<bits.size();i++)
+      {
+         hash = (hash ^ bits[i]) * 1099511628211ULL;
+      }
+      return (std::size_t)(hash ^ (hash >> 32));
+   }
+
+   const std::vector<bool>& PackedNavBits::getBits() const
+   {
+      if (!bitsCacheValid)
+      {
+         bitsCache = getBitsCopy();
+         bitsCacheValid = true;
+      }
+      return bitsCache;
+   }
+
+   std::vector<bool> PackedNavBits::getBitsCopy() const
+   {
+      std::vector<bool> rv(bits_size);
+      for (size_t i=0;i<bits_size;i++)
+      {
+         rv[i] = getBit(i);
+      }
+      return rv;
+   }
+
    void PackedNavBits::invert( )
    {
-         // Each bit is either 1 or 0.
-         // Starting with 1 and subtracting the 
-         // current value will yield the inverse
-         //   
-         //  Input    Equation     Result
-         //    1       1 - 1          0
-         //    0       1 - 0          1
-         //
-         // This accomplishes the purpose without incurring
-         // the cost of a conditional statement.
-      for (int i=0;i<bits.size();i++)
+      bitsCacheValid = false;
+      for (size_t i=0;i<bits.size();i++)
       {
-         bits[i] = 1 - bits[i];
+         bits[i] = ~bits[i];
       }
+         // keep the bits past the end zero
+      if (bits_size & 63)
+         bits.back() &= ~(~uint64_t(0) >> (bits_size & 63));
    } 
 
       /**
@@ -704,9 +786,10 @@ namespace gpstk
       short finalBit = endBit;
       if (finalBit==-1) finalBit = bits_used - 1;
 
-      for (short i=startBit; i<=finalBit; i++)
+      for (int i=startBit; i<=finalBit; i+=64)
       {
-         bits[i] = from.bits[i];
+         int n = std::min(finalBit-i+1, 64);
+         putBits(i, from.asUint64_t(i,n), n);
       }
    }
 
@@ -737,20 +820,7 @@ namespace gpstk
          GPSTK_THROW(exc);
       }
 
-      size_t ndx = startBit;
-      uint64_t mask = 0x0000000000000001L; 
-
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; i++)
-      {
-         bits[ndx] = false;
-         if (out & mask)
-         {
-            bits[ndx] = true;
-         }
-         mask >>= 1;
-         ndx++;
-      }
+      putBits(startBit, out, numBits);
    }
 
 
@@ -765,7 +835,7 @@ namespace gpstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -828,10 +898,10 @@ namespace gpstk
       int numBitInWord = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (getBit(i)) word++;
        
          numBitInWord++;
          if (numBitInWord >= 32)
@@ -867,10 +937,10 @@ namespace gpstk
       int bit_count    = 0; 
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (getBit(i)) word++;
        
          numBitInWord++;
          if (numBitInWord >= numBitsPerWord)
@@ -884,7 +954,7 @@ namespace gpstk
             //but ONLY if there are more bits left to put on the next line.
             if (word_count>0 && 
                 word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;        
+                (i+1) < bits_size) s << endl;        
          }
       }
          // Need to check if there is a partial word in the buffer
@@ -894,7 +964,7 @@ namespace gpstk
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size()); 
+      return(bits_size); 
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -947,19 +1017,27 @@ namespace gpstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them. 
-      if (bits.size()!=right.bits.size()) return false; 
+      if (bits_size!=right.bits_size) return false; 
 
       short startBit = startBitA;
       short endBit = endBitA; 
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
-
-      for (int i=startBit;i<=endBit;i++)
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
+      if (startBit<0 || endBit<startBit) return true;
+
+         // Compare whole words, masking off the bits outside
+         // [startBit,endBit] in the first and last words.
+      size_t first = startBit >> 6;
+      size_t last = endBit >> 6;
+      for (size_t i=first;i<=last;i++)
       {
-         if (bits[i]!=right.bits[i])
+         uint64_t mask = ~uint64_t(0);
+         if (i==first) mask >>= (startBit & 63);
+         if (i==last) mask &= ~uint64_t(0) << (63 - (endBit & 63));
+         if ((bits[i] ^ right.bits[i]) & mask)
          {
             return false;
          }
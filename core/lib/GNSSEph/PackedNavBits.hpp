@@ -58,6 +58,16 @@ namespace gpstk
    /// @ingroup ephemcalc 
    //@{
 
+      /**
+       * Navigation message bits along with the metadata identifying
+       * where and when they were collected.
+       *
+       * The bits are stored left justified in 64-bit words (bit 0 is
+       * the most significant bit of the first word), so fields are
+       * extracted and inserted with shifts and masks and messages are
+       * compared and hashed a word at a time rather than bit by bit.
+       * Storage bits beyond getNumBits() are kept zero.
+       */
    class PackedNavBits
    {
    public:
@@ -356,6 +366,14 @@ namespace gpstk
           */
       bool operator<(const PackedNavBits& right) const; 
 
+         /**
+          * Return a hash of the bit contents (not the metadata).
+          * Objects for which matchBits(right) is true have the same
+          * hash, so this may be used to bucket messages before a full
+          * comparison.
+          */
+      std::size_t hashBits() const;
+
          /**
           *  Bitwise invert contents of this object.
           */
@@ -423,8 +441,15 @@ namespace gpstk
        void setXmitCoerced(bool tf=true) {xMitCoerced=tf;}
        bool isXmitCoerced() const {return xMitCoerced;}
 
-      const std::vector<bool>& getBits() const
-      { return bits; }
+         /** Return the bits, one element per bit.  The vector is
+          * unpacked from the stored words on the first call after the
+          * bits change, and the reference stays valid until the bits
+          * next change.  Use getBitsCopy() where the object is read by
+          * more than one thread. */
+      const std::vector<bool>& getBits() const;
+
+         /// Return a copy of the bits, one element per bit.
+      std::vector<bool> getBitsCopy() const;
 
          /** Indicate the status of parity/CRC checking.  Must be
           * explicitly set after construction, no parity checking is
@@ -437,17 +462,39 @@ namespace gpstk
       NavID navID;             /**< Defines the navigation message tracked */ 
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+      std::vector<uint64_t> bits; /**< Holds the packed data,
+                                       left justified */
+      size_t bits_size;        /**< Number of bits held in bits[] */
       int bits_used;
       
       bool xMitCoerced;        /**< Used to indicate that the transmit
                                     time is NOT directly derived from
                                     the SOW in the message */
 
+      mutable std::vector<bool> bitsCache; /**< Unpacked bits for getBits() */
+      mutable bool bitsCacheValid;         /**< bitsCache matches bits */
+
          /** Unpack the bits */
       uint64_t asUint64_t(const int startBit, const int numBits ) const 
          throw(InvalidParameter);
 
+         /** Return up to 64 bits starting at startBit, right
+          * justified.  No range checking is performed. */
+      uint64_t peekBits(const size_t startBit, const int numBits) const;
+
+         /** Store the numBits least significant bits of value
+          * starting at startBit, growing the storage if needed. */
+      void putBits(const size_t startBit, const uint64_t value,
+                   const int numBits);
+
+         /** Change the number of bits held, zeroing any bits
+          * beyond the new size. */
+      void resizeBits(const size_t newSize);
+
+         /** Return a single bit.  No range checking is performed. */
+      bool getBit(const size_t ndx) const
+      { return ((bits[ndx >> 6] >> (63 - (ndx & 63))) & 1) != 0; }
+
          /** Pack the bits */
       void addUint64_t( const uint64_t value, const int numBits );
 
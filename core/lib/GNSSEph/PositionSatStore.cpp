@@ -94,72 +94,166 @@ namespace gpstk
       const throw(InvalidRequest)
    {
       try {
-         bool isExact;
-         int i;
          PositionRecord rec;
-         DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
+         InterpWork work;
+         interpolate(sat, ttag, rec, work);
+         return rec;
+      }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
 
-         isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity);
-         if(isExact && haveVelocity) {
-            rec = it1->second;
-            return rec;
+   // Return values for one satellite at each of several times, as getValue().
+   unsigned int PositionSatStore::getValues(const SatID& sat,
+                                            const vector<CommonTime>& ttags,
+                                            vector<PositionRecord>& recs,
+                                            vector<bool>& valid)
+      const throw()
+   {
+      unsigned int nvalid(0);
+      InterpWork work;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            interpolate(sat, ttags[i], recs[i], work);
+            valid[i] = true;
+            nvalid++;
          }
+         catch(Exception& e) { }
+      }
+      return nvalid;
+   }
 
-         // pull data out of the data table
-         size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
-         CommonTime ttag0(it1->first);
-         vector<double> times,P[3],V[3],A[3],sigP[3],sigV[3],sigA[3];
+   // Return values for each of several (satellite,time) pairs, as getValue().
+   unsigned int PositionSatStore::getValues(const vector<SatID>& sats,
+                                            const vector<CommonTime>& ttags,
+                                            vector<PositionRecord>& recs,
+                                            vector<bool>& valid)
+      const throw(InvalidRequest)
+   {
+      if(sats.size() != ttags.size()) {
+         InvalidRequest e("Satellite and time lists differ in size");
+         GPSTK_THROW(e);
+      }
 
-         kt = it1; n=0;
-         while(1) {
-            // find index matching ttag
-            if(isExact && ABS(kt->first - ttag) < 1.e-8)
-               Nmatch = n;
-            times.push_back(kt->first - ttag0);          // sec
-            for(i=0; i<3; i++) {
-               P[i].push_back(kt->second.Pos[i]);
-               V[i].push_back(kt->second.Vel[i]);
-               A[i].push_back(kt->second.Acc[i]);
-               sigP[i].push_back(kt->second.sigPos[i]);
-               sigV[i].push_back(kt->second.sigVel[i]);
-               sigA[i].push_back(kt->second.sigAcc[i]);
+      unsigned int nvalid(0);
+      InterpWork work;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            interpolate(sats[i], ttags[i], recs[i], work);
+            valid[i] = true;
+            nvalid++;
+         }
+         catch(Exception& e) { }
+      }
+      return nvalid;
+   }
+
+   // Compute the interpolated record for sat at ttag, for getValue() and
+   // getValues(). The table interval is copied into work.data, one row of N
+   // points for each component, and the Lagrange weights are computed once and
+   // applied to every row. The interval is kept in work, and used again while
+   // ttag stays between its central points, so that getValues() looks up the
+   // table once per interval rather than once per time.
+   void PositionSatStore::interpolate(const SatID& sat, const CommonTime& ttag,
+                                      PositionRecord& rec, InterpWork& work)
+      const throw(InvalidRequest)
+   {
+      try {
+         bool isExact(false);
+         int i;
+         DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
+         size_t k,N,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+
+         // getTableInterval() would return the same interval, not exact
+         if(work.valid && work.sat == sat &&
+            (work.it1+Nlow)->first < ttag && ttag < (work.it1+Nhi)->first)
+         {
+            it1 = work.it1;
+            it2 = work.it2;
+            N = it2-it1+1;
+         }
+         else {
+            work.valid = false;
+            isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity);
+            if(isExact && haveVelocity) {
+               rec = it1->second;
+               return;
             }
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+            N = it2-it1+1;
+            if(N < 4) {
+               InvalidRequest e("Lagrange interpolation needs at least 4 points,"
+                                " interpolation order is too small");
+               GPSTK_THROW(e);
+            }
+
+            // pull data out of the data table
+            CommonTime ttag0(it1->first);
+            work.times.resize(N);
+            work.data.resize(9*N);
+            double *P(&work.data[0]), *V(&work.data[3*N]), *A(&work.data[6*N]);
+
+            for(k=0, kt=it1; k<N; k++, ++kt) {
+               // find index matching ttag
+               if(isExact && ABS(kt->first - ttag) < 1.e-8)
+                  Nmatch = k;
+               work.times[k] = kt->first - ttag0;          // sec
+               for(i=0; i<3; i++) {
+                  P[i*N+k] = kt->second.Pos[i];
+                  V[i*N+k] = kt->second.Vel[i];
+                  A[i*N+k] = kt->second.Acc[i];
+               }
+            }
+
+            // keep it for the next call, unless it is centered on ttag
+            if(!isExact) {
+               work.valid = true;
+               work.sat = sat;
+               work.it1 = it1;
+               work.it2 = it2;
+            }
+         }
+         CommonTime ttag0(it1->first);
+         const double *P(&work.data[0]), *V(&work.data[3*N]), *A(&work.data[6*N]);
+
+         if(isExact && Nmatch == Nhalf-1) { Nlow++; Nhi++; }
+         const PositionRecord& recLow((it1+Nlow)->second);
+         const PositionRecord& recHi((it1+Nhi)->second);
+         const PositionRecord& recMatch((it1+Nmatch)->second);
 
          // Lagrange interpolation
+         const double *L, *Lp;
+         double dt(ttag-ttag0);                 // dt in seconds
+         LagrangeWeights(work.times, dt, work.L, work.Lp);
+         L = &work.L[0];
+         Lp = &work.Lp[0];
+
          rec.sigAcc = rec.Acc = Triple(0,0,0);        // default
-         double dt(ttag-ttag0), err;           // dt in seconds
          if(haveVelocity) {
             for(i=0; i<3; i++) {
                // interpolate the positions
-               rec.Pos[i] = LagrangeInterpolation(times,P[i],dt,err);
-               if(haveAcceleration) {
-                  // interpolate velocities and acclerations
-                  rec.Vel[i] = LagrangeInterpolation(times,V[i],dt,err);
-                  rec.Acc[i] = LagrangeInterpolation(times,A[i],dt,err);
-               }
-               else {
-                  // interpolate velocities(dm/s) to get V and A
-                  LagrangeInterpolation(times,V[i],dt,rec.Vel[i],rec.Acc[i]);
-                  rec.Acc[i] *= 0.1;      // dm/s/s -> m/s/s
-               }
+               rec.Pos[i] = WeightedSum(L, P+i*N, N);
+               // interpolate velocities
+               rec.Vel[i] = WeightedSum(L, V+i*N, N);
+               if(haveAcceleration)
+                  rec.Acc[i] = WeightedSum(L, A+i*N, N);
+               else        // differentiate velocities(dm/s) to get A
+                  rec.Acc[i] = 0.1 * WeightedSum(Lp, V+i*N, N);  // ->m/s/s
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
-                  rec.sigVel[i] = sigV[i][Nmatch];
-                  if(haveAcceleration) rec.sigAcc[i] = sigA[i][Nmatch];
+                  rec.sigPos[i] = recMatch.sigPos[i];
+                  rec.sigVel[i] = recMatch.sigVel[i];
+                  if(haveAcceleration) rec.sigAcc[i] = recMatch.sigAcc[i];
                }
                else {
                   // TD is this sigma related to 'err' in the Lagrange call?
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
-                  rec.sigVel[i] = RSS(sigV[i][Nhi],sigV[i][Nlow]);
+                  rec.sigPos[i] = RSS(recHi.sigPos[i],recLow.sigPos[i]);
+                  rec.sigVel[i] = RSS(recHi.sigVel[i],recLow.sigVel[i]);
                   if(haveAcceleration)
-                     rec.sigAcc[i] = RSS(sigA[i][Nhi],sigA[i][Nlow]);
+                     rec.sigAcc[i] = RSS(recHi.sigAcc[i],recLow.sigAcc[i]);
                }
                // else Acc=sig_Acc=0   // TD can we do better?
             }
@@ -167,20 +261,19 @@ namespace gpstk
          else {               // no V data - must interpolate position to get velocity
             for(i=0; i<3; i++) {
                // interpolate positions(km) to get P and V
-               LagrangeInterpolation(times,P[i],dt,rec.Pos[i],rec.Vel[i]);
-               rec.Vel[i] *= 10000.;         // km/sec -> dm/sec
+               rec.Pos[i] = WeightedSum(L, P+i*N, N);
+               rec.Vel[i] = 10000. * WeightedSum(Lp, P+i*N, N);  // km/s -> dm/s
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
+                  rec.sigPos[i] = recMatch.sigPos[i];
                }
                else {
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
+                  rec.sigPos[i] = RSS(recHi.sigPos[i],recLow.sigPos[i]);
                }
                // TD
                rec.sigVel[i] = 0.0;
             }
          }
-         return rec;
       }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
@@ -43,6 +43,7 @@
 #define GPSTK_POSITION_SAT_STORE_INCLUDE
 
 #include <map>
+#include <vector>
 #include <iostream>
 
 #include "TabularSatStore.hpp"
@@ -117,6 +118,30 @@ namespace gpstk
          /// Store half the interpolation order, for convenience
       unsigned int Nhalf;
 
+         /** Work space for interpolate(), reused from one call to the
+          * next.  When valid, times and data hold the table interval
+          * [it1,it2] of sat, which interpolate() uses again, without
+          * calling getTableInterval(), for any time strictly between
+          * its two central points. */
+      struct InterpWork
+      {
+         InterpWork() : valid(false) {}
+         std::vector<double> times;    ///< table times - first time (sec)
+         std::vector<double> data;     ///< tabulated data, one row each
+         std::vector<double> L, Lp;    ///< Lagrange weights
+         bool valid;                   ///< times and data hold [it1,it2]
+         SatID sat;                    ///< satellite of the interval
+         DataTableIterator it1, it2;   ///< the interval
+      };
+
+         /** Compute the interpolated record for sat at ttag; the
+          * implementation of getValue() and getValues().
+          * @throw InvalidRequest as getValue(), or if there are fewer
+          *   than 4 points for Lagrange interpolation */
+      void interpolate(const SatID& sat, const CommonTime& ttag,
+                       PositionRecord& rec, InterpWork& work)
+         const throw(InvalidRequest);
+
          // member functions
    public:
 
@@ -153,6 +178,39 @@ namespace gpstk
       PositionRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** Return values for one satellite at each of several times,
+          * as getValue() would.  The table interval and interpolation
+          * weights found for each time are shared by all the
+          * components of the record, and work space by all the
+          * times, so this is considerably faster than calling
+          * getValue() in a loop, e.g. over a time grid.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttags the times (CommonTime) of interest
+          * @param[out] recs PositionRecord for each of ttags
+          * @param[out] valid for each of ttags, false if the record
+          *   could not be computed (where getValue() would throw)
+          * @return the number of valid records */
+      unsigned int getValues(const SatID& sat,
+                             const std::vector<CommonTime>& ttags,
+                             std::vector<PositionRecord>& recs,
+                             std::vector<bool>& valid)
+         const throw();
+
+         /** Return values for each of several (satellite,time) pairs,
+          * as getValue() would; see getValues(sat,ttags,recs,valid).
+          * @param[in] sats the SatIDs of interest
+          * @param[in] ttags the times of interest, one for each of sats
+          * @param[out] recs PositionRecord for each pair
+          * @param[out] valid for each pair, false if the record
+          *   could not be computed
+          * @return the number of valid records
+          * @throw InvalidRequest if sats and ttags differ in size */
+      unsigned int getValues(const std::vector<SatID>& sats,
+                             const std::vector<CommonTime>& ttags,
+                             std::vector<PositionRecord>& recs,
+                             std::vector<bool>& valid)
+         const throw(InvalidRequest);
+
          /** Return the position for the given satellite at the given time
           * @param[in] sat the SatID of the satellite of interest
           * @param[in] ttag the time (CommonTime) of interest
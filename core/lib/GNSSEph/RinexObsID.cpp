@@ -39,24 +39,204 @@
  * gpstk::RinexObsID - Identifies types of observations
  */
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
 #include "RinexObsID.hpp"
 #include "RinexSatID.hpp"
 #include "StringUtils.hpp"
 
+namespace
+{
+      /** The interned RinexObsIDs, see RinexObsID::handle().
+       * Lookups do not lock: each entry of the text index and each
+       * block of RinexObsIDs is written, under the lock, before it is
+       * published by an atomic store, and is never changed after. */
+   struct RinexObsIDTable
+   {
+         /// Size of the text index, a power of 2.
+      static const unsigned TextSize = 4096;
+         /// Number of RinexObsIDs in each block.
+      static const unsigned BlockSize = 256;
+         /// Most blocks.
+      static const unsigned MaxBlocks = 64;
+
+      RinexObsIDTable()
+            : count(0)
+      {
+         for(unsigned i = 0; i < TextSize; i++)
+            text[i].store(0, std::memory_order_relaxed);
+         for(unsigned i = 0; i < MaxBlocks; i++)
+            blocks[i].store(NULL, std::memory_order_relaxed);
+      }
+
+      ~RinexObsIDTable()
+      {
+         for(unsigned i = 0; i < MaxBlocks; i++)
+            delete [] blocks[i].load(std::memory_order_relaxed);
+      }
+
+         /// Find key in the text index, returning its handle or -1.
+      int find(uint32_t key) const
+      {
+         for(unsigned i = 0; i < TextSize; i++) {
+            uint64_t e = text[(key + i) & (TextSize-1)].load(
+               std::memory_order_acquire);
+            if(e == 0)
+               return -1;
+            if(static_cast<uint32_t>(e >> 32) == key)
+               return static_cast<int>(e & 0xffffffff) - 1;
+         }
+         return -1;
+      }
+
+         /// Add key to the text index, if there is room.  Call with
+         /// the lock held.
+      void add(uint32_t key, int h)
+      {
+         for(unsigned i = 0; i < TextSize; i++) {
+            std::atomic<uint64_t>& slot(text[(key + i) & (TextSize-1)]);
+            if(slot.load(std::memory_order_relaxed) == 0) {
+               slot.store((static_cast<uint64_t>(key) << 32) | (h + 1),
+                          std::memory_order_release);
+               return;
+            }
+         }
+      }
+
+         /// The RinexObsID with handle h, which must have been
+         /// published.
+      const gpstk::RinexObsID& at(int h) const
+      {
+         return blocks[h / BlockSize].load(std::memory_order_acquire)
+            [h % BlockSize];
+      }
+
+      std::mutex mtx;
+         /** Handle + 1 of each specifier seen, in the low 32 bits,
+          * keyed by its characters, one byte each, in the high 32
+          * bits.  Open addressed; 0 marks an empty entry. */
+      std::atomic<uint64_t> text[TextSize];
+         /// RinexObsID for each handle, in blocks of BlockSize.
+      std::atomic<gpstk::RinexObsID*> blocks[MaxBlocks];
+         /// Number of handles published.
+      std::atomic<int> count;
+         /// Handle for each distinct RinexObsID.  Used with the lock
+         /// held.
+      std::map<gpstk::ObsID, int> idIndex;
+   };
+
+      // A function-local static, so the table is ready whenever it
+      // is first used, including during static initialization.
+   RinexObsIDTable& rinexObsIDTable()
+   {
+      static RinexObsIDTable table;
+      return table;
+   }
+}
+
 namespace gpstk
 {
    /// Construct this object from the string specifier
    RinexObsID::RinexObsID(const std::string& strID) throw(InvalidParameter)
    {
+      try {
+         intern(strID, *this);
+      }
+      catch(InvalidParameter& ip) { GPSTK_RETHROW(ip); }
+   }
+
+
+   int RinexObsID::handle(const std::string& strID) throw(InvalidParameter)
+   {
+      RinexObsID rid;
+      try {
+         return intern(strID, rid);
+      }
+      catch(InvalidParameter& ip) { GPSTK_RETHROW(ip); }
+   }
+
+
+   RinexObsID RinexObsID::fromHandle(int h) throw(InvalidParameter)
+   {
+      RinexObsIDTable& table(rinexObsIDTable());
+      if(h < 0 || h >= table.count.load(std::memory_order_acquire)) {
+         InvalidParameter ip("Invalid RinexObsID handle " +
+                             StringUtils::asString(h));
+         GPSTK_THROW(ip);
+      }
+      return table.at(h);
+   }
+
+
+   int RinexObsID::intern(const std::string& strID, RinexObsID& rid)
+      throw(InvalidParameter)
+   {
+         // Only 3 and 4 character specifiers are valid, and those
+         // fit the key exactly.  A 4 character specifier cannot start
+         // with a NUL, so it never matches a 3 character one.  0 marks
+         // an empty entry, so it is not used as a key.
+      std::string::size_type len(strID.length());
+      bool keyed((len == 3) || (len == 4 && strID[0] != '\0'));
+      uint32_t key(0);
+      if(keyed)
+         for(std::string::size_type i = 0; i < len; i++)
+            key = (key << 8) | static_cast<unsigned char>(strID[i]);
+      keyed = keyed && (key != 0);
+
+      RinexObsIDTable& table(rinexObsIDTable());
+      if(keyed) {
+         int h = table.find(key);
+         if(h >= 0) {
+            rid = table.at(h);
+            return h;
+         }
+      }
+
+      std::lock_guard<std::mutex> lock(table.mtx);
+         // another thread may have added it since
+      if(keyed) {
+         int h = table.find(key);
+         if(h >= 0) {
+            rid = table.at(h);
+            return h;
+         }
+      }
+
       if(!isValidRinexObsID(strID)) {
          InvalidParameter ip(strID + " is not a valid RinexObsID");
          GPSTK_THROW(ip);
       }
-      try {
-         ObsID obsid(strID);
-         *this = RinexObsID(obsid.type, obsid.band, obsid.code);
+         // ObsID(std::string) may add to the ObsID maps (see
+         // ObsID::idCreator), which the lock also serializes.
+      ObsID obsid(strID);
+      rid = RinexObsID(obsid.type, obsid.band, obsid.code);
+
+      int h;
+      std::map<ObsID, int>::const_iterator iit = table.idIndex.find(rid);
+      if(iit != table.idIndex.end())
+         h = iit->second;
+      else {
+         h = table.count.load(std::memory_order_relaxed);
+         unsigned b = h / RinexObsIDTable::BlockSize;
+         if(b >= RinexObsIDTable::MaxBlocks) {
+            InvalidParameter ip("Too many distinct RinexObsIDs");
+            GPSTK_THROW(ip);
+         }
+         RinexObsID *block = table.blocks[b].load(std::memory_order_relaxed);
+         if(block == NULL) {
+            block = new RinexObsID[RinexObsIDTable::BlockSize];
+            table.blocks[b].store(block, std::memory_order_release);
+         }
+         block[h % RinexObsIDTable::BlockSize] = rid;
+         table.idIndex[rid] = h;
+         table.count.store(h + 1, std::memory_order_release);
       }
-      catch(InvalidParameter& ip) { GPSTK_RETHROW(ip); }
+      if(keyed)
+         table.add(key, h);
+      return h;
    }
 
    RinexObsID::RinexObsID(const RinexObsType& rot) : ObsID()
@@ -82,9 +262,13 @@ namespace gpstk
    {
       char buff[4];
 
-      buff[0] = ot2char[type];
-      buff[1] = cb2char[band];
-      buff[2] = tc2char[code];
+         // find() rather than operator[], so the shared maps are only read
+      std::map<ObservationType, char>::const_iterator oti = ot2char.find(type);
+      std::map<CarrierBand, char>::const_iterator cbi = cb2char.find(band);
+      std::map<TrackingCode, char>::const_iterator tci = tc2char.find(code);
+      buff[0] = (oti == ot2char.end() ? 0 : oti->second);
+      buff[1] = (cbi == cb2char.end() ? 0 : cbi->second);
+      buff[2] = (tci == tc2char.end() ? 0 : tci->second);
       buff[3] = 0;
       return std::string(buff);
    }
@@ -163,10 +347,17 @@ namespace gpstk
       char ot(strID[0]);
       char cb(strID[1]);
       char tc(strID[2]);
-      std::string codes(ObsID::validRinexTrackingCodes[sys][cb]);
       if(ot == ' ' || ot == '-')
          return false;
-      if(codes.find(std::string(1,tc)) == std::string::npos)
+         // look up without operator[], which would insert entries
+      std::map<char, std::map<char, std::string> >::const_iterator sit =
+         ObsID::validRinexTrackingCodes.find(sys);
+      if(sit == ObsID::validRinexTrackingCodes.end())
+         return false;
+      std::map<char, std::string>::const_iterator cit = sit->second.find(cb);
+      if(cit == sit->second.end())
+         return false;
+      if(cit->second.find(std::string(1,tc)) == std::string::npos)
          return false;
       if(sys == 'G' && ot == 'C' && tc == 'N')           // the one exception
          return false;
@@ -106,7 +106,8 @@ namespace gpstk
       RinexObsID(ObservationType ot, CarrierBand cb, TrackingCode tc)
             : ObsID(ot, cb, tc) {};
       
-         /// Construct this object from the string specifier
+         /** Construct this object from the string specifier.
+          * Each distinct specifier is parsed only once, see handle(). */
       RinexObsID(const std::string& strID) throw(InvalidParameter);
 
          /// Constructor from ObsID
@@ -146,6 +147,33 @@ namespace gpstk
       static std::ostream& dumpCheck(std::ostream& s)
          throw(gpstk::Exception);
 
+         /** Return a small integer handle for the string specifier
+          * strID, as accepted by the string constructor.  The first
+          * time a specifier is seen it is parsed and the result
+          * recorded; after that it is found by hashing its
+          * characters.  Specifiers giving equal RinexObsIDs (e.g.
+          * "C1C" and "GC1C") give the same handle, so handles may be
+          * compared, and used as map keys or vector indices, in place
+          * of the RinexObsIDs themselves.  Handles are numbered from
+          * 0 in the order first seen, and are never reused.
+          * This function, and the string constructor which uses it,
+          * may be called from several threads at once; only the first
+          * sight of a specifier takes a lock.
+          * @note The validity of a specifier is checked only when it
+          *   is first seen, so later changes to
+          *   ObsID::validRinexTrackingCodes do not affect it.
+          * @throw InvalidParameter if strID is not a valid RinexObsID. */
+      static int handle(const std::string& strID) throw(InvalidParameter);
+
+         /** Return the RinexObsID for a handle returned by handle().
+          * @throw InvalidParameter if h is not such a handle. */
+      static RinexObsID fromHandle(int h) throw(InvalidParameter);
+
+   private:
+         /// Find or record strID, setting rid and returning its handle.
+      static int intern(const std::string& strID, RinexObsID& rid)
+         throw(InvalidParameter);
+
    }; // end class RinexObsID
 
       //@}
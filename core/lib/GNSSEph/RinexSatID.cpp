@@ -45,4 +45,5 @@
 namespace gpstk
 {
    char RinexSatID::fillchar = '0';
+   const int RinexSatID::numHandles;
 }
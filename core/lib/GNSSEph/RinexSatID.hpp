@@ -197,21 +197,143 @@ namespace gpstk
          throw(Exception)
       {
          char c;
-         std::istringstream iss(s);
 
          id = -1; system = systemGPS;  // default
          if(s.find_first_not_of(std::string(" \t\n"), 0) == std::string::npos)
             return;                    // all whitespace yields the default
 
+            // The usual "Xnn" or "X n" form, as found on every
+            // satellite line of a RINEX 3 file, is decoded directly
+            // rather than through a stringstream.
+         if((s.length() == 3) && fromShortForm(s.data()))
+            return;
+
+         std::istringstream iss(s);
          iss >> c;                     // read one character (non-whitespace)
-         switch(c)
+         if((c >= '0') && (c <= '9'))
          {
                // no leading system character
-            case '0': case '1': case '2': case '3': case '4':
-            case '5': case '6': case '7': case '8': case '9':
-               iss.putback(c);
-               system = SatID::systemGPS;
-               break;
+            iss.putback(c);
+            system = SatID::systemGPS;
+         }
+         else
+            setSystemFromChar(c);
+         iss >> id;
+         if(id <= 0) id = -1;
+      }
+
+
+         /** Set the RinexSatID from the \a len characters at \a s,
+          * e.g. the first three columns of a satellite line in a
+          * memory-mapped RINEX 3 file.  The result is identical to
+          * fromString(std::string(s, len)), but the usual "Xnn" form
+          * is decoded without making a temporary string. */
+
+      void fromString(const char* s, std::string::size_type len)
+         throw(Exception)
+      {
+         if((len == 3) && fromShortForm(s))
+            return;
+         fromString(std::string(s, len));
+      }
+
+
+         /// Number of distinct handles, see handle().
+      static const int numHandles = 909;
+
+
+         /** Return a small integer handle, from 0 to numHandles-1,
+          * for this satellite, or -1 if it has none (an unknown
+          * system, or an id under -1 or over 99, which RINEX cannot
+          * represent).  Every satellite a RINEX file can name has a
+          * handle, including those with id 0 and the system-only
+          * satellites with id -1, each in a slot of its own.  Equal
+          * satellites have equal handles, handles are ordered as the
+          * satellites are, and fromHandle() recovers the satellite,
+          * so handles may be used as map keys or vector indices in
+          * place of the RinexSatIDs themselves.  The handle is
+          * computed from the system and id, so unlike
+          * RinexObsID::handle() no table is involved. */
+
+      int handle() const
+         throw()
+      {
+         int sys;
+         switch(system)
+         {
+            case systemGPS:     sys = 0; break;
+            case systemGalileo: sys = 1; break;
+            case systemGlonass: sys = 2; break;
+            case systemGeosync: sys = 3; break;
+            case systemTransit: sys = 4; break;
+            case systemBeiDou:  sys = 5; break;
+            case systemQZSS:    sys = 6; break;
+            case systemIRNSS:   sys = 7; break;
+            case systemMixed:   sys = 8; break;
+            default:            return -1;
+         }
+         if(id < -1 || id > 99)
+            return -1;
+         return 101 * sys + id + 1;
+      }
+
+
+         /// Return the satellite with handle h, see handle().
+         /// @note Handles out of range yield an invalid object.
+
+      static RinexSatID fromHandle(int h)
+         throw()
+      {
+         static const SatelliteSystem systems[] =
+            { systemGPS, systemGalileo, systemGlonass, systemGeosync,
+              systemTransit, systemBeiDou, systemQZSS, systemIRNSS,
+              systemMixed };
+         if(h < 0 || h >= numHandles)
+            return RinexSatID();
+         return RinexSatID(h % 101 - 1, systems[h / 101]);
+      }
+
+
+         /// Convert the RinexSatID to string (1 character plus 2-digit integer).
+
+      std::string toString() const
+         throw()
+      {
+         std::ostringstream oss;
+         oss.fill(fillchar);
+         oss << systemChar() << std::setw(2) << id;
+         return oss.str();
+      }
+
+
+   private:
+
+         /// Decode the three characters at s if they are of the form
+         /// "Xnn" or "X n"; return false, leaving *this unchanged, if not.
+
+      bool fromShortForm(const char* s)
+         throw(Exception)
+      {
+         if(!(((s[0] >= 'A') && (s[0] <= 'Z')) ||
+              ((s[0] >= 'a') && (s[0] <= 'z'))) ||
+            !((s[1] == ' ') || ((s[1] >= '0') && (s[1] <= '9'))) ||
+            !((s[2] >= '0') && (s[2] <= '9')))
+            return false;
+         setSystemFromChar(s[0]);
+         id = 10 * (s[1] == ' ' ? 0 : s[1] - '0') + (s[2] - '0');
+         if(id <= 0) id = -1;
+         return true;
+      }
+
+
+         /// Set the system from a RINEX system character.
+         /// @throw Exception if c is not a RINEX system character.
+
+      void setSystemFromChar(char c)
+         throw(Exception)
+      {
+         switch(c)
+         {
             case 'R': case 'r':
                system = SatID::systemGlonass;
                break;
@@ -244,25 +366,8 @@ namespace gpstk
                            + c + std::string("\""));
                GPSTK_THROW(e);
          }
-         iss >> id;
-         if(id <= 0) id = -1;
       }
 
-
-         /// Convert the RinexSatID to string (1 character plus 2-digit integer).
-
-      std::string toString() const
-         throw()
-      {
-         std::ostringstream oss;
-         oss.fill(fillchar);
-         oss << systemChar() << std::setw(2) << id;
-         return oss.str();
-      }
-
-
-   private:
-
       static char fillchar;  ///< Fill character used during stream output.
 
    }; // class RinexSatID
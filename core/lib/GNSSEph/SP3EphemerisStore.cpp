@@ -88,28 +88,9 @@ namespace gpstk
       try { crec = clkStore.getValue(sat,ttag); }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
 
-      try {
-         Xvt retXvt;
-         retXvt.health = Xvt::HealthStatus::Unavailable;
-         for(int i=0; i<3; i++) {
-            retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
-            retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
-         }
-         if(useSP3clock) {                            // SP3
-            retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
-            retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
-         }
-         else {                                       // RINEX clock
-            retXvt.clkbias = crec.bias;               // sec
-            retXvt.clkdrift = crec.drift;             // sec/sec
-         }
-
-            // compute relativity correction, in seconds
-         retXvt.computeRelativityCorrection();
-         retXvt.health = Xvt::HealthStatus::Unused;
-         return retXvt;
-      }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      Xvt retXvt;
+      makeXvt(prec, crec, retXvt);
+      return retXvt;
    }
 
 
@@ -137,32 +118,91 @@ namespace gpstk
          return rv;
       }
 
+      makeXvt(prec, crec, rv);
+      return rv;
+   }
+
+
+   unsigned int SP3EphemerisStore ::
+   computeXvt(const SatID& sat, const vector<CommonTime>& ttags,
+              vector<Xvt>& xvts) const
+      throw()
+   {
+      vector<PositionRecord> precs;
+      vector<ClockRecord> crecs;
+      vector<bool> pvalid, cvalid;
+      posStore.getValues(sat, ttags, precs, pvalid);
+      clkStore.getValues(sat, ttags, crecs, cvalid);
+      return makeXvts(precs, pvalid, crecs, cvalid, xvts);
+   }
+
+
+   unsigned int SP3EphemerisStore ::
+   computeXvt(const vector<SatID>& sats, const vector<CommonTime>& ttags,
+              vector<Xvt>& xvts) const
+      throw(InvalidRequest)
+   {
+      vector<PositionRecord> precs;
+      vector<ClockRecord> crecs;
+      vector<bool> pvalid, cvalid;
       try
       {
-         for (int i=0; i<3; i++)
-         {
-            rv.x[i] = prec.Pos[i] * 1000.0;    // km -> m
-            rv.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
-         }
-         if (useSP3clock)
-         {                                        // SP3
-            rv.clkbias = crec.bias * 1.e-6;       // microsec -> sec
-            rv.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
-         }
-         else
-         {                                        // RINEX clock
-            rv.clkbias = crec.bias;               // sec
-            rv.clkdrift = crec.drift;             // sec/sec
-         }
+         posStore.getValues(sats, ttags, precs, pvalid);
+         clkStore.getValues(sats, ttags, crecs, cvalid);
+      }
+      catch(InvalidRequest& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      return makeXvts(precs, pvalid, crecs, cvalid, xvts);
+   }
+
 
-            // compute relativity correction, in seconds
-         rv.computeRelativityCorrection();
-         rv.health = Xvt::HealthStatus::Unused;
+   void SP3EphemerisStore ::
+   makeXvt(const PositionRecord& prec, const ClockRecord& crec, Xvt& rv) const
+      throw()
+   {
+      for (int i=0; i<3; i++)
+      {
+         rv.x[i] = prec.Pos[i] * 1000.0;    // km -> m
+         rv.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
       }
-      catch(...)
+      if (useSP3clock)
+      {                                        // SP3
+         rv.clkbias = crec.bias * 1.e-6;       // microsec -> sec
+         rv.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
+      }
+      else
+      {                                        // RINEX clock
+         rv.clkbias = crec.bias;               // sec
+         rv.clkdrift = crec.drift;             // sec/sec
+      }
+
+         // compute relativity correction, in seconds
+      rv.computeRelativityCorrection();
+      rv.health = Xvt::HealthStatus::Unused;
+   }
+
+
+   unsigned int SP3EphemerisStore ::
+   makeXvts(const vector<PositionRecord>& precs, const vector<bool>& pvalid,
+            const vector<ClockRecord>& crecs, const vector<bool>& cvalid,
+            vector<Xvt>& xvts) const
+      throw()
+   {
+      unsigned int nvalid = 0;
+      xvts.resize(precs.size());
+      for (size_t j=0; j<precs.size(); j++)
       {
+         Xvt& rv(xvts[j]);
+         rv = Xvt();
+         rv.health = Xvt::HealthStatus::Unavailable;
+         if (!pvalid[j] || !cvalid[j])
+            continue;
+         makeXvt(precs[j], crecs[j], rv);
+         nvalid++;
       }
-      return rv;
+      return nvalid;
    }
 
 
@@ -132,6 +132,28 @@ namespace gpstk
       void loadSP3Store(const std::string& filename, bool fillClockStore)
          throw(Exception);
 
+         /** Private utility routine, the one kernel of getXvt() and
+          * all the computeXvt(): combine the interpolated position and
+          * clock records of a satellite into rv, converting units to
+          * meters and seconds, and compute the relativity correction.
+          * @param[in] prec the interpolated position record
+          * @param[in] crec the interpolated clock record
+          * @param[out] rv the Xvt, with health "Unused" */
+      void makeXvt(const PositionRecord& prec, const ClockRecord& crec,
+                   Xvt& rv) const
+         throw();
+
+         /** Private utility routine used by the computeXvt() for
+          * several times.  Combine interpolated position and clock
+          * records into Xvts with makeXvt().
+          * @return the number of Xvts that are valid. */
+      unsigned int makeXvts(const std::vector<PositionRecord>& precs,
+                            const std::vector<bool>& pvalid,
+                            const std::vector<ClockRecord>& crecs,
+                            const std::vector<bool>& cvalid,
+                            std::vector<Xvt>& xvts) const
+         throw();
+
    public:
 
          /// Default constructor
@@ -182,6 +204,36 @@ namespace gpstk
       virtual Xvt computeXvt(const SatID& id, const CommonTime& t) const
          throw();
 
+         /** Compute the position, velocity and clock offset of one
+          * satellite at each of several times, as computeXvt(id,t)
+          * would, but interpolating the tables in one pass with
+          * PositionSatStore::getValues() and
+          * ClockSatStore::getValues().  This is the efficient way to
+          * evaluate a satellite over a time grid.
+          * @param[in] id the object's identifier
+          * @param[in] ttags the times to look up
+          * @param[out] xvts the Xvt for each of ttags; the health is
+          *   "Unavailable" where it could not be determined.
+          * @return the number of Xvts that could be determined. */
+      unsigned int computeXvt(const SatID& id,
+                              const std::vector<CommonTime>& ttags,
+                              std::vector<Xvt>& xvts) const
+         throw();
+
+         /** Compute the position, velocity and clock offset for each
+          * of several (satellite,time) pairs, as computeXvt(id,t)
+          * would; see computeXvt(id,ttags,xvts).
+          * @param[in] ids the objects' identifiers
+          * @param[in] ttags the times to look up, one for each of ids
+          * @param[out] xvts the Xvt for each pair; the health is
+          *   "Unavailable" where it could not be determined.
+          * @return the number of Xvts that could be determined.
+          * @throw InvalidRequest if ids and ttags differ in size */
+      unsigned int computeXvt(const std::vector<SatID>& ids,
+                              const std::vector<CommonTime>& ttags,
+                              std::vector<Xvt>& xvts) const
+         throw(InvalidRequest);
+
          /** Get the satellite health at a specific time.
           * @param[in] id the object's identifier
           * @param[in] t the time to look up
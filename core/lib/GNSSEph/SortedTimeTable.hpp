@@ -0,0 +1,263 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SortedTimeTable.hpp
+ * Time-ordered table of data records kept in contiguous storage, for
+ * use as the per-satellite table of TabularSatStore. */
+
+#ifndef GPSTK_SORTED_TIME_TABLE_INCLUDE
+#define GPSTK_SORTED_TIME_TABLE_INCLUDE
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+
+      /// @ingroup GNSSEph
+      //@{
+
+      /** A table of DataRecords keyed by time, with the subset of the
+       * std::map<CommonTime, DataRecord> interface used by
+       * TabularSatStore and the stores derived from it.  The records
+       * are kept sorted by time in a single std::vector, so that
+       * iterating over an interpolation interval walks contiguous
+       * memory, and iterators are random access.
+       *
+       * Tabular ephemeris and clock data (SP3, RINEX clock) are
+       * nearly always added in time order and at a fixed interval.
+       * Appending a record later than every record in the table is
+       * constant time, and while the records remain evenly spaced,
+       * lower_bound(), upper_bound() and find() compute the position
+       * of a time directly from the first time and the spacing,
+       * rather than searching.  Inserting a record out of order is
+       * linear in the size of the table, and if the spacing is then
+       * not uniform, searches fall back to a binary search.
+       *
+       * As with std::map, keys are compared using
+       * CommonTime::operator<(), so times in conflicting time
+       * systems throw InvalidRequest.  Inserting or erasing records
+       * invalidates iterators. */
+   template <class DataRecord>
+   class SortedTimeTable
+   {
+   public:
+      typedef CommonTime key_type;
+      typedef DataRecord mapped_type;
+      typedef std::pair<CommonTime, DataRecord> value_type;
+      typedef typename std::vector<value_type>::iterator iterator;
+      typedef typename std::vector<value_type>::const_iterator const_iterator;
+      typedef typename std::vector<value_type>::size_type size_type;
+
+         /// Default constructor, an empty table.
+      SortedTimeTable() throw()
+            : uniform(true), step(0.0)
+      {}
+
+      iterator begin() throw() { return table.begin(); }
+      const_iterator begin() const throw() { return table.begin(); }
+      iterator end() throw() { return table.end(); }
+      const_iterator end() const throw() { return table.end(); }
+
+         /// Number of records in the table.
+      size_type size() const throw() { return table.size(); }
+         /// True if the table has no records.
+      bool empty() const throw() { return table.empty(); }
+
+         /// Remove all records.
+      void clear() throw()
+      {
+         table.clear();
+         uniform = true;
+         step = 0.0;
+      }
+
+         /// Pre-allocate storage for n records.
+      void reserve(size_type n) { table.reserve(n); }
+
+         /** True if the records are evenly spaced in time, so that
+          * searches are done with arithmetic on the time. */
+      bool isUniform() const throw() { return uniform; }
+
+         /** Interval in seconds between consecutive records, if
+          * isUniform() and there are at least two records, else 0. */
+      double getStep() const throw() { return (uniform ? step : 0.0); }
+
+         /// Return the first record with time not less than ttag.
+      const_iterator lower_bound(const CommonTime& ttag) const
+      { return table.begin() + lowerIndex(ttag); }
+      iterator lower_bound(const CommonTime& ttag)
+      { return table.begin() + lowerIndex(ttag); }
+
+         /// Return the first record with time greater than ttag.
+      const_iterator upper_bound(const CommonTime& ttag) const
+      { return table.begin() + upperIndex(ttag); }
+      iterator upper_bound(const CommonTime& ttag)
+      { return table.begin() + upperIndex(ttag); }
+
+         /// Return the record at time ttag, or end() if there is none.
+      const_iterator find(const CommonTime& ttag) const
+      {
+         size_type i(lowerIndex(ttag));
+         if(i == table.size() || ttag < table[i].first)
+            return table.end();
+         return table.begin() + i;
+      }
+      iterator find(const CommonTime& ttag)
+      {
+         size_type i(lowerIndex(ttag));
+         if(i == table.size() || ttag < table[i].first)
+            return table.end();
+         return table.begin() + i;
+      }
+
+         /** Return the record at time ttag, inserting a default
+          * DataRecord if there is none, as std::map::operator[]. */
+      DataRecord& operator[](const CommonTime& ttag)
+      {
+            // the usual case: append after the last record
+         if(table.empty() || table.back().first < ttag)
+         {
+            if(table.size() == 1)
+               step = ttag - table.back().first;
+            else if(uniform && table.size() > 1 &&
+                    std::fabs((ttag - table.back().first) - step) > 1.0e-8)
+               uniform = false;
+            table.push_back(value_type(ttag, DataRecord()));
+            return table.back().second;
+         }
+
+         size_type i(lowerIndex(ttag));
+         if(ttag < table[i].first)
+         {
+            table.insert(table.begin() + i, value_type(ttag, DataRecord()));
+            updateSpacing();
+         }
+         return table[i].second;
+      }
+
+         /// Remove the record at pos.
+      void erase(iterator pos)
+      {
+         table.erase(pos);
+         updateSpacing();
+      }
+
+         /// Remove the records in [first,last).
+      void erase(iterator first, iterator last)
+      {
+         table.erase(first, last);
+         updateSpacing();
+      }
+
+   private:
+         /// Index of the first record with time >= ttag.
+      size_type lowerIndex(const CommonTime& ttag) const
+      {
+         if(table.empty())
+            return 0;
+
+         if(!uniform || step <= 0.0)
+            return std::lower_bound(table.begin(), table.end(), ttag,
+                                    lessTime) - table.begin();
+
+            // compute the index, then correct for round off
+         double x((ttag - table.front().first) / step);
+         size_type i;
+         if(x <= 0.0)
+            i = 0;
+         else if(x >= double(table.size()))
+            i = table.size();
+         else
+            i = size_type(std::ceil(x));
+         while(i > 0 && !(table[i-1].first < ttag))
+            i--;
+         while(i < table.size() && table[i].first < ttag)
+            i++;
+         return i;
+      }
+
+         /// Index of the first record with time > ttag.
+      size_type upperIndex(const CommonTime& ttag) const
+      {
+         size_type i(lowerIndex(ttag));
+         if(i < table.size() && !(ttag < table[i].first))
+            i++;
+         return i;
+      }
+
+         /// Redetermine whether the records are evenly spaced.
+      void updateSpacing()
+      {
+         uniform = true;
+         step = 0.0;
+         if(table.size() < 2)
+            return;
+         step = table[1].first - table[0].first;
+         for(size_type i=2; i<table.size(); i++)
+         {
+            if(std::fabs((table[i].first - table[i-1].first) - step) > 1.0e-8)
+            {
+               uniform = false;
+               break;
+            }
+         }
+      }
+
+         /// Comparison of a record and a time, for std::lower_bound.
+      static bool lessTime(const value_type& rec, const CommonTime& ttag)
+      { return rec.first < ttag; }
+
+         /// The records, in time order.
+      std::vector<value_type> table;
+
+         /// True if all records are step seconds apart.
+      bool uniform;
+
+         /// Interval in seconds between records, when uniform.
+      double step;
+
+   }; // end class SortedTimeTable
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_SORTED_TIME_TABLE_INCLUDE
@@ -52,6 +52,7 @@
 #include "TimeString.hpp"
 #include "Xvt.hpp"
 #include "CivilTime.hpp"
+#include "SortedTimeTable.hpp"
 //#include "logstream.hpp"      // TEMP
 
 namespace gpstk
@@ -77,8 +78,10 @@ namespace gpstk
          // compile these were originally in the protected block.
    public:
          // the data tables
-         /// std::map with key=CommonTime, value=DataRecord
-      typedef std::map<CommonTime, DataRecord> DataTable;
+         /** time-ordered table of DataRecord, with the interface of
+          * std::map with key=CommonTime, value=DataRecord but
+          * contiguous storage and random access iterators. */
+      typedef SortedTimeTable<DataRecord> DataTable;
 
          /// std::map with key=SatID, value=DataTable
       typedef std::map<SatID, DataTable> SatTable;
@@ -87,7 +90,7 @@ namespace gpstk
    protected:
 
          /** the data tables:
-          * std::map<SatID, std::map<CommonTime, DataRecord> > */
+          * std::map<SatID, SortedTimeTable<DataRecord> > */
       SatTable tables;
 
          /** Time system of tables; default and initial value is
@@ -182,7 +185,9 @@ namespace gpstk
           * parameter exactReturn is true) or (it1+nhalf-1) or
           * (it1+nhalf) (if exactReturn is false).  This routine is
           * used to select data from the table for interpolation; note
-          * that DataTable is a map<CommonTime,DataRecord>.
+          * that DataTable is a SortedTimeTable<DataRecord>, so that
+          * for regularly spaced data the interval is located with
+          * arithmetic on the time rather than a search.
           * @param[in] sat satellite of interest
           * @param[in] ttag time of interest, e.g. where interpolation
           *   will be conducted
@@ -247,9 +252,10 @@ namespace gpstk
 
                /** @note throw here if time systems do not match and
                 * are not "Any" */
-            it1 = dtable.find(ttag);
+               // lower_bound points to the first element with key >= ttag
+            it1 = it2 = dtable.lower_bound(ttag);
                // is it an exact match?
-            bool exactMatch(it1 != dtable.end());
+            bool exactMatch(it1 != dtable.end() && !(ttag < it1->first));
 
                // user must decide whether to return with exact value;
                // e.g. without velocity data, user needs the interval
@@ -257,8 +263,6 @@ namespace gpstk
             if(exactMatch && exactReturn)
                return true;
 
-               // lower_bound points to the first element with key >= ttag
-            it1 = it2 = dtable.lower_bound(ttag);
             if (it1 == dtable.end())
             {
                InvalidRequest e("No data in time range for satellite " +
@@ -441,9 +445,10 @@ namespace gpstk
                // find the timetag in this table
                /** @note throw here if time systems do not match and
                 * are not "Any" */
-            it1 = dtable.find(ttag);
+               // lower_bound points to the first element with key >= ttag
+            it1 = it2 = dtable.lower_bound(ttag);
                // is it an exact match?
-            bool exactMatch(it1 != dtable.end());
+            bool exactMatch(it1 != dtable.end() && !(ttag < it1->first));
 
                // user must decide whether to return with exact value;
                // e.g. without velocity data, user needs the interval
@@ -451,9 +456,6 @@ namespace gpstk
             if(exactMatch && exactReturn)
                return true;
 
-               // lower_bound points to the first element with key >= ttag
-            it1 = it2 = dtable.lower_bound(ttag);
-
                // Should we allow to predict data?
             if(it1 == dtable.end())
             {
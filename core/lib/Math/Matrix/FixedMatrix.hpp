@@ -0,0 +1,283 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedMatrix.hpp
+ * Matrix with dimensions fixed at compile time, stored without allocation
+ */
+ 
+#ifndef GPSTK_FIXEDMATRIX_HPP
+#define GPSTK_FIXEDMATRIX_HPP
+
+#include "Matrix.hpp"
+#include "FixedVector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A matrix of R rows and C columns, R and C fixed at compile time.
+       * Like FixedVector, the elements (R*C of them, in row major order)
+       * are stored inside the object and a FixedMatrix never allocates
+       * memory.  Use it for the 3x3 rotations and small covariance
+       * blocks of inner loops, where Matrix<T> would make several heap
+       * allocations per operation.
+       *
+       * FixedMatrix is a RefMatrixBase, so the functions written for
+       * ConstMatrixBase (inverse(), inverseSVD(), normF(), operator<<
+       * ...) accept it and return a Matrix<T>, and it converts to a
+       * Matrix<T> with the Matrix constructor, or from any matrix of
+       * the same dimensions.  The products, sums and transpose() of
+       * FixedMatrix and FixedVector defined below return fixed size
+       * results; they sum in the same order as the Matrix<T> operators,
+       * so they give results identical to those.
+       *
+       * @code
+       * FixedMatrix<double,3,3> R(fixedRotation(angle,3)*fixedRotation(tilt,1));
+       * FixedVector<double,3> x(R * y);
+       * Matrix<double> M(R);                   // converts to a Matrix
+       * @endcode
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix : public RefMatrixBase<T, FixedMatrix<T,R,C> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type, in row major order
+      typedef T* iterator;
+         /// STL const iterator type, in row major order
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements zero.
+      FixedMatrix()
+      { this->assignFrom(T(0)); }
+         /// Constructor given a value for all elements.
+      explicit FixedMatrix(const T initialValue)
+      { this->assignFrom(initialValue); }
+         /// Constructor copying R*C elements of an array, in row major order.
+      explicit FixedMatrix(const T* vec)
+      { this->assignFrom(vec); }
+         /// Copy constructor from a ConstMatrixBase type, which must
+         /// have R rows and C columns.
+      template <class E>
+      explicit FixedMatrix(const ConstMatrixBase<T, E>& mat)
+         throw(MatrixException)
+      {
+         if (mat.rows() != R || mat.cols() != C)
+         {
+            MatrixException e("Invalid dimensions for FixedMatrix(Matrix)");
+            GPSTK_THROW(e);
+         }
+         this->assignFrom(mat);
+      }
+         /// Submatrix constructor, copying R rows and C columns of mat
+         /// starting at (topRow,topCol).
+      template <class E>
+      FixedMatrix(const ConstMatrixBase<T, E>& mat, size_t topRow,
+                  size_t topCol)
+         throw(MatrixException)
+      {
+         if ((topRow + R) > mat.rows() || (topCol + C) > mat.cols())
+         {
+            MatrixException e("Invalid dimensions for FixedMatrix(Matrix)");
+            GPSTK_THROW(e);
+         }
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               m[i*C+j] = mat(topRow + i, topCol + j);
+      }
+
+         /// STL iterator begin
+      iterator begin() { return m; }
+         /// STL const iterator begin
+      const_iterator begin() const { return m; }
+         /// STL iterator end
+      iterator end() { return m + R*C; }
+         /// STL const iterator end
+      const_iterator end() const { return m + R*C; }
+         /// STL size
+      size_t size() const { return R*C; }
+         /// The number of rows in the matrix
+      size_t rows() const { return R; }
+         /// The number of columns in the matrix
+      size_t cols() const { return C; }
+         /// The elements, as an array of R*C in row major order
+      T* data() { return m; }
+         /// The elements, as an array of R*C in row major order, const
+      const T* data() const { return m; }
+
+         /// Non-const matrix operator(row,col)
+      T& operator() (size_t rowNum, size_t colNum)
+      { return m[rowNum*C + colNum]; }
+         /// Const matrix operator(row,col)
+      T operator() (size_t rowNum, size_t colNum) const
+      { return m[rowNum*C + colNum]; }
+
+         /// Copies any matrix, which must have R rows and C columns.
+      template <class E>
+      FixedMatrix& operator=(const ConstMatrixBase<T, E>& mat)
+         throw(MatrixException)
+      {
+         if (mat.rows() != R || mat.cols() != C)
+         {
+            MatrixException e("Invalid dimensions for FixedMatrix = Matrix");
+            GPSTK_THROW(e);
+         }
+         return this->assignFrom(mat);
+      }
+         /// Assigns all elements to t.
+      FixedMatrix& operator=(const T t)
+      { return this->assignFrom(t); }
+         /// Copies R*C elements of an array, in row major order.
+      FixedMatrix& operator=(const T* array)
+      { return this->assignFrom(array); }
+
+   private:
+         /// the elements, in row major order
+      T m[R*C];
+   };
+
+      /**
+       * FixedMatrix * FixedMatrix : row by column multiplication, in
+       * the same order as Matrix * Matrix.
+       */
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,K>& l,
+                                       const FixedMatrix<T,K,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            for (size_t k = 0; k < K; k++)
+               toReturn(i,j) += l(i,k) * r(k,j);
+      return toReturn;
+   }
+
+      /**
+       * FixedMatrix * FixedVector, in the same order as Matrix * Vector.
+       */
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,R> operator*(const FixedMatrix<T,R,C>& m,
+                                     const FixedVector<T,C>& v)
+   {
+      FixedVector<T,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn[i] += m(i,j) * v[j];
+      return toReturn;
+   }
+
+      /// FixedMatrix + FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator+(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn(l);
+      return toReturn += r;
+   }
+
+      /// FixedMatrix - FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator-(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn(l);
+      return toReturn -= r;
+   }
+
+      /// FixedMatrix * scalar
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,C>& m, const T d)
+   {
+      FixedMatrix<T,R,C> toReturn(m);
+      return toReturn *= d;
+   }
+
+      /// scalar * FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const T d, const FixedMatrix<T,R,C>& m)
+   {
+      FixedMatrix<T,R,C> toReturn(m);
+      return toReturn *= d;
+   }
+
+      /// Returns a FixedMatrix that is \c m transposed.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,C,R> transpose(const FixedMatrix<T,R,C>& m)
+   {
+      FixedMatrix<T,C,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(j,i) = m(i,j);
+      return toReturn;
+   }
+
+      /**
+       * Return a FixedMatrix rotation matrix [inverse() = transpose()]
+       * for the rotation through \c angle radians about \c axis number
+       * (= 1, 2 or 3); the same matrix as rotation().
+       */
+   template <class T>
+   inline FixedMatrix<T,3,3> fixedRotation(T angle, int axis)
+      throw(MatrixException)
+   {
+      if (axis < 1 || axis > 3)
+      {
+         MatrixException e("Invalid axis (must be 1,2, or 3)");
+         GPSTK_THROW(e);
+      }
+      FixedMatrix<T,3,3> toReturn;
+      int i1 = axis-1;
+      int i2 = (i1+1) % 3;
+      int i3 = (i2+1) % 3;
+      toReturn(i1,i1) = 1.0;
+      toReturn(i2,i2) = toReturn(i3,i3) = ::cos(angle);
+      toReturn(i3,i2) = -(toReturn(i2,i3) = ::sin(angle));
+      return toReturn;
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif
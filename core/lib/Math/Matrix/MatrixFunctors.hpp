@@ -43,6 +43,7 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include "MatrixKernels.hpp"
 
 namespace gpstk
 {
@@ -591,45 +592,24 @@ namespace gpstk
             GPSTK_THROW(e);
          }
 
-         size_t N=m.rows(),i,j,k;
-         double d;
-         Matrix<T> P(m);
-         U = Matrix<T>(m.rows(),m.cols(),T(0));
+         size_t N=m.rows(),i,j;
 
-         for(j=N-1; ; j--) {
-            if(P(j,j) <= T(0)) {
-               MatrixException e("Cholesky fails - eigenvalue <= 0");
-               GPSTK_THROW(e);
-            }
-            U(j,j) = SQRT(P(j,j));
-            d = T(1)/U(j,j);
-            if(j > 0) {
-               for(k=0; k<j; k++) U(k,j)=d*P(k,j);
-               for(k=0; k<j; k++)
-                  for(i=0; i<=k; i++)
-                     P(i,k) -= U(k,j)*U(i,j);
-            }
-            if(j==0) break;      // since j is unsigned
+            // factor copies of m in place, on their column major storage
+         U = m;
+         if(choleskyUpperColMajor(U.begin(), N) != N) {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GPSTK_THROW(e);
          }
+         for(j=0; j<N; j++)
+            for(i=j+1; i<N; i++) U(i,j) = T(0);
 
-         P = m;
-         L = Matrix<T>(m.rows(),m.cols(),T(0));
-         for(j=0; j<=N-1; j++) {
-            if(P(j,j) <= T(0)) {
-               MatrixException e("Cholesky fails - eigenvalue <= 0");
-               GPSTK_THROW(e);
-            }
-            L(j,j) = SQRT(P(j,j));
-            d = T(1)/L(j,j);
-            if(j < N-1) {
-               for(k=j+1; k<N; k++) L(k,j)=d*P(k,j);
-               for(k=j+1; k<N; k++) {
-                  for(i=k; i<N; i++) {
-                     P(i,k) -= L(i,j)*L(k,j);
-                  }
-               }
-            }
+         L = m;
+         if(choleskyLowerColMajor(L.begin(), N) != N) {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GPSTK_THROW(e);
          }
+         for(j=1; j<N; j++)
+            for(i=0; i<j; i++) L(i,j) = T(0);
 
       }  // end Cholesky::operator()
 
@@ -741,45 +721,7 @@ namespace gpstk
          throw (MatrixException)
       {
          A = m;
-         size_t i,j,k;
-         Vector<T> v(A.rows());
-         T sum,alpha;
-
-            // loop over cols
-         const T EPS(1.e-200);
-         for(j=0; (j<A.cols()-1 && j<A.rows()-1); j++) {
-            sum = T(0);
-               // loop over rows at diagonal and below
-            for(i=j; i<A.rows(); i++) {
-               v(i) = A(i,j);
-               A(i,j) = T(0);       // this is optional - below the diag is trash
-               sum += v(i)*v(i);
-            }
-
-            if(sum < EPS) continue;             // already zero below diagonal
-
-            sum = SQRT(sum);
-            if(v(j) > T(0)) sum = -sum;
-            A(j,j) = sum;
-            v(j) = v(j) - sum;
-            sum = T(1)/(sum*v(j));
-
-               // loop over columns beyond j
-            for(k=j+1; k<A.cols(); k++) {
-               alpha = T(0);
-                  // loop over rows at and below j
-               for(i=j; i<A.rows(); i++) {
-                  alpha += A(i,k)*v(i);
-               }
-               alpha *= sum;
-               if(alpha*alpha < EPS) continue;
-                  // modify column k at and below j
-               for(i=j; i<A.rows(); i++) {
-                  A(i,k) += alpha*v(i);
-               }
-            }  // end loop over cols > j
-
-         }  // end loop over cols
+         householderColMajor(A.begin(), A.rows(), A.cols());
 
       }  // end Householder::operator()
       
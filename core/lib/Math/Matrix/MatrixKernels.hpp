@@ -0,0 +1,346 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MatrixKernels.hpp
+ * Cache blocked kernels on column major arrays, used by the Matrix
+ * operators and functors.
+ */
+
+#ifndef GPSTK_MATRIX_KERNELS_HPP
+#define GPSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include "MathBase.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /*
+       * These kernels work directly on the column major storage of
+       * Matrix<T>, rather than through operator(), so that the
+       * innermost loops run over contiguous memory.  They are blocked
+       * so that the data used by the innermost loops stays in cache
+       * for large matrices, and when the library is built with OpenMP
+       * (USE_OPENMP) the large ones are split over threads by
+       * columns of the result.
+       *
+       * The blocking does NOT change the order of the floating point
+       * operations on any element: every sum is accumulated in the
+       * same order as by the plain loops it replaces, and the threads
+       * work on disjoint columns.  The results are therefore identical
+       * to those of the plain loops, bit for bit, with any block size
+       * and any number of threads.
+       */
+
+      /// Minimum number of multiply-adds in a kernel for OpenMP to split
+      /// it over threads.
+   static const double MatrixKernelParallelWork = 1.e6;
+
+      /**
+       * Matrix product c += a*b, where a is [m,p], b is [p,n] and c is
+       * [m,n], all column major.  Each element of c is summed over
+       * k = 0..p-1 in order, as in operator*(Matrix,Matrix).
+       *
+       * The rows of a are first copied so that they are contiguous,
+       * like the columns of b; then c is computed in 4x4 tiles, each
+       * held in registers while the inner dimension is swept, in
+       * blocks that keep the rows and columns in use in cache.
+       */
+   template <class T>
+   void multiplyColMajor(const T *a, const T *b, T *c,
+                         size_t m, size_t p, size_t n)
+   {
+      if (m == 0 || p == 0 || n == 0)
+         return;
+      const size_t KB(256);      // length of the inner dimension in a block
+      std::vector<T> at(m*p);    // transpose of a
+      for (size_t k = 0; k < p; k++)
+         for (size_t i = 0; i < m; i++)
+            at[i*p + k] = a[i + k*m];
+      const T *ar(&at[0]);
+
+      const long ntile((n + 3) / 4);
+      for (size_t kb = 0; kb < p; kb += KB)
+      {
+         const size_t ke(std::min(kb + KB, p));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) \
+      if (double(m)*double(ke-kb)*double(n) > MatrixKernelParallelWork)
+#endif
+         for (long jt = 0; jt < ntile; jt++)
+         {
+            const size_t jb(jt*4), je(std::min(jb + 4, n));
+            size_t ib(0);
+            if (je - jb == 4)
+            {
+               const T *b0(b + jb*p), *b1(b0 + p), *b2(b1 + p), *b3(b2 + p);
+               for ( ; ib + 4 <= m; ib += 4)
+               {
+                  const T *a0(ar + ib*p), *a1(a0 + p), *a2(a1 + p), *a3(a2 + p);
+                  T *c0(c + ib + jb*m), *c1(c0 + m), *c2(c1 + m), *c3(c2 + m);
+                  T c00(c0[0]), c10(c0[1]), c20(c0[2]), c30(c0[3]),
+                     c01(c1[0]), c11(c1[1]), c21(c1[2]), c31(c1[3]),
+                     c02(c2[0]), c12(c2[1]), c22(c2[2]), c32(c2[3]),
+                     c03(c3[0]), c13(c3[1]), c23(c3[2]), c33(c3[3]);
+                  for (size_t k = kb; k < ke; k++)
+                  {
+                     const T x0(a0[k]), x1(a1[k]), x2(a2[k]), x3(a3[k]);
+                     const T y0(b0[k]), y1(b1[k]), y2(b2[k]), y3(b3[k]);
+                     c00 += x0*y0; c10 += x1*y0; c20 += x2*y0; c30 += x3*y0;
+                     c01 += x0*y1; c11 += x1*y1; c21 += x2*y1; c31 += x3*y1;
+                     c02 += x0*y2; c12 += x1*y2; c22 += x2*y2; c32 += x3*y2;
+                     c03 += x0*y3; c13 += x1*y3; c23 += x2*y3; c33 += x3*y3;
+                  }
+                  c0[0] = c00; c0[1] = c10; c0[2] = c20; c0[3] = c30;
+                  c1[0] = c01; c1[1] = c11; c1[2] = c21; c1[3] = c31;
+                  c2[0] = c02; c2[1] = c12; c2[2] = c22; c2[3] = c32;
+                  c3[0] = c03; c3[1] = c13; c3[2] = c23; c3[3] = c33;
+               }
+            }
+               // the edges of c, one element at a time
+            for (size_t j = jb; j < je; j++)
+            {
+               const T *bj(b + j*p);
+               for (size_t i = ib; i < m; i++)
+               {
+                  const T *ai(ar + i*p);
+                  T sum(c[i + j*m]);
+                  for (size_t k = kb; k < ke; k++)
+                     sum += ai[k]*bj[k];
+                  c[i + j*m] = sum;
+               }
+            }
+         }
+      }
+   }
+
+      /**
+       * Matrix times vector y += a*x, where a is [m,n], column major.
+       * Each element of y is summed over j = 0..n-1 in order, as in
+       * operator*(Matrix,Vector).
+       */
+   template <class T>
+   void multiplyVectorColMajor(const T *a, const T *x, T *y,
+                               size_t m, size_t n)
+   {
+      for (size_t j = 0; j < n; j++)
+      {
+         const T *aj(a + j*m);
+         const T xj(x[j]);
+         for (size_t i = 0; i < m; i++)
+            y[i] += aj[i] * xj;
+      }
+   }
+
+      /**
+       * In place Cholesky decomposition a = L*transpose(L) of the
+       * lower triangle of the [n,n] column major array a, as computed
+       * by class Cholesky.  The upper triangle is not referenced.  The
+       * columns are factored in panels, and each panel then updates
+       * the rest of the matrix in a single pass.
+       * @return n on success, else the column at which a pivot <= 0
+       *   was found.
+       */
+   template <class T>
+   size_t choleskyLowerColMajor(T *a, size_t n)
+   {
+      const size_t NB(32);       // columns in a panel
+      for (size_t jb = 0; jb < n; jb += NB)
+      {
+         size_t je(std::min(jb + NB, n));
+            // factor the panel
+         for (size_t j = jb; j < je; j++)
+         {
+            T *aj(a + j*n);
+            if (aj[j] <= T(0))
+               return j;
+            aj[j] = SQRT(aj[j]);
+            T d(T(1)/aj[j]);
+            for (size_t k = j+1; k < n; k++)
+               aj[k] = d*aj[k];
+            for (size_t k = j+1; k < je; k++)
+            {
+               T *ak(a + k*n);
+               const T lkj(aj[k]);
+               for (size_t i = k; i < n; i++)
+                  ak[i] -= aj[i]*lkj;
+            }
+         }
+            // update the columns to the right with the whole panel
+         const long kb(je), ke(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,8) \
+      if (double(n-je)*double(n-je)*double(je-jb) > 2*MatrixKernelParallelWork)
+#endif
+         for (long k = kb; k < ke; k++)
+         {
+            T *ak(a + k*n);
+            for (size_t j = jb; j < je; j++)
+            {
+               const T *aj(a + j*n);
+               const T lkj(aj[k]);
+               for (size_t i = k; i < n; i++)
+                  ak[i] -= aj[i]*lkj;
+            }
+         }
+      }
+      return n;
+   }
+
+      /**
+       * In place Cholesky decomposition a = U*transpose(U) of the
+       * upper triangle of the [n,n] column major array a, as computed
+       * by class Cholesky; the columns are factored from the last one,
+       * in panels as in choleskyLowerColMajor().  The lower triangle is
+       * not referenced.
+       * @return n on success, else the column at which a pivot <= 0
+       *   was found.
+       */
+   template <class T>
+   size_t choleskyUpperColMajor(T *a, size_t n)
+   {
+      const size_t NB(32);       // columns in a panel
+      for (size_t je = n; je > 0; )
+      {
+         size_t jb(je > NB ? je - NB : 0);
+            // factor the panel, last column first
+         for (size_t j = je; j-- > jb; )
+         {
+            T *aj(a + j*n);
+            if (aj[j] <= T(0))
+               return j;
+            aj[j] = SQRT(aj[j]);
+            T d(T(1)/aj[j]);
+            for (size_t k = 0; k < j; k++)
+               aj[k] = d*aj[k];
+            for (size_t k = jb; k < j; k++)
+            {
+               T *ak(a + k*n);
+               const T ukj(aj[k]);
+               for (size_t i = 0; i <= k; i++)
+                  ak[i] -= ukj*aj[i];
+            }
+         }
+            // update the columns to the left with the whole panel
+         const long kb(0), ke(jb);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,8) \
+      if (double(jb)*double(jb)*double(je-jb) > 2*MatrixKernelParallelWork)
+#endif
+         for (long k = kb; k < ke; k++)
+         {
+            T *ak(a + k*n);
+            for (size_t j = je; j-- > jb; )
+            {
+               const T *aj(a + j*n);
+               const T ukj(aj[k]);
+               for (size_t i = 0; i <= size_t(k); i++)
+                  ak[i] -= ukj*aj[i];
+            }
+         }
+         je = jb;
+      }
+      return n;
+   }
+
+      /**
+       * In place Householder triangularization of the [m,n] column
+       * major array a, as computed by class Householder: the elements
+       * below the diagonal are zeroed one column at a time, and each
+       * transformation is applied to the columns to its right, which
+       * are independent of each other and so are split over threads.
+       */
+   template <class T>
+   void householderColMajor(T *a, size_t m, size_t n)
+   {
+      if (m == 0 || n == 0)
+         return;
+      std::vector<T> v(m);
+      const T EPS(1.e-200);
+      for (size_t j = 0; (j < n-1 && j < m-1); j++)
+      {
+         T *aj(a + j*m);
+         T sum(0);
+            // loop over rows at diagonal and below
+         for (size_t i = j; i < m; i++)
+         {
+            v[i] = aj[i];
+            aj[i] = T(0);        // this is optional - below the diag is trash
+            sum += v[i]*v[i];
+         }
+
+         if (sum < EPS)
+            continue;            // already zero below diagonal
+
+         sum = SQRT(sum);
+         if (v[j] > T(0))
+            sum = -sum;
+         aj[j] = sum;
+         v[j] = v[j] - sum;
+         sum = T(1)/(sum*v[j]);
+
+            // loop over columns beyond j
+         const T *vp(&v[0]);
+         const long kb(j+1), ke(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) \
+      if (double(m-j)*double(n-j) > MatrixKernelParallelWork)
+#endif
+         for (long k = kb; k < ke; k++)
+         {
+            T *ak(a + k*m);
+            T alpha(0);
+            for (size_t i = j; i < m; i++)
+               alpha += ak[i]*vp[i];
+            alpha *= sum;
+            if (alpha*alpha < EPS)
+               continue;
+            for (size_t i = j; i < m; i++)
+               ak[i] += alpha*vp[i];
+         }
+      }
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif
@@ -845,6 +845,48 @@ namespace gpstk
       }
       return toReturn;
    }
+      /**
+       * Matrix * Matrix for two Matrix objects; the same product as the
+       * general operator above, computed on the column major storage
+       * by multiplyColMajor().
+       */
+   template <class T>
+   inline Matrix<T> operator* (const Matrix<T>& l, const Matrix<T>& r)
+      throw (MatrixException)
+   {
+      if (l.cols() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      multiplyColMajor(l.begin(), r.begin(), toReturn.begin(),
+                       l.rows(), l.cols(), r.cols());
+      return toReturn;
+   }
+
+      /**
+       * Matrix times Vector for Matrix and Vector objects; the same
+       * product as the general operator above, computed on the column
+       * major storage by multiplyVectorColMajor().
+       */
+   template <class T>
+   inline Vector<T> operator* (const Matrix<T>& m, const Vector<T>& v)
+      throw (MatrixException)
+   {
+      if (v.size() != m.cols())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.rows(), T(0));
+      multiplyVectorColMajor(m.begin(), v.begin(), toReturn.begin(),
+                             m.rows(), m.cols());
+      return toReturn;
+   }
+
       /**
        * Vector times matrix multiplication, returning a vector.
        */
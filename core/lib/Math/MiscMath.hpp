@@ -178,6 +178,67 @@ namespace gpstk
       }
    }  // end void LagrangeInterpolation(vector, vector, const T, T&, T&)
 
+      /// Compute the Lagrange interpolation weights L[i], i=0,N-1 (N=X.size())
+      /// for the abscissae X at x, so that the interpolating polynomial through
+      /// (X[i],Y[i]) is Y(x) = SUM[L[i]*Y[i]] for any ordinates Y.
+      /// The weights depend only on X and x, so when several quantities are
+      /// tabulated at the same X (e.g. the three components of a position)
+      /// they may be computed once and applied to each.
+      /// Li(x) = PROD(j!=i)[x-Xj] / PROD(j!=i)[Xi-Xj]; cost is O(N^2).
+   template <class T>
+   void LagrangeWeights(const std::vector<T>& X, const T& x, std::vector<T>& L)
+      throw()
+   {
+      std::size_t i,j,N=X.size();
+      L.resize(N);
+      for(i=0; i<N; i++) {
+         T P(1),D(1);
+         for(j=0; j<N; j++) {
+            if(i == j) continue;
+            P *= x-X[j];
+            D *= X[i]-X[j];
+         }
+         L[i] = P/D;
+      }
+   }  // end void LagrangeWeights(vector, const T, vector)
+
+      /// Compute the Lagrange interpolation weights L[i] and the weights of the
+      /// derivative Lp[i], i=0,N-1 (N=X.size()) for the abscissae X at x, so that
+      /// Y(x) = SUM[L[i]*Y[i]] and dY(x)/dx = SUM[Lp[i]*Y[i]]; see the notes
+      /// above LagrangeInterpolation(X,Y,x,y,dydx).  Lpi(x) = Si/Di is
+      /// computed with the product rule, in O(N^2) rather than O(N^3).
+   template <class T>
+   void LagrangeWeights(const std::vector<T>& X, const T& x,
+                        std::vector<T>& L, std::vector<T>& Lp)
+      throw()
+   {
+      std::size_t i,j,N=X.size();
+      L.resize(N);
+      Lp.resize(N);
+      for(i=0; i<N; i++) {
+         T P(1),S(0),D(1);
+         for(j=0; j<N; j++) {
+            if(i == j) continue;
+            S = S*(x-X[j]) + P;           // d/dx of PROD so far
+            P *= x-X[j];
+            D *= X[i]-X[j];
+         }
+         L[i] = P/D;
+         Lp[i] = S/D;
+      }
+   }  // end void LagrangeWeights(vector, const T, vector, vector)
+
+      /// Return SUM[W[i]*Y[i]], i=0,N-1, for example to apply the weights
+      /// computed by LagrangeWeights() to tabulated data Y.
+   template <class T>
+   inline T WeightedSum(const T *W, const T *Y, const std::size_t N) throw()
+   {
+      T sum(0);
+      for(std::size_t i=0; i<N; i++)
+         sum += W[i]*Y[i];
+      return sum;
+   }
+
 
       /// Returns the second derivative of Lagrange interpolation.
    template <class T>
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedVector.hpp
+ * Vector with a size fixed at compile time, stored without allocation
+ */
+ 
+#ifndef GPSTK_FIXEDVECTOR_HPP
+#define GPSTK_FIXEDVECTOR_HPP
+
+#include "Vector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements, N fixed at compile time.  The elements
+       * are stored inside the object, so unlike Vector<T> a
+       * FixedVector never allocates memory: a local FixedVector lives
+       * on the stack, and constructing, copying or returning one costs
+       * no more than the N elements themselves.  Use it for the small
+       * vectors (positions, velocities, integrator states) of inner
+       * loops, where the heap allocation of a Vector<T> would cost more
+       * than the arithmetic.
+       *
+       * FixedVector is a RefVectorBase, so the functions and operators
+       * written for ConstVectorBase (dot(), norm(), operator<< ...) and
+       * the assignment operators of RefVectorBase (+=, -=, *=, /=)
+       * apply to it, and it converts to and from Vector<T>.  The
+       * arithmetic operators between FixedVectors defined below return
+       * a FixedVector; their loops have a trip count fixed at compile
+       * time over contiguous storage, so the compiler unrolls and
+       * vectorizes them.
+       *
+       * @code
+       * FixedVector<double,3> a, b(1.0);
+       * a[0] = 2.0;
+       * FixedVector<double,3> c(a + 2.0*b);
+       * Vector<double> v(c);                   // converts to a Vector
+       * @endcode
+       */
+   template <class T, size_t N>
+   class FixedVector : public RefVectorBase<T, FixedVector<T,N> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements zero.
+      FixedVector()
+      { this->assignFrom(T(0)); }
+         /// Constructor given a value for all elements.
+      explicit FixedVector(const T initialValue)
+      { this->assignFrom(initialValue); }
+         /// Constructor copying the first N elements of an array.
+      explicit FixedVector(const T* vec)
+      { this->assignFrom(vec); }
+         /// Copy constructor from a ConstVectorBase type, which must
+         /// have N elements.
+      template <class E>
+      explicit FixedVector(const ConstVectorBase<T, E>& vec)
+         throw(VectorException)
+      {
+         if (vec.size() != N)
+         {
+            VectorException e("Invalid size for FixedVector(Vector)");
+            GPSTK_THROW(e);
+         }
+         this->assignFrom(vec);
+      }
+
+         /// STL iterator begin
+      iterator begin() { return v; }
+         /// STL const iterator begin
+      const_iterator begin() const { return v; }
+         /// STL iterator end
+      iterator end() { return v + N; }
+         /// STL const iterator end
+      const_iterator end() const { return v + N; }
+         /// STL size
+      size_t size() const { return N; }
+         /// STL max_size
+      size_t max_size() const { return N; }
+         /// The elements, as an array of N
+      T* data() { return v; }
+         /// The elements, as an array of N, const version
+      const T* data() const { return v; }
+
+         /// Non-const operator []
+      T& operator[] (size_t i) 
+      { return v[i]; }
+         /// Const operator []
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Non-const operator ()
+      T& operator() (size_t i) 
+      { return v[i]; }
+         /// Const operator ()
+      T operator() (size_t i) const
+      { return v[i]; }
+
+         /// Copies any vector, which must have N elements.
+      template <class E>
+      FixedVector& operator=(const ConstVectorBase<T, E>& x)
+         throw(VectorException)
+      {
+         if (x.size() != N)
+         {
+            VectorException e("Invalid size for FixedVector = Vector");
+            GPSTK_THROW(e);
+         }
+         return this->assignFrom(x);
+      }
+         /// Assigns all elements to x.
+      FixedVector& operator=(const T x)
+      { return this->assignFrom(x); }
+         /// Copies the first N elements of an array.
+      FixedVector& operator=(const T* x)
+      { return this->assignFrom(x); }
+
+   private:
+         /// the elements
+      T v[N];
+   };
+
+      /// FixedVector + FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator+(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn(l);
+      return toReturn += r;
+   }
+
+      /// FixedVector - FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator-(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn(l);
+      return toReturn -= r;
+   }
+
+      /// FixedVector * scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const FixedVector<T,N>& l, const T r)
+   {
+      FixedVector<T,N> toReturn(l);
+      return toReturn *= r;
+   }
+
+      /// scalar * FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const T l, const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] = l * r[i];
+      return toReturn;
+   }
+
+      /// FixedVector / scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator/(const FixedVector<T,N>& l, const T r)
+   {
+      FixedVector<T,N> toReturn(l);
+      return toReturn /= r;
+   }
+
+      /// The dot product of two FixedVectors, summed in index order as
+      /// dot(ConstVectorBase, ConstVectorBase).
+   template <class T, size_t N>
+   inline T dot(const FixedVector<T,N>& l, const FixedVector<T,N>& r)
+   {
+      T sum(0);
+      for (size_t i = 0; i < N; i++)
+         sum += l[i] * r[i];
+      return sum;
+   }
+
+      /// The cross product of two FixedVectors of size 3.
+   template <class T>
+   inline FixedVector<T,3> cross(const FixedVector<T,3>& l,
+                                 const FixedVector<T,3>& r)
+   {
+      FixedVector<T,3> toReturn;
+      toReturn[0] = l[1] * r[2] - l[2] * r[1];
+      toReturn[1] = l[2] * r[0] - l[0] * r[2];
+      toReturn[2] = l[0] * r[1] - l[1] * r[0];
+      return toReturn;
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif
@@ -38,6 +38,8 @@
 /// Pseudorange navigation solution, either a simple solution using all the
 /// given data, or a solution including editing via a RAIM algorithm.
 
+#include <map>
+#include <algorithm>
 #include "MathBase.hpp"
 #include "PRSolution.hpp"
 #include "GPSEllipsoid.hpp"
@@ -54,6 +56,8 @@ namespace gpstk
    const string PRSolution::calfmt = string("%04Y/%02m/%02d %02H:%02M:%02S %P");
    const string PRSolution::gpsfmt = string("%4F %10.3g");
    const string PRSolution::timfmt = gpsfmt + string(" ") + calfmt;
+   const double PRSolution::RAIMScreenRange = 1.e7;
+   const double PRSolution::RAIMScreenSlope = 2.e-2;
 
    ostream& operator<<(ostream& os, const WtdAveStats& was)
       { was.dump(os,was.getMessage()); return os;}
@@ -539,23 +543,9 @@ namespace gpstk
 
          LOG(DEBUG) << "RAIMCompute at time " << printTime(Tr,gpsfmt);
 
-         int iret,N;
-         size_t i,j;
-         vector<int> GoodIndexes;
-         // use these to save the 'best' solution within the loop.
-         // BestRMS marks the 'Best' set as unused.
-         bool BestTropFlag(false);
-         int BestNIter(0),BestIret(-5);
-         double BestRMS(-1.0),BestSL(0.0),BestConv(0.0);
-         Vector<double> BestSol(3,0.0),BestPFR;
-         vector<SatID> BestSats,SaveSats;
-         Matrix<double> SVP,BestCov,BestInvMCov,BestPartials;
-         vector<SatID::SatelliteSystem> BestSyss;
-
-         // initialize
-         Valid = false;
-         currTime = Tr;
-         TropFlag = SlopeFlag = RMSFlag = false;
+         int N;
+         size_t i;
+         Matrix<double> SVP;
 
          // ----------------------------------------------------------------
          // fill the SVP matrix, and use it for every solution
@@ -581,7 +571,50 @@ namespace gpstk
             LOG(DEBUG) << oss.str();
          }
 
-         // return is >=0(number of good sats) or -4(no ephemeris)
+         return RAIMCompute(Tr, Sats, Syss, SVP, invMC, pTropModel);
+      }
+      catch(Exception& e) {
+         GPSTK_RETHROW(e);
+      }
+   }  // end PRSolution::RAIMCompute()
+
+
+   // -------------------------------------------------------------------------
+   // Compute a solution using RAIM, given the output of PreparePRSolution().
+   int PRSolution::RAIMCompute(const CommonTime& Tr,
+                               vector<SatID>& Sats,
+                               vector<SatID::SatelliteSystem>& Syss,
+                               const Matrix<double>& SVP,
+                               const Matrix<double>& invMC,
+                               TropModel *pTropModel)
+      throw(Exception)
+   {
+      try {
+         int iret,N;
+         size_t i,j;
+         vector<int> GoodIndexes;
+         // use these to save the 'best' solution within the loop.
+         // BestRMS marks the 'Best' set as unused.
+         bool BestTropFlag(false);
+         int BestNIter(0),BestIret(-5),BestStage(-1);
+         size_t BestCombo(0);
+         double BestRMS(-1.0),BestSL(0.0),BestConv(0.0);
+         Vector<double> BestSol(3,0.0),BestPFR;
+         vector<SatID> BestSats,SaveSats;
+         Matrix<double> BestCov,BestInvMCov,BestPartials;
+         vector<SatID::SatelliteSystem> BestSyss;
+
+         // initialize
+         Valid = false;
+         currTime = Tr;
+         TropFlag = SlopeFlag = RMSFlag = false;
+
+         // PreparePRSolution() has marked every satellite without ephemeris
+         for(N=0,i=0; i<Sats.size(); i++)
+            if(Sats[i].id > 0)
+               N++;
+
+         // N is the number of good sats; none means no ephemeris
          if(N <= 0) return -4;
 
          // ----------------------------------------------------------------
@@ -616,17 +649,60 @@ namespace gpstk
          // stage is the number of satellites to reject.
          int stage(0);
 
+         // with IncrementalRAIM, save the all-satellite solution for RAIMScreen()
+         bool screen(false);
+         vector<SatID::SatelliteSystem> GoodSyss;
+         Matrix<double> FullPartials,FullCov,FullInvMCov;
+         Vector<double> FullResids;
+         if(IncrementalRAIM) {
+            screen = true;
+            for(i=0; i<GoodIndexes.size(); i++) {
+               GoodSyss.push_back(Sats[GoodIndexes[i]].system);
+               for(j=0; invMC.rows() > 0 && j<GoodIndexes.size(); j++)
+                  if(i != j && invMC(GoodIndexes[i],GoodIndexes[j]) != 0.0)
+                     screen = false;            // only for diagonal weights
+            }
+         }
+
          do {
-            // compute all the combinations of N satellites taken stage at a time
-            Combinations Combo(N,stage);
+            // compute all the combinations of N satellites taken stage at a time;
+            // Rejects[.] holds the indexes in GoodIndexes of those to reject
+            vector< vector<int> > Rejects;
+            {
+               Combinations Combo(N,stage);
+               do {
+                  vector<int> rej;
+                  for(i=0; i<GoodIndexes.size(); i++)
+                     if(Combo.isSelected(i))
+                        rej.push_back(i);
+                  Rejects.push_back(rej);
+               } while(Combo.Next() != -1);
+            }
+
+            // order the combinations by a lower bound on their RMS residual
+            vector<size_t> order;
+            vector<double> lower;
+            if(screen && stage > 0 && FullPartials.rows() > 0)
+               RAIMScreen(Rejects, GoodSyss, FullPartials, FullCov,
+                          FullInvMCov, FullResids, order, lower);
 
             // compute a solution for each combination of marked satellites
-            do {
+            for(size_t ic=0; ic<Rejects.size(); ic++) {
+               const size_t icombo(order.empty() ? ic : order[ic]);
+
+               // none of the rest can do better than the best so far
+               if(!lower.empty() && BestRMS >= 0.0 && lower[ic] > BestRMS) {
+                  LOG(DEBUG) << " RAIM: screening skips " << Rejects.size()-ic
+                     << " of " << Rejects.size() << " combinations";
+                  break;
+               }
+
                // Mark the satellites for this combination
                Sats = SaveSats;
-               for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
-                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+               for(i=0; i<Rejects[icombo].size(); i++) {
+                  j = GoodIndexes[Rejects[icombo][i]];
+                  Sats[j].id = -::abs(Sats[j].id);
+               }
 
                if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
                   ostringstream oss;
@@ -653,6 +729,14 @@ namespace gpstk
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
 
+               if(screen && stage == 0 && iret == 0 && !TropFlag &&
+                  Partials.rows() == GoodIndexes.size()) {
+                  FullPartials = Partials;
+                  FullCov = Covariance;
+                  FullInvMCov = invMeasCov;
+                  FullResids = Resids;
+               }
+
                // ----------------------------------------------------------------
                // if error, either quit or continue with next combo (SPS sets Valid F)
                if(iret < 0) {
@@ -684,8 +768,13 @@ namespace gpstk
                      //(Solution-memory.APSolution));
 
                // deal with the results of SimplePRSolution()
-               // save 'best' solution for later
-               if(BestRMS < 0.0 || RMSResidual < BestRMS) {
+               // save 'best' solution for later; among equals, the first in
+               // the usual order of the combinations
+               if(BestRMS < 0.0 || RMSResidual < BestRMS ||
+                  (RMSResidual == BestRMS && BestStage == stage &&
+                   icombo < BestCombo)) {
+                  BestStage = stage;
+                  BestCombo = icombo;
                   BestRMS = RMSResidual;
                   BestSol = Solution;
                   BestSats = SatelliteIDs;
@@ -704,7 +793,7 @@ namespace gpstk
                if(stage==0 && RMSResidual < RMSLimit)
                   break;
 
-            } while(Combo.Next() != -1);  // get the next combinations and repeat
+            }  // end loop over combinations
 
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
@@ -821,6 +910,140 @@ namespace gpstk
    }  // end PRSolution::RAIMCompute()
 
 
+   // -------------------------------------------------------------------------
+   // Screen the RAIM combinations using the all-satellite solution. Removing
+   // the data S from a linear least squares solution with covariance C,
+   // partials P, weights W and post-fit residuals r changes the residuals of
+   // the remaining data K to  r_K + H_KS y,  where H = P C PT and
+   // y = (W_S^-1 - H_SS)^-1 r_S, and the solution by -C P_S^T y; so only a
+   // small (stage x stage) system must be solved for each combination.
+   // The linear problem is the one of the last iteration of the all-satellite
+   // solution, so the prediction differs from the full solution of the
+   // combination only by the nonlinearity over the predicted change in
+   // position d, and by the convergence of that solution. The range is
+   // curved by at most d^2/(2*RAIMScreenRange), and the trop and the earth
+   // rotation correction change by at most RAIMScreenSlope*d, so no residual,
+   // and hence not the RMS residual, is off by more than
+   //    2*sqrt(2)*ConvergenceLimit
+   //       + sqrt(wmax/wmin) * (d^2/(2*RAIMScreenRange) + RAIMScreenSlope*d)
+   // where the weight ratio allows for the weighted projection.
+   void PRSolution::RAIMScreen(const vector< vector<int> >& Rejects,
+                               const vector<SatID::SatelliteSystem>& Syss,
+                               const Matrix<double>& P,
+                               const Matrix<double>& Cov,
+                               const Matrix<double>& iMC,
+                               const Vector<double>& Resids,
+                               vector<size_t>& order,
+                               vector<double>& lower) const throw()
+   {
+      const size_t n(P.rows()), ncombo(Rejects.size());
+      size_t c,i,k;
+
+      // by default, compute them all in the usual order
+      order.resize(ncombo);
+      for(c=0; c<ncombo; c++) order[c] = c;
+      lower.assign(ncombo,0.0);
+
+      // too few data left to estimate; let the full solution say so
+      if(Rejects.empty() || n < P.cols() + Rejects[0].size())
+         return;
+
+      try {
+         const Matrix<double> PT(transpose(P));
+         const Matrix<double> CPT(Cov * PT);
+         const Matrix<double> H(P * CPT);
+         Vector<double> wt(n,1.0);
+         if(iMC.rows() > 0)
+            for(i=0; i<n; i++) wt(i) = iMC(i,i);
+         double wmin(wt(0)),wmax(wt(0));
+         for(i=1; i<n; i++) {
+            if(wt(i) < wmin) wmin = wt(i);
+            if(wt(i) > wmax) wmax = wt(i);
+         }
+         if(wmin <= 0.0) return;
+         const double wratio(SQRT(wmax/wmin));
+         const double convBound(2.0*SQRT(2.0)*ConvergenceLimit);
+
+         // Resids are the pre-fit residuals of the last iteration; get the
+         // correction and the post-fit residuals of that linear problem
+         Vector<double> Wr(n);
+         for(i=0; i<n; i++) Wr(i) = wt(i)*Resids(i);
+         const Vector<double> dX(CPT * Wr);
+         const Vector<double> post(Resids - P * dX);
+
+         // count satellites in each system
+         map<SatID::SatelliteSystem,int> nsys;
+         for(i=0; i<n; i++) nsys[Syss[i]]++;
+
+         vector<bool> rejected(n,false);
+         for(c=0; c<ncombo; c++) {
+            const vector<int>& rej(Rejects[c]);
+            const size_t m(rej.size());
+
+            // if all of a system is rejected, the solution loses a clock
+            map<SatID::SatelliteSystem,int> nrej;
+            bool sysGone(false);
+            for(k=0; k<m; k++)
+               if(++nrej[Syss[rej[k]]] == nsys[Syss[rej[k]]]) sysGone = true;
+            if(sysGone) continue;
+
+            Matrix<double> M(m,m);
+            Vector<double> rS(m);
+            bool singular(false);
+            for(k=0; k<m; k++) {
+               rS(k) = post(rej[k]);
+               for(i=0; i<m; i++) M(k,i) = -H(rej[k],rej[i]);
+               M(k,k) += 1.0/wt(rej[k]);
+               // cf. the slope: the rest of the data does not determine this one
+               if(M(k,k)*wt(rej[k]) < 1.e-8) singular = true;
+            }
+            if(singular) continue;
+
+            Vector<double> y;
+            try { y = inverseLUD(M) * rS; }
+            catch(Exception& e) { continue; }
+
+            double sum(0.0);
+            for(k=0; k<m; k++) rejected[rej[k]] = true;
+            for(i=0; i<n; i++) {
+               if(rejected[i]) continue;
+               double res(post(i));
+               for(k=0; k<m; k++) res += H(i,rej[k]) * y(k);
+               sum += res*res;
+            }
+            for(k=0; k<m; k++) rejected[rej[k]] = false;
+
+            // change in position from the point of linearization
+            double d(0.0);
+            for(i=0; i<3; i++) {
+               double dx(dX(i));
+               for(k=0; k<m; k++) dx -= CPT(i,rej[k]) * y(k);
+               d += dx*dx;
+            }
+            d = SQRT(d);
+
+            double bound(convBound
+                   + wratio*(d*d/(2.0*RAIMScreenRange) + RAIMScreenSlope*d));
+            double rms(SQRT(sum/double(n-m)));
+            if(rms > bound) lower[c] = rms - bound;
+         }
+
+         // sort by the lower bound, keeping the usual order among equals
+         vector< pair<double,size_t> > sorted;
+         for(c=0; c<ncombo; c++) sorted.push_back(make_pair(lower[c],c));
+         sort(sorted.begin(), sorted.end());
+         for(c=0; c<ncombo; c++) {
+            lower[c] = sorted[c].first;
+            order[c] = sorted[c].second;
+         }
+      }
+      catch(Exception& e) {
+         // cannot screen; compute them all
+         for(c=0; c<ncombo; c++) order[c] = c;
+         lower.assign(ncombo,0.0);
+      }
+   }
+
    // -------------------------------------------------------------------------
    int PRSolution::DOPCompute(void) throw(Exception)
    {
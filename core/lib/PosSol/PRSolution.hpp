@@ -48,6 +48,7 @@
 #include "RinexSatID.hpp"
 #include "Stats.hpp"
 #include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 #include "Namelist.hpp"
 #include "XvtStore.hpp"
 #include "TropModel.hpp"
@@ -65,8 +66,9 @@ namespace gpstk
       std::string msg;
       std::string lab[3];
       Stats<double> S[3];
-      Matrix<double> sumInfo;
-      Vector<double> sumInfoState,Sbias;
+      // position only, so fixed size; add() is called for every epoch
+      FixedMatrix<double,3,3> sumInfo;
+      FixedVector<double,3> sumInfoState,Sbias;
 
    public:
 
@@ -88,18 +90,19 @@ namespace gpstk
          return (getCov()*sumInfoState + Sbias);
       }
 
-      Matrix<double> getCov(void) const { return inverseSVD(sumInfo); }
+      Matrix<double> getCov(void) const { return inverseSVD(getInfo()); }
 
-      Matrix<double> getInfo(void) const { return sumInfo; }
+      Matrix<double> getInfo(void) const
+         { return (N > 0 ? Matrix<double>(sumInfo) : Matrix<double>()); }
 
       int getN(void) const { return N; }
 
       void reset(void) throw()
       {
          N = 0;
-         sumInfo = Matrix<double>();
-         sumInfoState = Vector<double>();
-         Sbias = Vector<double>(3);
+         sumInfo = 0.0;
+         sumInfoState = 0.0;
+         Sbias = 0.0;
          S[0].Reset();
          S[1].Reset();
          S[2].Reset();
@@ -117,17 +120,13 @@ namespace gpstk
             }
 
             // NB do NOT include clock(s); this can ruin the position average
-            Vector<double> Sol3(Sol);
-            Sol3.resize(3);               // assumes position states come first
-            Sol3 = Sol3 - Sbias;
-            Matrix<double> Cov3(Cov,0,0,3,3);
+            FixedVector<double,3> Sol3;
+            for(unsigned int i=0; i<3; i++)  // assumes position states come first
+               Sol3[i] = Sol(i) - Sbias[i];
+            FixedMatrix<double,3,3> Cov3(Cov,0,0);
 
             // information matrix (position only)
-            Matrix<double> Info(inverseSVD(Cov3));
-            if(N == 0) {                  // first call: dimension and set to zero
-               sumInfo = Matrix<double>(3,3,0.0);
-               sumInfoState = Vector<double>(3,0.0);
-            }
+            FixedMatrix<double,3,3> Info(inverseSVD(Cov3));
 
             // add to the total information
             sumInfo += Info;
@@ -387,6 +386,7 @@ namespace gpstk
                              MaxNIterations(10),
                              ConvergenceLimit(3.e-7),
                              hasMemory(true),
+                             IncrementalRAIM(false),
                              Valid(false)
          {}
       /// Return the status of solution
@@ -430,6 +430,20 @@ namespace gpstk
       /// and a combined weighted average solution.
       bool hasMemory;
 
+      /// If true, RAIMCompute() does not compute a full solution for every
+      /// combination of rejected satellites. Instead it downdates the
+      /// all-satellite solution (Sherman-Morrison-Woodbury, linearized at the
+      /// all-satellite solution) to predict the RMS residual of each
+      /// combination, with a bound on the error of the prediction (see
+      /// RAIMScreen()). It then computes full solutions in order of the lower
+      /// bound on the RMS residual, and stops when that bound exceeds the best
+      /// RMS residual found, so that the selection is the same as that of the
+      /// full search. Combinations the downdate cannot predict (e.g. one that
+      /// rejects every satellite of a system) are always computed. The screen
+      /// is not used when the measurement covariance is not diagonal, or the
+      /// trop correction could not be applied to the all-satellite solution.
+      bool IncrementalRAIM;
+
       // input and output: -------------------------------------------------
 
       /// vector<SatID> containing satellite IDs for all the satellites input, with
@@ -627,6 +641,29 @@ namespace gpstk
                       TropModel *pTropModel)
          throw(Exception);
 
+      /// Compute a RAIM position/time solution, as above, but given the
+      /// satellites, systems and SVP matrix as output by PreparePRSolution().
+      /// This allows the ephemeris to be evaluated separately, e.g. ahead of
+      /// time on another thread, since PreparePRSolution() does not change
+      /// this object.
+      /// @param Tr          Measured time of reception of the data.
+      /// @param Satellites  std::vector<SatID> of satellites, as marked by
+      ///                    PreparePRSolution(); on return, as above.
+      /// @param Systems     std::vector<SatID::SatelliteSystem>, as output by
+      ///                    PreparePRSolution().
+      /// @param SVP         gpstk::Matrix<double> output by PreparePRSolution().
+      /// @param invMC       gpstk::Matrix<double> inverse measurement covariance,
+      ///                    as above.
+      /// @param pTropModel  pointer to gpstk::TropModel for trop correction.
+      /// @return Return values as above.
+      int RAIMCompute(const CommonTime& Tr,
+                      std::vector<SatID>& Satellites,
+                      std::vector<SatID::SatelliteSystem>& Systems,
+                      const Matrix<double>& SVP,
+                      const Matrix<double>& invMC,
+                      TropModel *pTropModel)
+         throw(Exception);
+
       /// Compute DOPs using the partials matrix from the last successful solution.
       /// RAIMCompute(), if successful, calls this before returning.
       /// Results stored in PRSolution::TDOP,PDOP,GDOP.
@@ -681,6 +718,34 @@ namespace gpstk
       /// empty vector used to detect default
       static const Vector<double> PRSNullVector;
 
+      /// Lower limit (m) on the range to any satellite, used by RAIMScreen() to
+      /// bound the curvature of the range over a change in position.
+      static const double RAIMScreenRange;
+
+      /// Upper limit on the change in the trop and earth rotation corrections
+      /// per meter of change in position, used by RAIMScreen(); this allows
+      /// for the trop at elevations down to about one degree.
+      static const double RAIMScreenSlope;
+
+      /// Used by RAIMCompute() when IncrementalRAIM is set. Given the
+      /// combinations Rejects of the good satellites to reject (indexes into the
+      /// rows of P), and the partials P, covariance Cov, inverse measurement
+      /// covariance iMC and residuals Resids of the last iteration of the
+      /// solution using all the good satellites, with the system of each in
+      /// Syss, compute a lower bound on the RMS residual of the full solution
+      /// for each combination. Return in order the indexes of Rejects sorted by
+      /// that bound, and in lower the bounds in the same order; zero means the
+      /// combination could not be screened and must be computed. If nothing can
+      /// be screened, order is the usual order and every bound is zero.
+      void RAIMScreen(const std::vector< std::vector<int> >& Rejects,
+                      const std::vector<SatID::SatelliteSystem>& Syss,
+                      const Matrix<double>& P,
+                      const Matrix<double>& Cov,
+                      const Matrix<double>& iMC,
+                      const Vector<double>& Resids,
+                      std::vector<size_t>& order,
+                      std::vector<double>& lower) const throw();
+
    }; // end class PRSolution
 
    //@}
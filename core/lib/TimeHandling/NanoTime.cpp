@@ -0,0 +1,157 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file NanoTime.cpp
+ * Compact integer time tag for inner loops and container keys.
+ */
+
+#include <cmath>
+#include "NanoTime.hpp"
+#include "TimeConstants.hpp"
+#include "StringUtils.hpp"
+
+namespace gpstk
+{
+   const int64_t NanoTime::NS_PER_SEC;
+   const int64_t NanoTime::NS_PER_DAY;
+   const int64_t NanoTime::BEGINNING_NS;
+   const int64_t NanoTime::END_NS;
+
+      // earliest representable NanoTime
+   const NanoTime
+   NanoTime::BEGINNING_OF_TIME(NanoTime::BEGINNING_NS, TimeSystem::Any);
+      // latest representable NanoTime
+   const NanoTime
+   NanoTime::END_OF_TIME(NanoTime::END_NS, TimeSystem::Any);
+
+      /// 'julian day' of the GPS epoch, the zero of the count.
+   static const long EPOCH_JDAY = GPS_EPOCH_MJD + MJD_JDAY;
+      /// Number of whole days either side of the epoch that fit in the
+      /// count, leaving room for the sentinel values.
+   static const long LIMIT_DAYS = 106750L;
+
+
+   void NanoTime ::
+   convertFromCommonTime(const CommonTime& ct)
+   {
+      long day, msod;
+      double fsod;
+      TimeSystem ts;
+      ct.getInternal(day, msod, fsod, ts);
+      sys = ts.getTimeSystem();
+
+      if (day == CommonTime::BEGIN_LIMIT_JDAY && msod == 0 && fsod == 0.)
+      {
+         ns = BEGINNING_NS;
+         return;
+      }
+      if (day == CommonTime::END_LIMIT_JDAY && msod == 0 && fsod == 0.)
+      {
+         ns = END_NS;
+         return;
+      }
+
+      long days = day - EPOCH_JDAY;
+      if (days < -LIMIT_DAYS || days > LIMIT_DAYS)
+      {
+         InvalidParameter ip("Time is outside the range of NanoTime: " +
+                             ct.asString());
+         GPSTK_THROW(ip);
+      }
+
+      ns = static_cast<int64_t>(days) * NS_PER_DAY
+         + static_cast<int64_t>(msod) * 1000000LL
+         + static_cast<int64_t>(std::floor(fsod * 1e9 + 0.5));
+   }
+
+
+   CommonTime NanoTime ::
+   convertToCommonTime() const
+   {
+      CommonTime ct;
+      if (ns == BEGINNING_NS)
+      {
+         ct = CommonTime::BEGINNING_OF_TIME;
+      }
+      else if (ns == END_NS)
+      {
+         ct = CommonTime::END_OF_TIME;
+      }
+      else
+      {
+            // floor division so times before the epoch have a
+            // non-negative time of day
+         int64_t days = ns / NS_PER_DAY;
+         int64_t rem = ns % NS_PER_DAY;
+         if (rem < 0)
+         {
+            days--;
+            rem += NS_PER_DAY;
+         }
+         ct.setInternal(EPOCH_JDAY + static_cast<long>(days),
+                        static_cast<long>(rem / 1000000LL),
+                        static_cast<double>(rem % 1000000LL) * 1e-9);
+      }
+      ct.setTimeSystem(TimeSystem(sys));
+      return ct;
+   }
+
+
+   std::string NanoTime ::
+   asString() const
+   {
+      return StringUtils::asString(ns) + " " + TimeSystem(sys).asString();
+   }
+
+
+   bool NanoTime ::
+   throwSystemMismatch(const NanoTime& right) const
+   {
+      InvalidRequest ir("NanoTime objects not in same time system, cannot"
+                        " be compared: " + TimeSystem(sys).asString() +
+                        " != " + TimeSystem(right.sys).asString());
+      GPSTK_THROW(ir);
+   }
+
+
+   std::ostream& operator<<(std::ostream& o, const NanoTime& nt)
+   {
+      o << nt.asString();
+      return o;
+   }
+
+} // namespace
@@ -0,0 +1,247 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file NanoTime.hpp
+ * Compact integer time tag for inner loops and container keys.
+ */
+
+#ifndef GPSTK_NANOTIME_HPP
+#define GPSTK_NANOTIME_HPP
+
+#include "gpstkplatform.h"
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A time held as a signed 64-bit count of nanoseconds since the
+       * GPS epoch (1980/01/06 00:00:00), along with its time system.
+       *
+       * NanoTime is intended for code that does a lot of time
+       * arithmetic and comparison, e.g. the keys of ephemeris stores
+       * and the time tags of data being processed an epoch at a
+       * time.  Differences, offsets and comparisons are done on the
+       * integer count with no normalization, and the object is 16
+       * bytes with no virtual functions, so it may be copied with
+       * memcpy and stored in arrays.
+       *
+       * The range is about +/-292 years from the GPS epoch (1688 to
+       * 2272).  CommonTime::BEGINNING_OF_TIME and
+       * CommonTime::END_OF_TIME are represented by BEGINNING_OF_TIME
+       * and END_OF_TIME, which are the extreme values of the count.
+       *
+       * A NanoTime converts to CommonTime and back without loss.
+       * CommonTime holds fractions of a nanosecond, which are rounded
+       * to the nearest nanosecond when converting the other way.
+       *
+       * The time system rules are those of CommonTime: two times may
+       * be compared or differenced if their systems are the same or
+       * either is TimeSystem::Any.
+       */
+   class NanoTime
+   {
+   public:
+         /// Nanoseconds in one second.
+      static const int64_t NS_PER_SEC = 1000000000LL;
+         /// Nanoseconds in one day.
+      static const int64_t NS_PER_DAY = 86400LL * NS_PER_SEC;
+         /// The count representing CommonTime::BEGINNING_OF_TIME.
+      static const int64_t BEGINNING_NS = INT64_MIN;
+         /// The count representing CommonTime::END_OF_TIME.
+      static const int64_t END_NS = INT64_MAX;
+
+         /// earliest representable NanoTime (CommonTime::BEGINNING_OF_TIME)
+      static const NanoTime BEGINNING_OF_TIME;
+         /// latest representable NanoTime (CommonTime::END_OF_TIME)
+      static const NanoTime END_OF_TIME;
+
+         /// Default constructor, the GPS epoch in an unknown time system.
+      constexpr NanoTime()
+            : ns(0), sys(TimeSystem::Unknown)
+      {}
+
+         /** Construct from a count of nanoseconds.
+          * @param[in] nanoseconds time since the GPS epoch.
+          * @param[in] ts the time system. */
+      constexpr explicit NanoTime(int64_t nanoseconds,
+                                  TimeSystem::Systems ts=TimeSystem::Unknown)
+            : ns(nanoseconds), sys(ts)
+      {}
+
+         /** Convert from CommonTime, rounding to the nearest nanosecond.
+          * @throw InvalidParameter if the time is out of range. */
+      explicit NanoTime(const CommonTime& ct)
+      { convertFromCommonTime(ct); }
+
+         /** Convert from CommonTime, rounding to the nearest nanosecond.
+          * @throw InvalidParameter if the time is out of range. */
+      void convertFromCommonTime(const CommonTime& ct);
+
+         /// Convert to CommonTime.
+      CommonTime convertToCommonTime() const;
+
+         /// Return the nanoseconds since the GPS epoch.
+      constexpr int64_t getNanoseconds() const
+      { return ns; }
+
+         /// Return the time system.
+      TimeSystem getTimeSystem() const
+      { return TimeSystem(sys); }
+
+         /// Set the time system.
+      void setTimeSystem(const TimeSystem& ts)
+      { sys = ts.getTimeSystem(); }
+
+         /**
+          * @name NanoTime Arithmetic Operations
+          * Offsets in seconds are rounded to the nearest nanosecond.
+          * The result of going beyond the range of the count is
+          * undefined.
+          */
+         //@{
+         /** Difference two times.
+          * @return the difference in seconds.
+          * @throw InvalidRequest if the time systems differ. */
+      constexpr double operator-(const NanoTime& right) const
+      { return diffNanoseconds(right) * 1e-9; }
+
+         /** Difference two times.
+          * @return the difference in nanoseconds.
+          * @throw InvalidRequest if the time systems differ. */
+      constexpr int64_t diffNanoseconds(const NanoTime& right) const
+      { return checkSystem(right) ? ns - right.ns : 0; }
+
+         /// Add nanoseconds to this time.
+      NanoTime& addNanoseconds(int64_t nanoseconds)
+      {
+         ns += nanoseconds;
+         return *this;
+      }
+
+         /// Add seconds to this time.
+      NanoTime& addSeconds(double seconds)
+      {
+         ns += secondsToNs(seconds);
+         return *this;
+      }
+
+      NanoTime& operator+=(double seconds)
+      { return addSeconds(seconds); }
+
+      NanoTime& operator-=(double seconds)
+      { return addSeconds(-seconds); }
+
+      constexpr NanoTime operator+(double seconds) const
+      { return NanoTime(ns + secondsToNs(seconds), sys); }
+
+      constexpr NanoTime operator-(double seconds) const
+      { return NanoTime(ns - secondsToNs(seconds), sys); }
+
+         /** Return this time plus nanoseconds; the constexpr
+          * counterpart of addNanoseconds(). */
+      constexpr NanoTime plusNanoseconds(int64_t nanoseconds) const
+      { return NanoTime(ns + nanoseconds, sys); }
+         //@}
+
+         /**
+          * @name NanoTime Comparison Operators
+          * Times compare by their count of nanoseconds.  Times in
+          * different systems are never equal, and ordering them
+          * throws InvalidRequest, as with CommonTime.
+          */
+         //@{
+      constexpr bool operator==(const NanoTime& right) const
+      { return ns == right.ns && compatible(right); }
+
+      constexpr bool operator!=(const NanoTime& right) const
+      { return !operator==(right); }
+
+      constexpr bool operator<(const NanoTime& right) const
+      { return checkSystem(right) && ns < right.ns; }
+
+      constexpr bool operator>(const NanoTime& right) const
+      { return right.operator<(*this); }
+
+      constexpr bool operator<=(const NanoTime& right) const
+      { return !right.operator<(*this); }
+
+      constexpr bool operator>=(const NanoTime& right) const
+      { return !operator<(right); }
+         //@}
+
+      std::string asString() const;
+
+   private:
+         /// True if the time systems allow comparison.
+      constexpr bool compatible(const NanoTime& right) const
+      {
+         return (sys == right.sys || sys == TimeSystem::Any ||
+                 right.sys == TimeSystem::Any);
+      }
+
+         /** Return true, or throw InvalidRequest if the time systems
+          * are incompatible.  The throw is only reached outside a
+          * constant expression, so the callers can be constexpr. */
+      constexpr bool checkSystem(const NanoTime& right) const
+      { return compatible(right) ? true : throwSystemMismatch(right); }
+
+         /** Throw InvalidRequest for incompatible time systems; kept
+          * out of line so the comparisons stay small.
+          * @return never returns. */
+      bool throwSystemMismatch(const NanoTime& right) const;
+
+         /// Round seconds to nanoseconds.
+      static constexpr int64_t secondsToNs(double seconds)
+      {
+         return static_cast<int64_t>(seconds < 0 ? seconds * 1e9 - 0.5
+                                                 : seconds * 1e9 + 0.5);
+      }
+
+      int64_t ns;                ///< nanoseconds since the GPS epoch
+      TimeSystem::Systems sys;   ///< time system of the count
+   }; // end class NanoTime
+
+   std::ostream& operator<<(std::ostream& o, const NanoTime& nt);
+
+      //@}
+
+} // namespace
+
+#endif // GPSTK_NANOTIME_HPP
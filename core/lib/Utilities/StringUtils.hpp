@@ -44,6 +44,9 @@
 
 #include <string>
 #include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -730,6 +733,74 @@ namespace gpstk
       inline unsigned long asUnsigned(const std::string& s)
       { return strtoul(s.c_str(), 0, 10); }
 
+         /**
+          * Convert a fixed-width field of characters to a double
+          * precision floating point number without copying the field
+          * into a temporary string.  The result is identical to
+          * asDouble(std::string(s, len)).
+          * @param s pointer to the first character of the field.
+          * @param len number of characters in the field.
+          * @return double representation of the field.
+          */
+      inline double asDouble(const char* s, std::string::size_type len);
+
+         /**
+          * Convert a fixed-width field of characters to an integer
+          * without copying the field into a temporary string.  The
+          * result is identical to asInt(std::string(s, len)).
+          * @param s pointer to the first character of the field.
+          * @param len number of characters in the field.
+          * @return long integer representation of the field.
+          */
+      inline long asInt(const char* s, std::string::size_type len);
+
+         /**
+          * Convert a fixed-width field of characters to an unsigned
+          * integer without copying the field into a temporary string.
+          * The result is identical to asUnsigned(std::string(s, len)).
+          * @param s pointer to the first character of the field.
+          * @param len number of characters in the field.
+          * @return unsigned long integer representation of the field.
+          */
+      inline unsigned long asUnsigned(const char* s,
+                                      std::string::size_type len);
+
+         /**
+          * Convert the fixed-width field of \a len characters
+          * starting at \a pos in \a s to a double precision floating
+          * point number, without copying it into a temporary string.
+          * The field is clipped at the end of \a s, and the result is
+          * identical to asDouble(s.substr(pos, len)).
+          * @throw std::out_of_range if pos > s.length().
+          */
+      inline double asDouble(const std::string& s,
+                             std::string::size_type pos,
+                             std::string::size_type len);
+
+         /**
+          * Convert the fixed-width field of \a len characters
+          * starting at \a pos in \a s to an integer, without copying
+          * it into a temporary string.  The field is clipped at the
+          * end of \a s, and the result is identical to
+          * asInt(s.substr(pos, len)).
+          * @throw std::out_of_range if pos > s.length().
+          */
+      inline long asInt(const std::string& s,
+                        std::string::size_type pos,
+                        std::string::size_type len);
+
+         /**
+          * Convert the fixed-width field of \a len characters
+          * starting at \a pos in \a s to an unsigned integer, without
+          * copying it into a temporary string.  The field is clipped
+          * at the end of \a s, and the result is identical to
+          * asUnsigned(s.substr(pos, len)).
+          * @throw std::out_of_range if pos > s.length().
+          */
+      inline unsigned long asUnsigned(const std::string& s,
+                                      std::string::size_type pos,
+                                      std::string::size_type len);
+
          /**
           * Convert a string to a single precision floating point number.
           * @param s string containing a number.
@@ -1249,6 +1320,17 @@ namespace gpstk
                              const std::string::size_type startPos = 0,
                              const std::string::size_type length = std::string::npos);
 
+         /**
+          * Convert FORTRAN representation of a double precision
+          * floating point number in a fixed-width field to a number,
+          * without copying the field into a temporary string.  The
+          * result is identical to for2doub(std::string(s, len)).
+          * @param s pointer to the first character of the field.
+          * @param len number of characters in the field.
+          * @return value of the number.
+          */
+      inline double for2doub(const char* s, std::string::size_type len);
+
          /**
           * Change a string into printable characters.  Control
           * characters 0, 1, ... 31 are changed to ^@, ^A, ... ^_ ;
@@ -1600,6 +1682,175 @@ namespace gpstk
          }
       }
 
+         /// Return true if \a c is white space as defined by isspace()
+         /// in the "C" locale, which is what strtod/strtol skip.
+      inline bool isFieldSpace(char c)
+      {
+         return ((c == ' ') || (c == '\t') || (c == '\n') ||
+                 (c == '\v') || (c == '\f') || (c == '\r'));
+      }
+
+      inline double asDouble(const char* s, std::string::size_type len)
+      {
+            // Exact powers of ten.  Any integer below 2^53 scaled by
+            // one of these with a single multiply or divide is
+            // correctly rounded, i.e. identical to strtod.
+         static const double pow10[] =
+            { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+         std::string::size_type i = 0;
+         while ((i < len) && isFieldSpace(s[i]))
+            i++;
+         bool negative = false;
+         if ((i < len) && ((s[i] == '-') || (s[i] == '+')))
+         {
+            negative = (s[i] == '-');
+            i++;
+         }
+         unsigned long long mantissa = 0;
+         int numDigits = 0, fracDigits = 0;
+         while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
+         {
+            mantissa = mantissa * 10 + (s[i++] - '0');
+            numDigits++;
+         }
+         if ((i < len) && (s[i] == '.'))
+         {
+            i++;
+            while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
+            {
+               mantissa = mantissa * 10 + (s[i++] - '0');
+               numDigits++;
+               fracDigits++;
+            }
+         }
+         int exponent = 0;
+         bool simple = ((numDigits > 0) && (numDigits <= 15));
+         if (simple && (i < len) && ((s[i] == 'e') || (s[i] == 'E')))
+         {
+            std::string::size_type j = i+1;
+            bool negExp = false;
+            if ((j < len) && ((s[j] == '-') || (s[j] == '+')))
+            {
+               negExp = (s[j] == '-');
+               j++;
+            }
+               // an 'e' with no digits after it is not part of the number
+            if ((j < len) && (s[j] >= '0') && (s[j] <= '9'))
+            {
+               int expDigits = 0;
+               while ((j < len) && (s[j] >= '0') && (s[j] <= '9'))
+               {
+                  exponent = exponent * 10 + (s[j++] - '0');
+                  if (++expDigits > 4)
+                     simple = false;
+               }
+               if (negExp)
+                  exponent = -exponent;
+               i = j;
+            }
+         }
+            // hexadecimal (e.g. "0x1p3") is left to strtod
+         if (simple && (i < len) && ((s[i] == 'x') || (s[i] == 'X')))
+            simple = false;
+         exponent -= fracDigits;
+         if (simple && (exponent >= -22) && (exponent <= 22))
+         {
+            double rv = static_cast<double>(mantissa);
+            if (exponent < 0)
+               rv /= pow10[-exponent];
+            else
+               rv *= pow10[exponent];
+            return (negative ? -rv : rv);
+         }
+            // anything unusual (long mantissa, inf, nan, ...) goes
+            // through strtod, using the stack when possible
+         char buf[64];
+         if (len < sizeof(buf))
+         {
+            std::copy(s, s+len, buf);
+            buf[len] = 0;
+            return strtod(buf, 0);
+         }
+         return asDouble(std::string(s, len));
+      }
+
+      inline long asInt(const char* s, std::string::size_type len)
+      {
+         std::string::size_type i = 0;
+         while ((i < len) && isFieldSpace(s[i]))
+            i++;
+         bool negative = false;
+         if ((i < len) && ((s[i] == '-') || (s[i] == '+')))
+         {
+            negative = (s[i] == '-');
+            i++;
+         }
+         long rv = 0;
+         int numDigits = 0;
+         while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
+         {
+               // let strtol deal with overflow
+            if (++numDigits > std::numeric_limits<long>::digits10)
+               return asInt(std::string(s, len));
+            rv = rv * 10 + (s[i++] - '0');
+         }
+         return (negative ? -rv : rv);
+      }
+
+      inline unsigned long asUnsigned(const char* s,
+                                      std::string::size_type len)
+      {
+         std::string::size_type i = 0;
+         while ((i < len) && isFieldSpace(s[i]))
+            i++;
+         bool negative = false;
+         if ((i < len) && ((s[i] == '-') || (s[i] == '+')))
+         {
+            negative = (s[i] == '-');
+            i++;
+         }
+         unsigned long rv = 0;
+         int numDigits = 0;
+         while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
+         {
+               // let strtoul deal with overflow
+            if (++numDigits > std::numeric_limits<unsigned long>::digits10)
+               return asUnsigned(std::string(s, len));
+            rv = rv * 10 + (s[i++] - '0');
+         }
+            // strtoul negates in unsigned arithmetic
+         return (negative ? -rv : rv);
+      }
+
+         /// Return the length of the field of len characters at pos
+         /// in s, clipped at the end of s, as substr() does.
+      inline std::string::size_type fieldLength(const std::string& s,
+                                                std::string::size_type pos,
+                                                std::string::size_type len)
+      {
+         if (pos > s.length())
+            throw std::out_of_range("StringUtils: field position " +
+                                    asString(pos) + " is past the end");
+         return std::min(len, s.length() - pos);
+      }
+
+      inline double asDouble(const std::string& s,
+                             std::string::size_type pos,
+                             std::string::size_type len)
+      { return asDouble(s.data() + pos, fieldLength(s, pos, len)); }
+
+      inline long asInt(const std::string& s,
+                        std::string::size_type pos,
+                        std::string::size_type len)
+      { return asInt(s.data() + pos, fieldLength(s, pos, len)); }
+
+      inline unsigned long asUnsigned(const std::string& s,
+                                      std::string::size_type pos,
+                                      std::string::size_type len)
+      { return asUnsigned(s.data() + pos, fieldLength(s, pos, len)); }
+
       inline long double asLongDouble(const std::string& s)
          throw(StringException)
       {
@@ -2666,28 +2917,73 @@ namespace gpstk
                              const std::string::size_type startPos,
                              const std::string::size_type length)
       {
-         std::string s(aStr, startPos, length);
-         strip(s);
+         return for2doub(aStr.data() + startPos,
+                         fieldLength(aStr, startPos, length));
+      }
+
 
-            // you can blame Rinex for these special checks
-         if (s.empty())
+      inline double for2doub(const char* s, std::string::size_type len)
+      {
+            // you can blame Rinex for these special checks: the
+            // first of 'E', 'D' or 'd' is the exponent character.
+         std::string::size_type expPos = 0;
+         while ((expPos < len) && (s[expPos] != 'E') &&
+                (s[expPos] != 'D') && (s[expPos] != 'd'))
+            expPos++;
+         if (expPos == len)
          {
-            return 0;
+               // just treat it like a double
+            return asDouble(s, len);
          }
 
-         std::string::size_type pos = s.find_first_of("EDd");
-         if (pos != std::string::npos)
+            // A well-formed number, i.e. "[sign]digits[.digits]" then
+            // the exponent character, "[sign]digits", is converted by
+            // strtod exactly as std::istream would, except that the
+            // stream turns an overflow into the largest double.
+         std::string::size_type i = 0;
+         while ((i < len) && isFieldSpace(s[i]))
+            i++;
+         if ((i < len) && ((s[i] == '-') || (s[i] == '+')))
+            i++;
+         int numDigits = 0;
+         while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
          {
-            s[pos] = 'e';
+            i++;
+            numDigits++;
          }
-         else
+         if ((i < len) && (s[i] == '.'))
          {
-               // just treat it like a double
-            return asDouble(aStr.substr(startPos, length));
+            i++;
+            while ((i < len) && (s[i] >= '0') && (s[i] <= '9'))
+            {
+               i++;
+               numDigits++;
+            }
+         }
+         std::string::size_type j = expPos+1;
+         if ((j < len) && ((s[j] == '-') || (s[j] == '+')))
+            j++;
+         char buf[64];
+         if ((numDigits > 0) && (i == expPos) && (j < len) &&
+             (s[j] >= '0') && (s[j] <= '9') && (len < sizeof(buf)))
+         {
+            std::copy(s, s+len, buf);
+            buf[expPos] = 'e';
+            double d = asDouble(buf, len);
+            if (d == std::numeric_limits<double>::infinity())
+               return std::numeric_limits<double>::max();
+            if (d == -std::numeric_limits<double>::infinity())
+               return -std::numeric_limits<double>::max();
+            return d;
          }
 
+            // anything else goes the long way round
+         std::string str(s, len);
+         strip(str);
+         str[str.find_first_of("EDd")] = 'e';
+
          std::stringstream st;
-         st << s;
+         st << str;
 
          double d;
          st >> d;
@@ -276,6 +276,17 @@ public:
    /// @endcode
    static std::ostream*& Stream();
 
+   /// direct the log output of the calling thread only to another stream, e.g.
+   /// to buffer it so that the output of several threads can be written in order.
+   /// While this is not NULL (the default), Stream() returns it in this thread.
+   /// @code
+   ///    std::ostringstream oss;
+   ///    ConfigureLOGstream::ThreadStream() = &oss;
+   ///    // ... LOG output of this thread goes to oss
+   ///    ConfigureLOGstream::ThreadStream() = NULL;
+   /// @endcode
+   static std::ostream*& ThreadStream();
+
    /// used internally
    static void Output(const std::string& msg);
 };
@@ -283,7 +294,14 @@ public:
 inline std::ostream*& ConfigureLOGstream::Stream()
 {
    static std::ostream *pStream = &(std::cout);
-   return pStream;
+   std::ostream*& pThread = ThreadStream();
+   return (pThread ? pThread : pStream);
+}
+
+inline std::ostream*& ConfigureLOGstream::ThreadStream()
+{
+   static thread_local std::ostream *pThread = NULL;
+   return pThread;
 }
 
 inline void ConfigureLOGstream::Output(const std::string& msg)
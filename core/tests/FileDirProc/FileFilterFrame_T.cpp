@@ -0,0 +1,347 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FileFilterFrameWithHeader.hpp"
+#include "RinexMetStream.hpp"
+#include "RinexMetHeader.hpp"
+#include "RinexMetData.hpp"
+#include "RinexMetFilterOperators.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "RinexObsFilterOperators.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+using namespace gpstk;
+
+typedef FileFilterFrameWithHeader<RinexMetStream, RinexMetData, RinexMetHeader>
+MetFFF;
+typedef FileFilterFrameWithHeader<RinexObsStream, RinexObsData, RinexObsHeader>
+ObsFFF;
+
+   // Sets the time of the first obs in the header, as mergeRinObs does.
+struct SetFirstObs
+{
+   void operator()(RinexObsHeader& h, const RinexObsData& first) const
+   { h.firstObs = first.time; }
+};
+
+class FileFilterFrame_T
+{
+public:
+   FileFilterFrame_T();
+
+      /// Compare mergeFiles() with sort() and unique() on sorted files.
+   unsigned mergeSortedTest();
+      /// Compare mergeFiles() with sort() and unique() on a file that
+      /// is out of order, forcing the records set aside to be written
+      /// to temporary files.
+   unsigned mergeUnsortedTest();
+      /// Compare mergeFiles() with sort() and unique() on files that
+      /// overlap, with different records at the same times, and are
+      /// out of order, ordered by time only, so that which of the
+      /// records at a time is kept depends on the order of the input.
+   unsigned mergeTiesTest();
+      /// Check that the header written is updated from the first
+      /// record, as mergeRinObs sets the time of the first obs.
+   unsigned mergeHeaderTest();
+
+private:
+      /**
+       * Merge inputs in memory and with mergeFiles() and compare.
+       * @param[in] timeOnly order the records by time only, rather
+       *   than by time and data.
+       */
+   void compareMerge(TestUtil& testFramework,
+                     const vector<string>& inputs,
+                     const string& base,
+                     unsigned long maxRecords,
+                     bool timeOnly = false);
+      /// Write the data of fff to fn, in reverse order if reverse is
+      /// true, after adding offset to each value.
+   void writeMet(MetFFF& fff, const string& fn, bool reverse, double offset);
+      /// Return the contents of a file, less the PGM / RUN BY / DATE
+      /// line, whose time is that at which the file was written.
+   string readFile(const string& fn);
+      /// Return true if the file exists.
+   bool fileExists(const string& fn);
+
+   string dataPath, tempPath;
+};
+
+
+FileFilterFrame_T ::
+FileFilterFrame_T()
+      : dataPath(getPathData() + getFileSep()),
+        tempPath(getPathTestTemp() + getFileSep())
+{
+}
+
+
+void FileFilterFrame_T ::
+compareMerge(TestUtil& testFramework,
+             const vector<string>& inputs,
+             const string& base,
+             unsigned long maxRecords,
+             bool timeOnly)
+{
+   string memFile = tempPath + base + "_mem.out";
+   string streamFile = tempPath + base + "_stream.out";
+
+   MetFFF mem(inputs);
+   RinexMetHeaderTouchHeaderMerge merged;
+   mem.touchHeader(merged);
+   if (timeOnly)
+      mem.sort(RinexMetDataOperatorLessThanSimple());
+   else
+      mem.sort(RinexMetDataOperatorLessThanFull(merged.obsSet));
+   mem.unique(RinexMetDataOperatorEqualsSimple());
+   int memFiltered = mem.getFiltered();
+   mem.writeFile(memFile, merged.theHeader);
+
+   MetFFF strm;
+   strm.newHeaderSource(inputs);
+   TUASSERTE(size_t, inputs.size(), strm.getHeaderCount());
+   RinexMetHeaderTouchHeaderMerge smerged;
+   strm.touchHeader(smerged);
+   unsigned long count;
+   if (timeOnly)
+      count = strm.mergeFiles(
+         inputs, streamFile, smerged.theHeader,
+         RinexMetDataOperatorLessThanSimple(),
+         RinexMetDataOperatorEqualsSimple(), maxRecords);
+   else
+      count = strm.mergeFiles(
+         inputs, streamFile, smerged.theHeader,
+         RinexMetDataOperatorLessThanFull(smerged.obsSet),
+         RinexMetDataOperatorEqualsSimple(), maxRecords);
+
+   TUASSERTE(unsigned long, mem.getDataCount(), count);
+   TUASSERTE(int, memFiltered, strm.getFiltered());
+   TUASSERT(readFile(memFile) == readFile(streamFile));
+      // temporary files are removed
+   for (int i = 0; i < 4; i++)
+   {
+      string temp = streamFile + ".merge" + StringUtils::asString(i);
+      TUASSERT(!fileExists(temp));
+      TUASSERT(!fileExists(temp + ".key"));
+   }
+}
+
+
+void FileFilterFrame_T ::
+writeMet(MetFFF& fff, const string& fn, bool reverse, double offset)
+{
+   list<RinexMetData> data(fff.getData());
+   if (reverse)
+      data.reverse();
+   RinexMetStream out(fn.c_str(), ios::out|ios::trunc);
+   out << fff.frontHeader();
+   list<RinexMetData>::iterator i;
+   for (i = data.begin(); i != data.end(); i++)
+   {
+      RinexMetData::RinexMetMap::iterator j;
+      for (j = i->data.begin(); j != i->data.end(); j++)
+         j->second += offset;
+      out << *i;
+   }
+}
+
+
+unsigned FileFilterFrame_T ::
+mergeSortedTest()
+{
+   TUDEF("FileFilterFrame", "mergeFiles");
+   vector<string> inputs;
+   inputs.push_back(dataPath + "arlm200a.15m");
+   inputs.push_back(dataPath + "arlm200b.15m");
+   compareMerge(testFramework, inputs, "FileFilterFrame_sorted",
+                MetFFF::defaultMergeRecords);
+      // the same file twice gives the file back
+   inputs[1] = inputs[0];
+   compareMerge(testFramework, inputs, "FileFilterFrame_twice",
+                MetFFF::defaultMergeRecords);
+   TURETURN();
+}
+
+
+unsigned FileFilterFrame_T ::
+mergeUnsortedTest()
+{
+   TUDEF("FileFilterFrame", "mergeFiles");
+      // write the data of a file in reverse order
+   string reversed = tempPath + "FileFilterFrame_reversed.15m";
+   MetFFF fff(dataPath + "arlm200a.15m");
+   TUASSERTE(size_t, 4, fff.getData().size());
+   writeMet(fff, reversed, true, 0);
+   vector<string> inputs;
+   inputs.push_back(reversed);
+   inputs.push_back(dataPath + "arlm200b.15m");
+      // records set aside in a temporary file
+   compareMerge(testFramework, inputs, "FileFilterFrame_unsorted", 3);
+      // all set aside in memory
+   compareMerge(testFramework, inputs, "FileFilterFrame_unsorted2",
+                MetFFF::defaultMergeRecords);
+   TURETURN();
+}
+
+
+unsigned FileFilterFrame_T ::
+mergeTiesTest()
+{
+   TUDEF("FileFilterFrame", "mergeFiles");
+      // copies of a file with different values at the same times,
+      // one in order and the other reversed
+   string shifted = tempPath + "FileFilterFrame_shifted.15m";
+   string shiftedRev = tempPath + "FileFilterFrame_shiftedrev.15m";
+   MetFFF fff(dataPath + "arlm200a.15m");
+   writeMet(fff, shifted, false, 1);
+   writeMet(fff, shiftedRev, true, 2);
+   vector<string> inputs;
+   inputs.push_back(shiftedRev);
+   inputs.push_back(dataPath + "arlm200a.15m");
+   inputs.push_back(shifted);
+   inputs.push_back(dataPath + "arlm200b.15m");
+   compareMerge(testFramework, inputs, "FileFilterFrame_ties", 3, true);
+   compareMerge(testFramework, inputs, "FileFilterFrame_ties2",
+                MetFFF::defaultMergeRecords, true);
+      // the first file in order decides, when the others are not
+   inputs[0] = shifted;
+   inputs[2] = shiftedRev;
+   compareMerge(testFramework, inputs, "FileFilterFrame_ties3", 3, true);
+   compareMerge(testFramework, inputs, "FileFilterFrame_ties4",
+                MetFFF::defaultMergeRecords, true);
+      // and with the full order, which keeps every record
+   compareMerge(testFramework, inputs, "FileFilterFrame_ties5", 3);
+   TURETURN();
+}
+
+
+unsigned FileFilterFrame_T ::
+mergeHeaderTest()
+{
+   TUDEF("FileFilterFrame", "mergeFiles");
+      // a copy of the second file whose header claims an earlier
+      // first obs than any of the data
+   string early = tempPath + "FileFilterFrame_early.15o";
+   {
+      ObsFFF fff(dataPath + "arlm200b.15o");
+      RinexObsHeader hdr(fff.frontHeader());
+      hdr.firstObs -= 86400;
+      RinexObsStream out(early.c_str(), ios::out|ios::trunc);
+      out << hdr;
+      list<RinexObsData>& data = fff.getData();
+      list<RinexObsData>::iterator i;
+      for (i = data.begin(); i != data.end(); i++)
+         out << *i;
+   }
+   vector<string> inputs;
+   inputs.push_back(early);
+   inputs.push_back(dataPath + "arlm200a.15o");
+
+   string memFile = tempPath + "FileFilterFrame_firstobs_mem.out";
+   string streamFile = tempPath + "FileFilterFrame_firstobs_stream.out";
+
+   ObsFFF mem(inputs);
+   RinexObsHeaderTouchHeaderMerge merged;
+   mem.touchHeader(merged);
+   mem.sort(RinexObsDataOperatorLessThanFull(merged.obsSet));
+   mem.unique(RinexObsDataOperatorEqualsSimple());
+   merged.theHeader.firstObs = mem.front().time;
+   mem.writeFile(memFile, merged.theHeader);
+
+   ObsFFF strm;
+   strm.newHeaderSource(inputs);
+   RinexObsHeaderTouchHeaderMerge smerged;
+   strm.touchHeader(smerged);
+   unsigned long count = strm.mergeFiles(
+      inputs, streamFile, smerged.theHeader,
+      RinexObsDataOperatorLessThanFull(smerged.obsSet),
+      RinexObsDataOperatorEqualsSimple(), ObsFFF::defaultMergeRecords,
+      SetFirstObs());
+
+   TUASSERTE(unsigned long, mem.getDataCount(), count);
+   TUASSERT(readFile(memFile) == readFile(streamFile));
+      // the header of the file read back has no time system
+   ObsFFF check(streamFile);
+   CommonTime firstObs(check.frontHeader().firstObs);
+   firstObs.setTimeSystem(mem.front().time.getTimeSystem());
+   TUASSERTE(CommonTime, mem.front().time, firstObs);
+   TURETURN();
+}
+
+
+string FileFilterFrame_T ::
+readFile(const string& fn)
+{
+   ifstream s(fn.c_str());
+   string line, contents;
+   while (getline(s, line))
+   {
+      if (line.find("PGM / RUN BY / DATE") == string::npos)
+         contents += line + "\n";
+   }
+   return contents;
+}
+
+
+bool FileFilterFrame_T ::
+fileExists(const string& fn)
+{
+   ifstream s(fn.c_str());
+   return s.good();
+}
+
+
+int main()
+{
+   FileFilterFrame_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.mergeSortedTest();
+   errorTotal += testClass.mergeUnsortedTest();
+   errorTotal += testClass.mergeTiesTest();
+   errorTotal += testClass.mergeHeaderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
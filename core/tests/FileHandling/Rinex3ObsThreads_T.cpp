@@ -0,0 +1,222 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+using namespace gpstk;
+
+   /** Tests that independent Rinex3ObsStream objects can be read
+    * concurrently, and interleaved, with the same results as reading
+    * each file on its own. */
+class Rinex3ObsThreads_T
+{
+public:
+   Rinex3ObsThreads_T();
+
+      /// Read the files one record at a time from each in turn.
+   int interleavedTest();
+      /// Read the files repeatedly from a pool of threads.
+   int concurrentTest();
+
+private:
+      /// All the records of one file, each summarized as a string.
+   typedef vector<string> Records;
+
+      /// Summarize every field of a record in a string.
+   static string summarize(const Rinex3ObsData& rod);
+      /// Read all of \a fn and summarize its records in \a recs.
+   static bool readFile(const string& fn, Records& recs);
+
+   vector<string> files;
+      /// Records of each of files, read sequentially.
+   vector<Records> expected;
+};
+
+
+Rinex3ObsThreads_T ::
+Rinex3ObsThreads_T()
+{
+   string dataFilePath = getPathData() + getFileSep();
+      // The first contains RINEX 2 epoch flag 3 and 4 records without
+      // an epoch time, which take the time of the preceding epoch.
+   files.push_back(dataFilePath + "mixed211.05o");
+   files.push_back(dataFilePath + "test_input_rinex2_obs_RinexObsFile.06o");
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "test_input_rinex3_76193040.14o");
+   expected.resize(files.size());
+   for (size_t i = 0; i < files.size(); i++)
+      readFile(files[i], expected[i]);
+}
+
+
+string Rinex3ObsThreads_T ::
+summarize(const Rinex3ObsData& rod)
+{
+   ostringstream oss;
+   oss.precision(17);
+   oss << rod.time << " " << rod.epochFlag << " " << rod.numSVs << " "
+       << rod.clockOffset << " " << rod.auxHeader.valid;
+   Rinex3ObsData::DataMap::const_iterator i;
+   for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+   {
+      oss << " " << i->first;
+      for (size_t j = 0; j < i->second.size(); j++)
+      {
+         oss << " " << i->second[j].data << "/" << i->second[j].lli
+             << "/" << i->second[j].ssi;
+      }
+   }
+   return oss.str();
+}
+
+
+bool Rinex3ObsThreads_T ::
+readFile(const string& fn, Records& recs)
+{
+   recs.clear();
+   try
+   {
+      Rinex3ObsStream strm(fn.c_str());
+      Rinex3ObsData rod;
+      while (strm >> rod)
+         recs.push_back(summarize(rod));
+      return strm.eof();
+   }
+   catch (...)
+   {
+      return false;
+   }
+}
+
+
+int Rinex3ObsThreads_T ::
+interleavedTest()
+{
+   TUDEF("Rinex3ObsStream", "operator>> interleaved");
+   vector<Rinex3ObsStream*> strms;
+   vector<Records> got(files.size());
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      TUASSERT(!expected[i].empty());
+      strms.push_back(new Rinex3ObsStream(files[i].c_str()));
+   }
+   bool reading = true;
+   while (reading)
+   {
+      reading = false;
+      for (size_t i = 0; i < strms.size(); i++)
+      {
+         Rinex3ObsData rod;
+         if (*strms[i] >> rod)
+         {
+            got[i].push_back(summarize(rod));
+            reading = true;
+         }
+      }
+   }
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      testFramework.assert_equals(expected[i].size(), got[i].size(),
+                                  __LINE__, files[i]);
+      for (size_t j = 0; j < got[i].size() && j < expected[i].size(); j++)
+         TUASSERTE(string, expected[i][j], got[i][j]);
+      delete strms[i];
+   }
+   TURETURN();
+}
+
+
+int Rinex3ObsThreads_T ::
+concurrentTest()
+{
+   TUDEF("Rinex3ObsStream", "operator>> concurrent");
+   const unsigned numThreads = 4;
+   const unsigned repeats = 8;
+   vector<Records> got(files.size() * repeats);
+   vector<char> ok(got.size(), 0);
+   atomic<size_t> next(0);
+
+      // Each worker takes the next file off the shared counter until
+      // all have been read.  Results are only checked once the
+      // threads have finished, as TestUtil is not thread-safe.
+   vector<thread> pool;
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      pool.push_back(thread([&]()
+         {
+            for (size_t job = next++; job < got.size(); job = next++)
+               ok[job] = readFile(files[job % files.size()], got[job]);
+         }));
+   }
+   for (size_t t = 0; t < pool.size(); t++)
+      pool[t].join();
+
+   for (size_t job = 0; job < got.size(); job++)
+   {
+      size_t i = job % files.size();
+      TUASSERT(ok[job] != 0);
+      testFramework.assert_equals(expected[i].size(), got[job].size(),
+                                  __LINE__, files[i]);
+      for (size_t j = 0; j < got[job].size() && j < expected[i].size(); j++)
+         TUASSERTE(string, expected[i][j], got[job][j]);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsThreads_T testClass;
+
+   errorTotal += testClass.interleavedTest();
+   errorTotal += testClass.concurrentTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
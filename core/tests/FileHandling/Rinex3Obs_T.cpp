@@ -39,6 +39,7 @@
 #include "Rinex3ObsStream.hpp"
 #include "Rinex3ObsHeader.hpp"
 #include "Rinex3ObsFilterOperators.hpp"
+#include "Rinex3ObsFlatData.hpp"
 
 #include "build_config.h"
 
@@ -81,6 +82,12 @@ public:
 
    int embeddedHeadersTest();
 
+      /// Compare records from the memory-mapped reader to the stream reader
+   int memoryMapTest( void );
+
+      /// Compare records read into Rinex3ObsFlatData to Rinex3ObsData
+   int flatDataTest( void );
+
 private:
 
    string dataFilePath;
@@ -1090,6 +1097,159 @@ A 9080                                                      MARKER NAME
    TURETURN();
 }
 
+int Rinex3Obs_T ::
+memoryMapTest()
+{
+   TUDEF("Rinex3ObsStream", "useMemoryMap");
+   try
+   {
+      gpstk::Rinex3ObsStream sstrm(dataRinexObsFile);
+      gpstk::Rinex3ObsStream mstrm(dataRinexObsFile);
+      gpstk::Rinex3ObsData srod, mrod;
+      TUASSERTE(bool, false, mstrm.isMemoryMapped());
+      TUASSERTE(bool, true, mstrm.useMemoryMap());
+      TUASSERTE(bool, true, mstrm.isMemoryMapped());
+      unsigned long count = 0;
+      while (sstrm >> srod)
+      {
+         TUASSERT(static_cast<bool>(mstrm >> mrod));
+         TUASSERTE(gpstk::CommonTime, srod.time, mrod.time);
+         TUASSERTE(short, srod.epochFlag, mrod.epochFlag);
+         TUASSERTE(short, srod.numSVs, mrod.numSVs);
+         TUASSERTE(double, srod.clockOffset, mrod.clockOffset);
+         TUASSERTE(unsigned long, srod.auxHeader.valid, mrod.auxHeader.valid);
+         TUASSERTE(size_t, srod.obs.size(), mrod.obs.size());
+         gpstk::Rinex3ObsData::DataMap::const_iterator si, mi;
+         for (si = srod.obs.begin(), mi = mrod.obs.begin();
+              (si != srod.obs.end()) && (mi != mrod.obs.end()); si++, mi++)
+         {
+            TUASSERTE(gpstk::RinexSatID, si->first, mi->first);
+            TUASSERTE(size_t, si->second.size(), mi->second.size());
+            for (size_t i = 0;
+                 (i < si->second.size()) && (i < mi->second.size()); i++)
+            {
+                  // bit-for-bit, no tolerance
+               TUASSERTE(double, si->second[i].data, mi->second[i].data);
+               TUASSERTE(bool,si->second[i].dataBlank,mi->second[i].dataBlank);
+               TUASSERTE(short, si->second[i].lli, mi->second[i].lli);
+               TUASSERTE(bool, si->second[i].lliBlank, mi->second[i].lliBlank);
+               TUASSERTE(short, si->second[i].ssi, mi->second[i].ssi);
+               TUASSERTE(bool, si->second[i].ssiBlank, mi->second[i].ssiBlank);
+            }
+         }
+         count++;
+      }
+      TUASSERT(count > 0);
+      TUASSERTE(bool, false, static_cast<bool>(mstrm >> mrod));
+      TUASSERTE(bool, true, mstrm.eof());
+      TUASSERTE(unsigned, sstrm.lineNumber, mstrm.lineNumber);
+      TUASSERTE(bool, false, mstrm.useMemoryMap(false));
+   }
+   catch (gpstk::Exception& e)
+   {
+      cerr << e << endl;
+      TUFAIL("unexpected exception");
+   }
+   TURETURN();
+}
+
+
+int Rinex3Obs_T ::
+flatDataTest()
+{
+   TUDEF("Rinex3ObsFlatData", "operator>>");
+   for (int mapped = 0; mapped < 2; mapped++)
+   {
+      try
+      {
+         gpstk::Rinex3ObsStream ostrm(dataRinexObsFile);
+         gpstk::Rinex3ObsStream fstrm(dataRinexObsFile);
+         if (mapped)
+            fstrm.useMemoryMap();
+         gpstk::Rinex3ObsData rod, conv;
+         gpstk::Rinex3ObsFlatData fd;
+         unsigned long count = 0;
+         while (ostrm >> rod)
+         {
+            TUASSERT(static_cast<bool>(fstrm >> fd));
+            TUASSERTE(gpstk::CommonTime, rod.time, fd.time);
+            TUASSERTE(short, rod.epochFlag, fd.epochFlag);
+            TUASSERTE(short, rod.numSVs, fd.numSVs);
+            TUASSERTE(double, rod.clockOffset, fd.clockOffset);
+            TUASSERTE(unsigned long, rod.auxHeader.valid, fd.auxHeader.valid);
+            TUASSERTE(size_t, rod.obs.size(), fd.numSats());
+            TUASSERTE(size_t, fd.numSats()+1, fd.start.size());
+            TUASSERTE(size_t, fd.start.back(), fd.values.size());
+               // every satellite is reachable through the view
+            gpstk::Rinex3ObsFlatData::ObsView view(fd.obsView());
+            TUASSERTE(size_t, rod.obs.size(), view.size());
+            gpstk::Rinex3ObsData::DataMap::const_iterator oi;
+            for (oi = rod.obs.begin(); oi != rod.obs.end(); oi++)
+            {
+               gpstk::Rinex3ObsFlatData::const_iterator fi =
+                  view.find(oi->first);
+               TUASSERT(fi != view.end());
+               if (fi == view.end())
+                  continue;
+               TUASSERTE(gpstk::RinexSatID, oi->first, fi->first);
+               TUASSERTE(size_t, oi->second.size(), fi->second.size());
+               for (size_t i = 0;
+                    (i < oi->second.size()) && (i < fi->second.size()); i++)
+               {
+                  gpstk::RinexDatum fdat(fi->second[i]);
+                  TUASSERTE(double, oi->second[i].data, fdat.data);
+                  TUASSERTE(bool, oi->second[i].dataBlank, fdat.dataBlank);
+                  TUASSERTE(short, oi->second[i].lli, fdat.lli);
+                  TUASSERTE(bool, oi->second[i].lliBlank, fdat.lliBlank);
+                  TUASSERTE(short, oi->second[i].ssi, fdat.ssi);
+                  TUASSERTE(bool, oi->second[i].ssiBlank, fdat.ssiBlank);
+                  TUASSERTE(double, oi->second[i].data,
+                            fd.getObs(oi->first, i).data);
+               }
+            }
+               // and the conversion back gives the same map
+            fd.toObsData(conv);
+            TUASSERTE(size_t, rod.obs.size(), conv.obs.size());
+            for (oi = rod.obs.begin(); oi != rod.obs.end(); oi++)
+            {
+               TUASSERTE(size_t, 1, conv.obs.count(oi->first));
+               for (size_t i = 0; i < oi->second.size() &&
+                       i < conv.obs[oi->first].size(); i++)
+               {
+                  TUASSERTE(double, oi->second[i].data,
+                            conv.obs[oi->first][i].data);
+               }
+            }
+            count++;
+         }
+         TUASSERT(count > 0);
+         TUASSERTE(bool, false, static_cast<bool>(fstrm >> fd));
+         TUASSERTE(bool, true, fstrm.eof());
+         TUASSERTE(unsigned, ostrm.lineNumber, fstrm.lineNumber);
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("unexpected exception");
+      }
+   }
+      // a satellite that is not in the epoch
+   gpstk::Rinex3ObsFlatData fd;
+   fd.addSat(gpstk::RinexSatID(1, gpstk::SatID::systemGPS), 2);
+   TUASSERTE(size_t, 1, fd.findSat(gpstk::RinexSatID(2, gpstk::SatID::systemGPS)));
+   try
+   {
+      fd.getObs(gpstk::RinexSatID(2, gpstk::SatID::systemGPS), 0);
+      TUFAIL("getObs should have thrown InvalidRequest");
+   }
+   catch (gpstk::InvalidRequest& e)
+   {
+      TUPASS("getObs");
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    int errorTotal = 0;
@@ -1101,6 +1261,8 @@ int main()
    errorTotal += testClass.filterOperatorsTest();
    errorTotal += testClass.roundTripTest();
    errorTotal += testClass.embeddedHeadersTest();
+   errorTotal += testClass.memoryMapTest();
+   errorTotal += testClass.flatDataTest();
 
       //Change to test v.3
    testClass.toRinex3();
@@ -1109,6 +1271,8 @@ int main()
    errorTotal += testClass.hardCodeTest();
    errorTotal += testClass.dataExceptionsTest();
    errorTotal += testClass.filterOperatorsTest();
+   errorTotal += testClass.memoryMapTest();
+   errorTotal += testClass.flatDataTest();
 
    testClass.toConversionTest();
    errorTotal += testClass.roundTripTest();
@@ -42,6 +42,9 @@
 #include "GPSWeekSecond.hpp"
 #include "Rinex3NavStream.hpp"
 #include "Rinex3NavData.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -185,6 +188,119 @@ public:
    }
 
 
+      /** GloEphemeris keeps the states of its integration to continue
+       * from in later calls; make sure the results do not depend on
+       * the order of the requests, by comparing with a fresh copy of
+       * the ephemeris for each request. */
+   unsigned svXvtCacheTest()
+   {
+      TUDEF("GloEphemeris", "svXvt");
+      try
+      {
+         gpstk::GloEphemerisStore store;
+         gpstk::Rinex3NavData nd = loadNav(store, testFramework, true);
+         const gpstk::GloEphemeris& ge(store.findEphemeris(nd.sat, nd.time));
+         const gpstk::GloEphemeris pristine(ge);
+         gpstk::CommonTime t0(ge.getEphemerisEpoch());
+            // forward and backward at 1 Hz, then jumping about
+         double offsets[] = { 0.5, 1.0, 2.0, 3.0, 59.0, 60.0, 61.0, 899.0,
+                              -1.0, -0.25, -2.0, -30.0, -31.0, -899.0,
+                              45.5, 30.0, 899.5, 29.999, -450.0, -30.0,
+                              0.0 };
+         unsigned nbad = 0;
+         for (unsigned i = 0; i < sizeof(offsets)/sizeof(offsets[0]); i++)
+         {
+            gpstk::GloEphemeris fresh(pristine);
+            gpstk::Xvt cached = ge.svXvt(t0 + offsets[i]);
+            gpstk::Xvt ref = fresh.svXvt(t0 + offsets[i]);
+            if (!(cached.x == ref.x) || !(cached.v == ref.v) ||
+                cached.clkbias != ref.clkbias)
+            {
+               nbad++;
+            }
+         }
+         TUASSERTE(unsigned, 0, nbad);
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+
+      /** The integration cache is updated by the const svXvt(); make sure
+       * that several threads evaluating (and copying) the same ephemeris
+       * at once get the same results as a serial evaluation. */
+   unsigned svXvtThreadTest()
+   {
+      TUDEF("GloEphemeris", "svXvt");
+      try
+      {
+         gpstk::GloEphemerisStore store;
+         gpstk::Rinex3NavData nd = loadNav(store, testFramework, true);
+         const gpstk::GloEphemeris& ge(store.findEphemeris(nd.sat, nd.time));
+         gpstk::CommonTime t0(ge.getEphemerisEpoch());
+         std::vector<double> offsets;
+         for (double dt = -899.0; dt < 900.0; dt += 7.25)
+         {
+            offsets.push_back(dt);
+         }
+         std::vector<gpstk::Xvt> ref;
+         for (unsigned i = 0; i < offsets.size(); i++)
+         {
+            gpstk::GloEphemeris fresh(ge);
+            ref.push_back(fresh.svXvt(t0 + offsets[i]));
+         }
+
+            // each thread walks the offsets in a different order, through
+            // the store and directly, while copying the ephemeris; each
+            // round starts from a copy with an empty cache
+         const unsigned nthreads = 4, nrounds = 200;
+         std::atomic<unsigned> nbad(0);
+         for (unsigned r = 0; r < nrounds; r++)
+         {
+            gpstk::GloEphemerisStore rstore;
+            rstore.addEphemeris(nd);
+            const gpstk::GloEphemeris& rge(rstore.findEphemeris(nd.sat,
+                                                                nd.time));
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < nthreads; t++)
+            {
+               threads.push_back(std::thread([&, t]()
+               {
+                  unsigned n = offsets.size();
+                  for (unsigned k = 0; k < n; k++)
+                  {
+                     unsigned i = (t % 2 == 0) ? (k*(2*t+1)+r) % n
+                                               : n-1 - (k*(2*t+1)+r) % n;
+                     gpstk::Xvt xvt = (k % 2 == 0)
+                        ? rstore.getXvt(nd.sat, t0 + offsets[i])
+                        : rge.svXvt(t0 + offsets[i]);
+                     gpstk::GloEphemeris copy(rge);
+                     if (!(xvt.x == ref[i].x) || !(xvt.v == ref[i].v) ||
+                         xvt.clkbias != ref[i].clkbias)
+                     {
+                        nbad++;
+                     }
+                  }
+               }));
+            }
+            for (unsigned t = 0; t < nthreads; t++)
+            {
+               threads[t].join();
+            }
+         }
+         TUASSERTE(unsigned, 0, nbad);
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+
    gpstk::Rinex3NavData loadNav(gpstk::GloEphemerisStore& store,
                                 gpstk::TestUtil& testFramework,
                                 bool firstOnly)
@@ -234,6 +350,8 @@ int main(int argc, char *argv[])
    total += testClass.doFindEphEmptyTests();
    total += testClass.computeXvtTest();
    total += testClass.getSVHealthTest();
+   total += testClass.svXvtCacheTest();
+   total += testClass.svXvtThreadTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << total << endl;
    return total;
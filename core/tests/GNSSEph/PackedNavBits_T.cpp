@@ -62,6 +62,7 @@ public:
    unsigned realDataTest();
    unsigned equalityTest();
    unsigned ancillaryMethods();
+   unsigned wordBoundaryTest();
 
    double eps; 
 };
@@ -834,6 +835,121 @@ ancillaryMethods()
    TURETURN();
 }
 
+   // The bits are stored in 64-bit words.  Pack fields of every
+   // length at offsets that straddle word boundaries and check the
+   // unpacking, comparison and hashing against the expected bits.
+unsigned PackedNavBits_T::
+wordBoundaryTest()
+{
+   TUDEF("PackedNavBits", "word boundaries");
+
+   SatID satID(1, SatID::systemGPS);
+   ObsID obsID( ObsID::otNavMsg, ObsID::cbL2, ObsID::tcC2LM );
+   CommonTime ct = CivilTime( 2011, 6, 2, 12, 14, 44.0, TimeSystem::GPS );
+
+      // reference copy of the expected bits, one per element
+   std::vector<bool> expected;
+   std::vector<int> starts, lengths;
+   std::vector<uint64_t> values;
+   PackedNavBits pnb(satID,obsID,ct);
+   uint64_t seed = 0x0123456789ABCDEFULL;
+   for (int numBits = 1; numBits <= 32; numBits++)
+   {
+      for (int rep = 0; rep < 5; rep++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         uint64_t value = (seed >> 11) & ((uint64_t(1) << numBits) - 1);
+         starts.push_back(pnb.getNumBits());
+         lengths.push_back(numBits);
+         values.push_back(value);
+         pnb.addUnsignedLong((unsigned long)value, numBits, 1);
+         for (int i = numBits-1; i >= 0; i--)
+            expected.push_back(((value >> i) & 1) != 0);
+      }
+   }
+   pnb.trimsize();
+   TUASSERTE(size_t, expected.size(), pnb.getNumBits());
+   TUASSERT(expected == pnb.getBits());
+
+   unsigned badFields = 0;
+   for (size_t i = 0; i < starts.size(); i++)
+   {
+      if (pnb.asUnsignedLong(starts[i], lengths[i], 1) != values[i])
+         badFields++;
+   }
+   TUASSERTE(unsigned, 0, badFields);
+
+   unsigned badBits = 0;
+   for (size_t i = 0; i < expected.size(); i++)
+   {
+      if (pnb.asBool(i) != expected[i])
+         badBits++;
+   }
+   TUASSERTE(unsigned, 0, badBits);
+
+      // flip a single bit at a time and check that only the ranges
+      // containing it stop matching, and that the ordering follows
+      // the first differing bit
+   PackedNavBits copy(pnb);
+   TUASSERT(copy.matchBits(pnb));
+   TUASSERTE(size_t, pnb.hashBits(), copy.hashBits());
+   unsigned badMatch = 0, badOrder = 0;
+   for (int bit = 0; bit < (int)expected.size()-1; bit += 7)
+   {
+      PackedNavBits flipped(pnb);
+      flipped.insertUnsignedLong(expected[bit] ? 0 : 1, bit, 1);
+      if (flipped.matchBits(pnb) ||
+          flipped.matchBits(pnb, bit, bit) ||
+          (bit > 0 && !flipped.matchBits(pnb, 0, bit-1)) ||
+          !flipped.matchBits(pnb, bit+1, expected.size()-1))
+      {
+         badMatch++;
+      }
+      if ((flipped < pnb) != expected[bit] ||
+          (pnb < flipped) == expected[bit])
+      {
+         badOrder++;
+      }
+   }
+   TUASSERTE(unsigned, 0, badMatch);
+   TUASSERTE(unsigned, 0, badOrder);
+   TUASSERT(!(pnb < copy));
+   TUASSERT(!(copy < pnb));
+
+      // invert twice is a no-op, and the spare bits stay clear so
+      // the comparison and hash are not affected
+   copy.invert();
+   TUASSERT(!copy.matchBits(pnb));
+   copy.invert();
+   TUASSERT(copy.matchBits(pnb));
+   TUASSERTE(size_t, pnb.hashBits(), copy.hashBits());
+
+      // getBits() returns the same vector until the bits change
+   TUASSERT(expected == copy.getBits());
+   TUASSERT(&copy.getBits() == &copy.getBits());
+   std::vector<bool> inverted(expected);
+   inverted.flip();
+   copy.invert();
+   TUASSERT(inverted == copy.getBits());
+   TUASSERT(inverted == copy.getBitsCopy());
+   copy.addUnsignedLong(1, 1, 1);
+   inverted.push_back(true);
+   TUASSERT(inverted == copy.getBits());
+
+      // append to an object whose length is not a multiple of 64
+   PackedNavBits joined(satID,obsID,ct);
+   joined.addUnsignedLong(5, 3, 1);
+   joined.trimsize();
+   joined.addPackedNavBits(pnb);
+   std::vector<bool> jexpected(expected);
+   jexpected.insert(jexpected.begin(), true);
+   jexpected.insert(jexpected.begin()+1, false);
+   jexpected.insert(jexpected.begin()+2, true);
+   TUASSERT(jexpected == joined.getBits());
+
+   TURETURN();
+}
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -844,6 +960,7 @@ int main()
    errorTotal += testClass.realDataTest();
    errorTotal += testClass.equalityTest();
    errorTotal += testClass.ancillaryMethods();
+   errorTotal += testClass.wordBoundaryTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
@@ -34,18 +34,164 @@
 //
 //==============================================================================
 
+#include "RinexObsID.hpp"
 #include "TestUtil.hpp"
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
 
 class RinexObsID_T
 {
 public:
    RinexObsID_T() {} // Default Constructor, set the precision value
    ~RinexObsID_T() {} // Default Desructor
+
+   unsigned handleTest()
+   {
+      TUDEF("RinexObsID", "handle");
+      int c1c = RinexObsID::handle("GC1C");
+         // the same specifier, and an equivalent one, give the same handle
+      TUASSERTE(int, c1c, RinexObsID::handle("GC1C"));
+      TUASSERTE(int, c1c, RinexObsID::handle("C1C"));
+      TUASSERTE(RinexObsID, RinexObsID("GC1C"), RinexObsID::fromHandle(c1c));
+      int l1c = RinexObsID::handle("GL1C");
+      int c2w = RinexObsID::handle("GC2W");
+      TUASSERT(l1c != c1c);
+      TUASSERT(c2w != c1c);
+      TUASSERT(c2w != l1c);
+      RinexObsID rid(RinexObsID::fromHandle(c2w));
+      TUASSERTE(ObsID::ObservationType, ObsID::otRange, rid.type);
+      TUASSERTE(ObsID::CarrierBand, ObsID::cbL2, rid.band);
+      TUASSERTE(ObsID::TrackingCode, ObsID::tcW, rid.code);
+         // the string constructor gives the same answer as before
+         // and after the specifier was interned
+      TUASSERTE(RinexObsID, RinexObsID(ObsID::otPhase, ObsID::cbL1,
+                                       ObsID::tcCA), RinexObsID("GL1C"));
+      TUASSERTE(RinexObsID, RinexObsID(ObsID::otDoppler, ObsID::cbE5b,
+                                       ObsID::tcIE5b), RinexObsID("ED7I"));
+      TUASSERTE(RinexObsID, RinexObsID("ED7I"),
+                RinexObsID::fromHandle(RinexObsID::handle("ED7I")));
+         // invalid specifiers are rejected every time
+      for (int i = 0; i < 2; i++)
+      {
+         try
+         {
+            RinexObsID::handle("GC1N");
+            TUFAIL("GC1N should be invalid");
+         }
+         catch (InvalidParameter& e)
+         {
+            TUPASS("GC1N");
+         }
+         try
+         {
+            RinexObsID rid2("GC1");
+            TUFAIL("GC1 should be invalid");
+         }
+         catch (InvalidParameter& e)
+         {
+            TUPASS("GC1");
+         }
+      }
+      try
+      {
+         RinexObsID::fromHandle(-1);
+         TUFAIL("-1 should be an invalid handle");
+      }
+      catch (InvalidParameter& e)
+      {
+         TUPASS("fromHandle");
+      }
+      TURETURN();
+   }
+
+
+   unsigned threadTest()
+   {
+      TUDEF("RinexObsID", "handle");
+         // valid specifiers, none seen before, so the threads find
+         // some and add others at the same time
+      const std::string sys("GRESCJI"), types("CLDS"), bands("125678"),
+         codes("CPWYMNDSLXIQABZ");
+      std::vector<std::string> specs;
+      for (unsigned s = 0; s < sys.size(); s++)
+         for (unsigned t = 0; t < types.size(); t++)
+            for (unsigned b = 0; b < bands.size(); b++)
+               for (unsigned c = 0; c < codes.size(); c++)
+               {
+                  std::string spec(1, sys[s]);
+                  spec = spec + types[t] + bands[b] + codes[c];
+                  if (isValidRinexObsID(spec))
+                     specs.push_back(spec);
+               }
+      TUASSERT(specs.size() > 100);
+      const unsigned nthreads = 4;
+      std::vector< std::vector<int> > handles(nthreads,
+                                              std::vector<int>(specs.size()));
+      std::atomic<unsigned> nbad(0);
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < nthreads; t++)
+      {
+         threads.push_back(std::thread([&, t]()
+         {
+            unsigned n = specs.size();
+            for (unsigned k = 0; k < 3*n; k++)
+            {
+               unsigned i = (t % 2 == 0) ? (k*(2*t+1)) % n
+                                         : n-1 - (k*(2*t+1)) % n;
+               try
+               {
+                  int h = RinexObsID::handle(specs[i]);
+                  if ((k >= n && h != handles[t][i]) ||
+                      !(RinexObsID::fromHandle(h) == RinexObsID(specs[i])))
+                  {
+                     nbad++;
+                  }
+                  handles[t][i] = h;
+               }
+               catch (...)
+               {
+                  nbad++;
+               }
+            }
+         }));
+      }
+      for (unsigned t = 0; t < nthreads; t++)
+      {
+         threads[t].join();
+      }
+      TUASSERTE(unsigned, 0, nbad);
+         // every thread got the same handles, and they match the
+         // objects as parsed without the table
+      for (unsigned i = 0; i < specs.size(); i++)
+      {
+         for (unsigned t = 1; t < nthreads; t++)
+         {
+            TUASSERTE(int, handles[0][i], handles[t][i]);
+         }
+         ObsID oid(specs[i]);
+         TUASSERTE(RinexObsID, RinexObsID(oid.type, oid.band, oid.code),
+                   RinexObsID::fromHandle(handles[0][i]));
+      }
+      TURETURN();
+   }
 };
 
 
 int main() //Main function to initialize and run all tests above
 {
-   return 0; //Return the total number of errors
+   RinexObsID_T testClass;
+   unsigned errorTotal = 0;
+
+      // first, so that the specifiers are new to the table
+   errorTotal += testClass.threadTest();
+   errorTotal += testClass.handleTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal; //Return the total number of errors
 }
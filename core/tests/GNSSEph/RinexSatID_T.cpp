@@ -34,18 +34,115 @@
 //
 //==============================================================================
 
+#include "RinexSatID.hpp"
 #include "TestUtil.hpp"
 #include <iostream>
+#include <set>
+
+using namespace std;
+using namespace gpstk;
 
 class RinexSatID_T
 {
 public:
    RinexSatID_T() {} // Default Constructor, set the precision value
    ~RinexSatID_T() {} // Default Desructor
+
+   unsigned handleTest()
+   {
+      TUDEF("RinexSatID", "handle");
+         // in the order of SatID::SatelliteSystem
+      const SatID::SatelliteSystem systems[] =
+         { SatID::systemGPS, SatID::systemGalileo, SatID::systemGlonass,
+           SatID::systemGeosync, SatID::systemTransit, SatID::systemBeiDou,
+           SatID::systemQZSS, SatID::systemIRNSS, SatID::systemMixed };
+      set<int> handles;
+      int prev = -1;
+      RinexSatID prevSat;
+      for (unsigned s = 0; s < sizeof(systems)/sizeof(systems[0]); s++)
+      {
+            // id 0 and the system-only id -1 each get a slot
+         for (int id = -1; id < 100; id++)
+         {
+            RinexSatID sat(id, systems[s]);
+            int h = sat.handle();
+            TUASSERT(h >= 0 && h < RinexSatID::numHandles);
+            TUASSERTE(RinexSatID, sat, RinexSatID::fromHandle(h));
+            handles.insert(h);
+               // handles are ordered as the satellites
+            if (prev >= 0)
+            {
+               TUASSERT(prevSat < sat);
+               TUASSERT(prev < h);
+            }
+            prev = h;
+            prevSat = sat;
+         }
+      }
+      TUASSERTE(size_t, 9*101, handles.size());
+      TUASSERTE(size_t, RinexSatID::numHandles, handles.size());
+      TUASSERT(RinexSatID(0, SatID::systemGPS).handle() !=
+               RinexSatID(-1, SatID::systemGPS).handle());
+         // all blank means GPS with no id
+      RinexSatID blank("   ");
+      TUASSERTE(RinexSatID, blank, RinexSatID::fromHandle(blank.handle()));
+      TUASSERTE(int, -1, RinexSatID().handle());
+      TUASSERTE(int, -1, RinexSatID(-2, SatID::systemGPS).handle());
+      TUASSERTE(int, -1, RinexSatID(100, SatID::systemGPS).handle());
+      TUASSERTE(int, -1, RinexSatID(1, SatID::systemLEO).handle());
+      TUASSERTE(RinexSatID, RinexSatID(), RinexSatID::fromHandle(-1));
+      TUASSERTE(RinexSatID, RinexSatID(),
+                RinexSatID::fromHandle(RinexSatID::numHandles));
+      TURETURN();
+   }
+
+
+   unsigned fromStringTest()
+   {
+      TUDEF("RinexSatID", "fromString");
+         // the buffer overload must agree with the string one,
+         // whether or not the short form applies
+      const char *ids[] = { "G01", "R 5", "E12", "S20", "J07", "C33",
+                            "I 2", "g01", "G00", "G 0", "   ", "1",
+                            " 7", "G1", "G 12", "R05 " };
+      for (unsigned i = 0; i < sizeof(ids)/sizeof(ids[0]); i++)
+      {
+         string str(ids[i]);
+         RinexSatID fromStr, fromBuf;
+         fromStr.fromString(str);
+            // the buffer need not be terminated after len characters
+         string buf(str + "  21463914.178 7");
+         fromBuf.fromString(buf.data(), str.length());
+         TUASSERTE(RinexSatID, fromStr, fromBuf);
+      }
+      RinexSatID sat;
+      sat.fromString("R 5 ", 3);
+      TUASSERTE(RinexSatID, RinexSatID(5, SatID::systemGlonass), sat);
+      sat.fromString("C33", 3);
+      TUASSERTE(RinexSatID, RinexSatID(33, SatID::systemBeiDou), sat);
+      try
+      {
+         sat.fromString("X01", 3);
+         TUFAIL("Expected an exception for system character X");
+      }
+      catch (Exception& e)
+      {
+         TUPASS("Exception for system character X");
+      }
+      TURETURN();
+   }
 };
 
 
 int main() //Main function to initialize and run all tests above
 {
-   return 0; //Return the total number of errors
+   RinexSatID_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.handleTest();
+   errorTotal += testClass.fromStringTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal; //Return the total number of errors
 }
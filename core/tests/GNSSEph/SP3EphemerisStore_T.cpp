@@ -322,6 +322,145 @@ public:
    }
 
 
+//=============================================================================
+// Test for computeXvt over several times and (sat,time) pairs.
+// The results must be identical to those of computeXvt and getXvt for
+// each time, including the times and satellites for which no Xvt is
+// available, on a grid fine enough that each table interval is used
+// for several times, and including the table times.
+//=============================================================================
+   /** Count the (sats[i],times[i]) for which xvts[i] differs in any
+    * way from the scalar computeXvt(), or from getXvt() where that
+    * succeeds; return the number that were valid and the same in
+    * nsame. */
+   unsigned countMismatches(const SP3EphemerisStore& store,
+                            const vector<SatID>& sats,
+                            const vector<CommonTime>& times,
+                            const vector<Xvt>& xvts,
+                            unsigned int& nsame)
+   {
+      unsigned int nbad = 0;
+      nsame = 0;
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         Xvt rv = store.computeXvt(sats[i], times[i]);
+         if (!(rv.x == xvts[i].x && rv.v == xvts[i].v &&
+               rv.clkbias == xvts[i].clkbias &&
+               rv.clkdrift == xvts[i].clkdrift &&
+               rv.relcorr == xvts[i].relcorr &&
+               rv.health == xvts[i].health))
+         {
+            nbad++;
+            continue;
+         }
+         try
+         {
+            Xvt gv = store.getXvt(sats[i], times[i]);
+            if (!(gv.x == rv.x && gv.v == rv.v &&
+                  gv.clkbias == rv.clkbias && gv.clkdrift == rv.clkdrift &&
+                  gv.relcorr == rv.relcorr && gv.health == rv.health))
+               nbad++;
+            else
+               nsame++;
+         }
+         catch (InvalidRequest& e)
+         {
+            if (rv.health != Xvt::HealthStatus::Unavailable)
+               nbad++;
+         }
+      }
+      return nbad;
+   }
+
+
+   unsigned computeXvtBatchTest()
+   {
+      TUDEF("SP3EphemerisStore", "computeXvt(batch)");
+
+      try
+      {
+         SP3EphemerisStore store;
+         SatID sid1(1, SatID::systemGPS);
+         SatID sid32(32, SatID::systemGPS);
+         CommonTime bTime = CivilTime(1997,4,6,0,0,0,gpstk::TimeSystem::GPS);
+
+         store.rejectBadPositions(false);
+         store.rejectBadClocks(false);
+         store.rejectPredPositions(false);
+         store.rejectPredClocks(false);
+         store.loadFile(inputSP3Data);
+
+            // 10 second grid, starting before the data begin
+         vector<CommonTime> times;
+         vector<SatID> sats, sats1;
+         for (int i = 0; i < 8640; i++)
+         {
+            times.push_back(bTime + 10.0*i - 3600.0);
+            sats.push_back(i % 3 == 0 ? sid32 : SatID(1 + (i/7) % 31,
+                                                       SatID::systemGPS));
+         }
+         sats1.assign(times.size(), sid1);
+
+         vector<Xvt> xvts;
+         unsigned int nvalid, nsame;
+         nvalid = store.computeXvt(sid1, times, xvts);
+         TUASSERTE(size_t, times.size(), xvts.size());
+         TUASSERT(nvalid > 0 && nvalid < times.size());
+         TUASSERTE(unsigned int, 0,
+                   countMismatches(store, sats1, times, xvts, nsame));
+         TUASSERTE(unsigned int, nvalid, nsame);
+
+         nvalid = store.computeXvt(sats, times, xvts);
+         TUASSERT(nvalid > 0 && nvalid < times.size());
+         TUASSERTE(unsigned int, 0,
+                   countMismatches(store, sats, times, xvts, nsame));
+         TUASSERTE(unsigned int, nvalid, nsame);
+
+            // linear clock interpolation, two points per interval
+         store.setClockLinearInterp();
+         nvalid = store.computeXvt(sid1, times, xvts);
+         TUASSERT(nvalid > 0 && nvalid < times.size());
+         TUASSERTE(unsigned int, 0,
+                   countMismatches(store, sats1, times, xvts, nsame));
+         TUASSERTE(unsigned int, nvalid, nsame);
+
+            // too few points for Lagrange interpolation of the positions
+         store.setPositionInterpOrder(2);
+         nvalid = store.computeXvt(sats, times, xvts);
+         TUASSERTE(unsigned int, 0, nvalid);
+         TUASSERTE(unsigned int, 0,
+                   countMismatches(store, sats, times, xvts, nsame));
+         TUASSERTE(unsigned int, 0, nsame);
+         try
+         {
+            store.getXvt(sid1, bTime + 3600.0 + 10.0);
+            TUFAIL("Second order Lagrange interpolation was accepted");
+         }
+         catch (InvalidRequest& e)
+         {
+            TUPASS("");
+         }
+
+         sats.pop_back();
+         try
+         {
+            store.computeXvt(sats, times, xvts);
+            TUFAIL("Mismatched satellite and time lists were accepted");
+         }
+         catch (InvalidRequest& e)
+         {
+            TUPASS("");
+         }
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+
+      TURETURN();
+   }
+
+
 //=============================================================================
 // Test for getSVHealth.
 // Tests the getSVHealth method in SP3EphemerisStore by comparing known
@@ -709,6 +848,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.SP3ESTest();
    errorTotal += testClass.getXvtTest();
    errorTotal += testClass.computeXvtTest();
+   errorTotal += testClass.computeXvtBatchTest();
    errorTotal += testClass.getSVHealthTest();
    errorTotal += testClass.getInitialTimeTest();
    errorTotal += testClass.getFinalTimeTest();
@@ -0,0 +1,143 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "SortedTimeTable.hpp"
+#include "CivilTime.hpp"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <map>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Compare the searches of a SortedTimeTable with those of std::map
+static int compareSearches(const SortedTimeTable<int>& stt,
+                           const map<CommonTime,int>& ref,
+                           const CommonTime& t0, double dt, int n)
+{
+   int fails = 0;
+   for (int i = 0; i < n; i++)
+   {
+      CommonTime t(t0 + i*dt);
+      SortedTimeTable<int>::const_iterator sit;
+      map<CommonTime,int>::const_iterator mit;
+      sit = stt.lower_bound(t);
+      mit = ref.lower_bound(t);
+      if ((sit == stt.end()) != (mit == ref.end()) ||
+          (sit != stt.end() && sit->first != mit->first))
+         fails++;
+      sit = stt.upper_bound(t);
+      mit = ref.upper_bound(t);
+      if ((sit == stt.end()) != (mit == ref.end()) ||
+          (sit != stt.end() && sit->first != mit->first))
+         fails++;
+      sit = stt.find(t);
+      mit = ref.find(t);
+      if ((sit == stt.end()) != (mit == ref.end()) ||
+          (sit != stt.end() && sit->second != mit->second))
+         fails++;
+   }
+   return fails;
+}
+
+
+int main()
+{
+   TUDEF("SortedTimeTable", "");
+
+   CommonTime t0 = CivilTime(2019,1,1,0,0,0.0,TimeSystem::GPS);
+   SortedTimeTable<int> stt;
+   map<CommonTime,int> ref;
+
+   TUCSM("operator[]");
+   TUASSERT(stt.empty());
+   for (int i = 0; i < 96; i++)
+   {
+      stt[t0 + i*900.0] = i;
+      ref[t0 + i*900.0] = i;
+   }
+   TUASSERTE(size_t, 96, stt.size());
+   TUASSERT(stt.isUniform());
+   TUASSERTFE(900.0, stt.getStep());
+   TUASSERTE(int, 10, stt[t0 + 9000.0]);
+   TUASSERTE(size_t, 96, stt.size());
+
+   TUCSM("lower_bound");
+      // times before, on, between and after the records
+   TUASSERTE(int, 0,
+             compareSearches(stt, ref, t0 - 2000.0, 450.0, 200));
+   TUASSERTE(int, 0,
+             compareSearches(stt, ref, t0 + 1.0e-9, 900.0, 96));
+   TUASSERT(stt.lower_bound(t0 + 95*900.0 + 1.0) == stt.end());
+   TUASSERT(stt.lower_bound(t0 - 1.0) == stt.begin());
+   TUASSERTE(int, 3, stt.lower_bound(t0 + 1800.5)->second);
+
+   TUCSM("find");
+   TUASSERT(stt.find(t0 + 100.0) == stt.end());
+   TUASSERTE(int, 95, stt.find(t0 + 95*900.0)->second);
+
+      // out of order inserts make the spacing uneven
+   stt[t0 + 450.0] = -1;
+   ref[t0 + 450.0] = -1;
+   TUASSERT(!stt.isUniform());
+   TUASSERTE(int, -1, stt.begin()[1].second);
+   TUASSERTE(int, 0,
+             compareSearches(stt, ref, t0 - 2000.0, 150.0, 700));
+   stt[t0 - 900.0] = -2;
+   ref[t0 - 900.0] = -2;
+   TUASSERTE(int, -2, stt.begin()->second);
+
+   TUCSM("erase");
+   stt.erase(stt.begin()+2);
+   ref.erase(t0 + 450.0);
+   TUASSERT(stt.isUniform());
+   TUASSERTE(int, 0,
+             compareSearches(stt, ref, t0 - 2000.0, 150.0, 700));
+   stt.erase(stt.upper_bound(t0 + 3600.0), stt.end());
+   ref.erase(ref.upper_bound(t0 + 3600.0), ref.end());
+   TUASSERTE(size_t, 6, stt.size());
+   TUASSERTE(int, 0,
+             compareSearches(stt, ref, t0 - 2000.0, 150.0, 100));
+
+   TUCSM("clear");
+   stt.clear();
+   TUASSERT(stt.empty());
+   TUASSERT(stt.lower_bound(t0) == stt.end());
+   TUASSERT(stt.find(t0) == stt.end());
+
+   TURETURN();
+}
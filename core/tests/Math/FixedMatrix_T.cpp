@@ -0,0 +1,231 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FixedMatrix.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+class FixedMatrix_T
+{
+public:
+   unsigned vectorTest();
+   unsigned matrixTest();
+   unsigned conversionTest();
+};
+
+
+unsigned FixedMatrix_T ::
+vectorTest()
+{
+   TUDEF("FixedVector", "operators");
+   FixedVector<double,3> zero;
+   for (size_t i = 0; i < zero.size(); i++)
+      TUASSERTFE(0., zero[i]);
+   double a[3] = { 1., -2., 3. }, b[3] = { 0.5, 4., -1. };
+   FixedVector<double,3> x(a), y(b);
+   Vector<double> vx(3), vy(3);
+   vx = a;
+   vy = b;
+      // same results as Vector
+   FixedVector<double,3> sum(x + 2.*y), diff(x - y/4.), prod(y*3.);
+   Vector<double> vsum(vx + 2.*vy), vdiff(vx - vy/4.), vprod(vy*3.);
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFE(vsum[i], sum[i]);
+      TUASSERTFE(vdiff[i], diff[i]);
+      TUASSERTFE(vprod[i], prod[i]);
+   }
+   TUASSERTFE(dot(vx,vy), dot(x,y));
+   TUASSERTFE(norm(vx), norm(x));
+   FixedVector<double,3> c(cross(x,y));
+   Vector<double> vc(cross(vx,vy));
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFE(vc[i], c[i]);
+   x += y;
+   TUASSERTFE(1.5, x[0]);
+   x = 2.;
+   TUASSERTFE(2., x[2]);
+   FixedVector<double,3> neg(-y);
+   TUASSERTFE(-4., neg[1]);
+   TURETURN();
+}
+
+
+unsigned FixedMatrix_T ::
+matrixTest()
+{
+   TUDEF("FixedMatrix", "operators");
+   FixedMatrix<double,3,3> zero;
+   TUASSERTE(size_t, 3, zero.rows());
+   TUASSERTE(size_t, 3, zero.cols());
+   TUASSERTE(size_t, 9, zero.size());
+   TUASSERTFE(0., normF(zero));
+
+      // rotations and products must match Matrix exactly
+   const double ang1(0.3), ang2(-1.2), ang3(2.5);
+   FixedMatrix<double,3,3> R(fixedRotation(ang1,1) * fixedRotation(ang2,2)
+                             * fixedRotation(ang3,3));
+   Matrix<double> M(rotation(ang1,1) * rotation(ang2,2) * rotation(ang3,3));
+   FixedMatrix<double,3,3> RT(transpose(R));
+   double v[3] = { 7000., -1234.5, 42. };
+   FixedVector<double,3> fv(v);
+   Vector<double> dv(3);
+   dv = v;
+   FixedVector<double,3> Rv(R * fv);
+   Vector<double> Mv(M * dv);
+   FixedMatrix<double,3,3> S(R + 2.*RT), D(R - RT*0.5);
+   Matrix<double> MS(M + 2.*transpose(M)), MD(M - transpose(M)*0.5);
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFE(Mv[i], Rv[i]);
+      for (size_t j = 0; j < 3; j++)
+      {
+         TUASSERTFE(M(i,j), R(i,j));
+         TUASSERTFE(M(j,i), RT(i,j));
+         TUASSERTFE(MS(i,j), S(i,j));
+         TUASSERTFE(MD(i,j), D(i,j));
+      }
+   }
+      // a rotation times its transpose is the identity
+   FixedMatrix<double,3,3> I(R * RT);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFEPS((i == j ? 1. : 0.), I(i,j), 1.e-15);
+
+      // non-square
+   double a[6] = { 1., 2., 3., 4., 5., 6. };
+   FixedMatrix<double,2,3> A(a);
+   TUASSERTFE(4., A(1,0));
+   FixedMatrix<double,2,2> AAT(A * transpose(A));
+   TUASSERTFE(14., AAT(0,0));
+   TUASSERTFE(32., AAT(0,1));
+   TUASSERTFE(77., AAT(1,1));
+
+   TUCSM("fixedRotation");
+   try
+   {
+      fixedRotation(1.0, 4);
+      TUFAIL("Expected MatrixException for an invalid axis");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("fixedRotation");
+   }
+   TURETURN();
+}
+
+
+unsigned FixedMatrix_T ::
+conversionTest()
+{
+   TUDEF("FixedMatrix", "FixedMatrix(Matrix)");
+   Matrix<double> M(4,4);
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = 0; j < 4; j++)
+         M(i,j) = 10.*i + j;
+   FixedMatrix<double,3,3> sub(M, 1, 1);
+   TUASSERTFE(11., sub(0,0));
+   TUASSERTFE(33., sub(2,2));
+   TUASSERTFE(23., sub(1,2));
+
+      // functions of ConstMatrixBase accept a FixedMatrix
+   FixedMatrix<double,2,2> F;
+   F(0,0) = 4.; F(0,1) = 1.; F(1,0) = 2.; F(1,1) = 3.;
+   Matrix<double> Finv(inverse(F));
+   TUASSERTFEPS(0.3, Finv(0,0), 1.e-15);
+   TUASSERTFEPS(-0.1, Finv(0,1), 1.e-15);
+   Matrix<double> MF(F);
+   TUASSERTE(size_t, 2, MF.rows());
+   TUASSERTFE(2., MF(1,0));
+   FixedMatrix<double,2,2> back(MF);
+   TUASSERTFE(3., back(1,1));
+   back = Matrix<double>(2,2,5.);
+   TUASSERTFE(5., back(0,1));
+   FixedVector<double,4> fv(M.rowCopy(2));
+   TUASSERTFE(23., fv[3]);
+   Vector<double> dv(fv);
+   TUASSERTE(size_t, 4, dv.size());
+   TUASSERTFE(21., dv[1]);
+
+   TUCSM("FixedMatrix(Matrix)");
+   try
+   {
+      FixedMatrix<double,3,3> bad(M);
+      TUFAIL("Expected MatrixException for wrong dimensions");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("FixedMatrix(Matrix)");
+   }
+   try
+   {
+      FixedMatrix<double,3,3> bad(M, 2, 0);
+      TUFAIL("Expected MatrixException for a submatrix out of range");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("FixedMatrix(Matrix)");
+   }
+   TUCSM("FixedVector(Vector)");
+   try
+   {
+      FixedVector<double,3> bad(dv);
+      TUFAIL("Expected VectorException for wrong size");
+   }
+   catch (VectorException& e)
+   {
+      TUPASS("FixedVector(Vector)");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FixedMatrix_T testClass;
+
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.matrixTest();
+   errorTotal += testClass.conversionTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
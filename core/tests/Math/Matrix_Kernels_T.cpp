@@ -0,0 +1,244 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+   /** Tests of the blocked kernels in MatrixKernels.hpp against the
+    * plain loops they replaced.  The sizes are chosen to cross the
+    * block boundaries, and the results must be the same bit for
+    * bit. */
+class Matrix_Kernels_T
+{
+public:
+   Matrix_Kernels_T() : seed(12345) {}
+   unsigned multiplyTest();
+   unsigned choleskyTest();
+   unsigned householderTest();
+
+private:
+   double random()
+   {
+      seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+      return double(seed) / 0x7fffffff - 0.5;
+   }
+   Matrix<double> randomMatrix(size_t r, size_t c)
+   {
+      Matrix<double> m(r, c);
+      for (size_t i = 0; i < r; i++)
+         for (size_t j = 0; j < c; j++)
+            m(i,j) = random();
+      return m;
+   }
+      /// number of elements of a and b that differ at all
+   static size_t countDiffs(const Matrix<double>& a, const Matrix<double>& b)
+   {
+      size_t n = 0;
+      for (size_t i = 0; i < a.rows(); i++)
+         for (size_t j = 0; j < a.cols(); j++)
+            if (a(i,j) != b(i,j))
+               n++;
+      return n;
+   }
+
+   unsigned long seed;
+};
+
+
+unsigned Matrix_Kernels_T ::
+multiplyTest()
+{
+   TUDEF("Matrix", "operator*");
+   size_t dims[][3] = { {1,1,1}, {3,5,2}, {70,65,33}, {300,130,41} };
+   for (size_t t = 0; t < 4; t++)
+   {
+      size_t m = dims[t][0], p = dims[t][1], n = dims[t][2];
+      Matrix<double> a(randomMatrix(m,p)), b(randomMatrix(p,n));
+      Vector<double> x(p);
+      for (size_t k = 0; k < p; k++)
+         x(k) = random();
+      Matrix<double> ref(m, n, 0.);
+      Vector<double> refx(m, 0.);
+      for (size_t i = 0; i < m; i++)
+      {
+         for (size_t j = 0; j < n; j++)
+            for (size_t k = 0; k < p; k++)
+               ref(i,j) += a(i,k) * b(k,j);
+         for (size_t k = 0; k < p; k++)
+            refx(i) += a(i,k) * x(k);
+      }
+      TUASSERTE(size_t, 0, countDiffs(ref, a*b));
+      Vector<double> ax(a*x);
+      size_t diffs = 0;
+      for (size_t i = 0; i < m; i++)
+         if (ax(i) != refx(i))
+            diffs++;
+      TUASSERTE(size_t, 0, diffs);
+   }
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+choleskyTest()
+{
+   TUDEF("Cholesky", "operator()");
+   size_t sizes[] = { 1, 31, 32, 33, 100 };
+   for (size_t t = 0; t < 5; t++)
+   {
+      size_t N = sizes[t], i, j, k;
+      Matrix<double> b(randomMatrix(N,N)), a(transpose(b) * b);
+      for (i = 0; i < N; i++)
+         a(i,i) += N;
+      Cholesky<double> ch;
+      ch(a);
+
+         // upper, last column first
+      Matrix<double> P(a), U(N, N, 0.);
+      for (j = N-1; ; j--)
+      {
+         U(j,j) = SQRT(P(j,j));
+         double d = 1./U(j,j);
+         for (k = 0; k < j; k++)
+            U(k,j) = d*P(k,j);
+         for (k = 0; k < j; k++)
+            for (i = 0; i <= k; i++)
+               P(i,k) -= U(k,j)*U(i,j);
+         if (j == 0)
+            break;
+      }
+      TUASSERTE(size_t, 0, countDiffs(U, ch.U));
+
+         // lower, first column first
+      Matrix<double> L(N, N, 0.);
+      P = a;
+      for (j = 0; j < N; j++)
+      {
+         L(j,j) = SQRT(P(j,j));
+         double d = 1./L(j,j);
+         for (k = j+1; k < N; k++)
+            L(k,j) = d*P(k,j);
+         for (k = j+1; k < N; k++)
+            for (i = k; i < N; i++)
+               P(i,k) -= L(i,j)*L(k,j);
+      }
+      TUASSERTE(size_t, 0, countDiffs(L, ch.L));
+   }
+
+      // not positive definite
+   Matrix<double> bad(40, 40, 0.);
+   for (size_t i = 0; i < 40; i++)
+      bad(i,i) = (i == 35 ? -1. : 1.);
+   Cholesky<double> ch;
+   try
+   {
+      ch(bad);
+      TUFAIL("Cholesky of a matrix that is not positive definite");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+householderTest()
+{
+   TUDEF("Householder", "operator()");
+   size_t dims[][2] = { {1,1}, {5,3}, {40,40}, {90,37} };
+   for (size_t t = 0; t < 4; t++)
+   {
+      size_t m = dims[t][0], n = dims[t][1], i, j, k;
+      Matrix<double> A(randomMatrix(m,n));
+      Householder<double> hh;
+      hh(A);
+
+      Vector<double> v(m);
+      const double EPS(1.e-200);
+      for (j = 0; (j < n-1 && j < m-1); j++)
+      {
+         double sum = 0., alpha;
+         for (i = j; i < m; i++)
+         {
+            v(i) = A(i,j);
+            A(i,j) = 0.;
+            sum += v(i)*v(i);
+         }
+         if (sum < EPS)
+            continue;
+         sum = SQRT(sum);
+         if (v(j) > 0.)
+            sum = -sum;
+         A(j,j) = sum;
+         v(j) = v(j) - sum;
+         sum = 1./(sum*v(j));
+         for (k = j+1; k < n; k++)
+         {
+            alpha = 0.;
+            for (i = j; i < m; i++)
+               alpha += A(i,k)*v(i);
+            alpha *= sum;
+            if (alpha*alpha < EPS)
+               continue;
+            for (i = j; i < m; i++)
+               A(i,k) += alpha*v(i);
+         }
+      }
+      TUASSERTE(size_t, 0, countDiffs(A, hh.A));
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Matrix_Kernels_T testClass;
+
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.choleskyTest();
+   errorTotal += testClass.householderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
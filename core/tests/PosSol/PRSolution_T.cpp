@@ -0,0 +1,247 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <vector>
+#include "PRSolution.hpp"
+#include "GPSEphemerisStore.hpp"
+#include "GGTropModel.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class PRSolution_T
+{
+public:
+   PRSolution_T()
+   {
+      dataDir = getPathData() + getFileSep();
+   }
+
+      /** Compare RAIM with IncrementalRAIM to the full search, on the GPS
+       * C1 pseudoranges of a RINEX file with an error added to one
+       * satellite, and perhaps a second error to another. The errors
+       * range from meters to hundreds of kilometers, where the
+       * linearization of the screen is poor, and the epochs are cut to
+       * six to eight satellites, for poor geometry and for combinations
+       * with equal (zero) RMS residual. Both must reject the same
+       * satellites and give the same solution. */
+   unsigned incrementalRAIMTest()
+   {
+      TUDEF("PRSolution", "RAIMCompute");
+      try
+      {
+         vector<Epoch> epochs;
+         loadData(epochs);
+         TUASSERT(epochs.size() > 100);
+
+         const double errors[] = { 20., 300., 5000., 400000. };
+         const double seconds[] = { 0., 12., 200. };
+         const unsigned sizes[] = { 6, 7, 8, 99 };
+         unsigned nsol = 0, ndiff = 0, nrej = 0, nhit = 0;
+         for (unsigned i = 0; i < epochs.size(); i += 6)
+         {
+            for (unsigned si = 0; si < 4; si++)
+            {
+               Epoch epoch(epochs[i]);
+               if (epoch.ranges.size() > sizes[si])
+               {
+                  epoch.sats.resize(sizes[si]);
+                  epoch.ranges.resize(sizes[si]);
+               }
+               unsigned n = epoch.ranges.size();
+               if (n < 6)
+                  continue;
+               for (unsigned ie = 0; ie < 4; ie++)
+               {
+                  for (unsigned is = 0; is < 3; is++)
+                  {
+                     for (unsigned k = 0; k < 2; k++)
+                     {
+                        unsigned bad = (i/6 + 3*k) % n;
+                        Epoch test(epoch);
+                        test.ranges[bad] += errors[ie];
+                        test.ranges[(bad+1+ie) % n] -= seconds[is];
+                        if (!compare(test, nsol))
+                           ndiff++;
+                        else if (is == 0 && errors[ie] > 200. && n > 6 &&
+                                 inc.isValid())
+                        {
+                              // a single large error must be rejected, given
+                              // enough satellites to identify it
+                           nrej++;
+                           if (rejected(test.sats[bad]))
+                              nhit++;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+         TUASSERT(nsol > 1500);
+         TUASSERTE(unsigned, 0, ndiff);
+         TUASSERT(nrej > 200);
+         TUASSERTE(unsigned, nrej, nhit);
+      }
+      catch (Exception& exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+private:
+      /// The GPS pseudoranges from one epoch.
+   struct Epoch
+   {
+      CommonTime time;
+      vector<SatID> sats;
+      vector<double> ranges;
+   };
+
+      /** Solve with and without IncrementalRAIM, keeping the first in
+       * inc, and return true if they agree exactly; count the valid
+       * solutions in nsol. */
+   bool compare(const Epoch& epoch, unsigned& nsol)
+   {
+      PRSolution full;
+      full.IncrementalRAIM = false;
+      inc = PRSolution();
+      inc.IncrementalRAIM = true;
+      int fret = solve(full, epoch);
+      int iret = solve(inc, epoch);
+      if (fret != iret || full.isValid() != inc.isValid() ||
+          full.SatelliteIDs != inc.SatelliteIDs)
+         return false;
+      if (fret < 0)
+         return true;
+      nsol++;
+      if (full.RMSResidual != inc.RMSResidual ||
+          full.Solution.size() != inc.Solution.size())
+         return false;
+      for (unsigned j = 0; j < full.Solution.size(); j++)
+      {
+         if (full.Solution(j) != inc.Solution(j))
+            return false;
+      }
+      return true;
+   }
+
+      /// Return true if the last incremental solution rejected sat.
+   bool rejected(const SatID& sat)
+   {
+      for (unsigned j = 0; j < inc.SatelliteIDs.size(); j++)
+      {
+         if (inc.SatelliteIDs[j].id < 0 &&
+             -inc.SatelliteIDs[j].id == sat.id)
+            return true;
+      }
+      return false;
+   }
+
+   int solve(PRSolution& prs, const Epoch& epoch)
+   {
+      prs.hasMemory = false;
+      vector<SatID> sats(epoch.sats);
+      vector<SatID::SatelliteSystem> systems;
+      Matrix<double> invMC;
+      GGTropModel trop;
+      return prs.RAIMCompute(epoch.time, sats, systems, epoch.ranges, invMC,
+                             &store, &trop);
+   }
+
+   void loadData(vector<Epoch>& epochs)
+   {
+      store.clear();
+      string navFile(dataDir + "arlm200a.15n");
+      Rinex3NavStream navStrm(navFile.c_str());
+      Rinex3NavHeader navHdr;
+      Rinex3NavData rnd;
+      navStrm >> navHdr;
+      while (navStrm >> rnd)
+      {
+         if (rnd.sat.system == SatID::systemGPS)
+            store.addEphemeris(GPSEphemeris(rnd));
+      }
+
+      string obsFile(dataDir + "arlm200a.15o");
+      Rinex3ObsStream obsStrm(obsFile.c_str());
+      Rinex3ObsHeader obsHdr;
+      Rinex3ObsData rod;
+      obsStrm >> obsHdr;
+      size_t c1 = obsHdr.getObsIndex("G", RinexObsID("GC1C"));
+      while (obsStrm >> rod)
+      {
+         Epoch epoch;
+         epoch.time = rod.time;
+         Rinex3ObsData::DataMap::const_iterator it;
+         for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+         {
+            if (it->first.system != SatID::systemGPS ||
+                it->second[c1].data == 0)
+               continue;
+            epoch.sats.push_back(it->first);
+            epoch.ranges.push_back(it->second[c1].data);
+         }
+         epochs.push_back(epoch);
+      }
+   }
+
+   string dataDir;
+   GPSEphemerisStore store;
+   PRSolution inc;            ///< the last solution with IncrementalRAIM
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PRSolution_T testClass;
+
+   errorTotal += testClass.incrementalRAIMTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
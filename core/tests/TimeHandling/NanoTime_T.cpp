@@ -0,0 +1,266 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "NanoTime.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <map>
+
+using namespace std;
+using namespace gpstk;
+
+class NanoTime_T
+{
+public:
+   unsigned initializationTest();
+   unsigned conversionTest();
+   unsigned arithmeticTest();
+   unsigned comparisonTest();
+   unsigned constexprTest();
+};
+
+
+unsigned NanoTime_T ::
+initializationTest()
+{
+   TUDEF("NanoTime", "NanoTime");
+   NanoTime t0;
+   TUASSERTE(int64_t, 0, t0.getNanoseconds());
+   TUASSERTE(TimeSystem, TimeSystem(TimeSystem::Unknown), t0.getTimeSystem());
+   NanoTime t1(1234567890123LL, TimeSystem::GPS);
+   TUASSERTE(int64_t, 1234567890123LL, t1.getNanoseconds());
+   TUASSERTE(TimeSystem, TimeSystem(TimeSystem::GPS), t1.getTimeSystem());
+   t1.setTimeSystem(TimeSystem::UTC);
+   TUASSERTE(TimeSystem, TimeSystem(TimeSystem::UTC), t1.getTimeSystem());
+      // GPS epoch
+   CommonTime ct = GPSWeekSecond(0, 0.0, TimeSystem::GPS);
+   NanoTime t2(ct);
+   TUASSERTE(int64_t, 0, t2.getNanoseconds());
+   TUASSERTE(TimeSystem, TimeSystem(TimeSystem::GPS), t2.getTimeSystem());
+   TURETURN();
+}
+
+
+unsigned NanoTime_T ::
+conversionTest()
+{
+   TUDEF("NanoTime", "convertToCommonTime");
+      // Times before and after the epoch, with and without fractional
+      // milliseconds.
+   CommonTime times[] =
+      {
+         CivilTime(1980, 1, 6, 0, 0, 0.0, TimeSystem::GPS),
+         CivilTime(1980, 1, 5, 23, 59, 59.999999999, TimeSystem::GPS),
+         CivilTime(1970, 1, 1, 0, 0, 0.0, TimeSystem::UTC),
+         CivilTime(2015, 7, 19, 12, 34, 56.123456789, TimeSystem::GPS),
+         CivilTime(2100, 2, 28, 23, 59, 59.999, TimeSystem::GLO),
+         CivilTime(1800, 3, 1, 0, 0, 0.000000001, TimeSystem::Any),
+         CommonTime::BEGINNING_OF_TIME,
+         CommonTime::END_OF_TIME
+      };
+   for (unsigned i = 0; i < sizeof(times)/sizeof(times[0]); i++)
+   {
+      NanoTime nt(times[i]);
+      CommonTime ct(nt.convertToCommonTime());
+         // CommonTime may hold fractions of a nanosecond
+      TUASSERTFEPS(0., ct - times[i], 0.5e-9);
+      TUASSERTE(TimeSystem, times[i].getTimeSystem(), ct.getTimeSystem());
+         // round trip from NanoTime is exact
+      TUASSERTE(int64_t, nt.getNanoseconds(), NanoTime(ct).getNanoseconds());
+   }
+   TUASSERTE(int64_t, NanoTime::BEGINNING_NS,
+             NanoTime(CommonTime::BEGINNING_OF_TIME).getNanoseconds());
+   TUASSERTE(int64_t, NanoTime::END_NS,
+             NanoTime(CommonTime::END_OF_TIME).getNanoseconds());
+   TUASSERTE(CommonTime, CommonTime::END_OF_TIME,
+             NanoTime::END_OF_TIME.convertToCommonTime());
+
+   NanoTime before(CivilTime(1980, 1, 5, 23, 59, 59.999999999,
+                             TimeSystem::GPS));
+   TUASSERTE(int64_t, -1, before.getNanoseconds());
+
+   TUCSM("NanoTime(const CommonTime&)");
+   try
+   {
+      NanoTime nt(CivilTime(1500, 1, 1, 0, 0, 0.0, TimeSystem::GPS));
+      TUFAIL("Expected InvalidParameter for a time out of range");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("InvalidParameter");
+   }
+   try
+   {
+      NanoTime nt(CivilTime(2300, 1, 1, 0, 0, 0.0, TimeSystem::GPS));
+      TUFAIL("Expected InvalidParameter for a time out of range");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("InvalidParameter");
+   }
+   TURETURN();
+}
+
+
+unsigned NanoTime_T ::
+arithmeticTest()
+{
+   TUDEF("NanoTime", "operator-");
+   CommonTime ct = GPSWeekSecond(1854, 345600.0, TimeSystem::GPS);
+   NanoTime t1(ct), t2(ct);
+   t2 += 1.5;
+   TUASSERTFE(1.5, t2 - t1);
+   TUASSERTE(int64_t, 1500000000LL, t2.diffNanoseconds(t1));
+   t2 -= 0.000000001;
+   TUASSERTE(int64_t, 1499999999LL, t2.diffNanoseconds(t1));
+   TUASSERTE(int64_t, -1000000000LL, (t1 - 1.0).diffNanoseconds(t1));
+   TUASSERTE(int64_t, 86400LL*NanoTime::NS_PER_SEC,
+             (t1 + 86400.0).diffNanoseconds(t1));
+   t2 = t1;
+   t2.addNanoseconds(-3);
+   TUASSERTE(int64_t, -3, t2.diffNanoseconds(t1));
+      // agrees with CommonTime arithmetic
+   CommonTime ct2(ct);
+   ct2 += 7200.25;
+   TUASSERTE(CommonTime, ct2, (t1 + 7200.25).convertToCommonTime());
+
+   NanoTime tu(t1.getNanoseconds(), TimeSystem::UTC);
+   try
+   {
+      double d = tu - t1;
+      TUFAIL("Expected InvalidRequest for differing time systems");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+   NanoTime ta(t1.getNanoseconds() + 10, TimeSystem::Any);
+   TUASSERTE(int64_t, 10, ta.diffNanoseconds(t1));
+   TURETURN();
+}
+
+
+unsigned NanoTime_T ::
+comparisonTest()
+{
+   TUDEF("NanoTime", "operator<");
+   NanoTime a(100, TimeSystem::GPS), b(101, TimeSystem::GPS),
+      c(100, TimeSystem::GPS), u(100, TimeSystem::UTC),
+      any(100, TimeSystem::Any);
+   TUASSERT(a < b);
+   TUASSERT(!(b < a));
+   TUASSERT(!(a < c));
+   TUASSERT(b > a);
+   TUASSERT(a <= c);
+   TUASSERT(a <= b);
+   TUASSERT(b >= a);
+   TUASSERT(a >= c);
+   TUCSM("operator==");
+   TUASSERT(a == c);
+   TUASSERT(a != b);
+   TUASSERT(a != u);
+   TUASSERT(a == any);
+   TUASSERT(u == any);
+   TUASSERT(NanoTime::BEGINNING_OF_TIME < a);
+   TUASSERT(a < NanoTime::END_OF_TIME);
+   TUCSM("operator<");
+   try
+   {
+      bool x = a < u;
+      TUFAIL("Expected InvalidRequest for differing time systems");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+      // usable as a map key, ordered the same as CommonTime
+   map<NanoTime, int> m;
+   CommonTime ct = GPSWeekSecond(1854, 0.0, TimeSystem::GPS);
+   for (int i = 9; i >= 0; i--)
+      m[NanoTime(ct + i*30.0)] = i;
+   TUASSERTE(size_t, 10, m.size());
+   int expected = 0;
+   for (map<NanoTime, int>::const_iterator i = m.begin(); i != m.end(); i++)
+   {
+      TUASSERTE(int, expected, i->second);
+      TUASSERTE(CommonTime, ct + expected*30.0,
+                i->first.convertToCommonTime());
+      expected++;
+   }
+   TUASSERTE(int, 3, m[NanoTime(ct + 90.0)]);
+   TURETURN();
+}
+
+
+unsigned NanoTime_T ::
+constexprTest()
+{
+   TUDEF("NanoTime", "constexpr");
+      // these are checked by the compiler; the test only has to build
+   constexpr NanoTime t1(1000000000LL, TimeSystem::GPS);
+   constexpr NanoTime t2(t1 + 1.5);
+   static_assert(t2.diffNanoseconds(t1) == 1500000000LL, "diffNanoseconds");
+   static_assert(t2 - t1 == 1.5, "operator-(NanoTime)");
+   static_assert((t1 - 0.000000001).getNanoseconds() == 999999999LL,
+                 "operator-(double)");
+   static_assert(t1.plusNanoseconds(-3).diffNanoseconds(t1) == -3,
+                 "plusNanoseconds");
+   static_assert(t1 < t2 && t2 > t1 && t1 <= t1 && t2 >= t1, "ordering");
+   static_assert(t1 == NanoTime(1000000000LL, TimeSystem::Any), "Any");
+   static_assert(t1 != NanoTime(1000000000LL, TimeSystem::UTC),
+                 "differing systems");
+   TUPASS("static_assert");
+   TURETURN();
+}
+
+
+int main()
+{
+   NanoTime_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.initializationTest();
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.comparisonTest();
+   errorTotal += testClass.constexprTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
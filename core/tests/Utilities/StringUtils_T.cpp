@@ -410,6 +410,56 @@ public:
    }
 
 
+      /**
+       * Tests for the fixed-width field converters, which must give
+       * exactly what converting the same field with substr does.
+       */
+   unsigned fieldToNumberTest()
+   {
+      TUDEF("StringUtils", "asDouble");
+      string line("G05  2.345678901234D+03 -1.25 -0.123456789012E-05"
+                  "    7 1D400   12");
+         // every field of every width, including ones running off
+         // the end of the line
+      for (string::size_type pos = 0; pos <= line.length(); pos++)
+      {
+         for (string::size_type len = 0; len < 25; len++)
+         {
+            string field(line.substr(pos, len));
+            TUCSM("asDouble");
+            TUASSERTE(double, asDouble(field), asDouble(line, pos, len));
+            TUCSM("asInt");
+            TUASSERTE(long, asInt(field), asInt(line, pos, len));
+            TUCSM("asUnsigned");
+            TUASSERTE(unsigned long, asUnsigned(field),
+                      asUnsigned(line, pos, len));
+         }
+      }
+      TUCSM("for2doub");
+      TUASSERTE(double, 2345.678901234, for2doub(line, 3, 20));
+      TUASSERTE(double, -0.123456789012e-5, for2doub(line, 29, 20));
+      TUASSERTE(double, 0, for2doub("   ", 3));
+      TUASSERTE(double, -1.25, for2doub(line, 23, 6));
+      TUASSERTE(double, 1.5, for2doub(" 1.5d0", 6));
+         // an overflow gives the largest double, as it always has
+      TUASSERTE(double, std::numeric_limits<double>::max(),
+                for2doub(line, 54, 6));
+         // exponent without digits, and no digits at all
+      TUASSERTE(double, 0, for2doub("1.5D", 4));
+      TUASSERTE(double, 0, for2doub(" D+05", 5));
+      try
+      {
+         asDouble(line, line.length()+1, 2);
+         TUFAIL("Expected std::out_of_range");
+      }
+      catch (std::out_of_range& e)
+      {
+         TUPASS("out_of_range");
+      }
+      TURETURN();
+   }
+
+
       /**
        * Tests for the number to string method.
        * Given numbers of various types, convert them to a string and
@@ -1201,6 +1251,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.stripTrailingTest();
    errorTotal += testClass.stripTest();
    errorTotal += testClass.stringToNumberTest();
+   errorTotal += testClass.fieldToNumberTest();
    errorTotal += testClass.numberToStringTest();
    errorTotal += testClass.hexConversionTest();
    errorTotal += testClass.stringReplaceTest();
@@ -55,6 +55,8 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 // gpstk
 #include "MathBase.hpp"
 #include "RinexSatID.hpp"
@@ -120,6 +122,7 @@ typedef struct configuration {
    int NrecOut;
    Epoch FirstEpoch,LastEpoch;
    bool smoothPR,smoothPH,smooth;
+   int nthreads;           // number of threads correcting passes
    int debug;
    bool verbose,DChelp;
    vector<string> DCcmds;        // all the --DC... on the cmd line
@@ -166,6 +169,10 @@ int Initialize(void) throw(Exception);
 int ShallowCheck(void) throw(Exception);  // called by Initialize()
 int WriteToRINEX(void) throw(Exception);
 void PrintSPList(ostream&, string, vector<SatPass>&);
+int CorrectPass(const int npass, GDCconfiguration& gdc, vector<string>& EditCmds)
+   throw(Exception);
+void OutputPass(const int npass, const vector<string>& EditCmds) throw(Exception);
+void CorrectPassesThreaded(void) throw(Exception);
 
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -173,9 +180,8 @@ int main(int argc, char **argv)
 {
    try {
       clock_t totaltime = clock();
-      int i,nread,npass,iret;
+      int nread,npass,iret;
       Epoch ttag;
-      string msg;
       vector<string> EditCmds;
 
       // Title and description
@@ -311,43 +317,15 @@ int main(int argc, char **argv)
          LOG(INFO) << "";
 
          // -------------------------------- call the GDC, output results and smooth
-         for(npass=0; npass<cfg.SPList.size(); npass++) {
-
-            LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << cfg.SPList[npass];
-            //cfg.SPList[npass].dump(*pLOGstrm,"RAW");      // temp
-
-            msg = "";
-            iret=DiscontinuityCorrector(cfg.SPList[npass],cfg.GDConfig,EditCmds,msg);
-            if(iret != 0) {
-               cfg.SPList[npass].status() = -1;         // failed
-               LOG(ERROR) << "GDC failed (" << iret << " "
-                  << (iret==-1 ? "Singularity":
-                     (iret==-3 ? "DT not set, or memory":
-                     (iret==-4 ? "No data":"Bad input")))
-                  << ") for pass "
-                  << npass+1 << " :\n" << msg;
-               continue;
-            }
-            //if(cfg.verbose && LOGlevel < ConfigureLOG::Level("VERBOSE"))
-            LOG(INFO) << msg;
-
-            ttag = cfg.SPList[npass].getFirstGoodTime();
-            if(ttag < cfg.FirstEpoch) cfg.FirstEpoch = ttag;
-            ttag = cfg.SPList[npass].getLastTime();
-            if(ttag > cfg.LastEpoch) cfg.LastEpoch = ttag;
-
-            // output editing commands
-            for(i=0; i<EditCmds.size(); i++)
-               cfg.ofout << EditCmds[i] << " # pass " << npass+1 << endl;
-            EditCmds.clear();
-
-            // smooth pseudorange and debias phase
-            if(cfg.smooth) {
-               cfg.SPList[npass].smooth(cfg.smoothPR, cfg.smoothPH, msg);
-               LOG(INFO) << msg;
+         if(cfg.nthreads > 1)
+            CorrectPassesThreaded();
+         else for(npass=0; npass<cfg.SPList.size(); npass++) {
+            // NB. if the GDC fails, its commands are output with the next pass
+            if(CorrectPass(npass, cfg.GDConfig, EditCmds) == 0) {
+               OutputPass(npass, EditCmds);
+               EditCmds.clear();
             }
-
-         }  // end for() loop over passes
+         }
 
          // -------------------------------- write to RINEX
          iret = WriteToRINEX();
@@ -791,6 +769,137 @@ void PrintSPList(ostream& os, string msg, vector<SatPass>& v)
    }
 }
 
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// Call the GDC on pass npass using configuration gdc, then smooth it. Return the GDC
+// return value; the GDC adds its editing commands to EditCmds. All output goes to
+// LOG (and GDC debug output to gdc's debug stream); nothing is written to cfg.ofout,
+// and only cfg.SPList[npass] is changed, so passes may be corrected concurrently.
+int CorrectPass(const int npass, GDCconfiguration& gdc, vector<string>& EditCmds)
+   throw(Exception)
+{
+try {
+   string msg;
+
+   LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << cfg.SPList[npass];
+   //cfg.SPList[npass].dump(*pLOGstrm,"RAW");      // temp
+
+   // number the call by pass, not by a count of calls, which differs with threads
+   int iret=DiscontinuityCorrector(cfg.SPList[npass],gdc,EditCmds,msg,-99,npass+1);
+   if(iret != 0) {
+      cfg.SPList[npass].status() = -1;         // failed
+      LOG(ERROR) << "GDC failed (" << iret << " "
+         << (iret==-1 ? "Singularity":
+            (iret==-3 ? "DT not set, or memory":
+            (iret==-4 ? "No data":"Bad input")))
+         << ") for pass "
+         << npass+1 << " :\n" << msg;
+      return iret;
+   }
+   //if(cfg.verbose && LOGlevel < ConfigureLOG::Level("VERBOSE"))
+   LOG(INFO) << msg;
+
+   // smooth pseudorange and debias phase
+   if(cfg.smooth) {
+      cfg.SPList[npass].smooth(cfg.smoothPR, cfg.smoothPH, msg);
+      LOG(INFO) << msg;
+   }
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// Output the editing commands of pass npass, corrected by CorrectPass(), and extend
+// the time span of the output to cover it.
+void OutputPass(const int npass, const vector<string>& EditCmds) throw(Exception)
+{
+try {
+   Epoch ttag;
+
+   ttag = cfg.SPList[npass].getFirstGoodTime();
+   if(ttag < cfg.FirstEpoch) cfg.FirstEpoch = ttag;
+   ttag = cfg.SPList[npass].getLastTime();
+   if(ttag > cfg.LastEpoch) cfg.LastEpoch = ttag;
+
+   // output editing commands
+   for(size_t i=0; i<EditCmds.size(); i++)
+      cfg.ofout << EditCmds[i] << " # pass " << npass+1 << endl;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// Correct all the passes, as the loop in main() does without threads, but with the
+// passes shared out among a pool of cfg.nthreads threads. Each pass is corrected with
+// its own copy of cfg.GDConfig, and its LOG and GDC debug output is buffered; then
+// the output of every pass is written here, in pass order, so that the log and
+// editing command output is the same as without threads.
+void CorrectPassesThreaded(void) throw(Exception)
+{
+   // the output of one pass
+   struct PassOutput {
+      int iret;
+      vector<string> EditCmds;
+      ostringstream log;
+      bool failed;
+      Exception error;
+      PassOutput() : iret(0), failed(false) {}
+   };
+
+   const size_t npasses(cfg.SPList.size());
+   vector<PassOutput> outputs(npasses);
+
+   // The passes differ greatly in size, so rather than a fixed share, each thread
+   // takes the largest pass not yet taken; the long passes are then not left until
+   // the end, when the other threads would be idle.
+   vector<size_t> order(npasses);
+   for(size_t n=0; n<npasses; n++) order[n] = n;
+   stable_sort(order.begin(), order.end(), [](size_t a, size_t b) {
+      return cfg.SPList[a].size() > cfg.SPList[b].size(); });
+   atomic<size_t> next(0);
+
+   auto corrector = [&]() {
+      size_t k;
+      while((k = next++) < npasses) {
+         const size_t npass(order[k]);
+         PassOutput& po(outputs[npass]);
+         GDCconfiguration gdc(cfg.GDConfig);
+         gdc.setDebugStream(po.log);
+         ConfigureLOGstream::ThreadStream() = &po.log;
+         try {
+            po.iret = CorrectPass(npass, gdc, po.EditCmds);
+         }
+         catch(Exception& e) { po.failed = true; po.error = e; }
+         catch(std::exception& e) {
+            po.failed = true;
+            po.error = Exception(string("std except: ") + e.what());
+         }
+         ConfigureLOGstream::ThreadStream() = NULL;
+      }
+   };
+
+   vector<thread> pool;
+   for(int n=0; n<cfg.nthreads; n++)
+      pool.push_back(thread(corrector));
+   for(size_t n=0; n<pool.size(); n++)
+      pool[n].join();
+
+   vector<string> EditCmds;
+   for(size_t npass=0; npass<npasses; npass++) {
+      PassOutput& po(outputs[npass]);
+      LOGstrm << po.log.str() << flush;
+      if(po.failed) GPSTK_THROW(po.error);
+      // as in main(), commands from a failed pass are output with the next pass
+      EditCmds.insert(EditCmds.end(), po.EditCmds.begin(), po.EditCmds.end());
+      if(po.iret == 0) {
+         OutputPass(npass, EditCmds);
+         EditCmds.clear();
+      }
+   }
+}
+
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 int GetCommandLine(int argc, char **argv) throw(Exception)
@@ -826,6 +935,7 @@ try {
    cfg.smoothPR = false;
    cfg.smoothPH = false;
    cfg.smooth = false;
+   cfg.nthreads = 1;
 
    for(i=0; i<9; i++) cfg.ndt[i]=-1;
 
@@ -914,6 +1024,8 @@ try {
             "Set DC parameter <param> to <value>");
    opts.Add(0, "DChelp", "", false, false, &cfg.DChelp, "",
             "Print list of DC parameters (all if -v) and their defaults, then quit");
+   opts.Add(0, "threads", "n", false, false, &cfg.nthreads, "",
+            "Number of threads correcting passes concurrently [1: none]");
 
    opts.Add(0, "log", "file", false, false, &cfg.LogFile, "# Output:",
             "Output log file name (" + cfg.LogFile + ")");
@@ -1014,6 +1126,9 @@ try {
    if(cfg.noCA1) cfg.useCA1 = false;
    if(cfg.noCA2) cfg.useCA2 = false;
 
+   if(cfg.nthreads < 1)
+      oss << "Error - --threads must be at least 1" << endl;
+
    // append errors
    cmdlineErrors += oss.str();
    stripTrailing(cmdlineErrors,'\n');
@@ -1134,6 +1249,8 @@ try {
       LOG(INFO) << " Output RINEX 'MARKER' is " << cfg.HDMarker;
    if(!cfg.HDNumber.empty())
       LOG(INFO) << " Output RINEX 'NUMBER' is " << cfg.HDNumber;
+   if(cfg.nthreads > 1)
+      LOG(INFO) << " Correct passes on " << cfg.nthreads << " threads";
    if(cfg.smoothPR) LOG(INFO) << " 'Smoothed range' option is on\n";
    if(cfg.smoothPH) LOG(INFO) << " 'Smoothed phase' option is on\n";
    if(!cfg.smooth) LOG(INFO) << " No smoothing.\n";
@@ -68,22 +68,42 @@ namespace gpstk
          antennaMap.erase(it);
 
       // add the new data
-      antennaMap[name] = antdata;
+      it = antennaMap.insert(make_pair(name, antdata)).first;
+      nameIndex[name] = &it->second;
    }
 
    // Get the antenna data for the given name from the store.
    // return true if successful, false if input name was not found in the store
    bool AntennaStore::getAntenna(string name, AntexData& antdata) throw()
    {
-      map<string, AntexData>::iterator it;
-      it = antennaMap.find(name);
-      if(it != antennaMap.end()) {
-         antdata = it->second;
+      const AntexData *ptr = findAntenna(name);
+      if(ptr) {
+         antdata = *ptr;
          return true;
       }
       return false;
    }
 
+   // Find the antenna data for the given name in the store, without copying it.
+   // return pointer to the data, or NULL if the name was not found in the store
+   const AntexData *AntennaStore::findAntenna(const string& name) const throw()
+   {
+      unordered_map<string, const AntexData*>::const_iterator it;
+      it = nameIndex.find(name);
+      if(it != nameIndex.end())
+         return it->second;
+      return NULL;
+   }
+
+   // rebuild the hashed name index from the map
+   void AntennaStore::buildNameIndex(void) throw()
+   {
+      nameIndex.clear();
+      map<string, AntexData>::const_iterator it;
+      for(it = antennaMap.begin(); it != antennaMap.end(); it++)
+         nameIndex[it->first] = &it->second;
+   }
+
    // Get the antenna data for the given satellite from the store.
    // Satellites are identified by two things:
    // system character: G or blank GPS, R GLONASS, E GALILEO, M MIXED
@@ -165,8 +185,10 @@ namespace gpstk
             if(!ok) rejects.push_back(it->first);
          }
       }
-      for(j=0; j<rejects.size(); j++)
+      for(j=0; j<rejects.size(); j++) {
          antennaMap.erase(rejects[j]);
+         nameIndex.erase(rejects[j]);
+      }
    }
 
    // Open and read an ANTEX format file with the given name, and read it.
@@ -47,6 +47,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include "AntexHeader.hpp"
 #include "AntexData.hpp"
@@ -93,6 +94,24 @@ namespace gpstk
       /// Empty constructor
       AntennaStore() : includeSats(0) {}
 
+      /// Copy constructor; the name index must point into the new store
+      AntennaStore(const AntennaStore& right)
+         : namesToInclude(right.namesToInclude), includeSats(right.includeSats),
+           antennaMap(right.antennaMap)
+      { buildNameIndex(); }
+
+      /// Assignment operator
+      AntennaStore& operator=(const AntennaStore& right)
+      {
+         if(this != &right) {
+            namesToInclude = right.namesToInclude;
+            includeSats = right.includeSats;
+            antennaMap = right.antennaMap;
+            buildNameIndex();
+         }
+         return *this;
+      }
+
       /// Destructor
       ~AntennaStore() {}
 
@@ -105,6 +124,12 @@ namespace gpstk
       /// @return true if successful, false if input name was not found in the store
       bool getAntenna(std::string name, AntexData& antdata) throw();
 
+      /// Find the antenna data for the given name in the store, without copying it.
+      /// The pointer is valid until the antenna is replaced or removed, or the
+      /// store is cleared.
+      /// @return pointer to the data, or NULL if the name was not found in the store
+      const AntexData *findAntenna(const std::string& name) const throw();
+
       /// Get the antenna data for the given satellite from the store.
       /// Satellites are identified by two things:
       /// system character: G or blank GPS, R GLONASS, E GALILEO, M MIXED
@@ -134,7 +159,7 @@ namespace gpstk
       unsigned int size(void) const throw() { return antennaMap.size(); }
 
       /// clear the store of all information
-      void clear(void) throw() { antennaMap.clear(); }
+      void clear(void) throw() { antennaMap.clear(); nameIndex.clear(); }
 
       /// call to have satellite antennas included in store
       /// NB. call before addAntenna() or addANTEXfile()
@@ -200,6 +225,9 @@ namespace gpstk
       void dump(std::ostream& s = std::cout, short detail = 0);
 
    private:
+      /// rebuild nameIndex from antennaMap
+      void buildNameIndex(void) throw();
+
       /// List of receiver names to include in store
       std::vector<std::string> namesToInclude;
 
@@ -209,7 +237,11 @@ namespace gpstk
 
       /// map from name of antenna to AntexData object
       std::map<std::string, AntexData> antennaMap;
-      
+
+      /// hashed index into antennaMap, for lookup by name; antennaMap itself
+      /// keeps the names in order for getNames(), dump() etc.
+      std::unordered_map<std::string, const AntexData*> nameIndex;
+
    }; // end class AntennaStore
    
 } // namespace gpstk
@@ -204,7 +204,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      double retpco, azim, zen;
+      double azim, zen;
       zen = elev_nadir;             // satellite: elev_nadir is a zenith (nadir) angle
       if(isRxAntenna)               // receiver: elev_nadir is an elevation
          zen = 90. - elev_nadir;
@@ -215,6 +215,116 @@ namespace gpstk
       while(azim < 0.0) azim += 360.0;
       while(azim >= 360.0) azim -= 360.0;
 
+      map<string, antennaPCOandPCVData>::const_iterator it;
+      it = freqPCVmap.find(freq);
+      if(it == freqPCVmap.end()) {
+         Exception e("Frequency " + freq
+               + " not found! System not supported or data corrupted.");
+         GPSTK_THROW(e);
+      }
+
+      const antennaPCOandPCVData& antpco = it->second;
+      if(!antpco.PCVgrid.empty())
+         return evaluatePCVGrid(antpco, azim, zen);
+
+      return evaluatePCVMap(antpco, azim, zen);
+   }
+
+   // Compute the phase center variations at many azimuth and elevation/nadir pairs
+   void AntexData::getPhaseCenterVariations(const string freq,
+                                            const vector<double>& azimuths,
+                                            const vector<double>& elev_nadirs,
+                                            vector<double>& pcvs) const
+      throw(Exception)
+   {
+      if(!isValid()) {
+         Exception e("Invalid AntexData object");
+         GPSTK_THROW(e);
+      }
+      if(azimuths.size() != elev_nadirs.size()) {
+         Exception e("Azimuth and elevation/nadir arrays differ in length");
+         GPSTK_THROW(e);
+      }
+
+      map<string, antennaPCOandPCVData>::const_iterator it;
+      it = freqPCVmap.find(freq);
+      if(it == freqPCVmap.end()) {
+         Exception e("Frequency " + freq
+               + " not found! System not supported or data corrupted.");
+         GPSTK_THROW(e);
+      }
+
+      const antennaPCOandPCVData& antpco = it->second;
+      const bool useGrid(!antpco.PCVgrid.empty());
+
+      pcvs.resize(azimuths.size());
+      for(size_t i=0; i<azimuths.size(); i++) {
+         if(elev_nadirs[i] < 0.0 || elev_nadirs[i] > 90.0) {
+            Exception e("Invalid elevation/nadir angle");
+            GPSTK_THROW(e);
+         }
+
+         double zen(elev_nadirs[i]), azim(azimuths[i]);
+         if(isRxAntenna) zen = 90. - zen;
+         while(azim < 0.0) azim += 360.0;
+         while(azim >= 360.0) azim -= 360.0;
+
+         pcvs[i] = (useGrid ? evaluatePCVGrid(antpco, azim, zen)
+                            : evaluatePCVMap(antpco, azim, zen));
+      }
+   }
+
+   // Copy the PCVs of each frequency from the maps into the regular grid
+   void AntexData::buildPCVGrids(void) throw()
+   {
+      map<string, antennaPCOandPCVData>::iterator it;
+      for(it = freqPCVmap.begin(); it != freqPCVmap.end(); ++it) {
+         antennaPCOandPCVData& antpco = it->second;
+         antpco.PCVgrid.clear();
+         antpco.nGridAzim = antpco.nGridZen = 0;
+         if(zenRange[2] <= 0.0 || (antpco.hasAzimuth && azimDelta <= 0.0))
+            continue;
+
+         // the keys must be exactly those computed by evaluatePCVGrid(), so
+         // that the grid and the maps give the same results
+         bool ok(true);
+         unsigned int naz(0), nzen(0), k;
+         vector<double> grid;
+         azimZenMap::const_iterator jt;
+         zenOffsetMap::const_iterator kt;
+         for(jt = antpco.PCVvalue.begin(); ok && jt != antpco.PCVvalue.end(); ++jt) {
+            if(antpco.hasAzimuth) {
+               if(jt->first < 0.0) continue;       // the NOAZI row is not used
+               if(jt->first != naz*azimDelta) { ok = false; break; }
+            }
+            else if(naz > 0) { ok = false; break; }
+
+            const zenOffsetMap& zenoffmap = jt->second;
+            if(naz == 0) nzen = zenoffmap.size();
+            if(nzen == 0 || zenoffmap.size() != nzen) { ok = false; break; }
+            for(k=0, kt = zenoffmap.begin(); kt != zenoffmap.end(); ++k, ++kt) {
+               if(kt->first != zenRange[0] + k*zenRange[2]) { ok = false; break; }
+               grid.push_back(kt->second);
+            }
+            naz++;
+         }
+
+         // azimuths must run from 0 through at least 360, so that every
+         // azimuth is bracketed without wrapping around
+         if(!ok || naz == 0) continue;
+         if(antpco.hasAzimuth && (naz < 2 || (naz-1)*azimDelta < 360.0)) continue;
+
+         antpco.PCVgrid.swap(grid);
+         antpco.nGridAzim = naz;
+         antpco.nGridZen = nzen;
+      }
+   }
+
+   // Interpolate the PCV maps at azimuth azim and zenith angle zen
+   double AntexData::evaluatePCVMap(const antennaPCOandPCVData& antpco,
+                                    const double azim, const double zen) const
+      throw()
+   {
       // find four points bracketing the point (azim,zen)
       //       zen
       //       ^
@@ -225,18 +335,9 @@ namespace gpstk
       //       az_lo  az_hi
       //
       // find bracketing azims within the map, then find bracketing zeniths and PCOs
-      double az_lo,az_hi,zn_lo,zn_hi,pco[4];
+      double retpco,az_lo,az_hi,zn_lo,zn_hi,pco[4];
       map<double, zenOffsetMap>::const_iterator jt_lo,jt_hi;
 
-      map<string, antennaPCOandPCVData>::const_iterator it;
-      it = freqPCVmap.find(freq);
-      if(it == freqPCVmap.end()) {
-         Exception e("Frequency " + freq
-               + " not found! System not supported or data corrupted.");
-         GPSTK_THROW(e);
-      }
-
-      const antennaPCOandPCVData& antpco = it->second;
       const azimZenMap& azzenmap = antpco.PCVvalue;      // map<double, zenOffsetMap>
 
       if(!antpco.hasAzimuth) {
@@ -309,6 +410,82 @@ namespace gpstk
       return retpco;
    }
 
+   // Interpolate the PCV grid at azimuth azim and zenith angle zen
+   double AntexData::evaluatePCVGrid(const antennaPCOandPCVData& antpco,
+                                     const double azim, const double zen) const
+      throw()
+   {
+      const int nzen(antpco.nGridZen);
+      const double *grid = &antpco.PCVgrid[0];
+      double zn_lo, zn_hi, retpco;
+      int k_lo, k_hi;
+
+      // bracket the zenith angle, as evaluateZenithMap(): at or beyond either
+      // end take the end value, otherwise zn_lo <= zen < zn_hi
+      if(zen <= zenRange[0]) {
+         k_lo = k_hi = 0;
+         zn_lo = zn_hi = zen;
+      }
+      else if(zen >= zenRange[0] + (nzen-1)*zenRange[2]) {
+         k_lo = k_hi = nzen-1;
+         zn_lo = zn_hi = zen;
+      }
+      else {
+         int k = int((zen - zenRange[0])/zenRange[2]);
+         if(k > nzen-2) k = nzen-2;
+         // guard against rounding in the division
+         while(k > 0 && zenRange[0] + k*zenRange[2] > zen) k--;
+         while(k < nzen-2 && zenRange[0] + (k+1)*zenRange[2] <= zen) k++;
+         zn_lo = zenRange[0] + k*zenRange[2];
+         if(zn_lo == zen) {                  // exact match
+            k_lo = k_hi = k;
+            zn_hi = zn_lo;
+         }
+         else {
+            k_lo = k;
+            k_hi = k+1;
+            zn_hi = zenRange[0] + k_hi*zenRange[2];
+         }
+      }
+
+      // bracket the azimuth; the grid runs from 0 through at least 360
+      int i(0);
+      double az_lo(0.0), az_hi(0.0);
+      if(antpco.hasAzimuth) {
+         const int naz(antpco.nGridAzim);
+         i = int(azim/azimDelta);
+         if(i > naz-2) i = naz-2;
+         while(i > 0 && i*azimDelta > azim) i--;
+         while(i < naz-2 && (i+1)*azimDelta <= azim) i++;
+         az_lo = i*azimDelta;
+         az_hi = (i+1)*azimDelta;
+      }
+
+      // no azimuth, or an exact match in azimuth
+      if(!antpco.hasAzimuth || az_lo == azim) {
+         const double *row = grid + i*nzen;
+         if(zn_lo == zn_hi)                  // exact match in zenith angle
+            retpco = row[k_hi];
+         else                                // linear interpolation in zenith angle
+            retpco = (row[k_hi]*(zen - zn_lo) + row[k_lo]*(zn_hi - zen))/(zn_hi - zn_lo);
+         return retpco;
+      }
+
+      // same points and arithmetic as evaluatePCVMap()
+      const double *lo = grid + i*nzen, *hi = lo + nzen;
+      const double pco[4] = { lo[k_hi], hi[k_hi], lo[k_lo], hi[k_lo] };
+      if(zn_hi == zn_lo)
+         retpco = (pco[2]*(az_hi - azim) + pco[3]*(azim - az_lo))/(az_hi - az_lo);
+      else
+         retpco = ( pco[0] * (az_hi - azim)*(zen - zn_lo)
+                  + pco[1] * (azim - az_lo)*(zen - zn_lo)
+                  + pco[2] * (az_hi - azim)*(zn_hi - zen)
+                  + pco[3] * (azim - az_lo)*(zn_hi - zen) )
+                        / ( (az_hi - az_lo)*(zn_hi - zn_lo) );
+
+      return retpco;
+   }
+
    void AntexData::dump(ostream& s, int detail) const
    {
       map<string, antennaPCOandPCVData>::const_iterator it;
@@ -840,6 +1017,7 @@ namespace gpstk
       }
       else if(label == endOfAntennaString) {   // "END OF ANTENNA"
          valid |= endOfAntennaValid;
+         buildPCVGrids();
       }
       else {
          //LOG(INFO) << "Found data record, valid is " << hex << valid;
@@ -170,6 +170,9 @@ namespace gpstk
       /// and how to apply the PCOs.
       class antennaPCOandPCVData {
       public:
+         /// constructor
+         antennaPCOandPCVData() : hasAzimuth(false), nGridAzim(0), nGridZen(0) {}
+
          /// nominal phase center offsets in mm, and RMS values,
          /// in NEU coordinates (for Receiver antennas)
          /// or XYZ (for Satellite antennas); from "NORTH / EAST / UP" record
@@ -188,6 +191,16 @@ namespace gpstk
          /// RMS values are OPTIONAL
          azimZenMap PCVvalue, PCVrms;
 
+         /// PCVvalue on its regular grid, for interpolation without searching the
+         /// maps: PCVgrid[i*nGridZen+k] = PCVvalue[azimuth i][zenith k], where
+         /// azimuth i is i*azimDelta (or NOAZI if !hasAzimuth, when nGridAzim==1)
+         /// and zenith k is zenRange[0]+k*zenRange[2]. Built by buildPCVGrids();
+         /// empty if the maps do not hold a complete regular grid.
+         std::vector<double> PCVgrid;
+
+         /// dimensions of PCVgrid
+         unsigned int nGridAzim, nGridZen;
+
       }; // end of class antennaPCOandPCVData
 
       // member data
@@ -321,6 +334,28 @@ namespace gpstk
                                      const double elev_nadir) const
          throw(Exception);
 
+      /// Compute the phase center variations at many (azimuth, elev_nadir) pairs
+      /// for one frequency; the same as calling getPhaseCenterVariation() for each
+      /// pair, but the frequency is found once.
+      /// @param freq frequency (usually G01 or G02)
+      /// @param azimuths the azimuth angles in degrees, as getPhaseCenterVariation()
+      /// @param elev_nadirs the elevation or nadir angles in degrees, the same
+      ///        length as azimuths
+      /// @param pcvs output phase center variations in millimeters, one per pair
+      /// @throw  as getPhaseCenterVariation(), or if the inputs differ in length
+      void getPhaseCenterVariations(const std::string freq,
+                                    const std::vector<double>& azimuths,
+                                    const std::vector<double>& elev_nadirs,
+                                    std::vector<double>& pcvs) const
+         throw(Exception);
+
+      /// Copy the PCVs of each frequency, if they lie on the regular grid given by
+      /// azimDelta and zenRange (as they do in any ANTEX file), from the maps into
+      /// antennaPCOandPCVData::PCVgrid, which the 'get' routines then interpolate
+      /// directly, with the same results as interpolating the maps. Called when the
+      /// record is read; call it again after changing antennaPCOandPCVData::PCVvalue.
+      void buildPCVGrids(void) throw();
+
       /// Dump AntexData. Set detail = 0 for type, serial no., sat codes only;
       /// = 1 for all information except phase center offsets, = 2 for all data.
 #pragma clang diagnostic push
@@ -328,6 +363,18 @@ namespace gpstk
       virtual void dump(std::ostream& s, int detail=0) const;
 #pragma clang diagnostic pop
    protected:
+      /// Interpolate the PCV maps at azimuth azim (0 <= azim < 360) and zenith
+      /// angle zen, for getPhaseCenterVariation().
+      double evaluatePCVMap(const antennaPCOandPCVData& antpco,
+                            const double azim, const double zen) const throw();
+
+      /// Interpolate antpco.PCVgrid (which must not be empty) at azimuth azim
+      /// (0 <= azim < 360) and zenith angle zen; the same bracketing and
+      /// arithmetic as evaluatePCVMap(), with indexes computed rather than
+      /// searched for.
+      double evaluatePCVGrid(const antennaPCOandPCVData& antpco,
+                             const double azim, const double zen) const throw();
+
       /// Find zenith angles bracketing the input zenith angle within the given map,
       /// and the corresponding PCOs.
       void evaluateZenithMap(const double& zen,
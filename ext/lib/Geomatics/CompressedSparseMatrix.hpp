@@ -0,0 +1,675 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file CompressedSparseMatrix.hpp  Compressed row (CSR) and compressed column (CSC)
+/// storage for sparse matrices, with a builder for assembling them, products with
+/// dense Vector and Matrix, and a square root information measurement update.
+
+#ifndef COMPRESSED_SPARSE_MATRIX_INCLUDE
+#define COMPRESSED_SPARSE_MATRIX_INCLUDE
+
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+#include "SparseMatrix.hpp"
+
+namespace gpstk
+{
+   // forward declarations
+   template <class T> class CSRMatrix;
+   template <class T> class CSCMatrix;
+   template <class T> CSCMatrix<T> transpose(const CSRMatrix<T>& M);
+   template <class T> CSRMatrix<T> transpose(const CSCMatrix<T>& M);
+
+   //---------------------------------------------------------------------------
+   /// Compressed storage common to CSRMatrix and CSCMatrix. The data are stored in
+   /// three arrays: the non-zero values and their minor (column for CSR, row for
+   /// CSC) indexes, in order of major index and then of minor index, and for each
+   /// major index the position in those arrays of its first element, plus the
+   /// total at the end. So major index k holds elements ptr[k] to ptr[k+1]-1.
+   /// Unlike SparseMatrix, which keeps a std::map of std::maps, the data are
+   /// contiguous and are walked without any search; on the other hand the
+   /// structure is fixed once built. Build it with SparseBuilder, or convert
+   /// a SparseMatrix or Matrix.
+   template <class T> class CompressedSparse
+   {
+   public:
+      /// number of non-zero data
+      inline unsigned int datasize(void) const { return val.size(); }
+
+      /// array of the positions of the first element of each major index,
+      /// of length (number of major indexes)+1
+      inline const std::vector<unsigned int>& pointers(void) const { return ptr; }
+
+      /// array of minor indexes, of length datasize()
+      inline const std::vector<unsigned int>& indexes(void) const { return ind; }
+
+      /// array of values, of length datasize()
+      inline const std::vector<T>& values(void) const { return val; }
+
+   protected:
+      /// empty constructor
+      CompressedSparse(void) : ptr(1,0) { }
+
+      /// value at (major, minor), zero if not stored
+      T find(const unsigned int maj, const unsigned int mnr) const
+      {
+         std::vector<unsigned int>::const_iterator b(ind.begin()+ptr[maj]),
+                                                   e(ind.begin()+ptr[maj+1]),
+                                                   it(std::lower_bound(b,e,mnr));
+         if(it == e || *it != mnr) return T(0);
+         return val[it - ind.begin()];
+      }
+
+      /// fill the arrays from triplets (major, minor, value), in any order.
+      /// Duplicates are summed, and zeros are not stored.
+      void compress(const unsigned int nmajor,
+                    const std::vector<unsigned int>& majors,
+                    const std::vector<unsigned int>& minors,
+                    const std::vector<T>& values)
+      {
+         const unsigned int n(values.size());
+
+         // sort the triplets by major then minor index; stable, so that
+         // duplicates are summed in the order they were added
+         std::vector<unsigned int> perm(n);
+         for(unsigned int k=0; k<n; k++) perm[k] = k;
+         std::stable_sort(perm.begin(), perm.end(), TripletOrder(majors,minors));
+
+         ptr.assign(nmajor+1,0);
+         ind.clear(); ind.reserve(n);
+         val.clear(); val.reserve(n);
+         for(unsigned int k=0; k<n; ) {
+            unsigned int maj(majors[perm[k]]), mnr(minors[perm[k]]);
+            T sum(values[perm[k]]);
+            for(k++; k<n && majors[perm[k]]==maj && minors[perm[k]]==mnr; k++)
+               sum += values[perm[k]];
+            if(sum == T(0)) continue;
+            ind.push_back(mnr);
+            val.push_back(sum);
+            ptr[maj+1]++;
+         }
+         for(unsigned int k=0; k<nmajor; k++) ptr[k+1] += ptr[k];
+      }
+
+      /// fill the arrays with the transpose of other, i.e. with the same matrix
+      /// stored the other way, from major index to minor; nminor is the number of
+      /// minor indexes of other. This is a counting sort, linear in datasize().
+      void transposeFrom(const CompressedSparse<T>& other, const unsigned int nminor)
+      {
+         const unsigned int nmajor(other.ptr.size()-1), n(other.val.size());
+         ptr.assign(nminor+1,0);
+         ind.resize(n);
+         val.resize(n);
+         unsigned int j,k;
+         for(k=0; k<n; k++) ptr[other.ind[k]+1]++;
+         for(j=0; j<nminor; j++) ptr[j+1] += ptr[j];
+         std::vector<unsigned int> next(ptr.begin(), ptr.end()-1);
+         for(j=0; j<nmajor; j++) {
+            for(k=other.ptr[j]; k<other.ptr[j+1]; k++) {
+               unsigned int pos(next[other.ind[k]]++);
+               ind[pos] = j;
+               val[pos] = other.val[k];
+            }
+         }
+      }
+
+      /// position of first element of each major index, and the total
+      std::vector<unsigned int> ptr;
+
+      /// minor index of each element
+      std::vector<unsigned int> ind;
+
+      /// value of each element
+      std::vector<T> val;
+
+   private:
+      /// order of triplets for compress()
+      class TripletOrder
+      {
+      public:
+         TripletOrder(const std::vector<unsigned int>& maj,
+                      const std::vector<unsigned int>& mnr)
+            : majors(maj), minors(mnr) { }
+         bool operator()(const unsigned int a, const unsigned int b) const
+         {
+            if(majors[a] != majors[b]) return (majors[a] < majors[b]);
+            return (minors[a] < minors[b]);
+         }
+      private:
+         const std::vector<unsigned int>& majors;
+         const std::vector<unsigned int>& minors;
+      };
+
+   }; // end class CompressedSparse
+
+   //---------------------------------------------------------------------------
+   /// Assemble a sparse matrix element by element, in any order, then convert it to
+   /// compressed row (CSR) or compressed column (CSC) form. Elements added more
+   /// than once are summed, as when assembling partials contribution by
+   /// contribution. For example
+   /// @code
+   /// SparseBuilder<double> B(nData, nState);
+   /// for(...) B.add(i, j, partial);
+   /// CSCMatrix<double> H(B.toCSC());
+   /// @endcode
+   template <class T> class SparseBuilder
+   {
+   public:
+      /// constructor with dimensions
+      SparseBuilder(unsigned int r, unsigned int c) : nrows(r), ncols(c) { }
+
+      /// get number of rows
+      inline unsigned int rows(void) const { return nrows; }
+
+      /// get number of columns
+      inline unsigned int cols(void) const { return ncols; }
+
+      /// number of elements added so far, counting duplicates
+      inline unsigned int datasize(void) const { return vals.size(); }
+
+      /// reserve space for n elements
+      void reserve(const unsigned int n)
+      {
+         irow.reserve(n);
+         jcol.reserve(n);
+         vals.reserve(n);
+      }
+
+      /// remove all elements; leave dimensions alone
+      void clear(void)
+      {
+         irow.clear();
+         jcol.clear();
+         vals.clear();
+      }
+
+      /// add value to element (i,j)
+      void add(const unsigned int i, const unsigned int j, const T& value)
+         throw(Exception)
+      {
+         if(i >= nrows || j >= ncols) {
+            std::ostringstream oss;
+            oss << "SparseBuilder index (" << i << "," << j << ") out of range for "
+                << nrows << "x" << ncols;
+            GPSTK_THROW(Exception(oss.str()));
+         }
+         irow.push_back(i);
+         jcol.push_back(j);
+         vals.push_back(value);
+      }
+
+      /// compressed row form of the elements added
+      CSRMatrix<T> toCSR(void) const
+      {
+         CSRMatrix<T> toRet(nrows, ncols);
+         toRet.compress(nrows, irow, jcol, vals);
+         return toRet;
+      }
+
+      /// compressed column form of the elements added
+      CSCMatrix<T> toCSC(void) const
+      {
+         CSCMatrix<T> toRet(nrows, ncols);
+         toRet.compress(ncols, jcol, irow, vals);
+         return toRet;
+      }
+
+   private:
+      /// dimensions
+      unsigned int nrows, ncols;
+
+      /// the elements, as parallel arrays row, column, value
+      std::vector<unsigned int> irow, jcol;
+      std::vector<T> vals;
+
+   }; // end class SparseBuilder
+
+   //---------------------------------------------------------------------------
+   /// Sparse matrix in compressed row (CSR) form, in which each row is stored
+   /// contiguously; see CompressedSparse. Products with a dense Vector on the
+   /// right are computed one row at a time, as dot products.
+   template <class T> class CSRMatrix : public CompressedSparse<T>
+   {
+   public:
+      friend class SparseBuilder<T>;
+      friend class CSCMatrix<T>;
+      friend CSRMatrix<T> transpose<T>(const CSCMatrix<T>& M);
+
+      /// empty constructor
+      CSRMatrix(void) : nrows(0), ncols(0) { }
+
+      /// constructor with dimensions; the matrix is all zero
+      CSRMatrix(unsigned int r, unsigned int c) : nrows(r), ncols(c)
+         { this->ptr.assign(r+1,0); }
+
+      /// constructor from SparseMatrix
+      explicit CSRMatrix(const SparseMatrix<T>& SM) : nrows(SM.rows()), ncols(SM.cols())
+      {
+         std::vector<unsigned int> r, c;
+         std::vector<T> v;
+         SM.flatten(r, c, v);
+         this->compress(nrows, r, c, v);
+      }
+
+      /// constructor from regular Matrix<T>; zeros are not stored
+      explicit CSRMatrix(const Matrix<T>& M) : nrows(M.rows()), ncols(M.cols())
+      {
+         this->ptr.assign(nrows+1,0);
+         for(unsigned int i=0; i<nrows; i++) {
+            for(unsigned int j=0; j<ncols; j++) {
+               if(M(i,j) == T(0)) continue;
+               this->ind.push_back(j);
+               this->val.push_back(M(i,j));
+            }
+            this->ptr[i+1] = this->val.size();
+         }
+      }
+
+      /// constructor from the same matrix in compressed column form
+      explicit CSRMatrix(const CSCMatrix<T>& CSC) : nrows(CSC.rows()), ncols(CSC.cols())
+         { this->transposeFrom(CSC, nrows); }
+
+      /// cast to Matrix<T>
+      operator Matrix<T>() const
+      {
+         Matrix<T> toRet(nrows,ncols,T(0));
+         for(unsigned int i=0; i<nrows; i++)
+            for(unsigned int k=this->ptr[i]; k<this->ptr[i+1]; k++)
+               toRet(i,this->ind[k]) = this->val[k];
+         return toRet;
+      }
+
+      /// get number of rows
+      inline unsigned int rows(void) const { return nrows; }
+
+      /// get number of columns
+      inline unsigned int cols(void) const { return ncols; }
+
+      /// size of matrix = rows()*cols()
+      inline unsigned int size(void) const { return nrows*ncols; }
+
+      /// element (i,j), zero if not stored
+      T operator()(const unsigned int i, const unsigned int j) const
+         { return this->find(i,j); }
+
+   private:
+      /// dimensions of the "real" matrix
+      unsigned int nrows, ncols;
+
+   }; // end class CSRMatrix
+
+   //---------------------------------------------------------------------------
+   /// Sparse matrix in compressed column (CSC) form, in which each column is stored
+   /// contiguously; see CompressedSparse. This is the natural form for algorithms
+   /// that work one column at a time, such as the Householder transformation in
+   /// SrifMU(), and for products with a dense Vector or Matrix on the right, which
+   /// add up multiples of the columns.
+   template <class T> class CSCMatrix : public CompressedSparse<T>
+   {
+   public:
+      friend class SparseBuilder<T>;
+      friend class CSRMatrix<T>;
+      friend CSCMatrix<T> transpose<T>(const CSRMatrix<T>& M);
+
+      /// empty constructor
+      CSCMatrix(void) : nrows(0), ncols(0) { }
+
+      /// constructor with dimensions; the matrix is all zero
+      CSCMatrix(unsigned int r, unsigned int c) : nrows(r), ncols(c)
+         { this->ptr.assign(c+1,0); }
+
+      /// constructor from SparseMatrix
+      explicit CSCMatrix(const SparseMatrix<T>& SM) : nrows(SM.rows()), ncols(SM.cols())
+      {
+         std::vector<unsigned int> r, c;
+         std::vector<T> v;
+         SM.flatten(r, c, v);
+         this->compress(ncols, c, r, v);
+      }
+
+      /// constructor from regular Matrix<T>; zeros are not stored
+      explicit CSCMatrix(const Matrix<T>& M) : nrows(M.rows()), ncols(M.cols())
+      {
+         this->ptr.assign(ncols+1,0);
+         for(unsigned int j=0; j<ncols; j++) {
+            for(unsigned int i=0; i<nrows; i++) {
+               if(M(i,j) == T(0)) continue;
+               this->ind.push_back(i);
+               this->val.push_back(M(i,j));
+            }
+            this->ptr[j+1] = this->val.size();
+         }
+      }
+
+      /// constructor from the same matrix in compressed row form
+      explicit CSCMatrix(const CSRMatrix<T>& CSR) : nrows(CSR.rows()), ncols(CSR.cols())
+         { this->transposeFrom(CSR, ncols); }
+
+      /// cast to Matrix<T>
+      operator Matrix<T>() const
+      {
+         Matrix<T> toRet(nrows,ncols,T(0));
+         for(unsigned int j=0; j<ncols; j++)
+            for(unsigned int k=this->ptr[j]; k<this->ptr[j+1]; k++)
+               toRet(this->ind[k],j) = this->val[k];
+         return toRet;
+      }
+
+      /// get number of rows
+      inline unsigned int rows(void) const { return nrows; }
+
+      /// get number of columns
+      inline unsigned int cols(void) const { return ncols; }
+
+      /// size of matrix = rows()*cols()
+      inline unsigned int size(void) const { return nrows*ncols; }
+
+      /// element (i,j), zero if not stored
+      T operator()(const unsigned int i, const unsigned int j) const
+         { return this->find(j,i); }
+
+   private:
+      /// dimensions of the "real" matrix
+      unsigned int nrows, ncols;
+
+   }; // end class CSCMatrix
+
+   //---------------------------------------------------------------------------
+   /// transpose of a compressed row matrix; the rows of M are the columns of the
+   /// transpose, so the arrays are simply copied
+   template <class T> CSCMatrix<T> transpose(const CSRMatrix<T>& M)
+   {
+      CSCMatrix<T> toRet(M.cols(), M.rows());
+      toRet.ptr = M.pointers();
+      toRet.ind = M.indexes();
+      toRet.val = M.values();
+      return toRet;
+   }
+
+   /// transpose of a compressed column matrix; the columns of M are the rows of
+   /// the transpose, so the arrays are simply copied
+   template <class T> CSRMatrix<T> transpose(const CSCMatrix<T>& M)
+   {
+      CSRMatrix<T> toRet(M.cols(), M.rows());
+      toRet.ptr = M.pointers();
+      toRet.ind = M.indexes();
+      toRet.val = M.values();
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   /// Compressed row matrix times Vector, one sparse dot product per row.
+   template <class T> Vector<T> operator*(const CSRMatrix<T>& L, const Vector<T>& V)
+      throw(Exception)
+   {
+      if(L.cols() != V.size())
+         GPSTK_THROW(Exception("Incompatible dimensions op*(CSRMatrix,Vector)"));
+
+      const std::vector<unsigned int>& ptr(L.pointers()), ind(L.indexes());
+      const std::vector<T>& val(L.values());
+      Vector<T> toRet(L.rows(),T(0));
+      for(unsigned int i=0; i<L.rows(); i++) {
+         T sum(0);
+         for(unsigned int k=ptr[i]; k<ptr[i+1]; k++)
+            sum += val[k] * V(ind[k]);
+         toRet(i) = sum;
+      }
+      return toRet;
+   }
+
+   /// Compressed column matrix times Vector, accumulating multiples of the columns.
+   template <class T> Vector<T> operator*(const CSCMatrix<T>& L, const Vector<T>& V)
+      throw(Exception)
+   {
+      if(L.cols() != V.size())
+         GPSTK_THROW(Exception("Incompatible dimensions op*(CSCMatrix,Vector)"));
+
+      const std::vector<unsigned int>& ptr(L.pointers()), ind(L.indexes());
+      const std::vector<T>& val(L.values());
+      Vector<T> toRet(L.rows(),T(0));
+      for(unsigned int j=0; j<L.cols(); j++) {
+         const T vj(V(j));
+         if(vj == T(0)) continue;
+         for(unsigned int k=ptr[j]; k<ptr[j+1]; k++)
+            toRet(ind[k]) += val[k] * vj;
+      }
+      return toRet;
+   }
+
+   /// Compressed row matrix times Matrix; each column of the result is computed as
+   /// in operator*(CSRMatrix,Vector), reading one column of R.
+   template <class T> Matrix<T> operator*(const CSRMatrix<T>& L, const Matrix<T>& R)
+      throw(Exception)
+   {
+      if(L.cols() != R.rows())
+         GPSTK_THROW(Exception("Incompatible dimensions op*(CSRMatrix,Matrix)"));
+
+      const std::vector<unsigned int>& ptr(L.pointers()), ind(L.indexes());
+      const std::vector<T>& val(L.values());
+      Matrix<T> toRet(L.rows(),R.cols(),T(0));
+      for(unsigned int j=0; j<R.cols(); j++) {
+         for(unsigned int i=0; i<L.rows(); i++) {
+            T sum(0);
+            for(unsigned int k=ptr[i]; k<ptr[i+1]; k++)
+               sum += val[k] * R(ind[k],j);
+            toRet(i,j) = sum;
+         }
+      }
+      return toRet;
+   }
+
+   /// Compressed column matrix times Matrix; each column of the result is computed
+   /// as in operator*(CSCMatrix,Vector), reading one column of R.
+   template <class T> Matrix<T> operator*(const CSCMatrix<T>& L, const Matrix<T>& R)
+      throw(Exception)
+   {
+      if(L.cols() != R.rows())
+         GPSTK_THROW(Exception("Incompatible dimensions op*(CSCMatrix,Matrix)"));
+
+      const std::vector<unsigned int>& ptr(L.pointers()), ind(L.indexes());
+      const std::vector<T>& val(L.values());
+      Matrix<T> toRet(L.rows(),R.cols(),T(0));
+      for(unsigned int j=0; j<R.cols(); j++) {
+         for(unsigned int k=0; k<L.cols(); k++) {
+            const T rkj(R(k,j));
+            if(rkj == T(0)) continue;
+            for(unsigned int n=ptr[k]; n<ptr[k+1]; n++)
+               toRet(ind[n],j) += val[n] * rkj;
+         }
+      }
+      return toRet;
+   }
+
+   /// Matrix times compressed column matrix; each column of the result is a
+   /// combination of the columns of L, one per element of the sparse column.
+   template <class T> Matrix<T> operator*(const Matrix<T>& L, const CSCMatrix<T>& R)
+      throw(Exception)
+   {
+      if(L.cols() != R.rows())
+         GPSTK_THROW(Exception("Incompatible dimensions op*(Matrix,CSCMatrix)"));
+
+      const std::vector<unsigned int>& ptr(R.pointers()), ind(R.indexes());
+      const std::vector<T>& val(R.values());
+      Matrix<T> toRet(L.rows(),R.cols(),T(0));
+      for(unsigned int j=0; j<R.cols(); j++) {
+         for(unsigned int n=ptr[j]; n<ptr[j+1]; n++) {
+            const unsigned int k(ind[n]);
+            const T rkj(val[n]);
+            for(unsigned int i=0; i<L.rows(); i++)
+               toRet(i,j) += L(i,k) * rkj;
+         }
+      }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------------
+   /// Square root information measurement update, with the partials H in compressed
+   /// column form and the data in D; on output D holds the residuals of fit. This is
+   /// the same algorithm as SrifMU(Matrix&,Vector&,SparseMatrix&,const unsigned int)
+   /// (see its documentation, and that of SrifMU in SRI.hpp), with the same result,
+   /// but the columns of H||D are kept as sorted arrays of row indexes and values.
+   /// The Householder transformation for column j is applied to column k only where
+   /// either is non-zero, and column k grows only by the rows of column j; so with
+   /// the block structured partials of, for example, many-station double
+   /// differencing, most of the work of the dense update is skipped.
+   /// @param R a priori SRI matrix (upper triangular, dimension N); if R and Z are
+   ///          empty they are created with dimension H.cols()
+   /// @param Z a priori SRI data vector (length N)
+   /// @param H measurement partials, M by N, with unit (whitened) noise covariance
+   /// @param D data vector, of length M; on output the residuals of fit
+   /// @throw Exception if the dimensions are incompatible
+   template <class T>
+   void SrifMU(Matrix<T>& R, Vector<T>& Z, const CSCMatrix<T>& H, Vector<T>& D)
+      throw(Exception)
+   {
+      // if necessary, create R and Z
+      if(H.cols() > 0 && R.rows() == 0 && Z.size() == 0) {
+         R = Matrix<T>(H.cols(),H.cols(),T(0));
+         Z = Vector<T>(H.cols(),T(0));
+      }
+
+      if(H.cols() == 0 || H.cols() != R.cols() || Z.size() < R.rows()
+                       || D.size() != H.rows()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  R has dimension "
+            << R.rows() << "x" << R.cols() << ",\n  Z has length "
+            << Z.size() << ",\n  H has dimension "
+            << H.rows() << "x" << H.cols() << ",\n  and D has length "
+            << D.size();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const T EPS=T(1.e-20);
+      const unsigned int m(H.rows()), n(R.rows());
+      unsigned int i,j,k,p,q;
+      T dum, delta, beta, sum;
+
+      // working copy of the columns of A = H || D
+      std::vector< std::vector<unsigned int> > rowA(n+1);
+      std::vector< std::vector<T> > valA(n+1);
+      const std::vector<unsigned int>& ptr(H.pointers()), ind(H.indexes());
+      const std::vector<T>& val(H.values());
+      for(j=0; j<n; j++) {
+         rowA[j].assign(ind.begin()+ptr[j], ind.begin()+ptr[j+1]);
+         valA[j].assign(val.begin()+ptr[j], val.begin()+ptr[j+1]);
+      }
+      for(i=0; i<m; i++) {
+         if(D(i) == T(0)) continue;
+         rowA[n].push_back(i);
+         valA[n].push_back(D(i));
+      }
+
+      std::vector<unsigned int> rowNew;      // merge buffers
+      std::vector<T> valNew;
+
+      for(j=0; j<n; j++) {          // loop over columns
+         const std::vector<unsigned int>& rj(rowA[j]);
+         const std::vector<T>& vj(valA[j]);
+         if(rj.empty())             // A is already zero below the diagonal
+            continue;
+
+         // column j of A is entirely below the diagonal
+         sum = T(0);
+         for(p=0; p<vj.size(); p++)
+            sum += vj[p]*vj[p];
+         if(sum < EPS) continue;    // sum is positive
+
+         dum = R(j,j);
+         sum += dum * dum;          // add diagonal element
+         sum = (dum > T(0) ? -T(1) : T(1)) * SQRT(sum);
+         delta = dum - sum;
+         R(j,j) = sum;
+
+         beta = sum*delta;          // beta by construction must be negative
+         if(beta > -EPS) continue;
+         beta = T(1)/beta;
+
+         for(k=j+1; k<=n; k++) {    // columns to right of diagonal (j,j), and D
+            std::vector<unsigned int>& rk(rowA[k]);
+            std::vector<T>& vk(valA[k]);
+
+            // dot product of columns k and j
+            T dotkj(0);
+            for(p=0, q=0; p<rk.size() && q<rj.size(); ) {
+               if(rk[p] < rj[q]) p++;
+               else if(rj[q] < rk[p]) q++;
+               else { dotkj += vk[p] * vj[q]; p++; q++; }
+            }
+
+            sum = delta * (k==n ? Z(j) : R(j,k));
+            sum += dotkj;
+            if(sum == T(0)) continue;
+
+            sum *= beta;
+            if(k==n) Z(j) += sum*delta;
+            else   R(j,k) += sum*delta;
+
+            // A(i,k) += sum * A(i,j), merging the rows of column j into column k
+            rowNew.clear();
+            valNew.clear();
+            for(p=0, q=0; p<rk.size() || q<rj.size(); ) {
+               if(q == rj.size() || (p < rk.size() && rk[p] < rj[q])) {
+                  rowNew.push_back(rk[p]);
+                  valNew.push_back(vk[p]);
+                  p++;
+               }
+               else if(p == rk.size() || rj[q] < rk[p]) {
+                  rowNew.push_back(rj[q]);
+                  valNew.push_back(sum * vj[q]);
+                  q++;
+               }
+               else {
+                  rowNew.push_back(rk[p]);
+                  valNew.push_back(vk[p] + sum * vj[q]);
+                  p++; q++;
+               }
+            }
+            rk.swap(rowNew);
+            vk.swap(valNew);
+         }
+      }
+
+      // the last column of A holds the residuals
+      D = T(0);
+      for(p=0; p<rowA[n].size(); p++)
+         D(rowA[n][p]) = valA[n][p];
+
+   }  // end SrifMU
+
+}  // namespace
+
+#endif   // define COMPRESSED_SPARSE_MATRIX_INCLUDE
@@ -242,6 +242,10 @@ namespace gpstk {
    /// the SatPass flag.
    /// Glonass satellites require a frequency channel integer; the caller may pass
    /// this in, or let the GDC compute it from the data - if it fails it returns -6.
+   /// Each call is numbered in the output (see GDCreturn); by default the number is
+   /// a count of calls, but the caller may give it, e.g. the index of the pass.
+   /// Calls that do not share SatPass or GDCconfiguration objects may be made
+   /// concurrently, on several threads, as long as each numbers its calls.
    ///
    /// @param SP       SatPass object containing the input data.
    /// @param config   GDCconfiguration object.
@@ -249,6 +253,7 @@ namespace gpstk {
    /// @param retMsg   string summary of results: see 'GDC' in output, class GDCreturn
    ///      if retMsg is not empty on call, replace 'GDC' with retMsg.
    /// @param GLOn     GLONASS frequency channel (-7<=n<7), -99 means UNKNOWN
+   /// @param unique   number of this call in the output; 0 means use the count
    /// @return 0 for success, otherwise return an Error code;
    ///
    /// codes are defined as follows.
@@ -262,7 +267,8 @@ namespace gpstk {
                               GDCconfiguration& config,
                               std::vector<std::string>& EditCmds,
                               std::string& retMsg,
-                              int GLOn=-99)
+                              int GLOn=-99,
+                              int unique=0)
       throw(Exception);
 
    //@}
@@ -2012,7 +2012,8 @@ namespace gpstk
       throw(Exception)
    {
       try {
-         Matrix<double> NutPreBias = PreciseEarthRotation2010(CoordTransTime(t));
+         FixedMatrix<double,3,3> NutPreBias(
+                                 PreciseEarthRotation2010(CoordTransTime(t)));
 
          // extract X and Y coords of the CIP from the matrix
          // cf. sofa bpn2xy.c
@@ -2049,15 +2050,16 @@ namespace gpstk
    // see class EarthOrientation.
    // param xp, Earth wobble in arcseconds, as found in the IERS bulletin.
    // param yp, Earth wobble in arcseconds, as found in the IERS bulletin.
-   // return Matrix<double>(3,3) rotation matrix
-   Matrix<double> EarthOrientation::PolarMotionMatrix1996(double xp, double yp)
+   // return FixedMatrix<double,3,3> rotation matrix
+   FixedMatrix<double,3,3> EarthOrientation::PolarMotionMatrix1996(double xp,
+                                                                   double yp)
       throw()
    {
       xp *= ARCSEC_TO_RAD;
       yp *= ARCSEC_TO_RAD;
-      Matrix<double> R1,R2;
-      R1 = rotation(-yp,1);
-      R2 = rotation(-xp,2);
+      FixedMatrix<double,3,3> R1,R2;
+      R1 = fixedRotation(-yp,1);
+      R2 = fixedRotation(-xp,2);
       return (R2*R1);
    }
 
@@ -2069,9 +2071,9 @@ namespace gpstk
    // param t EphTime epoch of the rotation.
    // param xp, Earth wobble in arcseconds, as found in the IERS bulletin.
    // param yp, Earth wobble in arcseconds, as found in the IERS bulletin.
-   // return Matrix<double>(3,3) rotation matrix CIP -> TRS
-   Matrix<double> EarthOrientation::PolarMotionMatrix2003(EphTime t,
-                                                         double xp, double yp)
+   // return FixedMatrix<double,3,3> rotation matrix CIP -> TRS
+   FixedMatrix<double,3,3> EarthOrientation::PolarMotionMatrix2003(EphTime t,
+                                                   double xp, double yp)
       throw()
    {
       double sp(Sprime(t));      // parameter s' provides position of TEO on CIP
@@ -2079,10 +2081,10 @@ namespace gpstk
             << " with T = " << CoordTransTime(t);
       xp *= ARCSEC_TO_RAD;
       yp *= ARCSEC_TO_RAD;
-      Matrix<double> R1,R2,R3;
-      R3 = rotation(sp, 3);
-      R2 = rotation(-xp, 2);
-      R1 = rotation(-yp, 1);
+      FixedMatrix<double,3,3> R1,R2,R3;
+      R3 = fixedRotation(sp, 3);
+      R2 = fixedRotation(-xp, 2);
+      R1 = fixedRotation(-yp, 1);
       return (R1*R2*R3);
    }
 
@@ -2125,15 +2127,15 @@ namespace gpstk
    // param psib F-W angle
    // param epsa F-W angle, the obliquity
    // return 3x3 rotation matrix
-   Matrix<double> EarthOrientation::FukushimaWilliams(double gamb, double phib,
-                                                       double psib, double epsa)
+   FixedMatrix<double,3,3> EarthOrientation::FukushimaWilliams(double gamb,
+                                    double phib, double psib, double epsa)
       throw()
    {
-      Matrix<double> R;
-      R = rotation(-epsa,1) *
-          rotation(-psib,3) *
-          rotation(phib,1) *
-          rotation(gamb,3);
+      FixedMatrix<double,3,3> R;
+      R = fixedRotation(-epsa,1) *
+          fixedRotation(-psib,3) *
+          fixedRotation(phib,1) *
+          fixedRotation(gamb,3);
       return R;
    }
 
@@ -2342,21 +2344,21 @@ namespace gpstk
    // eps,  the obliquity of the ecliptic, in radians,
    // dpsi, the nutation in longitude (counted in the ecliptic), in radians
    // deps, the nutation in obliquity, in radians.
-   Matrix<double> EarthOrientation::NutationMatrix(double eps,
-                                                   double dpsi, double deps)
+   FixedMatrix<double,3,3> EarthOrientation::NutationMatrix(double eps,
+                                                double dpsi, double deps)
       throw()
    {
-      Matrix<double> R1 = rotation(eps, 1);
-      Matrix<double> R2 = rotation(-dpsi, 3);
-      Matrix<double> R3 = rotation(-(eps+deps), 1);
+      FixedMatrix<double,3,3> R1 = fixedRotation(eps, 1);
+      FixedMatrix<double,3,3> R2 = fixedRotation(-dpsi, 3);
+      FixedMatrix<double,3,3> R3 = fixedRotation(-(eps+deps), 1);
       return (R3*R2*R1);
    }
 
    //------------------------------------------------------------------------------
    // IERS1996 nutation matrix, a 3x3 rotation matrix, given
    // param T, the coordinate transformation time at the time of interest
-   // return nutation matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::NutationMatrix1996(double T)
+   // return nutation matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::NutationMatrix1996(double T)
       throw()
    {
       double eps(Obliquity1996(T)), deps, dpsi, om;
@@ -2369,12 +2371,23 @@ namespace gpstk
    // IERS2003 nutation matrix, a 3x3 rotation matrix
    // (including the frame bias matrix), given
    // param T, the coordinate transformation time at the time of interest
-   // return nutation matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::NutationMatrix2003(double T)
+   // return nutation matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::NutationMatrix2003(double T)
       throw()
    {
-      double eps(Obliquity1996(T)), deps, dpsi;    // same as Obliquity2003
+      double deps, dpsi;
       NutationAngles2003(T,deps,dpsi);
+      return NutationMatrix2003(T,deps,dpsi);
+   }
+
+   //------------------------------------------------------------------------------
+   // IERS2003 nutation matrix given T and the nutation angles from
+   // NutationAngles2003(T)
+   FixedMatrix<double,3,3> EarthOrientation::NutationMatrix2003(double T,
+                                                   double deps, double dpsi)
+      throw()
+   {
+      double eps(Obliquity1996(T));                // same as Obliquity2003
 
       // Precession rate contributions with respect to IAU 2000
       // Precession and obliquity corrections (radians)
@@ -2388,8 +2401,8 @@ namespace gpstk
    // IERS2010 nutation matrix, a 3x3 rotation matrix, given
    // param T, the coordinate transformation time at the time of interest;
    // cf. FukushimaWilliams().
-   // return nutation matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::NutationMatrix2010(double T)
+   // return nutation matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::NutationMatrix2010(double T)
       throw()
    {
       double deps,dpsi,eps;
@@ -2418,8 +2431,8 @@ namespace gpstk
    //------------------------------------------------------------------------------
    // Compute the IERS1996 precession matrix, a 3x3 rotation matrix, given
    // param T, the coordinate transformation time at the time of interest
-   // return precession matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::PrecessionMatrix1996(double T)
+   // return precession matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::PrecessionMatrix1996(double T)
       throw()
    {
          // IAU76 - ref McCarthy - seconds of arc
@@ -2429,10 +2442,10 @@ namespace gpstk
       double theta = TAR*(2004.3109 - T*(0.42665 + T*0.041833));
       double z     = TAR*(2306.2181 + T*(1.09468 + T*0.018203));
 
-      Matrix<double> R1 = rotation(-zeta, 3);
-      Matrix<double> R2 = rotation(theta, 2);
-      Matrix<double> R3 = rotation(-z, 3);
-      Matrix<double> P = R3*R2*R1;
+      FixedMatrix<double,3,3> R1 = fixedRotation(-zeta, 3);
+      FixedMatrix<double,3,3> R2 = fixedRotation(theta, 2);
+      FixedMatrix<double,3,3> R3 = fixedRotation(-z, 3);
+      FixedMatrix<double,3,3> P = R3*R2*R1;
 
       return P;
    }
@@ -2441,8 +2454,8 @@ namespace gpstk
    // Compute the IERS2003 precession matrix, a 3x3 rotation matrix, given
    // param T, the coordinate transformation time at the time of interest
    // Includes the frame bias matrix. cf sofa bp00.c
-   // return precession matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::PrecessionMatrix2003(double T)
+   // return precession matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::PrecessionMatrix2003(double T)
       throw()
    {
       // obliquity at the J2000.0 epoch
@@ -2485,19 +2498,19 @@ namespace gpstk
       epsa += depspr;
 
       // Frame bias matrix
-      Matrix<double> R1 = rotation(raeps0, 3);
-      Matrix<double> R2 = rotation(psibias * ::sin(eps0), 2);
-      Matrix<double> R3 = rotation(-epsbias, 1);
-      Matrix<double> FrameBias(R3*R2*R1);
+      FixedMatrix<double,3,3> R1 = fixedRotation(raeps0, 3);
+      FixedMatrix<double,3,3> R2 = fixedRotation(psibias * ::sin(eps0), 2);
+      FixedMatrix<double,3,3> R3 = fixedRotation(-epsbias, 1);
+      FixedMatrix<double,3,3> FrameBias(R3*R2*R1);
       LOG(DEBUG7) << "\nframe bias matrix:\n" << fixed << setprecision(15) << showpos
          << FrameBias;
 
       // Precession matrix
-      R1 = rotation(eps0, 1);
-      R2 = rotation(-psia, 3);
-      R3 = rotation(-epsa, 1);
-      Matrix<double> R4 = rotation(chia, 3);
-      Matrix<double> Precess(R4*R3*R2*R1);
+      R1 = fixedRotation(eps0, 1);
+      R2 = fixedRotation(-psia, 3);
+      R3 = fixedRotation(-epsa, 1);
+      FixedMatrix<double,3,3> R4 = fixedRotation(chia, 3);
+      FixedMatrix<double,3,3> Precess(R4*R3*R2*R1);
       LOG(DEBUG7) << "\nprecession matrix:\n" << fixed << setprecision(15) << showpos
          << Precess;
 
@@ -2523,8 +2536,8 @@ namespace gpstk
 
    //------------------------------------------------------------------------------
    // IERS2010 frame bias matrix, a 3x3 rotation matrix; cf. FukushimaWilliams().
-   // return frame bias matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::BiasMatrix2010(void)
+   // return frame bias matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::BiasMatrix2010(void)
       throw()
    {
       // get F-W angles at J2000
@@ -2539,21 +2552,21 @@ namespace gpstk
    // Compute the IERS2010 precession matrix, a 3x3 rotation matrix, given
    // param T, the coordinate transformation time at the time of interest
    // Does not include the frame bias matrix. Cf. FukushimaWilliams().
-   // return precession matrix Matrix<double>(3,3)
-   Matrix<double> EarthOrientation::PrecessionMatrix2010(double T)
+   // return precession matrix FixedMatrix<double,3,3>
+   FixedMatrix<double,3,3> EarthOrientation::PrecessionMatrix2010(double T)
       throw()
    {
       // the F-W angles
       double gamb,phib,psib,epsa;
 
       // get frame bias matrix
-      Matrix<double> B = BiasMatrix2010();
+      FixedMatrix<double,3,3> B = BiasMatrix2010();
 
       // get F-W angles at epoch
       FukushimaWilliams(T, gamb, phib, psib, epsa);
 
       // precession x frame bias matrix
-      Matrix<double> PB = FukushimaWilliams(gamb, phib, psib, epsa);
+      FixedMatrix<double,3,3> PB = FukushimaWilliams(gamb, phib, psib, epsa);
 
       return (PB * transpose(B));
    }
@@ -2564,12 +2577,12 @@ namespace gpstk
    // for IERS 2003.
    // param T CoordTransTime of interest
    // return 3x3 rotation matrix
-   Matrix<double> EarthOrientation::PreciseEarthRotation2003(double T)
+   FixedMatrix<double,3,3> EarthOrientation::PreciseEarthRotation2003(double T)
       throw(Exception)
    {
       try {
-         Matrix<double> N = NutationMatrix2003(T);
-         Matrix<double> P = PrecessionMatrix2003(T);     // includes bias
+         FixedMatrix<double,3,3> N = NutationMatrix2003(T);
+         FixedMatrix<double,3,3> P = PrecessionMatrix2003(T);     // includes bias
 
          //Matrix<double> NPB(N*P);
          //LOG(DEBUG7) << "\nNPB matrix:\n" << fixed << setprecision(15) << setw(18)
@@ -2586,7 +2599,7 @@ namespace gpstk
    // for IERS 2010.
    // param T CoordTransTime of interest
    // return 3x3 rotation matrix
-   Matrix<double> EarthOrientation::PreciseEarthRotation2010(double T)
+   FixedMatrix<double,3,3> EarthOrientation::PreciseEarthRotation2010(double T)
       throw(Exception)
    {
       try {
@@ -2611,12 +2624,12 @@ namespace gpstk
    // Input is the time of interest, the polar motion angles xp and yp (arcsecs),
    // and UT1-UTC (sec) (xp,yp and UT1-UTC are just as found in the IERS bulletin;
    // see class EarthOrientation).
-   Matrix<double> EarthOrientation::ECEFtoInertial1996(EphTime t,
+   FixedMatrix<double,3,3> EarthOrientation::ECEFtoInertial1996(EphTime t,
                        double xp, double yp, double UT1mUTC, bool reduced)
       throw(Exception)
    {
       try {
-         Matrix<double> P,N,W,S;
+         FixedMatrix<double,3,3> P,N,W,S;
 
          double T=CoordTransTime(t);
 
@@ -2654,7 +2667,7 @@ namespace gpstk
          LOG(DEBUG7) << "\nGAST = " << fixed << setprecision(15)
                << showpos << g*RAD_TO_DEG;
 
-         S = rotation(g,3);
+         S = fixedRotation(g,3);
          LOG(DEBUG7) << "\ncelestial-to-terrestrial matrix (no polar motion):\n"
                << fixed << setprecision(15) << setw(18) << showpos << S*N*P;
 
@@ -2674,13 +2687,11 @@ namespace gpstk
    // Input is the time of interest, the polar motion angles xp and yp (arcsecs),
    // and UT1-UTC (sec) (xp,yp and UT1-UTC are just as found in the IERS bulletin;
    // see class EarthOrientation).
-   Matrix<double> EarthOrientation::ECEFtoInertial2003(EphTime t,
-                                                double xp, double yp, double UT1mUTC)
+   FixedMatrix<double,3,3> EarthOrientation::ECEFtoInertial2003(EphTime t,
+                                       double xp, double yp, double UT1mUTC)
       throw(Exception)
    {
       try {
-         Matrix<double> P,N,R,W;
-
          double T(CoordTransTime(t));
 
          if(LOGlevel >= DEBUG7) {
@@ -2694,11 +2705,29 @@ namespace gpstk
          }
 
          // nutation
-         double deps, dpsi, dpsipr, depspr;
+         double deps, dpsi;
          NutationAngles2003(T,deps,dpsi);
+
+         return ECEFtoInertialNutation2003(t, T, deps, dpsi, xp, yp, UT1mUTC);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Build the IERS 2003 transformation ECEF-to-inertial given the nutation angles
+   FixedMatrix<double,3,3> EarthOrientation::ECEFtoInertialNutation2003(EphTime t,
+                 double T, double deps, double dpsi,
+                 double xp, double yp, double UT1mUTC)
+      throw(Exception)
+   {
+      try {
+         FixedMatrix<double,3,3> P,N,R,W;
+
          LOG(DEBUG7) << "\nnutation angles psi eps " << fixed << setprecision(15)
             << showpos << dpsi << " " << deps;
 
+         double dpsipr, depspr;
+
          // Precession rate contributions with respect to IAU 2000
          // Precession and obliquity corrections (radians)
          PrecessionRateCorrections2003(T, dpsipr, depspr);
@@ -2717,7 +2746,7 @@ namespace gpstk
          // precession
          P = PrecessionMatrix2003(T);
 
-         Matrix<double> NPB(N*P);
+         FixedMatrix<double,3,3> NPB(N*P);
          LOG(DEBUG7) << "\nNPB matrix:\n" << fixed << setprecision(15) << setw(18)
                << showpos << NPB;
 
@@ -2725,7 +2754,7 @@ namespace gpstk
          double era(EarthRotationAngle(t,UT1mUTC));
          LOG(DEBUG7) << "\nERA = " << fixed << setprecision(15) << showpos
                         << era*RAD_TO_DEG;
-         R = rotation(era,3);
+         R = fixedRotation(era,3);
 
          //double gast = GAST2003(t, UT1mUTC);
          //R = rotation(gast,3);
@@ -2746,7 +2775,7 @@ namespace gpstk
    // Input is the time of interest, the polar motion angles xp and yp (arcsecs),
    // and UT1-UTC (sec) (xp,yp and UT1-UTC are just as found in the IERS bulletin;
    // see class EarthOrientation).
-   Matrix<double> EarthOrientation::ECEFtoInertial2010(EphTime t,
+   FixedMatrix<double,3,3> EarthOrientation::ECEFtoInertial2010(EphTime t,
                        double xp, double yp, double UT1mUTC)
       throw(Exception)
    {
@@ -2759,6 +2788,20 @@ namespace gpstk
          double X,Y,s;
          XYCIO(T, X, Y);
          s = S(T,X,Y,IERSConvention::IERS2010);
+
+         return ECEFtoInertialCIO2010(t, X, Y, s, xp, yp, UT1mUTC);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Build the IERS 2010 transformation ECEF-to-inertial given the CIO X, Y and s
+   FixedMatrix<double,3,3> EarthOrientation::ECEFtoInertialCIO2010(EphTime t,
+                 double X, double Y, double s,
+                 double xp, double yp, double UT1mUTC)
+      throw(Exception)
+   {
+      try {
          LOG(DEBUG7) << "X = " << fixed << setprecision(15) << showpos << X;
          LOG(DEBUG7) << "Y = " << fixed << setprecision(15) << showpos << Y;
          LOG(DEBUG7) << "s\" = " << fixed << setprecision(15) << s/ARCSEC_TO_RAD;
@@ -2768,8 +2811,9 @@ namespace gpstk
          double r2(X*X+Y*Y);                          // squared radius
          double e(r2 != 0.0 ? ::atan2(Y, X) : 0.0);   // spherical angles
          double d(::atan(::sqrt(r2/(1.0-r2))));       //
-         Matrix<double> GCRStoCIRS;
-         GCRStoCIRS = rotation(-(e+s),3) * rotation(d, 2) * rotation(e, 3);
+         FixedMatrix<double,3,3> GCRStoCIRS;
+         GCRStoCIRS = fixedRotation(-(e+s),3) * fixedRotation(d, 2)
+                    * fixedRotation(e, 3);
          LOG(DEBUG7) << "\nNPB matrix:\n" << fixed << setprecision(15) << setw(18)
                << showpos << GCRStoCIRS;
 
@@ -2781,20 +2825,21 @@ namespace gpstk
                      << showpos << era*RAD_TO_DEG;
 
          // compute transf. CIRS-to-TIRS or intermediate-celestial-to-terrestrial
-         Matrix<double> CIRStoTIRS;
-         CIRStoTIRS = rotation(era, 3);
+         FixedMatrix<double,3,3> CIRStoTIRS;
+         CIRStoTIRS = fixedRotation(era, 3);
          LOG(DEBUG7) << "\ncelestial-to-terrestrial matrix (no polar motion):\n"
                << fixed << setprecision(15) << setw(18) << showpos
                << CIRStoTIRS * GCRStoCIRS;
 
          // compute the polar motion matrix, TIRS-to-ITRS
          //double sprime(Sprime(T));
-         Matrix<double> PolarMotion(PolarMotionMatrix2003(t, xp, yp)); // 2010 == 2003
+         // 2010 == 2003
+         FixedMatrix<double,3,3> PolarMotion(PolarMotionMatrix2003(t, xp, yp));
          LOG(DEBUG7) << "\npolar motion matrix:\n" << fixed << setprecision(15)
                << setw(18) << showpos << PolarMotion;
 
          // combine to get GCRS-to-ITRS
-         Matrix<double> GCRStoITRS;
+         FixedMatrix<double,3,3> GCRStoITRS;
          GCRStoITRS = PolarMotion * CIRStoTIRS * GCRStoCIRS;
 
          // invert to get ITRS-to-GCRS or ECEFtoInertial
@@ -54,6 +54,7 @@
 #include "Triple.hpp"
 #include "Position.hpp"
 #include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 // geomatics
 #include "EphTime.hpp"
 #include "IERSConvention.hpp"
@@ -384,6 +385,10 @@ namespace gpstk {
       Matrix<double> ECEFtoJ2000(const EphTime& t, bool reduced=false)
          throw(Exception);
 
+      /// EarthOrientationCache tabulates the series evaluated by the private
+      /// functions below, and assembles the matrices from interpolated values.
+      friend class EarthOrientationCache;
+
    private:
       //------------------------------------------------------------------------------
       /// locator s which gives the position of the CIO on the equator of
@@ -584,8 +589,8 @@ namespace gpstk {
       /// angles xp and yp (arcseconds), as found in the IERS bulletin;
       /// @param xp, Earth wobble in arcseconds, as found in the IERS bulletin.
       /// @param yp, Earth wobble in arcseconds, as found in the IERS bulletin.
-      /// @return Matrix<double>(3,3) rotation matrix
-      static Matrix<double> PolarMotionMatrix1996(double xp, double yp)
+      /// @return FixedMatrix<double,3,3> rotation matrix
+      static FixedMatrix<double,3,3> PolarMotionMatrix1996(double xp, double yp)
          throw();
 
       //------------------------------------------------------------------------------
@@ -596,8 +601,9 @@ namespace gpstk {
       /// @param t EphTime epoch of the rotation.
       /// @param xp, Earth wobble in arcseconds, as found in the IERS bulletin.
       /// @param yp, Earth wobble in arcseconds, as found in the IERS bulletin.
-      /// @return Matrix<double>(3,3) rotation matrix CIP -> TRS
-      static Matrix<double> PolarMotionMatrix2003(EphTime t, double xp, double yp)
+      /// @return FixedMatrix<double,3,3> rotation matrix CIP -> TRS
+      static FixedMatrix<double,3,3> PolarMotionMatrix2003(EphTime t,
+                                                         double xp, double yp)
          throw();
 
       //------------------------------------------------------------------------------
@@ -627,8 +633,8 @@ namespace gpstk {
       /// @param psib F-W angle
       /// @param epsa F-W angle, the obliquity
       /// @return 3x3 rotation matrix B, PB or NPB
-      static Matrix<double> FukushimaWilliams(double gamb, double phib,
-                                              double psib, double epsa)
+      static FixedMatrix<double,3,3> FukushimaWilliams(double gamb, double phib,
+                                                       double psib, double epsa)
          throw();
 
       //------------------------------------------------------------------------------
@@ -662,46 +668,53 @@ namespace gpstk {
       /// @param eps, Obliquity(T), the obliquity of the ecliptic, in radians,
       /// @param dpsi, the nutation in longitude (counted in the ecliptic) in radians.
       /// @param deps, the nutation in obliquity, in radians.
-      /// @return nutation matrix Matrix<double>(3,3)
-      static Matrix<double> NutationMatrix(double eps, double dpsi, double deps)
+      /// @return nutation matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> NutationMatrix(double eps,
+                                                    double dpsi, double deps)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS1996 nutation matrix, a 3x3 rotation matrix, given
       /// @param T, the coordinate transformation time at the time of interest
-      /// @return nutation matrix Matrix<double>(3,3)
-      static Matrix<double> NutationMatrix1996(double T)
+      /// @return nutation matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> NutationMatrix1996(double T)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS2003 nutation matrix, a 3x3 rotation matrix
       /// (including the frame bias matrix), given
       /// @param T, the coordinate transformation time at the time of interest
-      /// @return nutation matrix Matrix<double>(3,3)
-      static Matrix<double> NutationMatrix2003(double T)
+      /// @return nutation matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> NutationMatrix2003(double T)
+         throw();
+
+      /// IERS2003 nutation matrix given T and the nutation angles deps and dpsi
+      /// (radians) from NutationAngles2003(T); cf. NutationMatrix2003(T).
+      static FixedMatrix<double,3,3> NutationMatrix2003(double T,
+                                                        double deps, double dpsi)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS2010 nutation matrix, a 3x3 rotation matrix, given
       /// @param T, the coordinate transformation time at the time of interest;
       /// cf. FukushimaWilliams().
-      /// @return nutation matrix Matrix<double>(3,3)
-      static Matrix<double> NutationMatrix2010(double T)
+      /// @return nutation matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> NutationMatrix2010(double T)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS1996 precession matrix, a 3x3 rotation matrix, given
       /// @param T, the coordinate transformation time at the time of interest
-      /// @return precession matrix Matrix<double>(3,3)
-      static Matrix<double> PrecessionMatrix1996(double T)
+      /// @return precession matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> PrecessionMatrix1996(double T)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS2003 precession matrix, a 3x3 rotation matrix
       /// (including the frame bias matrix), given
       /// @param T, the coordinate transformation time at the time of interest
-      /// @return precession matrix Matrix<double>(3,3)
-      static Matrix<double> PrecessionMatrix2003(double T)
+      /// @return precession matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> PrecessionMatrix2003(double T)
          throw();
 
       //------------------------------------------------------------------------------
@@ -713,16 +726,16 @@ namespace gpstk {
 
       //------------------------------------------------------------------------------
       /// IERS2010 frame bias matrix, a 3x3 rotation matrix; cf. FukushimaWilliams().
-      /// @return frame bias matrix Matrix<double>(3,3)
-      static Matrix<double> BiasMatrix2010(void)
+      /// @return frame bias matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> BiasMatrix2010(void)
          throw();
 
       //------------------------------------------------------------------------------
       /// IERS2010 precession matrix, a 3x3 rotation matrix, given
       /// @param T, the coordinate transformation time at the time of interest
       /// Does not include the frame bias matrix; cf. FukushimaWilliams().
-      /// @return precession matrix Matrix<double>(3,3)
-      static Matrix<double> PrecessionMatrix2010(double T)
+      /// @return precession matrix FixedMatrix<double,3,3>
+      static FixedMatrix<double,3,3> PrecessionMatrix2010(double T)
          throw();
 
       //------------------------------------------------------------------------------
@@ -732,7 +745,7 @@ namespace gpstk {
       /// @param T CoordTransTime(EphTime t) for time of interest
       /// @return 3x3 rotation matrix
       /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
-      static Matrix<double> PreciseEarthRotation2003(double T)
+      static FixedMatrix<double,3,3> PreciseEarthRotation2003(double T)
          throw(Exception);
 
       //------------------------------------------------------------------------------
@@ -742,7 +755,7 @@ namespace gpstk {
       /// @param T CoordTransTime(EphTime t) for time of interest
       /// @return 3x3 rotation matrix
       /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
-      static Matrix<double> PreciseEarthRotation2010(double T)
+      static FixedMatrix<double,3,3> PreciseEarthRotation2010(double T)
          throw(Exception);
 
       //------------------------------------------------------------------------------
@@ -758,8 +771,8 @@ namespace gpstk {
       ///                 'no tides', as is the case with the NGA EOPs (default=F).
       /// @return 3x3 rotation matrix
       /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
-      Matrix<double> ECEFtoInertial1996(EphTime t, double xp, double yp,
-                           double UT1mUTC, bool reduced=false)
+      FixedMatrix<double,3,3> ECEFtoInertial1996(EphTime t, double xp, double yp,
+                                    double UT1mUTC, bool reduced=false)
          throw(Exception);
 
       //------------------------------------------------------------------------------
@@ -773,7 +786,22 @@ namespace gpstk {
       /// @param UT1mUTC, UT1-UTC in seconds, as found in the IERS bulletin.
       /// @return 3x3 rotation matrix
       /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
-      Matrix<double> ECEFtoInertial2003(EphTime t,double xp,double yp,double UT1mUTC)
+      FixedMatrix<double,3,3> ECEFtoInertial2003(EphTime t, double xp, double yp,
+                                                 double UT1mUTC)
+         throw(Exception);
+
+      //------------------------------------------------------------------------------
+      /// The part of ECEFtoInertial2003() that follows the evaluation of the
+      /// nutation series: build the transformation given the nutation angles.
+      /// @param t EphTime epoch of the rotation.
+      /// @param T CoordTransTime(t)
+      /// @param deps, dpsi nutation angles in radians, from NutationAngles2003(T)
+      /// @param xp, yp, UT1mUTC EOPs as in ECEFtoInertial2003().
+      /// @return 3x3 rotation matrix
+      /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
+      static FixedMatrix<double,3,3> ECEFtoInertialNutation2003(EphTime t,
+                                       double T, double deps, double dpsi,
+                                       double xp, double yp, double UT1mUTC)
          throw(Exception);
 
       //------------------------------------------------------------------------------
@@ -789,7 +817,22 @@ namespace gpstk {
       ///                 'no tides', as is the case with the NGA EOPs (default=F).
       /// @return 3x3 rotation matrix
       /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
-      Matrix<double> ECEFtoInertial2010(EphTime t,double xp,double yp,double UT1mUTC)
+      FixedMatrix<double,3,3> ECEFtoInertial2010(EphTime t, double xp, double yp,
+                                                 double UT1mUTC)
+         throw(Exception);
+
+      //------------------------------------------------------------------------------
+      /// The part of ECEFtoInertial2010() that follows the evaluation of the
+      /// CIO series: build the transformation given the CIO coordinates and s.
+      /// @param t EphTime epoch of the rotation.
+      /// @param X, Y coordinates of the CIO, from XYCIO()
+      /// @param s locator of the CIO, from S()
+      /// @param xp, yp, UT1mUTC EOPs as in ECEFtoInertial2010().
+      /// @return 3x3 rotation matrix
+      /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
+      static FixedMatrix<double,3,3> ECEFtoInertialCIO2010(EphTime t,
+                                       double X, double Y, double s,
+                                       double xp, double yp, double UT1mUTC)
          throw(Exception);
 
    }; // end class EarthOrientation
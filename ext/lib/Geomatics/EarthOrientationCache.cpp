@@ -0,0 +1,317 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file EarthOrientationCache.cpp
+/// class EarthOrientationCache interpolates tabulated values of the nutation and
+/// CIO series of class EarthOrientation.
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+// GPSTk
+#include "StringUtils.hpp"
+#include "FixedMatrix.hpp"
+
+#include "EarthOrientationCache.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gpstk
+{
+   //---------------------------------------------------------------------------------
+   EarthOrientationCache::EarthOrientationCache(const IERSConvention& conv,
+                                                double tol)
+      throw(Exception)
+      : convention(conv), tolerance(tol), stepDays(1.0), step(1.0/36525.0),
+        firstNode(0)
+   {
+      if(convention != IERSConvention::IERS2003 &&
+         convention != IERSConvention::IERS2010)
+      {
+         Exception e("EarthOrientationCache is implemented only for IERS2003"
+                     " and IERS2010, not " + convention.asString());
+         GPSTK_THROW(e);
+      }
+
+      try { setAccuracy(tol); }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Choose the largest step, from 4 days down to 1/64 day, for which the
+   // interpolation error at test times over two weeks near J2000 is within tol.
+   void EarthOrientationCache::setAccuracy(double tol) throw(Exception)
+   {
+      if(tol <= 0.0) {
+         Exception e("Invalid accuracy bound " + StringUtils::asString(tol));
+         GPSTK_THROW(e);
+      }
+      tolerance = tol;
+
+      int i,m;
+      double vi[NVALUES], vf[NVALUES];
+      for(stepDays = 4.0; stepDays >= 1.0/64.0; stepDays /= 2.0) {
+         step = stepDays/36525.0;
+         table.clear();
+
+         double maxerr(0.0);
+         for(m=0; m<16; m++) {
+            double T((0.31 + 0.9*m)/36525.0);
+            interpolate(T, vi);
+            evaluateSeries(T, vf);
+            for(i=0; i<NVALUES; i++)
+               if(::fabs(vi[i]-vf[i]) > maxerr) maxerr = ::fabs(vi[i]-vf[i]);
+         }
+
+         if(maxerr <= tolerance) {
+            table.clear();
+            return;
+         }
+      }
+
+      table.clear();
+      Exception e("Accuracy bound " + StringUtils::asString(tol)
+                  + " cannot be met by EarthOrientationCache");
+      GPSTK_THROW(e);
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthOrientationCache::NutationAngles(const EphTime& t,
+                                              double& deps, double& dpsi)
+      throw(Exception)
+   {
+      try {
+         double v[NVALUES];
+         interpolate(EarthOrientation::CoordTransTime(t), v);
+         deps = v[0];
+         dpsi = v[1];
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthOrientationCache::CIO(const EphTime& t,
+                                   double& X, double& Y, double& s)
+      throw(Exception)
+   {
+      try {
+         double v[NVALUES];
+         interpolate(EarthOrientation::CoordTransTime(t), v);
+         X = v[2];
+         Y = v[3];
+         s = v[4];
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   Matrix<double> EarthOrientationCache::NutationMatrix(const EphTime& t)
+      throw(Exception)
+   {
+      try {
+         double v[NVALUES], T(EarthOrientation::CoordTransTime(t));
+         interpolate(T, v);
+         if(convention == IERSConvention::IERS2003)
+            return EarthOrientation::NutationMatrix2003(T, v[0], v[1]);
+         return EarthOrientation::NutationMatrix(EarthOrientation::Obliquity2010(T),
+                                                 v[1], v[0]);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   Matrix<double> EarthOrientationCache::PreciseEarthRotation(const EphTime& t)
+      throw(Exception)
+   {
+      try {
+         double v[NVALUES], T(EarthOrientation::CoordTransTime(t));
+         interpolate(T, v);
+         if(convention == IERSConvention::IERS2003)
+            return (EarthOrientation::NutationMatrix2003(T, v[0], v[1])
+                  * EarthOrientation::PrecessionMatrix2003(T));
+
+         // cf. EarthOrientation::PreciseEarthRotation2010()
+         double gamb,phib,psib,epsa;
+         EarthOrientation::FukushimaWilliams(T, gamb, phib, psib, epsa);
+         return EarthOrientation::FukushimaWilliams(gamb,phib,psib+v[1],epsa+v[0]);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   Matrix<double> EarthOrientationCache::ECEFtoInertial(const EarthOrientation& eo,
+                                                        const EphTime& t)
+      throw(Exception)
+   {
+      if(eo.convention != convention) {
+         Exception e("IERS convention of the EOPs (" + eo.convention.asString()
+                     + ") differs from that of the cache ("
+                     + convention.asString() + ")");
+         GPSTK_THROW(e);
+      }
+
+      try {
+         double v[NVALUES], T(EarthOrientation::CoordTransTime(t));
+         interpolate(T, v);
+         if(convention == IERSConvention::IERS2003)
+            return EarthOrientation::ECEFtoInertialNutation2003(t, T, v[0], v[1],
+                                                 eo.xp, eo.yp, eo.UT1mUTC);
+         return EarthOrientation::ECEFtoInertialCIO2010(t, v[2], v[3], v[4],
+                                                 eo.xp, eo.yp, eo.UT1mUTC);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthOrientationCache::CIO(const vector<EphTime>& times, vector<double>& X,
+                                   vector<double>& Y, vector<double>& s)
+      throw(Exception)
+   {
+      try {
+         X.resize(times.size());
+         Y.resize(times.size());
+         s.resize(times.size());
+         for(size_t i=0; i<times.size(); i++)
+            CIO(times[i], X[i], Y[i], s[i]);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthOrientationCache::ECEFtoInertial(const vector<EarthOrientation>& eos,
+                                              const vector<EphTime>& times,
+                                              vector< Matrix<double> >& rots)
+      throw(Exception)
+   {
+      if(eos.size() != times.size()) {
+         Exception e("EOP and time arrays differ in length");
+         GPSTK_THROW(e);
+      }
+
+      try {
+         rots.resize(times.size());
+         for(size_t i=0; i<times.size(); i++)
+            rots[i] = ECEFtoInertial(eos[i], times[i]);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   // private functions
+   //---------------------------------------------------------------------------------
+   // Evaluate the full series at T: deps, dpsi, X, Y, s
+   void EarthOrientationCache::evaluateSeries(double T, double *v) const throw()
+   {
+      if(convention == IERSConvention::IERS2003) {
+         EarthOrientation::NutationAngles2003(T, v[0], v[1]);
+         FixedMatrix<double,3,3> NPB(EarthOrientation::NutationMatrix2003(T,v[0],v[1])
+                                   * EarthOrientation::PrecessionMatrix2003(T));
+         v[2] = NPB(2,0);
+         v[3] = NPB(2,1);
+         v[4] = EarthOrientation::S(T, v[2], v[3], IERSConvention::IERS2003);
+      }
+      else {
+         double TT(T);
+         EarthOrientation::NutationAngles2010(T, v[0], v[1]);
+         EarthOrientation::XYCIO(TT, v[2], v[3]);
+         v[4] = EarthOrientation::S(T, v[2], v[3], IERSConvention::IERS2010);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Extend the table to include nodes kmin through kmax, or start a new table if
+   // they are far from the current one.
+   void EarthOrientationCache::tabulate(long kmin, long kmax) throw()
+   {
+      long k, n(table.size()/NVALUES), klast(firstNode+n-1);
+
+      if(n == 0 || kmax < firstNode-MAXGAP || kmin > klast+MAXGAP) {
+         firstNode = kmin;
+         table.resize((kmax-kmin+1)*NVALUES);
+         for(k=kmin; k<=kmax; k++)
+            evaluateSeries(k*step, &table[(k-kmin)*NVALUES]);
+         return;
+      }
+
+      if(kmin < firstNode) {
+         vector<double> front((firstNode-kmin)*NVALUES);
+         for(k=kmin; k<firstNode; k++)
+            evaluateSeries(k*step, &front[(k-kmin)*NVALUES]);
+         table.insert(table.begin(), front.begin(), front.end());
+         firstNode = kmin;
+      }
+
+      if(kmax > klast) {
+         table.resize((kmax-firstNode+1)*NVALUES);
+         for(k=klast+1; k<=kmax; k++)
+            evaluateSeries(k*step, &table[(k-firstNode)*NVALUES]);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Lagrange interpolation in the table, using the NPOINTS nodes centered on the
+   // interval containing T.
+   void EarthOrientationCache::interpolate(double T, double *v) throw()
+   {
+      // prod(j-m), m=0..NPOINTS-1, m != j
+      static const double denom[NPOINTS] =
+                        { -5040.0, 720.0, -240.0, 144.0, -144.0, 240.0, -720.0, 5040.0 };
+
+      int i,j;
+      double x(T/step);
+      long k0(long(::floor(x)) - (NPOINTS/2-1));      // first node used
+      tabulate(k0, k0+NPOINTS-1);
+
+      // Lagrange coefficients at u, NPOINTS/2-1 <= u < NPOINTS/2
+      double u(x-k0), left[NPOINTS], coef[NPOINTS], right(1.0);
+      left[0] = 1.0;
+      for(j=1; j<NPOINTS; j++)
+         left[j] = left[j-1] * (u-(j-1));
+      for(j=NPOINTS-1; j>=0; j--) {
+         coef[j] = left[j]*right/denom[j];
+         right *= (u-j);
+      }
+
+      const double *node = &table[(k0-firstNode)*NVALUES];
+      for(i=0; i<NVALUES; i++) {
+         v[i] = 0.0;
+         for(j=0; j<NPOINTS; j++)
+            v[i] += coef[j] * node[j*NVALUES+i];
+      }
+   }
+
+}  // end namespace gpstk
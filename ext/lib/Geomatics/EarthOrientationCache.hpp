@@ -0,0 +1,200 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file EarthOrientationCache.hpp
+/// Include file defining the EarthOrientationCache class, which interpolates
+/// tabulated values of the nutation and CIO series of class EarthOrientation.
+
+#ifndef CLASS_EARTHORIENTCACHE_INCLUDE
+#define CLASS_EARTHORIENTCACHE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+// GPSTk
+#include "Exception.hpp"
+#include "Matrix.hpp"
+// geomatics
+#include "EphTime.hpp"
+#include "IERSConvention.hpp"
+#include "EarthOrientation.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gpstk {
+
+   /// class EarthOrientationCache serves the precession-nutation part of the
+   /// transformations of class EarthOrientation without evaluating the long
+   /// trigonometric series (IERS2003NutationData.hpp, IERS2010CIOSeriesData.hpp) at
+   /// every call. The nutation angles deps and dpsi, and the CIO coordinates X, Y
+   /// and locator s, are computed with the full series at the nodes of a regular
+   /// grid in time, as they are needed, and interpolated between the nodes with
+   /// 8-point Lagrange interpolation. The grid step is the largest that keeps the
+   /// interpolation error within the given accuracy bound (radians); it is chosen
+   /// by comparing interpolated and full values at test times over two weeks near
+   /// J2000. The default bound of 1.e-12 radians (0.2 microarcseconds, or 6 microns
+   /// at the surface of the Earth) is reached with a step of half a day.
+   ///
+   /// The cache is for IERS2003 and IERS2010 only; the IERS1996 series is short.
+   /// Polar motion and the Earth rotation angle, which depend on the EOPs, are
+   /// computed exactly as by EarthOrientation. The table grows to cover the times
+   /// requested, so computing for times in order, or for many satellites at nearly
+   /// the same time, is cheap; a time far from the table starts a new one.
+   /// An EarthOrientationCache is not safe for use by more than one thread at a
+   /// time, since every call may add to the table.
+   class EarthOrientationCache
+   {
+   public:
+      /// Constructor
+      /// @param conv IERS convention, IERS2003 or IERS2010
+      /// @param tol bound on the interpolation error, radians
+      /// @throw if the convention is not IERS2003 or IERS2010, or the bound cannot
+      ///        be met (cf. setAccuracy())
+      EarthOrientationCache(const IERSConvention& conv=IERSConvention::IERS2010,
+                            double tol=1.0e-12)
+         throw(Exception);
+
+      /// Set the bound on the interpolation error, choose the grid step and clear
+      /// the table.
+      /// @param tol bound on the interpolation error, radians
+      /// @throw if tol is not positive or cannot be met with a step of 1/64 day
+      void setAccuracy(double tol) throw(Exception);
+
+      /// @return the bound on the interpolation error, radians
+      double getAccuracy(void) const throw() { return tolerance; }
+
+      /// @return the grid step, days
+      double getStep(void) const throw() { return stepDays; }
+
+      /// @return the IERS convention of the cache
+      IERSConvention getConvention(void) const throw() { return convention; }
+
+      /// @return the number of nodes in the table
+      unsigned int size(void) const throw() { return table.size()/NVALUES; }
+
+      /// remove all nodes from the table
+      void clear(void) throw() { table.clear(); }
+
+      //------------------------------------------------------------------------------
+      /// Nutation of the obliquity (deps) and of the longitude (dpsi), radians,
+      /// as EarthOrientation computes them for the convention of the cache.
+      /// @param t EphTime time of interest
+      /// @param deps, nutation of the obliquity (output) in radians
+      /// @param dpsi, nutation of the longitude (output) in radians
+      /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
+      void NutationAngles(const EphTime& t, double& deps, double& dpsi)
+         throw(Exception);
+
+      /// Coordinates X,Y of the CIP and the locator s of the CIO, radians; for
+      /// IERS2003 X and Y are the bottom row of the NPB matrix.
+      /// @param t EphTime time of interest
+      /// @param X, Y coordinates of the CIP (output)
+      /// @param s locator of the CIO (output)
+      /// @throw if the TimeSystem conversion fails (if TimeSystem is Unknown)
+      void CIO(const EphTime& t, double& X, double& Y, double& s)
+         throw(Exception);
+
+      /// Same as EarthOrientation::NutationMatrix(t), using interpolated angles.
+      Matrix<double> NutationMatrix(const EphTime& t) throw(Exception);
+
+      /// Same as EarthOrientation::PreciseEarthRotation(t), using interpolated
+      /// angles.
+      Matrix<double> PreciseEarthRotation(const EphTime& t) throw(Exception);
+
+      /// Same as eo.ECEFtoInertial(t), using interpolated angles.
+      /// @param eo EOPs at time t, with the same IERS convention as the cache
+      /// @param t EphTime epoch of the rotation.
+      /// @return 3x3 rotation matrix
+      /// @throw if the conventions differ, or the TimeSystem conversion fails
+      Matrix<double> ECEFtoInertial(const EarthOrientation& eo, const EphTime& t)
+         throw(Exception);
+
+      //------------------------------------------------------------------------------
+      /// Compute CIO() at each of the given times.
+      /// @param times EphTimes of interest
+      /// @param X, Y, s output arrays of the same length as times
+      void CIO(const std::vector<EphTime>& times, std::vector<double>& X,
+               std::vector<double>& Y, std::vector<double>& s)
+         throw(Exception);
+
+      /// Compute ECEFtoInertial() at each of the given times.
+      /// @param eos EOPs at each time, the same length as times
+      /// @param times EphTimes of interest
+      /// @param rots output rotation matrices, one per time
+      void ECEFtoInertial(const std::vector<EarthOrientation>& eos,
+                          const std::vector<EphTime>& times,
+                          std::vector< Matrix<double> >& rots)
+         throw(Exception);
+
+   private:
+      /// number of values tabulated at each node: deps, dpsi, X, Y, s
+      static const int NVALUES = 5;
+
+      /// number of points used in the interpolation
+      static const int NPOINTS = 8;
+
+      /// the table does not extend over gaps larger than this many nodes
+      static const long MAXGAP = 1024;
+
+      /// evaluate the full series at CoordTransTime T into v[NVALUES]
+      void evaluateSeries(double T, double *v) const throw();
+
+      /// make sure the table holds nodes kmin through kmax
+      void tabulate(long kmin, long kmax) throw();
+
+      /// interpolate the table at CoordTransTime T into v[NVALUES]
+      void interpolate(double T, double *v) throw();
+
+      /// IERS convention
+      IERSConvention convention;
+
+      /// bound on the interpolation error, radians
+      double tolerance;
+
+      /// grid step in days, and in units of CoordTransTime (centuries)
+      double stepDays, step;
+
+      /// values at the nodes; node k (firstNode <= k) is at T = k*step, with
+      /// values table[(k-firstNode)*NVALUES + i], i=0..NVALUES-1
+      std::vector<double> table;
+
+      /// index of the first node in table
+      long firstNode;
+
+   }; // end class EarthOrientationCache
+
+}  // end namespace gpstk
+
+#endif // CLASS_EARTHORIENTCACHE_INCLUDE
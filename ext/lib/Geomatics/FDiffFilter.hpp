@@ -45,7 +45,9 @@
 /// There are several statistical filters implemented as classes. These classes are
 /// templates; the template parameter should be a float (probably double);
 /// it is used to construct gpstk::Stats<T>, gpstk::TwoSampleStats<T> and
-/// gpstk::SeqStats<T>, which are fundamental to these algorithms.
+/// gpstk::SeqStats<T>, which are fundamental to these algorithms. Statistics in
+/// sliding windows use gpstk::SlidingStats<T> and gpstk::SlidingTwoSampleStats<T>
+/// (SlidingStats.hpp), which are updated in O(1) per point without drift.
 ///    All the filters look for outliers and discontinuities (slips) in a timeseries.
 /// The first difference filter analyses the simple first difference of the data.
 /// The window filter uses a 2-pane sliding window centered on the data point in
@@ -86,6 +88,7 @@
 #define FDIFF_FILTER_INCLUDE
 
 #include "Stats.hpp"
+#include "SlidingStats.hpp"
 #include "StatsFilterHit.hpp"
 #include "RobustStats.hpp"
 #include "StringUtils.hpp"
@@ -257,10 +260,11 @@ template<class T> int FDiffFilter<T>::filter(const size_t i0, int dsize)
 
    // generate the analysis vector
    Avec.clear();
+   Avec.reserve(dsize);
 
    // compute stats on sigmas and data in a sliding window of width Nwind
-   gpstk::TwoSampleStats<T> fstats;       // stats on the first diffs in window
-   gpstk::TwoSampleStats<T> dstats;       // stats on the data in window
+   gpstk::SlidingTwoSampleStats<T> fstats;   // stats on the first diffs in window
+   gpstk::SlidingTwoSampleStats<T> dstats;   // stats on the data in window
    std::vector<T> slopes;                 // store slopes, for robust stats
 
    // loop over all data, computing first difference and stats in sliding window
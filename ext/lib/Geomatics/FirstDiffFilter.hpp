@@ -40,7 +40,9 @@
 /// are several statistical filters implemented as classes. These classes are
 /// templates; the template parameter should be a float (probably double);
 /// it is used to construct gpstk::Stats<T>, gpstk::TwoSampleStats<T> and
-/// gpstk::SeqStats<T>, which are fundamental to these algorithms.
+/// gpstk::SeqStats<T>, which are fundamental to these algorithms. Statistics in
+/// sliding windows use gpstk::SlidingStats<T> and gpstk::SlidingTwoSampleStats<T>
+/// (SlidingStats.hpp), which are updated in O(1) per point without drift.
 ///    All the filters look for outliers and discontinuities (slips) in a timeseries.
 /// The first difference filter analyses the simple first difference of the data.
 /// The window filter uses a 2-pane sliding window centered on the data point in
@@ -82,6 +84,7 @@
 
 #include <vector>
 #include "Stats.hpp"
+#include "SlidingStats.hpp"
 #include "RobustStats.hpp"
 //#include "StringUtils.hpp"       // TEMP
 //#include "logstream.hpp"         // TEMP
@@ -232,6 +235,7 @@ template<class T> int FirstDiffFilter<T>::filter(const size_t i0, int dsize)
    if(!noflags && flags.size()-i0 < dsize) return -3;
 
    analvec.clear();
+   analvec.reserve(dsize);
 
    // find the first good point, but don't necessarily increment
    i = i0; if(!noflags) while(i<ilimit && flags[i]) i++;
@@ -389,7 +393,7 @@ template<class T> int FirstDiffFilter<T>::analyze2(
    const unsigned int N(4);
    unsigned int i,j;
    std::ostringstream oss;
-   gpstk::Stats<double> pstats,fstats;       // TD? TwoSampleStats
+   gpstk::SlidingStats<double> pstats,fstats;       // TD? TwoSampleStats
 
    if(dump) oss << "FirstDiff analyze2" << std::fixed << std::setprecision(3)
          << " fdlimit=" << fdlimit << " siglim=" << siglim << " ratlim=" << ratlim
@@ -577,8 +581,13 @@ void FirstDiffFilter<T>::getStats(FilterHit<T>& fe)
    int j(-1);
    unsigned int i,k;
    fe.min = fe.max = fe.med = fe.mad = T(0);
-   for(i=0; i<analvec.size(); i++)
-      if(analvec[i].index == fe.index) { j=i; break; }
+   // analvec is in order of index - search it
+   i = 0; k = analvec.size();
+   while(i < k) {
+      unsigned int m((i+k)/2);
+      if(analvec[m].index < fe.index) i = m+1; else k = m;
+   }
+   if(i < analvec.size() && analvec[i].index == fe.index) j = i;
    if(j == -1) return;
    k = fe.index + fe.npts;                // last index in this seg is k-1
 
@@ -40,6 +40,11 @@
 //------------------------------------------------------------------------------------
 // system includes
 #include <iostream>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // GPSTk
 #include "Exception.hpp"
@@ -72,15 +77,16 @@ const double Rinex3ObsFileLoader::dttol(0.001);
 int Rinex3ObsFileLoader::loadFiles(string& errmsg, string& msg)
 {
 try {
-   int nint;
-   unsigned int i,j;
+   if(nthreads > 1 && filenames.size() > 1)
+      return loadFilesParallel(errmsg, msg);
+
+   unsigned int i;
    double dt;
-   string str;
    Rinex3ObsHeader roh;
    Rinex3ObsData rod, outrod;
-   vector<string>::const_iterator vit;
-   map< RinexSatID, vector<int> >::iterator soit;     // SatObsCountMap
    ostringstream oss, ossx;
+   bool stop(false);
+   unsigned int station(0);
 
    prevtime = CommonTime::BEGINNING_OF_TIME;
    prevtime.setTimeSystem(TimeSystem::Any);
@@ -119,48 +125,10 @@ try {
             strm >> roh;
 
             // update list of wanted obs types
-            map<string,vector<RinexObsID> >::const_iterator kt;
-            for(kt = roh.mapObsTypes.begin(); kt != roh.mapObsTypes.end(); kt++) {
-               for(i=0; i<kt->second.size(); i++) {
-                  // need 4-char string version of ObsID
-                  string sys = kt->first;                // system
-                  string rot = kt->second[i].asString(); // 3-char id
-                  string srot = sys + rot;               // 4-char id
-
-                  for(j=0; j<inputWantedObsTypes.size(); j++) {
-                     string wsrot(inputWantedObsTypes[j]);
-                     string wsys(wsrot.substr(0,1));
-                     string wrot(wsrot.substr(1,3));
-
-                     // if sys and rot match, and srot is not found, add it
-                     if(((wsys == "*" && RinexObsID(wrot) == RinexObsID(rot)) ||
-                         (wsys == sys && RinexObsID(wsrot) == RinexObsID(srot))) &&
-                        vectorindex(wantedObsTypes,srot) == -1)
-                     {
-                        wantedObsTypes.push_back(srot);  // add it
-                        // the number of observations for each observation type
-                        countWantedObsTypes.push_back(0);
-                        
-                        ossx << " Add obs type " << srot
-                           << " =~ " << inputWantedObsTypes[j]
-                           << " from " << filename << endl;
-                     }
-                  }
-               }
-            }  // end loop over obs types in header
-
-            // must keep SatObsCountMap vectors parallel to wantedObsTypes
-            if(SatObsCountMap.size() > 0) {                       // table exists
-               vector<int> v(SatObsCountMap.begin()->second);
-               j = wantedObsTypes.size();
-               if(v.size() < j) {                                 // vectors are short
-                  soit = SatObsCountMap.begin();
-                  for( ; soit != SatObsCountMap.end(); ++soit)
-                     soit->second.resize(j , 0);                  // extend with zeros
-               }
-            }
+            addWantedObsTypes(roh, filename, ossx);
 
             headers.push_back(roh);
+            station = stationIndex(roh, filename);
          }
          catch(Exception& e) {
             oss << "Error - failed to read header for file " << filename
@@ -226,71 +194,9 @@ try {
             // ignore data outside of time limits given by user
             if(rod.time < startTime) continue;
             if(rod.time > stopTime) break;
-            if(rod.time < begDataTime) begDataTime = rod.time;
-            if(rod.time > endDataTime) endDataTime = rod.time;
-
-            // count epochs
-            nepochs++;
-            if(nepochsToRead > -1 && nepochs >= nepochsToRead) break;
-
-            // prepare output rod
-            outrod.time = rod.time;
-            outrod.clockOffset = rod.clockOffset;
-            outrod.epochFlag = rod.epochFlag;
-            // outrod.auxHeader.clear();
-            outrod.numSVs = 0;
-            outrod.obs.clear();
-
-            // loop over satellites, counting data per ObsID
-            Rinex3ObsData::DataMap::const_iterator it;
-            for(it=rod.obs.begin(); it != rod.obs.end(); ++it) {
-               RinexSatID sat(it->first);
-
-               // is the sat excluded?  NB it does not exclude sat=(sys,-1)
-               if(exSats.size() > 0 &&
-                  find(exSats.begin(), exSats.end(), sat) != exSats.end())
-                     continue;
-
-               // 1-char string = system
-               string sys(sat.toString().substr(0,1));
-               const vector<RinexObsID> types(roh.mapObsTypes[sys]);
-
-               // loop over obs
-               for(i=0; i<it->second.size(); i++) {
-                  if(it->second[i].data == 0.0) continue;   // don't count missing
-
-                  // combine the system and obs type into total rinex obs ID
-                  string srot = sys + types[i].asString();  // 4-char RinexObsID
-
-                  // is it wanted? nint is the index into
-                  // wantedObsTypes, SatObsCountMap and outrod.obs
-                  nint = vectorindex(wantedObsTypes,srot);
-                  if(nint == -1) continue;
-
-                  // count the sat/obs
-                  soit = SatObsCountMap.find(sat);
-                  if(soit == SatObsCountMap.end()) {           // add the sat
-                     vector<int> v(wantedObsTypes.size(),0);   // keep parallel
-                     SatObsCountMap[sat] = v;                  // creates map entry
-                  }
-                  SatObsCountMap[sat][nint]++;
-                  countWantedObsTypes[nint]++;
-
-                  // add it to outrod
-                  if(saveData) {
-                     if(outrod.obs.find(sat) == outrod.obs.end()) {
-                        vector<RinexDatum> v(wantedObsTypes.size());
-                        outrod.obs[sat] = v;
-                        outrod.numSVs++;
-                     }
-                     outrod.obs[sat][nint] = it->second[i];
-                  }
-               }
-            }
 
-            if(saveData && outrod.obs.size() > 0) datastore.push_back(outrod);
-
-            if(nepochsToRead > -1 && nepochs >= nepochsToRead) break;
+            // count, and save or pass to the callback
+            if(!saveEpoch(rod, roh, station, outrod)) { stop = true; break; }
 
          }  // end loop over epochs
 
@@ -313,10 +219,466 @@ try {
                << printTime(timeOrder[i],timefmt) << " are out of time order" << endl;
       }
 
-      if(nepochsToRead > -1 && nepochs >= nepochsToRead) break;
+      if(stop) break;
 
    }  // end loop over files
 
+   finishMessages(oss, ossx, errmsg, msg);
+
+   return nread;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+namespace {
+   // One file being read by loadFilesParallel(). The queue, started and done are
+   // shared between the reading thread and the merge, under the mutex; the rest
+   // belongs to the reading thread until it is joined.
+   struct ParallelFile
+   {
+      string filename;           // name of the file
+      int hindex;                // index of its header in headers
+      unsigned int station;      // index of its station in stations
+      CommonTime firstTime;      // no epoch precedes this (TIME OF FIRST OBS)
+      bool started;              // a thread has taken this file
+      bool done;                 // the thread has finished with it
+      deque<Rinex3ObsData> queue;// epochs read and edited, not yet merged
+      vector<double> dts;        // time steps, for the estimator
+      vector<int> nOrder;        // out of time order records, cf. loadFiles()
+      vector<CommonTime> timeOrder;
+      string errors;             // error messages
+   };
+}
+
+//------------------------------------------------------------------------------------
+// Read the files on a pool of threads, merging the epochs in time order.
+// All headers are read first, in order, by this thread, so wantedObsTypes is
+// complete before any data are counted; this also defines any unknown obs types,
+// which must not be done while other threads are using ObsID.
+int Rinex3ObsFileLoader::loadFilesParallel(string& errmsg, string& msg)
+{
+   unsigned int i;
+   ostringstream oss, ossx;
+   vector<ParallelFile> pfiles;
+
+   // read the headers ------------------------------------------------
+   int nread(0);
+   for(unsigned int nf=0; nf<filenames.size(); nf++) {
+      string filename(filenames[nf]);
+      StringUtils::stripLeading(filename);
+      StringUtils::stripTrailing(filename);
+      if(filename.empty()) {
+         oss << "Error - file name " << nf+1 << " is blank";
+         continue;
+      }
+      nread++;
+
+      Rinex3ObsStream strm(filename.c_str());
+      if(!strm.is_open()) {
+         oss << "Error - could not open file " << filename << endl;
+         continue;
+      }
+      strm.exceptions(fstream::failbit);
+
+      Rinex3ObsHeader roh;
+      try {
+         strm >> roh;
+         addWantedObsTypes(roh, filename, ossx);
+         headers.push_back(roh);
+      }
+      catch(Exception& e) {
+         oss << "Error - failed to read header for file " << filename
+            << " with exception " << e.getText(0) << endl;
+         continue;
+      }
+
+      ParallelFile pf;
+      pf.filename = filename;
+      pf.hindex = headers.size()-1;
+      pf.station = stationIndex(roh, filename);
+      pf.firstTime = CommonTime::BEGINNING_OF_TIME;
+      if(roh.valid & Rinex3ObsHeader::validFirstTime)
+         pf.firstTime = roh.firstObs.convertToCommonTime();
+      pf.firstTime.setTimeSystem(TimeSystem::Any);
+      pf.started = pf.done = false;
+      pfiles.push_back(pf);
+   }
+
+   // threads take the files in order of their first epoch
+   vector<unsigned int> startOrder;
+   for(i=0; i<pfiles.size(); i++) startOrder.push_back(i);
+   stable_sort(startOrder.begin(), startOrder.end(),
+      [&pfiles](unsigned int a, unsigned int b)
+         { return pfiles[a].firstTime < pfiles[b].firstTime; });
+
+   mutex mtx;
+   condition_variable dataReady;    // an epoch was queued, or a file is done
+   condition_variable spaceFree;    // an epoch was merged, or starved or abort set
+   unsigned int nextStart(0);       // index in startOrder of next file to read
+   bool starved(false);             // merge needs a file not yet started
+   bool abort(false);               // merge is finished, stop reading
+
+   // read and edit one file at a time; editing is as in loadFiles() but with
+   // the previous time per file
+   auto reader = [&]()
+   {
+      for(;;) {
+         unsigned int k;
+         {
+            lock_guard<mutex> lock(mtx);
+            if(abort || nextStart >= startOrder.size()) return;
+            k = startOrder[nextStart++];
+            pfiles[k].started = true;
+         }
+         ParallelFile& pf(pfiles[k]);
+         ostringstream err;
+
+         try {
+            Rinex3ObsStream strm(pf.filename.c_str());
+            strm.exceptions(fstream::failbit);
+            Rinex3ObsHeader roh;
+            strm >> roh;
+
+            bool onOrder(false);
+            CommonTime prev(CommonTime::BEGINNING_OF_TIME);
+            prev.setTimeSystem(TimeSystem::Any);
+            Rinex3ObsData rod;
+            while(1) {
+               try {
+                  strm >> rod;
+                  rod.time.setTimeSystem(TimeSystem::Any);
+               }
+               catch(Exception& e) {
+                  err << "Error - failed to read data in file " << pf.filename
+                     << " with exception " << e.getText(0) << endl;
+                  break;
+               }
+               if(strm.eof() || !strm.good()) break;
+               if(rod.epochFlag != 0 && rod.epochFlag != 1) continue;
+
+               if(prev != CommonTime::BEGINNING_OF_TIME) {
+                  double dt(rod.time - prev);
+                  if(dtdec > 0.0) {
+                     double delta(static_cast<GPSWeekSecond>(rod.time).sow);
+                     if(::fabs(delta - dtdec*long(0.5+delta/dtdec)) > 0.25)
+                        continue;
+                  }
+                  if(dt >= dttol)
+                     pf.dts.push_back(dt);
+                  else {
+                     if(!onOrder) {
+                        pf.nOrder.push_back(0);
+                        pf.timeOrder.push_back(prev);
+                        onOrder = true;
+                     }
+                     pf.nOrder[pf.nOrder.size()-1]++;
+                     continue;
+                  }
+                  onOrder = false;
+               }
+
+               prev = rod.time;
+               if(rod.time < startTime) continue;
+               if(rod.time > stopTime) break;
+
+               // queue it for the merge, waiting while this file is too far ahead
+               unique_lock<mutex> lock(mtx);
+               while(!abort && !starved && pf.queue.size() >= maxBufferedEpochs)
+                  spaceFree.wait(lock);
+               if(abort) break;
+               pf.queue.push_back(std::move(rod));
+               dataReady.notify_one();
+            }
+         }
+         catch(Exception& e) {
+            err << "Error - failed to read file " << pf.filename
+               << " with exception " << e.getText(0) << endl;
+         }
+
+         {
+            lock_guard<mutex> lock(mtx);
+            pf.errors = err.str();
+            pf.done = true;
+         }
+         dataReady.notify_one();
+      }
+   };
+
+   vector<thread> pool;
+   unsigned int npool(nthreads < int(pfiles.size()) ? nthreads : pfiles.size());
+   for(i=0; i<npool; i++) pool.push_back(thread(reader));
+
+   // merge the files in time order, on this thread -------------------
+   try {
+      Rinex3ObsData rod, outrod;
+      unique_lock<mutex> lock(mtx);
+      for(;;) {
+         // find the earliest next epoch: the head of a queue, or the first
+         // time of a file not yet started; ties go to the earlier station, then
+         // to the earlier file, so the store is in (time, station) order
+         int best(-1);
+         bool wait(false);
+         CommonTime bestTime, t;
+         for(i=0; i<pfiles.size(); i++) {
+            if(!pfiles[i].queue.empty())
+               t = pfiles[i].queue.front().time;
+            else if(pfiles[i].done)
+               continue;
+            else if(pfiles[i].started) {      // next epoch not yet known
+               wait = true;
+               break;
+            }
+            else
+               t = pfiles[i].firstTime;
+            if(best < 0 || t < bestTime ||
+               (t == bestTime && pfiles[i].station < pfiles[best].station))
+               { best = i; bestTime = t; }
+         }
+         if(!wait && best < 0) break;        // all files done
+
+         // need a file that no thread is free to start?
+         starved = (!wait && pfiles[best].queue.empty());
+         if(wait || starved) {
+            if(starved) spaceFree.notify_all();
+            dataReady.wait(lock);
+            continue;
+         }
+
+         rod = std::move(pfiles[best].queue.front());
+         pfiles[best].queue.pop_front();
+         spaceFree.notify_all();
+
+         lock.unlock();
+         bool keep(saveEpoch(rod, headers[pfiles[best].hindex],
+                             pfiles[best].station, outrod));
+         lock.lock();
+         if(!keep) break;
+      }
+      abort = true;
+      spaceFree.notify_all();
+   }
+   catch(...) {
+      {
+         lock_guard<mutex> lock(mtx);
+         abort = true;
+      }
+      spaceFree.notify_all();
+      for(i=0; i<pool.size(); i++) pool[i].join();
+      throw;
+   }
+   for(i=0; i<pool.size(); i++) pool[i].join();
+
+   // time steps, errors and warnings, in the order of the files ------
+   for(unsigned int k=0; k<pfiles.size(); k++) {
+      const ParallelFile& pf(pfiles[k]);
+      for(i=0; i<pf.dts.size(); i++) mcv.add(pf.dts[i]);
+      oss << pf.errors;
+      for(i=0; i<pf.timeOrder.size(); i++)
+         oss << "Warning - in file " << pf.filename << " " << pf.nOrder[i]
+            << " data records following epoch "
+            << printTime(pf.timeOrder[i],timefmt) << " are out of time order" << endl;
+   }
+   rawdt = mcv.bestDT();
+   nominalDT = (dtdec > 0.0 ? (dtdec > rawdt ? dtdec : rawdt) : rawdt);
+
+   finishMessages(oss, ossx, errmsg, msg);
+
+   return nread;
+}
+
+//------------------------------------------------------------------------------------
+// add the obs types in a header that match inputWantedObsTypes to wantedObsTypes
+void Rinex3ObsFileLoader::addWantedObsTypes(const Rinex3ObsHeader& roh,
+                                            const string& filename,
+                                            ostringstream& ossx)
+{
+   unsigned int i,j;
+
+   map<string,vector<RinexObsID> >::const_iterator kt;
+   for(kt = roh.mapObsTypes.begin(); kt != roh.mapObsTypes.end(); kt++) {
+      for(i=0; i<kt->second.size(); i++) {
+         // need 4-char string version of ObsID
+         string sys = kt->first;                // system
+         string rot = kt->second[i].asString(); // 3-char id
+         string srot = sys + rot;               // 4-char id
+
+         for(j=0; j<inputWantedObsTypes.size(); j++) {
+            string wsrot(inputWantedObsTypes[j]);
+            string wsys(wsrot.substr(0,1));
+            string wrot(wsrot.substr(1,3));
+
+            // if sys and rot match, and srot is not found, add it
+            if(((wsys == "*" && RinexObsID(wrot) == RinexObsID(rot)) ||
+                (wsys == sys && RinexObsID(wsrot) == RinexObsID(srot))) &&
+               vectorindex(wantedObsTypes,srot) == -1)
+            {
+               wantedObsTypes.push_back(srot);  // add it
+               // the number of observations for each observation type
+               countWantedObsTypes.push_back(0);
+
+               ossx << " Add obs type " << srot
+                  << " =~ " << inputWantedObsTypes[j]
+                  << " from " << filename << endl;
+            }
+         }
+      }
+   }  // end loop over obs types in header
+
+   // must keep SatObsCounts vectors parallel to wantedObsTypes
+   j = wantedObsTypes.size();
+   for(i=0; i<SatObsCounts.size(); i++)
+      if(SatObsCounts[i].size() > 0)                     // sat found
+         SatObsCounts[i].resize(j, 0);                   // extend with zeros
+
+   // the header, or the wanted obs types, may have changed
+   wantedIndexes.clear();
+}
+
+//------------------------------------------------------------------------------------
+// index in wantedObsTypes of each obs type of system sys in header roh
+const vector<int>& Rinex3ObsFileLoader::wantedIndex(const Rinex3ObsHeader& roh,
+                                                    char sys)
+{
+   vector< vector<int> >& perSys(wantedIndexes[&roh]);
+   if(perSys.empty()) perSys.resize(128);
+   vector<int>& index(perSys[sys & 0x7f]);
+   if(index.empty()) {
+      // 1-char string = system
+      string ssys(1,sys);
+      map<string,vector<RinexObsID> >::const_iterator kt(roh.mapObsTypes.find(ssys));
+      if(kt != roh.mapObsTypes.end()) {
+         for(unsigned int i=0; i<kt->second.size(); i++)
+            // combine the system and obs type into total rinex obs ID
+            index.push_back(vectorindex(wantedObsTypes, ssys+kt->second[i].asString()));
+      }
+   }
+   return index;
+}
+
+//------------------------------------------------------------------------------------
+// find the station of a header, by MARKER NAME or else file name, adding it if new
+unsigned int Rinex3ObsFileLoader::stationIndex(const Rinex3ObsHeader& roh,
+                                               const string& filename)
+{
+   string name(roh.markerName);
+   StringUtils::stripTrailing(name);
+   if(name.empty()) name = filename;
+   int i(vectorindex(stations, name));
+   if(i > -1) return i;
+   stations.push_back(name);
+   return stations.size()-1;
+}
+
+//------------------------------------------------------------------------------------
+// build the map of Sat/Obs counts from SatObsCounts
+map<RinexSatID, vector<int> > Rinex3ObsFileLoader::getWantedSatObsCountMap(void) const
+{
+   map<RinexSatID, vector<int> > satObsCountMap;
+   for(unsigned int i=0; i<SatObsCounts.size(); i++)
+      if(SatObsCounts[i].size() > 0)
+         satObsCountMap[RinexSatID::fromHandle(i)] = SatObsCounts[i];
+   return satObsCountMap;
+}
+
+//------------------------------------------------------------------------------------
+// count one epoch of data that has passed editing, and save it in the store or
+// pass it to the callback
+// return false if loading should stop, true otherwise
+bool Rinex3ObsFileLoader::saveEpoch(const Rinex3ObsData& rod, Rinex3ObsHeader& roh,
+                                    unsigned int station, Rinex3ObsData& outrod)
+{
+   int nint;
+   unsigned int i;
+   bool save(saveData || epochCallback);
+
+   if(rod.time < begDataTime) begDataTime = rod.time;
+   if(rod.time > endDataTime) endDataTime = rod.time;
+
+   // count epochs
+   nepochs++;
+   if(nepochsToRead > -1 && nepochs >= nepochsToRead) return false;
+
+   // prepare output rod
+   outrod.time = rod.time;
+   outrod.clockOffset = rod.clockOffset;
+   outrod.epochFlag = rod.epochFlag;
+   // outrod.auxHeader.clear();
+   outrod.numSVs = 0;
+   outrod.obs.clear();
+
+   // loop over satellites, counting data per ObsID
+   Rinex3ObsData::DataMap::const_iterator it;
+   for(it=rod.obs.begin(); it != rod.obs.end(); ++it) {
+      RinexSatID sat(it->first);
+
+      // is the sat excluded?  NB it does not exclude sat=(sys,-1)
+      if(exSats.size() > 0 &&
+         find(exSats.begin(), exSats.end(), sat) != exSats.end())
+            continue;
+
+      // index in wantedObsTypes of each obs type of the sat's system
+      const vector<int>& wanted(wantedIndex(roh, sat.systemChar()));
+
+      // the sat's counts, and its data in outrod, found when first needed
+      int h(sat.handle());
+      vector<int> *counts(NULL);
+      vector<RinexDatum> *outdata(NULL);
+
+      // loop over obs
+      for(i=0; i<it->second.size() && i<wanted.size(); i++) {
+         if(it->second[i].data == 0.0) continue;   // don't count missing
+
+         // is it wanted? nint is the index into
+         // wantedObsTypes, SatObsCounts and outrod.obs
+         nint = wanted[i];
+         if(nint == -1) continue;
+
+         // count the sat/obs
+         if(counts == NULL) {
+            if(h < 0) {
+               Exception e("Satellite " + sat.toString() + " has no RinexSatID handle");
+               GPSTK_THROW(e);
+            }
+            if(SatObsCounts.empty())
+               SatObsCounts.resize(RinexSatID::numHandles);
+            counts = &SatObsCounts[h];
+            if(counts->empty())                          // add the sat
+               counts->resize(wantedObsTypes.size(),0);  // keep parallel
+         }
+         (*counts)[nint]++;
+         countWantedObsTypes[nint]++;
+
+         // add it to outrod; sats come in order, so this adds at the end
+         if(save) {
+            if(outdata == NULL) {
+               outdata = &(outrod.obs.insert(outrod.obs.end(),
+                              make_pair(sat, vector<RinexDatum>(wantedObsTypes.size())))
+                           ->second);
+               outrod.numSVs++;
+            }
+            (*outdata)[nint] = it->second[i];
+         }
+      }
+   }
+
+   if(save && outrod.obs.size() > 0) {
+      if(epochCallback) return epochCallback(outrod, station);
+      datastore.push_back(outrod);
+      storeStations.push_back(station);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------------
+// strip the error and info messages from loadFiles() and return them
+void Rinex3ObsFileLoader::finishMessages(const ostringstream& oss,
+                                         const ostringstream& ossx,
+                                         string& errmsg, string& msg)
+{
    if(!errmsg.empty()) errmsg += string("\n");
    errmsg += oss.str();
    if(!errmsg.empty()) {
@@ -328,12 +690,6 @@ try {
       StringUtils::stripTrailing(msg,'\n');
       StringUtils::stripTrailing(msg,'\r');
    }
-
-   return nread;
-}
-catch(Exception& e) { GPSTK_RETHROW(e); }
-catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
-catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
 //------------------------------------------------------------------------------------
@@ -388,8 +744,9 @@ try {
    unsigned int i;
    unsigned short flag;
    GSatID sat;
-   map<GSatID,unsigned int> indexForSat;
-   map<GSatID,unsigned int>::const_iterator satit;
+   pair<unsigned int,GSatID> key;         // (station, sat)
+   map<pair<unsigned int,GSatID>,unsigned int> indexForSat;
+   map<pair<unsigned int,GSatID>,unsigned int>::const_iterator satit;
    map<char,vector<string> >::const_iterator obsit;
 
    // add to existing SPList
@@ -397,9 +754,10 @@ try {
       // sort existing list on time - this probably already done
       std::sort(SPList.begin(),SPList.end());
 
-      // fill index array using SPList - later ones overwrite earlier ones
+      // fill index array using SPList - later ones overwrite earlier ones;
+      // these are continued with the data of the first station
       for(i=0; i<SPList.size(); i++)
-         indexForSat[SPList[i].getSat()] = i;
+         indexForSat[make_pair(0U,GSatID(SPList[i].getSat()))] = i;
    }
 
    // for use in putting data into SatPass
@@ -420,6 +778,7 @@ try {
          if(jt == indexLoadOT.end())      // skip unwanted system
             continue;
          sat = GSatID(it->first);         // converts from RinexSatID
+         key = make_pair(storeStations[nds], sat);
 
          // get obstypes for this sys
          obsit = sysSPOT.find(sys);
@@ -443,14 +802,14 @@ try {
             }
          }
 
-         // find the current SatPass for this sat
-         satit = indexForSat.find(sat);
+         // find the current SatPass for this station and sat
+         satit = indexForSat.find(key);
          if(satit == indexForSat.end()) {       // create a new one
             SatPass newSP(sat,nominalDT,obsit->second);
             SPList.push_back(newSP);
             npass++;
-            indexForSat[sat] = SPList.size()-1;
-            satit = indexForSat.find(sat);
+            indexForSat[key] = SPList.size()-1;
+            satit = indexForSat.find(key);
          }
 
          // add the data to the SatPass
@@ -462,8 +821,8 @@ try {
                SatPass newSP(sat,nominalDT,obsit->second);
                SPList.push_back(newSP);
                npass++;
-               indexForSat[sat] = SPList.size()-1;
-               satit = indexForSat.find(sat);
+               indexForSat[key] = SPList.size()-1;
+               satit = indexForSat.find(key);
             }
 
          } while(i == -1);       // will iterate only once, if there is a gap
@@ -492,11 +851,12 @@ void Rinex3ObsFileLoader::dumpSatObsTable(ostream& s) const
    s << endl;
    
    // dump the counts
-   map<RinexSatID, vector<int> >::const_iterator soit;
-   for(soit = SatObsCountMap.begin(); soit != SatObsCountMap.end(); ++soit) {
-      s << " " << soit->first;
-      for(i=0; i<soit->second.size(); i++)
-         s << " " << setw(5) << soit->second[i];
+   // in the order of the handles, which is that of the sats
+   for(unsigned int h=0; h<SatObsCounts.size(); h++) {
+      if(SatObsCounts[h].empty()) continue;
+      s << " " << RinexSatID::fromHandle(h);
+      for(i=0; i<SatObsCounts[h].size(); i++)
+         s << " " << setw(5) << SatObsCounts[h][i];
       s << endl;
    }
 
@@ -515,8 +875,10 @@ void Rinex3ObsFileLoader::dumpStoreData(ostream& s) const
    for(unsigned int i=0; i<datastore.size(); i++) {
       const Rinex3ObsData& rod(datastore[i]);
       s << "Dump of Rinex3ObsData" << " at "
-         << printTime(rod.time,timefmt)
-         << " epochFlag = " << rod.epochFlag
+         << printTime(rod.time,timefmt);
+      if(stations.size() > 1)
+         s << " station " << stations[storeStations[i]];
+      s << " epochFlag = " << rod.epochFlag
          << " numSVs = " << rod.numSVs << fixed << setprecision(9)
          << " clk offset = " << rod.clockOffset << endl;
 
@@ -44,6 +44,9 @@
 // system includes
 #include <string>
 #include <vector>
+#include <functional>
+#include <sstream>
+#include <iomanip>
 
 // GPSTk
 #include "Exception.hpp"
@@ -73,8 +76,23 @@ namespace gpstk {
 /// 5. Read the output: dumpSatObsTable() or dumpData() [if saved], and access output
 /// 6. Optionally write the output to vector of SatPass with WriteSatPassList()
 /// 7. Reset and go again reset() or reset(vector<files>)
+///
+/// With setThreads(n>1) the files are parsed on a pool of n threads and the
+/// epochs merged into time order, so the files need not be consecutive; e.g. one
+/// file per station. Each file is read ahead at most setMaxBufferedEpochs() epochs.
+/// Each epoch is tagged with its station (cf. getStations(), getStoreStation()),
+/// so the merged store is keyed by (time, station); epochs of the same time come
+/// in station order.
+/// With setEpochCallback() each epoch is passed to the caller as it is loaded,
+/// rather than accumulated in the store.
 class Rinex3ObsFileLoader
 {
+public:
+   /// Function called by loadFiles() for each epoch of wanted data, in time
+   /// order, in place of adding it to the store; return false to stop loading.
+   /// The second argument is the index of the epoch's station in getStations().
+   typedef std::function<bool(const Rinex3ObsData&, unsigned int)> EpochCallback;
+
 private:
    static const double dttol;             ///< tolerance in comparing times
 
@@ -94,9 +112,15 @@ private:
    /// list of wanted RinexObsIDs, without any "*", which appear in header(s)
    std::vector<std::string> wantedObsTypes;
 
-   /// count of prn/obs for wanted obs types
-   /// NB the vector<int> is parallel to wantedObsTypes;
-   std::map<RinexSatID, std::vector<int> > SatObsCountMap;
+   /// count of prn/obs for wanted obs types, indexed by RinexSatID::handle(),
+   /// empty for sats not found; cf. getWantedSatObsCountMap()
+   /// NB each non-empty vector<int> is parallel to wantedObsTypes;
+   std::vector< std::vector<int> > SatObsCounts;
+
+   /// index in wantedObsTypes (-1 if not wanted) of each obs type in a header,
+   /// per header and system char; built by wantedIndex() as needed, and
+   /// cleared when wantedObsTypes changes
+   std::map<const Rinex3ObsHeader*, std::vector< std::vector<int> > > wantedIndexes;
 
    /// total counts per obs for wanted obs types (parallel to wantedObsTypes)
    std::vector<int> countWantedObsTypes;
@@ -121,11 +145,24 @@ private:
    /// vector of all input data - filled only if saveData is true.
    std::vector<Rinex3ObsData> datastore;
 
+   /// station names: the distinct MARKER NAMEs of the headers (the file name if
+   /// blank), in the order of the files
+   std::vector<std::string> stations;
+   /// station of each epoch in datastore, as an index in stations
+   std::vector<unsigned int> storeStations;
+
+   // parallel loading and streaming
+   int nthreads;                          ///< number of threads to read files (1)
+   unsigned int maxBufferedEpochs;        ///< epochs each file may be read ahead
+   EpochCallback epochCallback;           ///< if set, called instead of storing
+
    /// initialization used by the constructors
    void init(void)
    {
       saveData = false;
       nepochsToRead = -1;
+      nthreads = 1;
+      maxBufferedEpochs = 1000;
       timefmt = std::string("%04Y/%02m/%02d %02H:%02M:%02S");
       reset();
    }
@@ -177,11 +214,14 @@ public:
       obstypes.clear();
       mcv.reset();
       datastore.clear();
+      stations.clear();
+      storeStations.clear();
       exSats.clear();
       headers.clear();
       inputWantedObsTypes.clear();
       wantedObsTypes.clear();
-      SatObsCountMap.clear();
+      SatObsCounts.clear();
+      wantedIndexes.clear();
    }
 
    /// reset with new filenames
@@ -257,6 +297,27 @@ public:
    inline void excludeSats(std::vector<SatID> sats)
       { for(int i=0; i<sats.size(); i++) excludeSat(sats[i]); }
 
+   /// set the number of threads used to read the files; 1 (the default) reads
+   /// the files one after another, n>1 reads up to n files at once and merges
+   /// their epochs in time order. Headers are still read first, in order.
+   /// @param[in] n number of threads
+   inline void setThreads(int n) { nthreads = (n < 1 ? 1 : n); }
+   /// set the memory limit of the parallel reader: the number of epochs each
+   /// file being read may get ahead of the merge (default 1000).
+   /// If the merge needs an epoch from a file that has not been started
+   /// because all threads are waiting on this limit, it is exceeded until
+   /// a thread is free.
+   /// @param[in] n maximum epochs buffered per file
+   inline void setMaxBufferedEpochs(unsigned int n)
+      { maxBufferedEpochs = (n < 1 ? 1 : n); }
+   /// pass each loaded epoch, with the wanted obs types (cf. getStore()), to
+   /// a function as it is loaded instead of adding it to the store, so the
+   /// whole dataset is never held in memory. Counts and times are still
+   /// accumulated. The function is always called from the thread that
+   /// called loadFiles(), in time order; if it returns false, loading stops.
+   /// @param[in] cb function to call, or an empty EpochCallback to store data
+   inline void setEpochCallback(EpochCallback cb) { epochCallback = cb; }
+
    // access results: after loadFiles() ---------------------------------
 
    /// write a summary of the entire loader configuration/output to a string
@@ -277,8 +338,7 @@ public:
 
    /// access Sat/Obs counts for list of wanted ObsIDs
    /// @return map<RinexSatID, vector<int>> of counts of data found for Sat/ObsID
-   inline std::map<RinexSatID, std::vector<int> > getWantedSatObsCountMap(void) const
-      { return SatObsCountMap; }
+   std::map<RinexSatID, std::vector<int> > getWantedSatObsCountMap(void) const;
    /// access total Obs counts for list of wanted ObsIDs
    /// @return vector<int> total epoch counts for wanted obs types
    ///     (parallel to wantedObsTypes)
@@ -306,6 +366,17 @@ public:
    inline const std::vector<Rinex3ObsData>& getStore(void) const
       { return datastore; }
 
+   /// access the stations of the files read
+   /// @return MARKER NAME of each distinct station (the file name if blank)
+   inline const std::vector<std::string>& getStations(void) const
+      { return stations; }
+
+   /// get the station of an epoch in the data store
+   /// @param[in] i index in the store
+   /// @return index in getStations() of the station of the epoch
+   inline unsigned int getStoreStation(unsigned int i) const
+      { return storeStations[i]; }
+
    // Read the files ----------------------------------------------------
 
    /// Read the files already defined
@@ -314,12 +385,54 @@ public:
    /// @return 0 ok, >0 number of files read
    int loadFiles(std::string& errmsg, std::string& msg);
 
+private:
+   /// loadFiles() for nthreads > 1
+   int loadFilesParallel(std::string& errmsg, std::string& msg);
+
+   /// add the obs types in a header that match inputWantedObsTypes to
+   /// wantedObsTypes, keeping counts and SatObsCounts parallel to it
+   /// @param[in] roh header of file
+   /// @param[in] filename name of file, for messages
+   /// @param[in,out] ossx stream for informative messages
+   void addWantedObsTypes(const Rinex3ObsHeader& roh, const std::string& filename,
+                          std::ostringstream& ossx);
+
+   /// find the station of a header, adding it to stations if new
+   /// @param[in] roh header of file
+   /// @param[in] filename name of file, the station name if MARKER NAME is blank
+   /// @return index of the station in stations
+   unsigned int stationIndex(const Rinex3ObsHeader& roh, const std::string& filename);
+
+   /// count one epoch of data that has passed editing, and save it in the store
+   /// or pass it to the callback
+   /// @param[in] rod epoch of data
+   /// @param[in] roh header of the file it came from
+   /// @param[in] station index in stations of the file's station
+   /// @param[in,out] outrod workspace for epoch of wanted data
+   /// @return false if loading should stop, true otherwise
+   bool saveEpoch(const Rinex3ObsData& rod, Rinex3ObsHeader& roh,
+                  unsigned int station, Rinex3ObsData& outrod);
+
+   /// index in wantedObsTypes of each obs type of a system in a header
+   /// @param[in] roh header of the file
+   /// @param[in] sys system char
+   /// @return vector parallel to roh.mapObsTypes for sys, -1 if not wanted
+   const std::vector<int>& wantedIndex(const Rinex3ObsHeader& roh, char sys);
+
+   /// append the error and informative messages of loadFiles() to the output
+   static void finishMessages(const std::ostringstream& oss,
+                              const std::ostringstream& ossx,
+                              std::string& errmsg, std::string& msg);
+
+public:
+
    // Utilities ---------------------------------------------------------
    /// Write the stored data to a list of SatPass objects, given a vector of obstypes
    /// and (for each system) a parallel vector of indexes into the Loader's ObsIDs
    /// (getWantedObsTypes()), and a vector of SatPass to be written to.
    /// SPList need not be empty; however if not empty, obstypes must be identical to
-   /// those of existing SatPasses.
+   /// those of existing SatPasses, which are continued with the data of the first
+   /// station. Each station's data go into passes of its own.
    /// @param[in] obstypes map of <sys,vector<ObsID>> for SatPass (2or3-char obsID)
    /// @param[in] indexLoadOT map<char,vector<int>> with key=system char,
    ///    value=vector parallel to obstypes with elements equal to
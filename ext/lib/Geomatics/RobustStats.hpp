@@ -49,6 +49,9 @@
 // system includes
 #include <string>
 #include <cmath>
+#include <vector>
+#include <set>
+#include <algorithm>
 
 // GPSTk
 #include "Exception.hpp"
@@ -285,6 +288,23 @@ namespace gpstk {
    /// Robust statistics.
    namespace Robust
    {
+   /// Compute the median of an array of length nd by selection
+   /// (std::nth_element) rather than sorting, in O(nd) time.
+   /// The array is reordered; nd must be > 0.
+   /// @param xd         array of data.
+   /// @param nd         length of array xd.
+   /// @return median of the data in array xd.
+   template <typename T>
+   T SelectMedian(T *xd, const int nd)
+   {
+      int k(nd/2);
+      std::nth_element(xd, xd+k, xd+nd);
+      if(nd%2)
+         return xd[k];
+         // after selection the lower half is xd[0..k-1], in any order
+      return (*std::max_element(xd, xd+k) + xd[k])/T(2);
+   }
+
    /// Compute median of an array of length nd;
    /// array xd is returned sorted, unless save_flag is true.
    /// @param xd         array of data.
@@ -302,32 +322,18 @@ namespace gpstk {
       }
 
       try {
-         int i;
-         T med, *save=NULL;
-
+            // select on a copy; no need to sort
          if(save_flag) {
-            save = new T[nd];
-            if(!save) {
-               Exception e("Could not allocate temporary array");
-               GPSTK_THROW(e);
-            }
-            for(i=0; i<nd; i++) save[i]=xd[i];
+            std::vector<T> save(xd, xd+nd);
+            return SelectMedian(&save[0], nd);
          }
 
          QSort(xd,nd);
 
          if(nd%2)
-            med = xd[(nd+1)/2-1];
+            return xd[(nd+1)/2-1];
          else
-            med = (xd[nd/2-1]+xd[nd/2])/T(2);
-
-            // restore original data from temporary
-         if(save_flag) {
-            for(i=0; i<nd; i++) xd[i]=save[i];
-            delete[] save;
-         }
-
-         return med;
+            return (xd[nd/2-1]+xd[nd/2])/T(2);
       }
       catch(Exception& e) { GPSTK_RETHROW(e); }
 
@@ -366,6 +372,7 @@ namespace gpstk {
 
    /// Compute the median absolute deviation of a double array of length nd,
    /// as well as the median (M = Median(xd,nd));
+   /// Both medians are found by selection, without sorting.
    /// NB this routine will trash the array xd unless save_flag is true (default).
    /// @param xd array of data (input).
    /// @param nd length of array xd (input).
@@ -376,43 +383,27 @@ namespace gpstk {
    T MedianAbsoluteDeviation(T *xd, int nd, T& M, bool save_flag=true)
       throw(Exception)
    {
-      int i;
-      T mad, *save;
-
       if(!xd || nd < 2) {
          Exception e("Invalid input");
          GPSTK_THROW(e);
       }
 
-         // store data in a temporary array
+         // work on a temporary array, unless xd may be trashed
+      std::vector<T> save;
+      T *wd(xd);
       if(save_flag) {
-         save = new T[nd];
-         if(!save) {
-            Exception e("Could not allocate temporary array");
-            GPSTK_THROW(e);
-         }
-         for(i=0; i<nd; i++) save[i]=xd[i];
+         save.assign(xd, xd+nd);
+         wd = &save[0];
       }
 
-         // get the median (don't care if xd gets sorted...)
-      M = Median(xd, nd, false);
-
-         // compute xd=abs(xd-M)
-      for(i=0; i<nd; i++) xd[i] = ABSOLUTE(xd[i]-M);
+         // get the median
+      M = SelectMedian(wd, nd);
 
-         // sort xd in ascending order
-      QSort(xd, nd);
+         // compute wd=abs(wd-M)
+      for(int i=0; i<nd; i++) wd[i] = ABSOLUTE(wd[i]-M);
 
          // find median and normalize to get mad
-      mad = Median(xd, nd, false) / T(RobustTuningE);
-
-         // restore original data from temporary
-      if(save_flag) {
-         for(i=0; i<nd; i++) xd[i]=save[i];
-         delete[] save;
-      }
-
-      return mad;
+      return SelectMedian(wd, nd) / T(RobustTuningE);
 
    }  // end MedianAbsoluteDeviation
 
@@ -423,6 +414,115 @@ namespace gpstk {
       throw(Exception)
    { return MedianAbsoluteDeviation(xd,nd,M,save_flag); }
 
+   /// Quantile of a sliding window of data, updated as data enter and
+   /// leave the window in O(log n) time, where n is the number of data in
+   /// the window, rather than sorting the window for each new datum.
+   /// The window is kept in two sorted halves, the lower holding the
+   /// smallest floor(q*(n-1))+1 data; the quantile interpolates between
+   /// the largest of the lower and the smallest of the upper half:
+   /// if h = q*(n-1) and f = h-floor(h), the result is
+   /// (1-f)*x[floor(h)] + f*x[floor(h)+1], with x the sorted data.
+   /// For q=0.5 this is the same value as Median().
+   /// @code
+   /// Robust::SlidingQuantile<double> rm;            // running median
+   /// for(i=0; i<data.size(); i++) {
+   ///    rm.add(data[i]);
+   ///    if(i >= width) rm.remove(data[i-width]);
+   ///    if(i >= width-1) med[i] = rm.value();
+   /// }
+   /// @endcode
+   template <typename T>
+   class SlidingQuantile
+   {
+   public:
+      /// Constructor
+      /// @param q the quantile, 0 <= q <= 1; default is the median.
+      /// @throw if q is outside [0,1]
+      SlidingQuantile(double q=0.5) throw(Exception) : quant(q)
+      {
+         if(q < 0.0 || q > 1.0) {
+            Exception e("Invalid quantile");
+            GPSTK_THROW(e);
+         }
+      }
+
+      /// add a datum to the window
+      void add(const T& x) throw()
+      {
+         if(lower.empty() || !(*lower.rbegin() < x))
+            lower.insert(x);
+         else
+            upper.insert(x);
+         balance();
+      }
+
+      /// remove a datum that was added earlier from the window
+      /// @throw if x is not in the window
+      void remove(const T& x) throw(Exception)
+      {
+         typename std::multiset<T>::iterator it;
+         if(!lower.empty() && !(*lower.rbegin() < x)) {
+            it = lower.find(x);
+            if(it != lower.end()) { lower.erase(it); balance(); return; }
+         }
+         else {
+            it = upper.find(x);
+            if(it != upper.end()) { upper.erase(it); balance(); return; }
+         }
+         Exception e("Datum is not in the window");
+         GPSTK_THROW(e);
+      }
+
+      /// empty the window
+      void clear(void) throw()
+      { lower.clear(); upper.clear(); }
+
+      /// number of data in the window
+      int size(void) const throw()
+      { return lower.size() + upper.size(); }
+
+      /// the quantile of the data in the window
+      /// @throw if the window is empty
+      T value(void) const throw(Exception)
+      {
+         if(lower.empty()) {
+            Exception e("Window is empty");
+            GPSTK_THROW(e);
+         }
+         double h(quant*(size()-1));
+         T f(h - ::floor(h));
+         if(f == T(0) || upper.empty())
+            return *lower.rbegin();
+         return (T(1)-f) * *lower.rbegin() + f * *upper.begin();
+      }
+
+      /// the quantile this object computes
+      double getQuantile(void) const throw()
+      { return quant; }
+
+   private:
+      /// move data between the halves until lower has floor(q*(n-1))+1 data
+      void balance(void) throw()
+      {
+         int n(size());
+         if(n == 0) return;
+         size_t nlow(static_cast<size_t>(::floor(quant*(n-1))) + 1);
+         while(lower.size() > nlow) {
+            typename std::multiset<T>::iterator it(--lower.end());
+            upper.insert(upper.begin(), *it);
+            lower.erase(it);
+         }
+         while(lower.size() < nlow) {
+            lower.insert(lower.end(), *upper.begin());
+            upper.erase(upper.begin());
+         }
+      }
+
+      double quant;              ///< quantile, 0 <= quant <= 1
+      std::multiset<T> lower;    ///< smallest floor(quant*(n-1))+1 data
+      std::multiset<T> upper;    ///< the rest of the data
+   };  // end class SlidingQuantile
+
    /// Compute the m-estimate. Iteratively determine the m-estimate, which
    /// is a measure of mean or median, but is less sensitive to outliers.
    /// M is the median (M=Median(xd,nd)), and MAD is the
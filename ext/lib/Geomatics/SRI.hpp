@@ -59,6 +59,7 @@
 #include "Namelist.hpp"
 #include "SRIMatrix.hpp"
 #include "SparseMatrix.hpp"
+#include "CompressedSparseMatrix.hpp"
 
 namespace gpstk
 {
@@ -416,15 +417,15 @@ public:
    }
 
       /// SRIF (Kalman) measurement update, or least squares update, Sparse version.
-      /// Call the SRI measurement update for this SRI and the given input. See doc.
-      /// for SrifMU().
+      /// Call the SRI measurement update for this SRI and the given input, with the
+      /// partials converted to compressed column form. See doc. for SrifMU().
       /// @param Partials matrix
       /// @param Data vector
    void measurementUpdate(SparseMatrix<double>& Partials, Vector<double>& Data)
       throw(Exception)
    {
       try {
-         SrifMU(R, Z, Partials, Data);
+         SrifMU(R, Z, CSCMatrix<double>(Partials), Data);
       }
       catch(MatrixException& me) { GPSTK_RETHROW(me); }
    }
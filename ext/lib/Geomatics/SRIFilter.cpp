@@ -185,20 +185,23 @@ void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>&
       GPSTK_THROW(me);
    }
    try {
-      SparseMatrix<double> A(H || D);
+      CSCMatrix<double> P;
       SparseMatrix<double> CHL;
          // whiten partials and data
       if(&CM != &SRINullSparseMatrix) {
          CHL = lowerCholesky(CM);
          SparseMatrix<double> L(inverseLT(CHL));
-         A = L * A;
+         SparseMatrix<double> A(L * (H || D));
+         P = CSCMatrix<double>(SparseMatrix<double>(A,0,0,A.rows(),A.cols()-1));
+         D = Vector<double>(A.colCopy(A.cols()-1));
       }
+      else
+         P = CSCMatrix<double>(H);
 
          // update *this with the whitened information
-      SrifMU(R, Z, A);
+      SrifMU(R, Z, P, D);
 
-         // copy out D and un-whiten residuals
-      D = Vector<double>(A.colCopy(A.cols()-1));
+         // un-whiten residuals
       if(&CM != &SRINullSparseMatrix) {      // same if above creates CHL
          D = CHL * D;
       }
@@ -207,6 +210,30 @@ void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>&
    catch(VectorException& ve) { GPSTK_RETHROW(ve); }
 }
 
+//------------------------------------------------------------------------------------
+// SRIF (Kalman) measurement update, or least squares update -- compressed column
+// version. Returns residuals in D
+void SRIFilter::measurementUpdate(const CSCMatrix<double>& H, Vector<double>& D)
+   throw(MatrixException,VectorException)
+{
+   if(H.cols() != R.cols() || H.rows() != D.size()) {
+      string msg("\nInvalid input dimensions:\n  SRI is ");
+      msg += asString<int>(R.rows()) + "x"
+          + asString<int>(R.cols()) + ",\n  Partials is "
+          + asString<int>(H.rows()) + "x"
+          + asString<int>(H.cols()) + ",\n  Data has length "
+          + asString<int>(D.size());
+
+      MatrixException me(msg);
+      GPSTK_THROW(me);
+   }
+   try {
+      SrifMU(R, Z, H, D);
+   }
+   catch(MatrixException& me) { GPSTK_RETHROW(me); }
+   catch(VectorException& ve) { GPSTK_RETHROW(ve); }
+}
+
 //------------------------------------------------------------------------------------
 // SRIF (Kalman) time update see SrifTU for doc.
 void SRIFilter::timeUpdate(Matrix<double>& PhiInv,
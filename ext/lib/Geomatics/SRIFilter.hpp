@@ -55,6 +55,7 @@
 // geomatics
 #include "SRI.hpp"
 #include "SparseMatrix.hpp"
+#include "CompressedSparseMatrix.hpp"
 
 namespace gpstk
 {
@@ -145,6 +146,16 @@ public:
                           const SparseMatrix<double>& CM=SRINullSparseMatrix)
    throw(MatrixException,VectorException);
 
+      /// SRIF (Kalman) simple linear measurement update, with the partials in
+      /// compressed column form; this is the fastest version for large sparse
+      /// partials. See SrifMU(Matrix&,Vector&,const CSCMatrix&,Vector&).
+      /// @param H  Partials matrix, dimension MxN; the data must be whitened.
+      /// @param D  Data vector, length M; on output D is post-fit residuals.
+      /// @throw if dimension N does not match dimension of SRI, or if other
+      ///        dimensions are inconsistent.
+   void measurementUpdate(const CSCMatrix<double>& H, Vector<double>& D)
+   throw(MatrixException,VectorException);
+
       /// SRIF (Kalman) time update
       /// This routine uses the Householder transformation to propagate the SRIFilter
       /// state and covariance through a time step.
@@ -102,6 +102,9 @@ void SatPass::init(RinexSatID insat, double indt, vector<string> obstypes) throw
       indexForLabel[obstypes[i]] = i;
       labelForIndex[i] = obstypes[i];
    }
+   obsdata.resize(obstypes.size());
+   obslli.resize(obstypes.size());
+   obsssi.resize(obstypes.size());
 }
 
 SatPass& SatPass::operator=(const SatPass& right) throw()
@@ -115,9 +118,13 @@ SatPass& SatPass::operator=(const SatPass& right) throw()
       firstTime = right.firstTime;
       lastTime = right.lastTime;
       ngood = right.ngood;
-      spdvector.resize(right.spdvector.size());
-      for(int i=0; i<right.spdvector.size(); i++)
-         spdvector[i] = right.spdvector[i];
+      flags = right.flags;
+      userflags = right.userflags;
+      counts = right.counts;
+      toffsets = right.toffsets;
+      obsdata = right.obsdata;
+      obslli = right.obslli;
+      obsssi = right.obsssi;
    }
 
    return *this;
@@ -149,26 +156,36 @@ int SatPass::addData(const Epoch tt,
                   + StringUtils::asString(ssi.size()));
       GPSTK_THROW(e);
    }
-   if(spdvector.size() > 0 && spdvector[0].data.size() != data.size()) {
-      Exception e("Error - addData passed different dimension that earlier!"
+   if(data.size() != obsdata.size()) {
+      Exception e("Error - addData passed different dimension than c'tor!"
                    + StringUtils::asString(data.size()) + " != "
-                   + StringUtils::asString(spdvector[0].data.size()));
+                   + StringUtils::asString(obsdata.size()));
       GPSTK_THROW(e);
    }
 
-   // create a new SatPassData
-   SatPassData spd(data.size());
-   spd.flag = flag;
+   // find the column of each input
+   vector<unsigned int> index(data.size());
+   map<string, unsigned int>::const_iterator it;
    for(int k=0; k<data.size(); k++) {
-      int i = indexForLabel[obstypes[k]];
-      spd.data[i] = data[k];
-      spd.lli[i] = lli[k];
-      spd.ssi[i] = ssi[k];
+      if((it = indexForLabel.find(obstypes[k])) == indexForLabel.end()) {
+         Exception e("Invalid obs type in addData() " + obstypes[k]);
+         GPSTK_THROW(e);
+      }
+      index[k] = it->second;
    }
 
    // push_back defines count and
    // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
-   return push_back(tt, spd);
+   int n = push_back(tt, flag);
+   if(n < 0) return n;
+
+   for(int k=0; k<data.size(); k++) {
+      obsdata[index[k]][n] = data[k];
+      obslli[index[k]][n] = lli[k];
+      obsssi[index[k]][n] = ssi[k];
+   }
+
+   return n;
 }
 
 // return -4 robs was not obs data (header info)
@@ -184,30 +201,33 @@ int SatPass::addData(const RinexObsData& robs) throw()
    RinexObsData::RinexSatMap::const_iterator it;
    RinexObsData::RinexObsTypeMap::const_iterator jt;
    map<string,unsigned int>::const_iterator kt;
-   SatPassData spd(indexForLabel.size());
 
    // loop over satellites
    for(it=robs.obs.begin(); it != robs.obs.end(); it++) {
       if(it->first == sat) {      // sat is this->sat
-         spd.flag = OK;
-         // loop over obs
+         unsigned short flag(OK);
+         // loop over obs; first check the data, without storing it
          for(kt=indexForLabel.begin(); kt != indexForLabel.end(); kt++) {
             if((jt=it->second.find(RinexObsHeader::convertObsType(kt->first)))
-                  == it->second.end()) {
-               spd.data[kt->second] = 0.0;
-               spd.lli[kt->second] = 0;
-               spd.ssi[kt->second] = 0;
-               //spd.flag = BAD;// don't do this b/c spd may have 'empty' obs types
-            }
-            else {
-               spd.data[kt->second] = jt->second.data;
-               spd.lli[kt->second] = jt->second.lli;
-               spd.ssi[kt->second] = jt->second.ssi;
-               if(jt->second.data == 0.0) spd.flag = BAD;
+                  != it->second.end() && jt->second.data == 0.0)
+               flag = BAD;
+            //else flag = BAD;// don't do this b/c may have 'empty' obs types
+         }
+
+         // push_back leaves zero data, lli and ssi for missing obs types
+         int n = push_back(robs.time,flag);
+         if(n < 0) return n;
+
+         for(kt=indexForLabel.begin(); kt != indexForLabel.end(); kt++) {
+            if((jt=it->second.find(RinexObsHeader::convertObsType(kt->first)))
+                  != it->second.end()) {
+               obsdata[kt->second][n] = jt->second.data;
+               obslli[kt->second][n] = jt->second.lli;
+               obsssi[kt->second][n] = jt->second.ssi;
             }
          }  // end loop over obs
 
-         return push_back(robs.time,spd);
+         return n;
       }
    }
    return -3;        // sat was not found
@@ -228,13 +248,14 @@ try {
    //if(count == -1) return 1;            // 4/16/13
    if(count < 0) return -1;
 
-   unsigned int i, j, n(0);                     // count for ngood
-   for(i=0; i<spdvector.size(); i++) {
-      if(spdvector[i].ndt >= static_cast<unsigned int>(count)) { j=i; break; }
-      if(spdvector[i].flag != SatPass::BAD) n++;
+   int j(-1);                                   // last index kept
+   unsigned int i, n(0);                        // count for ngood
+   for(i=0; i<counts.size(); i++) {
+      if(flags[i] != SatPass::BAD) n++;
+      if(counts[i] >= static_cast<unsigned int>(count)) { j=i; break; }
    }
    if(j > -1) {
-      spdvector.resize(j+1);
+      truncate(j+1);
       lastTime = time(j);
       ngood = n;
    }
@@ -287,7 +308,11 @@ try {
 
    bool first,done,ok;
    int i,dn,di,sign(0);
-   const int N(spdvector.size());
+   const int N(size());
+   const vector<double>& dataP1(obsdata[indexForLabel[(useC1 ? "C1" : "P1")]]);
+   const vector<double>& dataP2(obsdata[indexForLabel["P2"]]);
+   const vector<double>& dataL1(obsdata[indexForLabel["L1"]]);
+   const vector<double>& dataL2(obsdata[indexForLabel["L2"]]);
    double pP1,pP2,pL1,pL2,pRB1,pRB2;
    TwoSampleStats<double> dN1,dN2;
    static const double testStdDev(40.0),testSlope(0.1),testRatio(10.0),testSigma(.25);
@@ -309,12 +334,12 @@ try {
       // compute the slope of dBias vs dL: biases B = L - DP
       first = true;
       for(i=0; i<N; i+=di) {
-         if(!(spdvector[i].flag & OK)) continue;         // skip bad data
+         if(!(flags[i] & OK)) continue;         // skip bad data
 
-         double P1 = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-         double P2 = spdvector[i].data[indexForLabel["P2"]];
-         double L1 = spdvector[i].data[indexForLabel["L1"]];
-         double L2 = spdvector[i].data[indexForLabel["L2"]];
+         double P1 = dataP1[i];
+         double P2 = dataP2[i];
+         double L1 = dataL1[i];
+         double L2 = dataL2[i];
          double RB1 = wl1*L1 - D11*P1 - D12*P2;
          double RB2 = wl2*L2 - D21*P1 - D22*P2;
 
@@ -468,16 +493,15 @@ try {
    double RB,dLB0(0.0);
    long LB,LB0;
    Stats<double> PB;
+   vector<double>& dataP(obsdata[indexForLabel[freq==1 ? (useC1 ? "C1" : "P1")
+                                                       : (useC2 ? "C2" : "P2")]]);
+   vector<double>& dataL(obsdata[indexForLabel[freq==1 ? "L1" : "L2"]]);
 
    // get the biases B = L - P
-   for(first=true,i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(first=true,i=0; i<size(); i++) {
+      if(!(flags[i] & OK)) continue;        // skip bad data
 
-      double P,L;
-      if(freq==1) P = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-      else        P = spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]];
-      if(freq==1) L = spdvector[i].data[indexForLabel["L1"]];
-      else        L = spdvector[i].data[indexForLabel["L2"]];
+      double P(dataP[i]),L(dataL[i]);
 
       if(first) {                   // remove the large numerical range
          LB0 = long(L-P/wl);
@@ -527,27 +551,15 @@ try {
 
    if(!debiasPH && !smoothPR) return;
 
-   for(i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(i=0; i<size(); i++) {
+      if(!(flags[i] & OK)) continue;        // skip bad data
 
       // replace the pseudorange with the smoothed pseudorange
-      if(smoothPR) {
-         // compute the debiased phase, with real bias
-         if(freq==1) {
-            spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]]
-                        = spdvector[i].data[indexForLabel["L1"]] - RB;
-         }
-         else if(freq==2) {
-            spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]]
-                        = spdvector[i].data[indexForLabel["L2"]] - RB;
-         }
-      }
+      // compute the debiased phase, with real bias
+      if(smoothPR) dataP[i] = dataL[i] - RB;
 
       // replace the phase with the debiased phase, with integer bias (cycles)
-      if(debiasPH) {
-         if(freq==1) spdvector[i].data[indexForLabel["L1"]] -= LB;
-         if(freq==2) spdvector[i].data[indexForLabel["L2"]] -= LB;
-      }
+      if(debiasPH) dataL[i] -= LB;
    }
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
@@ -593,15 +605,19 @@ try {
    double RB1,RB2,dbL1,dbL2,dLB10(0.0),dLB20(0.0);
    long LB1,LB2,LB10,LB20;
    Stats<double> PB1,PB2;
+   vector<double>& dataP1(obsdata[indexForLabel[(useC1 ? "C1" : "P1")]]);
+   vector<double>& dataP2(obsdata[indexForLabel[(useC2 ? "C2" : "P2")]]);
+   vector<double>& dataL1(obsdata[indexForLabel["L1"]]);
+   vector<double>& dataL2(obsdata[indexForLabel["L2"]]);
 
    // get the biases B = L - DP
-   for(first=true,i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(first=true,i=0; i<size(); i++) {
+      if(!(flags[i] & OK)) continue;        // skip bad data
 
-      double P1 = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-      double P2 = spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]];
-      double L1 = spdvector[i].data[indexForLabel["L1"]] - dLB10;
-      double L2 = spdvector[i].data[indexForLabel["L2"]] - dLB20;
+      double P1 = dataP1[i];
+      double P2 = dataP2[i];
+      double L1 = dataL1[i] - dLB10;
+      double L2 = dataL2[i] - dLB20;
 
       if(first) {                   // remove the large numerical range
          LB10 = long(L1-P1/wl1);
@@ -667,25 +683,23 @@ try {
 
    if(!debiasPH && !smoothPR) return;
 
-   for(i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(i=0; i<size(); i++) {
+      if(!(flags[i] & OK)) continue;        // skip bad data
 
       // replace the pseudorange with the smoothed pseudorange
       if(smoothPR) {
          // compute the debiased phase, with real bias
-         dbL1 = spdvector[i].data[indexForLabel["L1"]] - RB1;
-         dbL2 = spdvector[i].data[indexForLabel["L2"]] - RB2;
+         dbL1 = dataL1[i] - RB1;
+         dbL2 = dataL2[i] - RB2;
 
-         spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]]
-                                                = D11*wl1*dbL1 + D12*wl2*dbL2;
-         spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]]
-                                                = D21*wl1*dbL1 + D22*wl2*dbL2;
+         dataP1[i] = D11*wl1*dbL1 + D12*wl2*dbL2;
+         dataP2[i] = D21*wl1*dbL1 + D22*wl2*dbL2;
       }
 
       // replace the phase with the debiased phase, with integer bias (cycles)
       if(debiasPH) {
-         spdvector[i].data[indexForLabel["L1"]] -= LB1;
-         spdvector[i].data[indexForLabel["L2"]] -= LB2;
+         dataL1[i] -= LB1;
+         dataL2[i] -= LB2;
       }
    }
 }
@@ -696,7 +710,7 @@ catch(Exception& e) { GPSTK_RETHROW(e); }
 // NB may be used as rvalue or lvalue
 double& SatPass::data(unsigned int i, string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in data() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -705,21 +719,21 @@ double& SatPass::data(unsigned int i, string type) throw(Exception)
       Exception e("Invalid obs type in data() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].data[it->second];
+   return obsdata[it->second][i];
 }
 
 double& SatPass::timeoffset(unsigned int i) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in timeoffset() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].toffset;
+   return toffsets[i];
 }
 
 unsigned short& SatPass::LLI(unsigned int i, string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in LLI() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -728,12 +742,12 @@ unsigned short& SatPass::LLI(unsigned int i, string type) throw(Exception)
       Exception e("Invalid obs type in LLI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].lli[it->second];
+   return obslli[it->second][i];
 }
 
 unsigned short& SatPass::SSI(unsigned int i, string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in SSI() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -742,85 +756,142 @@ unsigned short& SatPass::SSI(unsigned int i, string type) throw(Exception)
       Exception e("Invalid obs type in SSI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].ssi[it->second];
+   return obsssi[it->second][i];
+}
+
+double& SatPass::data(unsigned int i, unsigned int ot) throw(Exception)
+{
+   if(i >= size()) {
+      Exception e("Invalid index in data() " + asString(i));
+      GPSTK_THROW(e);
+   }
+   if(ot >= obsdata.size()) {
+      Exception e("Invalid obs type index in data() " + asString(ot));
+      GPSTK_THROW(e);
+   }
+   return obsdata[ot][i];
+}
+
+unsigned short& SatPass::LLI(unsigned int i, unsigned int ot) throw(Exception)
+{
+   if(i >= size()) {
+      Exception e("Invalid index in LLI() " + asString(i));
+      GPSTK_THROW(e);
+   }
+   if(ot >= obslli.size()) {
+      Exception e("Invalid obs type index in LLI() " + asString(ot));
+      GPSTK_THROW(e);
+   }
+   return obslli[ot][i];
+}
+
+unsigned short& SatPass::SSI(unsigned int i, unsigned int ot) throw(Exception)
+{
+   if(i >= size()) {
+      Exception e("Invalid index in SSI() " + asString(i));
+      GPSTK_THROW(e);
+   }
+   if(ot >= obsssi.size()) {
+      Exception e("Invalid obs type index in SSI() " + asString(ot));
+      GPSTK_THROW(e);
+   }
+   return obsssi[ot][i];
+}
+
+vector<double>& SatPass::dataColumn(unsigned int ot) throw(Exception)
+{
+   if(ot >= obsdata.size()) {
+      Exception e("Invalid obs type index in dataColumn() " + asString(ot));
+      GPSTK_THROW(e);
+   }
+   return obsdata[ot];
+}
+
+const vector<double>& SatPass::dataColumn(unsigned int ot) const throw(Exception)
+{
+   if(ot >= obsdata.size()) {
+      Exception e("Invalid obs type index in dataColumn() " + asString(ot));
+      GPSTK_THROW(e);
+   }
+   return obsdata[ot];
 }
 
 // ---------------------------------- set routines ----------------------------
 void SatPass::setFlag(unsigned int i, unsigned short f) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in setFlag() " + asString(i));
       GPSTK_THROW(e);
    }
 
-   if(spdvector[i].flag != BAD && f == BAD) ngood--;
-   if(spdvector[i].flag == BAD && f != BAD) ngood++;
-   spdvector[i].flag = f;
+   if(flags[i] != BAD && f == BAD) ngood--;
+   if(flags[i] == BAD && f != BAD) ngood++;
+   flags[i] = f;
 }
 
 // set the userflag at one index to inflag;
 // NB SatPass does nothing w/ this member except setUserFlag() and getUserFlag();
 void SatPass::setUserFlag(unsigned int i, unsigned int f) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in setUserFlag() " + asString(i));
       GPSTK_THROW(e);
    }
 
-   spdvector[i].userflag = f;
+   userflags[i] = f;
 }
 
 // ---------------------------------- get routines ----------------------------
 // get value of flag at one index
 unsigned short SatPass::getFlag(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in getFlag() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].flag;
+   return flags[i];
 }
 
 // get the userflag at one index
 // NB SatPass does nothing w/ this member except setUserFlag() and getUserFlag();
 unsigned int SatPass::getUserFlag(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in getUserFlag() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].userflag;
+   return userflags[i];
 }
 
 // get one element of the count array of this SatPass
 unsigned int SatPass::getCount(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("invalid in getCount() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].ndt;
+   return counts[i];
 }
 
 // @return the earliest time (full, including toffset) in this SatPass data
 Epoch SatPass::getFirstTime(void) const throw() { return time(0); }
 
 // @return the latest time (full, including toffset) in this SatPass data
-Epoch SatPass::getLastTime(void) const throw() { return time(spdvector.size()-1); }
+Epoch SatPass::getLastTime(void) const throw() { return time(size()-1); }
 
 // these allow you to get e.g. P1 or C1. NB return double not double& as above: rvalue
 double SatPass::data(unsigned int i, string type1, string type2) const
    throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in data() " + asString(i));
       GPSTK_THROW(e);
    }
    map<string, unsigned int>::const_iterator it;
    if((it = indexForLabel.find(type1)) != indexForLabel.end())
-      return spdvector[i].data[it->second];
+      return obsdata[it->second][i];
    else if((it = indexForLabel.find(type2)) != indexForLabel.end())
-      return spdvector[i].data[it->second];
+      return obsdata[it->second][i];
    else {
       Exception e("Invalid obs types in data() " + type1 + " " + type2);
       GPSTK_THROW(e);
@@ -830,15 +901,15 @@ double SatPass::data(unsigned int i, string type1, string type2) const
 unsigned short SatPass::LLI(unsigned int i, string type1, string type2)
    throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in LLI() " + asString(i));
       GPSTK_THROW(e);
    }
    map<string, unsigned int>::const_iterator it;
    if((it = indexForLabel.find(type1)) != indexForLabel.end())
-      return spdvector[i].lli[it->second];
+      return obslli[it->second][i];
    else if((it = indexForLabel.find(type2)) != indexForLabel.end())
-      return spdvector[i].lli[it->second];
+      return obslli[it->second][i];
    else {
       Exception e("Invalid obs types in LLI() " + type1 + " " + type2);
       GPSTK_THROW(e);
@@ -848,15 +919,15 @@ unsigned short SatPass::LLI(unsigned int i, string type1, string type2)
 unsigned short SatPass::SSI(unsigned int i, string type1, string type2)
    throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in SSI() " + asString(i));
       GPSTK_THROW(e);
    }
    map<string, unsigned int>::const_iterator it;
    if((it = indexForLabel.find(type1)) == indexForLabel.end())
-      return spdvector[i].ssi[it->second];
+      return obsssi[it->second][i];
    else if((it = indexForLabel.find(type2)) == indexForLabel.end())
-      return spdvector[i].ssi[it->second];
+      return obsssi[it->second][i];
    else {
       Exception e("Invalid obs types in SSI() " + type1 + " " + type2);
       GPSTK_THROW(e);
@@ -867,12 +938,12 @@ unsigned short SatPass::SSI(unsigned int i, string type1, string type2)
 // return the time corresponding to the given index in the data array
 Epoch SatPass::time(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= size()) {
       Exception e("Invalid index in time() " + asString(i));
       GPSTK_THROW(e);
    }
    // computing toff first is necessary to avoid a rare bug in Epoch..
-   double toff = spdvector[i].ndt * dt + spdvector[i].toffset;
+   double toff = counts[i] * dt + toffsets[i];
    return (firstTime + toff);
 }
 
@@ -893,21 +964,21 @@ bool SatPass::includesTime(const Epoch& tt) const throw()
 // return true if successful.
 bool SatPass::split(int N, SatPass &newSP) {
 try {
-   int i,j,n,oldgood,ilast;
+   int i,j,k,n,oldgood,ilast;
    Epoch tt;
 
-   newSP = SatPass(sat, dt);                       // create new SatPass
+   newSP = SatPass(sat, dt, getObsTypes());        // create new SatPass
    newSP.Status = Status;
    newSP.indexForLabel = indexForLabel;
    newSP.labelForIndex = labelForIndex;
 
    oldgood = ngood;
    ngood = ilast = 0;
-   for(i=0; i<spdvector.size(); i++) {             // loop over all data
-      n = spdvector[i].ndt;
+   for(i=0; i<size(); i++) {             // loop over all data
+      n = counts[i];
       tt = time(i);
       if(n < N) {                                     // keep in this SatPass
-         if(spdvector[i].flag != BAD) ngood++;
+         if(flags[i] != BAD) ngood++;
          ilast = i;
       }
       else {                                          // copy out data into new SP
@@ -916,14 +987,20 @@ try {
             newSP.firstTime = newSP.lastTime = tt;
          }
          j = newSP.countForTime(tt);
-         spdvector[i].ndt = j;
-         spdvector[i].toffset = tt - newSP.firstTime - j*dt;
-         newSP.spdvector.push_back(spdvector[i]);
+         newSP.flags.push_back(flags[i]);
+         newSP.userflags.push_back(userflags[i]);
+         newSP.counts.push_back(j);
+         newSP.toffsets.push_back(tt - newSP.firstTime - j*dt);
+         for(k=0; k<obsdata.size(); k++) {
+            newSP.obsdata[k].push_back(obsdata[k][i]);
+            newSP.obslli[k].push_back(obslli[k][i]);
+            newSP.obsssi[k].push_back(obsssi[k][i]);
+         }
       }
    }
 
    // now trim this SatPass
-   spdvector.resize(ilast+1);
+   truncate(ilast+1);
    lastTime = time(ilast);
 
    return true;
@@ -935,7 +1012,7 @@ void SatPass::decimate(const int N, Epoch refTime) throw(Exception)
 {
 try {
    if(N <= 1) return;
-   if(spdvector.size() < N) { dt = N*dt; return; }
+   if(size() < N) { dt = N*dt; return; }
    if(refTime == CommonTime::BEGINNING_OF_TIME) refTime = firstTime;
 
    // find new firstTime = time(nstart)
@@ -947,27 +1024,27 @@ try {
    // decimate
    ngood = 0;
    Epoch newfirstTime, tt;
-   for(j=0,i=0; i<spdvector.size(); i++) {
-      if(spdvector[i].ndt % N != nstart) continue;
+   for(j=0,i=0; i<size(); i++) {
+      if(counts[i] % N != nstart) continue;
       lastTime = time(i);
       if(j==0) {
          newfirstTime = time(i);
-         spdvector[i].toffset = 0.0;
-         spdvector[i].ndt = 0;
+         toffsets[i] = 0.0;
+         counts[i] = 0;
       }
       else {
          tt = time(i);
-         spdvector[i].ndt = int(0.5+(tt-newfirstTime)/(N*dt));
-         spdvector[i].toffset = tt - newfirstTime - spdvector[i].ndt * N * dt;
+         counts[i] = int(0.5+(tt-newfirstTime)/(N*dt));
+         toffsets[i] = tt - newfirstTime - counts[i] * N * dt;
       }
-      spdvector[j] = spdvector[i];
-      if(spdvector[j].flag != BAD) ngood++;
+      copyData(j,i);
+      if(flags[j] != BAD) ngood++;
       j++;
    }
 
    dt = N*dt;
    firstTime = newfirstTime;
-   spdvector.resize(j); // trim
+   truncate(j); // trim
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
@@ -985,24 +1062,24 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
    os << " gap(pts)";
    os << endl;
 
-   for(i=0; i<spdvector.size(); i++) {
+   for(i=0; i<size(); i++) {
       tt = time(i);
       os << msg1
          << " " << setw(3) << i
          << " " << sat
-         << " " << setw(3) << spdvector[i].ndt
-         << " " << setw(2) << spdvector[i].flag
+         << " " << setw(3) << counts[i]
+         << " " << setw(2) << flags[i]
          << " " << printTime(tt,SatPass::outFormat)
          << fixed << setprecision(6)
-         << " " << setw(9) << spdvector[i].toffset
+         << " " << setw(9) << toffsets[i]
          << setprecision(3);
       for(j=0; j<indexForLabel.size(); j++)
-         os << " " << setw(13) << spdvector[i].data[j]
-            << " " << spdvector[i].lli[j]
-            << " " << spdvector[i].ssi[j];
-      if(i==0) last = spdvector[i].ndt;
-      if(spdvector[i].ndt - last > 1) os << " " << spdvector[i].ndt-last;
-      last = spdvector[i].ndt;
+         os << " " << setw(13) << obsdata[j][i]
+            << " " << obslli[j][i]
+            << " " << obsssi[j][i];
+      if(i==0) last = counts[i];
+      if(counts[i] - last > 1) os << " " << counts[i]-last;
+      last = counts[i];
       os << endl;
    }
 }
@@ -1010,7 +1087,7 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
 // output SatPass to ostream
 ostream& operator<<(ostream& os, SatPass& sp )
 {
-   os << setw(4) << sp.spdvector.size()
+   os << setw(4) << sp.size()
       << " " << sp.sat
       << " " << setw(4) << sp.ngood
       << " " << setw(2) << sp.Status
@@ -1022,14 +1099,14 @@ ostream& operator<<(ostream& os, SatPass& sp )
    return os;
 }
 
-// ---------------------------- private SatPassData functions --------------------
-// add data to the arrays at timetag tt (private)
+// ---------------------------- private functions ----------------------------------
+// add an epoch of zero data at timetag tt (private)
 // return >=0 ok (index of added data), -1 gap, -2 timetag out of order
-int SatPass::push_back(const Epoch tt, SatPassData& spd) throw()
+int SatPass::push_back(const Epoch tt, const unsigned short flag) throw()
 {
    unsigned int n;
       // if this is the first point, save first time
-   if(spdvector.size() == 0) {
+   if(size() == 0) {
       firstTime = lastTime = tt;
       n = 0;
    }
@@ -1038,30 +1115,53 @@ int SatPass::push_back(const Epoch tt, SatPassData& spd) throw()
          // compute count for this point - prev line means n is >= 0
       n = countForTime(tt);
          // test size of gap
-      if( (n - spdvector[spdvector.size()-1].ndt) * dt > maxGap)
+      if( (n - counts[size()-1]) * dt > maxGap)
          return -1;
       lastTime = tt;
    }
 
       // add it
-   //spd.flag = 1;
    // ngood is useless unless it's changed whenever any flag is...
-   if(spd.flag != SatPass::BAD) ngood++;
-   spd.ndt = n;
-   spd.toffset = tt - firstTime - n*dt;
-   spdvector.push_back(spd);
-   return (spdvector.size()-1);
+   if(flag != SatPass::BAD) ngood++;
+   flags.push_back(flag);
+   userflags.push_back(0);
+   counts.push_back(n);
+   toffsets.push_back(tt - firstTime - n*dt);
+   for(unsigned int k=0; k<obsdata.size(); k++) {
+      obsdata[k].push_back(0.0);
+      obslli[k].push_back(0);
+      obsssi[k].push_back(0);
+   }
+   return (size()-1);
 }
 
-// get one element of the data array of this SatPass (private)
-struct SatPass::SatPassData SatPass::getData(unsigned int i) const
-   throw(Exception)
+// remove all data at index n and after (private)
+void SatPass::truncate(const unsigned int n) throw()
 {
-   if(i >= spdvector.size()) {         // TD ?? keep this - its private
-      Exception e("invalid in getData() " + asString(i));
-      GPSTK_THROW(e);
+   if(n >= size()) return;
+   flags.resize(n);
+   userflags.resize(n);
+   counts.resize(n);
+   toffsets.resize(n);
+   for(unsigned int k=0; k<obsdata.size(); k++) {
+      obsdata[k].resize(n);
+      obslli[k].resize(n);
+      obsssi[k].resize(n);
+   }
+}
+
+// copy all the data at index j to index i (private)
+void SatPass::copyData(const unsigned int i, const unsigned int j) throw()
+{
+   flags[i] = flags[j];
+   userflags[i] = userflags[j];
+   counts[i] = counts[j];
+   toffsets[i] = toffsets[j];
+   for(unsigned int k=0; k<obsdata.size(); k++) {
+      obsdata[k][i] = obsdata[k][j];
+      obslli[k][i] = obslli[k][j];
+      obsssi[k][i] = obsssi[k][j];
    }
-   return spdvector[i];
 }
 
 }  // end namespace gpstk
@@ -58,65 +58,16 @@ namespace gpstk {
 /// class SatPass holds all range and phase data for a full satellite pass.
 /// Constructed and filled by the calling program, it is used to pass data into
 /// and out of the GPSTK discontinuity corrector.
+/// The data is stored by column, one contiguous array per obs type, rather than
+/// by epoch; loops over the data should get the index of each obs type once,
+/// using getObsIndex(), and then use the routines that take that index, or the
+/// whole column (dataColumn()), rather than those that take the obs type string.
 /// NB. if objects of this class are combined together, e.g. in STL containers
 /// such as list or vector, they MUST be consistently defined, namely the number
 /// of observation types must be the same, otherwise a nasty segmentation fault
 /// can occur when building the STL container.
 class SatPass {
 protected:
-   // --------------- SatPassData data structure for internal use only ----------
-   //
-   struct SatPassData {
-      // member data ----------------------------------
-      /// a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
-      /// then reset by other processing.
-      unsigned short flag;
-      /// a flag for arbitrary use by the user; SatPass ONLY has set/getUserFlag()
-      unsigned int userflag;
-      /// time 'count' : time of data = FirstTime + ndt * dt + offset
-      unsigned int ndt;
-      /// offset of time from integer number * dt since FirstTime.
-      double toffset;
-      /// data for one epoch of RINEX data
-      std::vector<double> data;
-      /// loss-of-lock and signal-strength indicators (from RINEX) for data
-      /// parallel to data vector
-      std::vector<unsigned short> lli,ssi;
-
-      // private member functions ---------------------
-
-      /// constructor
-      /// @param n the number of data types to be stored, default 4
-      SatPassData(unsigned short n=4)
-         : flag(SatPass::OK), userflag(0), ndt(0), toffset(0.0)
-      {
-         data = std::vector<double>(n,0.0);
-         lli = std::vector<unsigned short>(n,0);
-         ssi = std::vector<unsigned short>(n,0);
-      }
-
-      // d'tor, copy c'tor and operator= are built by compiler,
-      // but operator= will not work correctly, b/c a deep copy is needed.
-      SatPassData& operator=(const SatPassData& right) throw()
-      {
-         if(&right != this) {
-            flag = right.flag;
-            userflag = right.userflag;
-            ndt = right.ndt;
-            toffset = right.toffset;
-            data.resize(right.data.size());
-            lli.resize(right.lli.size());
-            ssi.resize(right.ssi.size());
-            int i;
-            for(i=0; i<right.data.size(); i++) data[i] = right.data[i];
-            for(i=0; i<right.lli.size(); i++) lli[i] = right.lli[i];
-            for(i=0; i<right.ssi.size(); i++) ssi[i] = right.ssi[i];
-         }
-
-         return *this;
-      }
-   }; // end struct SatPassData
-
    // --------------- private member data -----------------------------
    /// Status flag for use exclusively by the caller. It is set to 0
    /// by the constructors, but otherwise ignored by class SatPass and
@@ -129,7 +80,8 @@ protected:
    /// Satellite identifier for this data.
    RinexSatID sat;
 
-   /// STL map relating strings identifying obs types with indexes in SatPassData
+   /// STL map relating strings identifying obs types with indexes in the obs type
+   /// columns obsdata, obslli and obsssi
    std::map<std::string,unsigned int> indexForLabel;
    std::map<unsigned int,std::string> labelForIndex;
 
@@ -142,22 +94,41 @@ protected:
    /// number of timetags with good data in the data arrays.
    unsigned int ngood;
 
-   /// ALL data in the pass, stored in SatPassData objects, in time order
-   std::vector<SatPassData> spdvector;
+   /// ALL data in the pass, in time order, stored by column: one array for each
+   /// of flag, userflag, count and time offset, and one array per obs type for
+   /// each of data, LLI and SSI. All the arrays have the same length, size().
+   /// Obs type columns are indexed as in indexForLabel (cf. getObsIndex()).
+
+   /// flag (cf. SatPass::BAD, etc.) that is set to OK at creation, then reset by
+   /// other processing.
+   std::vector<unsigned short> flags;
+   /// flag for arbitrary use by the user; SatPass ONLY has set/getUserFlag()
+   std::vector<unsigned int> userflags;
+   /// time 'count' : time of data = firstTime + count * dt + toffset
+   std::vector<unsigned int> counts;
+   /// offset of time from integer number * dt since firstTime.
+   std::vector<double> toffsets;
+   /// data, loss-of-lock and signal-strength indicators (from RINEX),
+   /// [obs type index][index]
+   std::vector< std::vector<double> > obsdata;
+   std::vector< std::vector<unsigned short> > obslli,obsssi;
 
    // --------------- private member functions ------------------------
 
    /// called by constructors to initialize - see doc for them.
    void init(RinexSatID sat, double dt, std::vector<std::string> obstypes) throw();
 
-   /// add a complete SatPassData at time tt
+   /// add an epoch at time tt, with flag, and with zero data, LLI and SSI
    /// @return n>=0 if data was added successfully, n is the index of the new data
    ///            -1 if a gap is found (no data is added),
    ///            -2 if time tag is out of order (no data is added)
-   int push_back(const Epoch tt, SatPassData& spd) throw();
+   int push_back(const Epoch tt, const unsigned short flag) throw();
 
-   /// get a complete SatPassData at count i
-   struct SatPassData getData(unsigned int i) const throw(Exception);
+   /// remove all data at index n and after
+   void truncate(const unsigned int n) throw();
+
+   /// copy all the data at index j to index i
+   void copyData(const unsigned int i, const unsigned int j) throw();
 
 public:
    // ------------------ friends --------------------------------------
@@ -304,6 +275,43 @@ public:
    /// @return the SSI of the given type at the given index
    unsigned short& SSI(unsigned int i, std::string type) throw(Exception);
 
+   /// Get the index of an obs type, for use in the data(), LLI(), SSI() and
+   /// dataColumn() routines that take an index rather than a string; these do
+   /// not search the obs types on every call, and should be used in loops.
+   /// @param  type observation type (e.g. "L1")
+   /// @return the index of the obs type, or -1 if it is not stored
+   int getObsIndex(const std::string& type) const throw()
+   {
+      std::map<std::string,unsigned int>::const_iterator it(indexForLabel.find(type));
+      return (it == indexForLabel.end() ? -1 : int(it->second));
+   }
+
+   /// Access the data for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  ot   index of the observation type (cf. getObsIndex())
+   /// @return the data of the given type at the given index
+   double& data(unsigned int i, unsigned int ot) throw(Exception);
+
+   /// Access the LLI for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  ot   index of the observation type (cf. getObsIndex())
+   /// @return the LLI of the given type at the given index
+   unsigned short& LLI(unsigned int i, unsigned int ot) throw(Exception);
+
+   /// Access the SSI for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  ot   index of the observation type (cf. getObsIndex())
+   /// @return the SSI of the given type at the given index
+   unsigned short& SSI(unsigned int i, unsigned int ot) throw(Exception);
+
+   /// Access all the data for one obs type, in time order; the vector is parallel
+   /// to getFlags(), and its size is size(). Elements may be changed, but not the
+   /// size, and the reference is valid only until data is added or removed.
+   /// @param  ot   index of the observation type (cf. getObsIndex())
+   /// @return the data of the given type
+   std::vector<double>& dataColumn(unsigned int ot) throw(Exception);
+   const std::vector<double>& dataColumn(unsigned int ot) const throw(Exception);
+
    // -------------------------------- set only --------------------------------
    /// change the maximum time gap (in seconds) allowed within any SatPass
    /// @param gap  The maximum time gap (in seconds) allowed within any SatPass
@@ -350,6 +358,10 @@ public:
    /// @return the flag for the given index
    unsigned short getFlag(unsigned int i) const throw(Exception);
 
+   /// get all the flags, in time order; cf. dataColumn().
+   /// @return the flags of this SatPass, r-value only; use setFlag() to change them
+   const std::vector<unsigned short>& getFlags(void) const throw() { return flags; }
+
    /// get the userflag at one index
    /// NB SatPass does nothing w/ this member except setUserFlag() and getUserFlag();
    /// @param  i    index of the data of interest
@@ -364,7 +376,7 @@ public:
 
    /// @return the earliest time of good data in this SatPass data
    Epoch getFirstGoodTime(void) const throw() {
-      for(int j=0; j<spdvector.size(); j++) if(spdvector[j].flag & OK) {
+      for(int j=0; j<flags.size(); j++) if(flags[j] & OK) {
          return time(j);
       }
       return CommonTime::END_OF_TIME;
@@ -372,7 +384,7 @@ public:
 
    /// @return the latest time of good data in this SatPass data
    Epoch getLastGoodTime(void) const throw() {
-      for(int j=spdvector.size()-1; j>=0; j--) if(spdvector[j].flag & OK) {
+      for(int j=flags.size()-1; j>=0; j--) if(flags[j] & OK) {
          return time(j);
       }
       return CommonTime::BEGINNING_OF_TIME;
@@ -392,7 +404,7 @@ public:
 
    /// get the size of (the arrays in) this SatPass
    /// @return the size of the data array in this object
-   unsigned int size(void) const throw() { return spdvector.size(); }
+   unsigned int size(void) const throw() { return flags.size(); }
 
    /// get one element of the count array of this SatPass
    /// @param  i   index of the data of interest
@@ -441,7 +453,7 @@ public:
 
    // -------------------------------- utils ---------------------------------
    /// clear the data (but not the obs types) from the arrays
-   void clear(void) throw() { spdvector.clear(); }
+   void clear(void) throw() { truncate(0); }
 
    /// compute the timetag associated with index i in the data array
    /// @param  i   index of the data of interest
@@ -455,8 +467,8 @@ public:
    {
       int count = countForTime(tt);
       if(count < 0) return -1;
-      for(int i=0; i<spdvector.size(); i++)
-         if(count == spdvector[i].ndt) return i;
+      for(int i=0; i<counts.size(); i++)
+         if(count == counts[i]) return i;
       return -1;
    }
 
@@ -117,7 +117,7 @@ void SatPassIterator::reset(bool rev, bool dbug) throw()
          // define latest epoch when time reversed
          if(timeReverse && currentN == 0)
             currentN = int((SPList[i].firstTime - FirstTime)/DT + 0.5)
-                                 + SPList[i].spdvector[SPList[i].size()-1].ndt;
+                                 + SPList[i].counts[SPList[i].size()-1];
 
          // (re)build the maps
          if(listIndex.find(SPList[i].sat) == listIndex.end()) {
@@ -195,7 +195,7 @@ int SatPassIterator::next(map<unsigned int, unsigned int>& indexMap) throw(Excep
             continue;
          }
 
-         if(countOffset[sat] + SPList[i].spdvector[j].ndt == currentN) {
+         if(countOffset[sat] + SPList[i].counts[j] == currentN) {
             // found active sat at this count - add to map
             nextIndexMap[i] = j;
             numsvs++;
@@ -204,7 +204,7 @@ int SatPassIterator::next(map<unsigned int, unsigned int>& indexMap) throw(Excep
 
             // increment data index
             if((timeReverse && --j < 0) ||
-               (!timeReverse && ++j == SPList[i].spdvector.size()))
+               (!timeReverse && ++j == SPList[i].size()))
             {
                if(debug) LOG(INFO) << " This pass for sat " << sat << " is done ...";
                indexStatus[i] = 1;
@@ -307,7 +307,7 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
       //   << " at index " << i << " and time " << SPList[i].time(j);
 
       bool found = false;
-      bool flag = (SPList[i].spdvector[j].flag != SatPass::BAD);
+      bool flag = (SPList[i].flags[j] != SatPass::BAD);
       for(int k=0; k<SPList[i].labelForIndex.size(); k++) {
          RinexObsType ot;
          ot = RinexObsHeader::convertObsType(SPList[i].labelForIndex[k]);
@@ -317,12 +317,12 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
          else {
             found = true;
             // NO some obs may be zero b/c they are not collected (e.g. C2) -> bad
-            //robs.obs[sat][ot].data = flag ? SPList[i].spdvector[j].data[k] : 0.;
-            //robs.obs[sat][ot].lli  = flag ? SPList[i].spdvector[j].lli[k] : 0;
-            //robs.obs[sat][ot].ssi  = flag ? SPList[i].spdvector[j].ssi[k] : 0;
-            robs.obs[sat][ot].data = SPList[i].spdvector[j].data[k];
-            robs.obs[sat][ot].lli  = SPList[i].spdvector[j].lli[k];
-            robs.obs[sat][ot].ssi  = SPList[i].spdvector[j].ssi[k];
+            //robs.obs[sat][ot].data = flag ? SPList[i].obsdata[k][j] : 0.;
+            //robs.obs[sat][ot].lli  = flag ? SPList[i].obslli[k][j] : 0;
+            //robs.obs[sat][ot].ssi  = flag ? SPList[i].obsssi[k][j] : 0;
+            robs.obs[sat][ot].data = SPList[i].obsdata[k][j];
+            robs.obs[sat][ot].lli  = SPList[i].obslli[k][j];
+            robs.obs[sat][ot].ssi  = SPList[i].obsssi[k][j];
          }
       }
       if(found) robs.numSvs++;
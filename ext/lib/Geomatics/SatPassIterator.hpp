@@ -146,7 +146,7 @@ private:
    /// index of the current object in the list for this satellite
    std::map<RinexSatID,int> listIndex;
 
-   /// index of the data vector (spdvector) of the current object in the list
+   /// index of the data arrays of the current object in the list
    /// for this satellite
    std::map<RinexSatID,int> dataIndex;
 
@@ -162,7 +162,7 @@ private:
    std::vector<SatPass>& SPList;
 
    /// map of indexes i,j, created by next(), such that data returned by next() is
-   /// found at SatPassList[i].spdvector[j] where map[i]=j.
+   /// found at index j of SatPassList[i] where map[i]=j.
    std::map<unsigned int,unsigned int> nextIndexMap;
 
 }; // end class SatPassIterator
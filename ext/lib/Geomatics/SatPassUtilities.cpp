@@ -100,11 +100,17 @@ void Dump(vector<SatPass>& SatPassList, ostream& os, bool rev, bool dbug)
                << " " << SatPassList[ii].getFlag(jj);
             os << fixed << setprecision(3);
 
-            for(size_t i=0; i<obstypes.size(); i++)
+            for(size_t i=0; i<obstypes.size(); i++) {
+               int k(SatPassList[ii].getObsIndex(obstypes[i]));
+               if(k == -1) {
+                  Exception e("Invalid obs type in Dump() " + obstypes[i]);
+                  GPSTK_THROW(e);
+               }
                os << " " << obstypes[i]
-                  << " " << setw(13) << SatPassList[ii].data(jj,obstypes[i])
-                  << " " << SatPassList[ii].LLI(jj,obstypes[i])
-                  << " " << SatPassList[ii].SSI(jj,obstypes[i]);
+                  << " " << setw(13) << SatPassList[ii].data(jj,k)
+                  << " " << SatPassList[ii].LLI(jj,k)
+                  << " " << SatPassList[ii].SSI(jj,k);
+            }
             os << endl;
 
          }  // end loop over indexMap
@@ -142,12 +148,10 @@ try {
          ii = kt->first; jj = kt->second;
          SatID sat = SPList[ii].getSat();
          vector<string> ots = SPList[ii].getObsTypes();
-         // loop over obs types in this SP
+         // loop over obs types in this SP; i is also the index in SP
          for(i=0; i<ots.size(); i++) {
-            if(SPList[ii].hasType(ots[i])) {
-               data = SPList[ii].data(jj,ots[i]);
-               msh.add(ttag, sat, ots[i], data);
-            }
+            data = SPList[ii].data(jj,i);
+            msh.add(ttag, sat, ots[i], data);
          }
       }
    }
@@ -190,16 +194,14 @@ try {
          ii = kt->first; jj = kt->second;
          SatID sat = SPList[ii].getSat();
          vector<string> ots = SPList[ii].getObsTypes();
-         // loop over obs types in this SP
+         // loop over obs types in this SP; i is also the index in SP
          for(i=0; i<ots.size(); i++) {
-            if(SPList[ii].hasType(ots[i])) {
-               data = SPList[ii].data(jj,ots[i]);
-               // tricky - don't keep correcting ttag
-               ttagdum = static_cast<CommonTime>(ttag);
-               msh.fix(ttagdum, sat, ots[i], data);
-               SPList[ii].data(jj,ots[i]) = data;
-               if(++n == 1) deltfix = (ttagdum-ttag);    // only once
-            }
+            data = SPList[ii].data(jj,i);
+            // tricky - don't keep correcting ttag
+            ttagdum = static_cast<CommonTime>(ttag);
+            msh.fix(ttagdum, sat, ots[i], data);
+            SPList[ii].data(jj,i) = data;
+            if(++n == 1) deltfix = (ttagdum-ttag);    // only once
          }
          // correct time tag for this SP
          if(n > 0 && deltfix != 0.0)
@@ -574,13 +576,13 @@ int SatPassToRinex2File(string filename,
             if(SPList[ii].status() == -1) continue;
             SatID sat = SPList[ii].getSat();
             RinexObsData::RinexObsTypeMap rotm;
+            const bool good(SPList[ii].getFlag(jj) != SatPass::BAD);
             for(ngood=0,j=0; j<header.obsTypeList.size(); j++) {
                RinexDatum rd;
+               int k(good ? SPList[ii].getObsIndex(obstypes[j]) : -1);
 
-               if(SPList[ii].getFlag(jj) != SatPass::BAD &&
-                  SPList[ii].hasType(obstypes[j]))
-               {
-                  rd.data = SPList[ii].data(jj,obstypes[j]);
+               if(k != -1) {
+                  rd.data = SPList[ii].data(jj,k);
                   ngood++;
                }
                // else rd is all zeros
@@ -702,13 +704,13 @@ int SatPassToRinex3File(string filename,
                obstypes = SPList[ii].getObstypes();
 
             vector<RinexDatum> vRD;
+            const bool good(SPList[ii].getFlag(jj) != SatPass::BAD);
             for(ngood=0,j=0; j<obstypes.size(); j++) {
                RinexDatum rd;
+               int k(good ? SPList[ii].getObsIndex(obstypes[j]) : -1);
 
-               if(SPList[ii].getFlag(jj) != SatPass::BAD &&
-                  SPList[ii].hasType(obstypes[j]))
-               {
-                  rd.data = SPList[ii].data(jj,obstypes[j]);
+               if(k != -1) {
+                  rd.data = SPList[ii].data(jj,k);
                   //rd.ssi = ?;
                   //rd.lli = ?;
                   ngood++;
@@ -0,0 +1,347 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SlidingStats.hpp
+/// One- and two-sample statistics for a window that slides along a series, where
+/// each step adds the newest datum and subtracts the oldest. The sums are kept
+/// relative to a reference value K near the average of the window (so that the
+/// variance does not come from the difference of two large numbers); K starts at
+/// the first datum and is moved to the average whenever the window has wandered
+/// farther from it than the spread of the data. The sums are accumulated with
+/// Neumaier's compensated summation, so that the roundoff of the many Add()s and
+/// Subtract()s over a long series does not accumulate in the window statistics.
+/// Each Add() and Subtract() is O(1), and the results agree with those of
+/// gpstk::Stats and gpstk::TwoSampleStats on the same window, to roundoff.
+/// These are used by the statistical filters WindowFilter, FirstDiffFilter and
+/// FDiffFilter.
+
+#ifndef SLIDING_STATS_INCLUDE
+#define SLIDING_STATS_INCLUDE
+
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+namespace gpstk
+{
+   /// A sum, accumulated with Neumaier's compensation (improved Kahan summation),
+   /// so that the error does not grow with the number of terms.
+   template <class T> class CompensatedSum
+   {
+   public:
+      /// constructor
+      CompensatedSum() : sum(T()), comp(T()) { }
+
+      /// reset to zero
+      inline void Reset(void) { sum = comp = T(); }
+
+      /// add a term to the sum
+      inline void Add(const T& x)
+      {
+         T t(sum + x);
+         if(::fabs(sum) >= ::fabs(x))
+            comp += (sum - t) + x;
+         else
+            comp += (x - t) + sum;
+         sum = t;
+      }
+
+      /// return the sum
+      inline T Value(void) const { return sum + comp; }
+
+   private:
+      T sum;      ///< the running sum
+      T comp;     ///< the running compensation, the roundoff lost from sum
+   }; // end class CompensatedSum
+
+   // forward declaration
+   template <class T> class SlidingTwoSampleStats;
+
+   /// Conventional statistics of one sample in a sliding window; cf. gpstk::Stats.
+   /// NB. Subtract() assumes that the sample was previously added.
+   template <class T> class SlidingStats
+   {
+   public:
+      /// constructor
+      SlidingStats() { Reset(); }
+
+      /// reset, i.e. ignore earlier data and restart sampling
+      inline void Reset(void)
+      {
+         n = 0;
+         K = T();
+         sum.Reset();
+         sum2.Reset();
+      }
+
+      /// add a sample to the window
+      inline void Add(const T& x)
+      {
+         addTerm(x);
+         shift();
+      }
+
+      /// remove a sample, that was added earlier, from the window
+      inline void Subtract(const T& x)
+      {
+         if(n < 1) return;
+         if(n == 1) { Reset(); return; }
+         subtractTerm(x);
+         shift();
+      }
+
+      /// return the sample size
+      inline unsigned int N(void) const { return n; }
+
+      /// return the average
+      inline T Average(void) const
+      {
+         if(n == 0) return T();
+         return K + sum.Value()/T(n);
+      }
+
+      /// return the variance, normalized with 1/(N-1)
+      inline T Variance(void) const
+      {
+         if(n <= 1) return T();
+         T s(sum.Value());
+         return (sum2.Value() - s*s/T(n))/T(n-1);
+      }
+
+      /// return the standard deviation
+      inline T StdDev(void) const
+      {
+         if(n <= 1) return T();
+         return ::sqrt(Variance());
+      }
+
+      /// Write the stats to a single-line string
+      std::string asString(std::string msg=std::string(), int w=7, int p=4) const
+      {
+         std::ostringstream oss;
+         oss << "stats(sld):" << (msg.empty() ? "" : " "+msg)
+            << " N " << std::setw(w) << N() << std::fixed << std::setprecision(p)
+            << "  Ave " << std::setw(w) << Average()
+            << "  Std " << std::setw(w) << StdDev()
+            << "  Var " << std::setw(w) << Variance();
+         return oss.str();
+      }
+
+   private:
+      friend class SlidingTwoSampleStats<T>;
+
+      /// add x-K to the sums, setting K if the window is empty
+      inline void addTerm(const T& x)
+      {
+         if(n == 0) { Reset(); K = x; }
+         T d(x-K);
+         sum.Add(d);
+         sum2.Add(d*d);
+         n++;
+      }
+
+      /// remove x-K from the sums
+      inline void subtractTerm(const T& x)
+      {
+         T d(x-K);
+         sum.Add(-d);
+         sum2.Add(-d*d);
+         n--;
+      }
+
+      /// if the average is farther from K than the standard deviation, i.e.
+      /// 2*sum^2 > n*sum2, move K to the average and shift the sums to match.
+      /// @return the change in K, or zero
+      inline T shift(void)
+      {
+         if(n == 0) return T();
+         T s(sum.Value()), s2(sum2.Value());
+         if(T(2)*s*s <= T(n)*s2) return T();
+         T newK(K + s/T(n)), d(newK-K);
+         K = newK;
+         sum.Reset();
+         sum.Add(s - T(n)*d);
+         sum2.Reset();
+         sum2.Add(s2 - T(2)*d*s + T(n)*d*d);
+         return d;
+      }
+
+      unsigned int n;         ///< number of samples in the window
+      T K;                    ///< reference value, near the average; sums are of x-K
+      CompensatedSum<T> sum;  ///< sum of x-K
+      CompensatedSum<T> sum2; ///< sum of (x-K)^2
+   }; // end class SlidingStats
+
+   /// Conventional statistics of two samples (x,y) in a sliding window, including
+   /// the best-fit line y = slope*x + intercept; cf. gpstk::TwoSampleStats.
+   /// NB. Subtract() assumes that the sample was previously added.
+   template <class T> class SlidingTwoSampleStats
+   {
+   public:
+      /// constructor
+      SlidingTwoSampleStats() { Reset(); }
+
+      /// reset, i.e. ignore earlier data and restart sampling
+      inline void Reset(void) { SX.Reset(); SY.Reset(); sumxy.Reset(); }
+
+      /// add a sample to the window
+      inline void Add(const T& x, const T& y)
+      {
+         SX.addTerm(x);
+         SY.addTerm(y);
+         if(SX.n == 1) sumxy.Reset();
+         sumxy.Add((x-SX.K)*(y-SY.K));
+         shift();
+      }
+
+      /// remove a sample, that was added earlier, from the window
+      inline void Subtract(const T& x, const T& y)
+      {
+         if(SX.n < 1) return;
+         if(SX.n == 1) { Reset(); return; }
+         sumxy.Add(-(x-SX.K)*(y-SY.K));
+         SX.subtractTerm(x);
+         SY.subtractTerm(y);
+         shift();
+      }
+
+      /// return the sample size
+      inline unsigned int N(void) const { return SX.n; }
+      /// return computed X average
+      inline T AverageX(void) const { return SX.Average(); }
+      /// return computed Y average
+      inline T AverageY(void) const { return SY.Average(); }
+      /// return computed X variance
+      inline T VarianceX(void) const { return SX.Variance(); }
+      /// return computed Y variance
+      inline T VarianceY(void) const { return SY.Variance(); }
+      /// return computed X standard deviation
+      inline T StdDevX(void) const { return SX.StdDev(); }
+      /// return computed Y standard deviation
+      inline T StdDevY(void) const { return SY.StdDev(); }
+
+      /// return slope of best-fit line Y=slope*X + intercept
+      inline T Slope(void) const
+      {
+         if(N() == 0) return T();
+         T sx(SX.sum.Value());
+         T den(SX.sum2.Value() - sx*sx/T(N()));
+         if(den == T()) return T();
+         return Sxy()/den;
+      }
+
+      /// return intercept of best-fit line Y=slope*X + intercept
+      inline T Intercept(void) const
+      {
+         if(N() == 0) return T();
+         return AverageY() - Slope()*AverageX();
+      }
+
+      /// return correlation
+      inline T Correlation(void) const
+      {
+         if(N() <= 1) return T();
+         T den(StdDevX()*StdDevY()*T(N()-1));
+         if(den == T()) return T();
+         return Sxy()/den;
+      }
+
+      /// return conditional variance = (uncertainty y given x)^2
+      inline T VarianceYX(void) const
+      {
+         if(N() <= 2) return T();
+         T corr(Correlation());
+         return VarianceY() * (T(N()-1)/T(N()-2)) * (T(1)-corr*corr);
+      }
+
+      /// return conditional uncertainty = uncertainty y given x
+      inline T SigmaYX(void) const { return ::sqrt(VarianceYX()); }
+
+      /// return the predicted Y at the given X, using Slope and Intercept;
+      /// evaluated about the averages, rather than at x=0, to preserve precision
+      inline T Evaluate(T x) const
+      {
+         if(N() == 0) return T();
+         return AverageY() + Slope()*(x-AverageX());
+      }
+
+      /// Write the stats to a single-line string
+      std::string asString(std::string msg=std::string(), int w=7, int p=4) const
+      {
+         std::ostringstream oss;
+         oss << "stats(sts):" << (msg.empty() ? "" : " "+msg)
+            << " N " << std::setw(w) << N() << std::fixed << std::setprecision(p)
+            << "  AveX " << std::setw(w) << AverageX()
+            << "  AveY " << std::setw(w) << AverageY()
+            << "  Int " << std::setw(w) << Intercept()
+            << "  Slp " << std::setw(w) << Slope()
+            << "  CSig " << std::setw(w) << SigmaYX()
+            << "  Corr " << std::setw(w) << Correlation();
+         return oss.str();
+      }
+
+   private:
+      /// shift the references of x and y, if needed, and the cross sum with them:
+      /// sum (x-Kx-dx)*(y-Ky) = sumxy - dx*sum(y-Ky), and likewise for y
+      inline void shift(void)
+      {
+         T sy(SY.sum.Value()), dx(SX.shift());
+         if(dx != T()) {
+            T sxy(sumxy.Value() - dx*sy);
+            sumxy.Reset();
+            sumxy.Add(sxy);
+         }
+         T sx(SX.sum.Value()), dy(SY.shift());
+         if(dy != T()) {
+            T sxy(sumxy.Value() - dy*sx);
+            sumxy.Reset();
+            sumxy.Add(sxy);
+         }
+      }
+
+      /// return sum of (x-avex)*(y-avey)
+      inline T Sxy(void) const
+      { return sumxy.Value() - SX.sum.Value()*SY.sum.Value()/T(N()); }
+
+      SlidingStats<T> SX;        ///< stats on x
+      SlidingStats<T> SY;        ///< stats on y
+      CompensatedSum<T> sumxy;   ///< sum of (x-Kx)*(y-Ky)
+   }; // end class SlidingTwoSampleStats
+
+}  // end namespace gpstk
+
+#endif   // #define SLIDING_STATS_INCLUDE
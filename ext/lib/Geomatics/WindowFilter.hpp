@@ -40,7 +40,9 @@
 /// are several statistical filters implemented as classes. These classes are
 /// templates; the template parameter should be a float (probably double);
 /// it is used to construct gpstk::Stats<T>, gpstk::TwoSampleStats<T> and
-/// gpstk::SeqStats<T>, which are fundamental to these algorithms.
+/// gpstk::SeqStats<T>, which are fundamental to these algorithms. Statistics in
+/// sliding windows use gpstk::SlidingStats<T> and gpstk::SlidingTwoSampleStats<T>
+/// (SlidingStats.hpp), which are updated in O(1) per point without drift.
 ///    All the filters look for outliers and discontinuities (slips) in a timeseries.
 /// The first difference filter analyses the simple first difference of the data.
 /// The window filter uses a 2-pane sliding window centered on the data point in
@@ -86,6 +88,7 @@
 #include <vector>
 #include <deque>
 #include "Stats.hpp"
+#include "SlidingStats.hpp"
 #include "RobustStats.hpp"
 //#include "StringUtils.hpp"       // TEMP
 //#include "logstream.hpp"         // TEMP
@@ -199,7 +202,7 @@ public:
    std::string asString(void) const { return S.asString(); }
 
 private:
-   gpstk::Stats<T> S;
+   gpstk::SlidingStats<T> S;
 
 }; // end class OneSampleStatsFilter
 
@@ -250,7 +253,7 @@ public:
    std::string asString(void) const { return TSS.asString(); }
 
 private:
-   gpstk::TwoSampleStats<T> TSS;
+   gpstk::SlidingTwoSampleStats<T> TSS;
 
 }; // end class TwoSampleStatsFilter
 
@@ -1148,8 +1151,14 @@ void WindowFilter<T>::getStats(FilterHit<T>& sg, bool skip)
    sg.min = sg.max = sg.med = sg.mad = T(0);
 
    int j(-1);
-   for(i=0; i<analvec.size(); i++)
-      if(analvec[i].index == sg.index) { j=i; break; }
+   // analvec is in order of index - search it
+   size_t k(analvec.size());
+   i = 0;
+   while(i < k) {
+      size_t m((i+k)/2);
+      if(analvec[m].index < sg.index) i = m+1; else k = m;
+   }
+   if(i < analvec.size() && analvec[i].index == sg.index) j = i;
    if(j == -1) return;
 
    // stats on sigma       // TD would like the same for step....how to implement
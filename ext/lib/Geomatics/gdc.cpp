@@ -169,7 +169,7 @@ int gdc::DiscontinuityCorrector(SatPass& SP, string& retMsg, vector<string>& cmd
 
          // test for good data
          // must consistently mark bad data in SP with SatPass::BAD
-         if(!(SP.spdvector[i].flag & SatPass::OK)
+         if(!(SP.flags[i] & SatPass::OK)
             || SP.data(i,L1) == 0.0 || SP.data(i,L2) == 0.0
             || SP.data(i,P1) == 0.0 || SP.data(i,P2) == 0.0)
          {
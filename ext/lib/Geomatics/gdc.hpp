@@ -492,7 +492,7 @@ protected:
    /// vector of data e.g. WLC and GFP, in wavelengths
    std::vector<double> dataWL, dataGF;
 
-   /// vector of dt*ndt = number of steps of dt from begin point * dt; from spdvector
+   /// vector of dt*ndt = number of steps of dt from begin point * dt; from SatPass counts
    std::vector<double> xdata;
 
    // NB flags must be int, not unsigned, for StatsFilter processing
@@ -45,6 +45,7 @@
 #include <list>
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <ctype.h>
 #include <math.h>
 
@@ -55,45 +56,121 @@
 namespace gpstk 
 {
    
-   double Expression::BinOpNode::getValue() 
-      throw (ExpressionException) 
+   Expression::OpCode Expression::opCode(const std::string& op)
    {
+      if (op=="+") return opAdd;
+      if (op=="-") return opSub;
+      if (op=="*") return opMul;
+      if (op=="/") return opDiv;
+      if (op=="cos") return opCos;
+      if (op=="sin") return opSin;
+      if (op=="tan") return opTan;
+      if (op=="acos") return opAcos;
+      if (op=="asin") return opAsin;
+      if (op=="atan") return opAtan;
+      if (op=="exp") return opExp;
+      if (op=="abs") return opAbs;
+      if (op=="sqrt") return opSqrt;
+      if (op=="log") return opLog;
+      if (op=="log10") return opLog10;
+      return opInvalid;
+   }
 
-      // To get the value, compute the value of the left and
-      // right operands, and combine them with the operator.
-      double leftVal = left->getValue();
-      double rightVal = right->getValue();
-
-      if (op=="+") return leftVal + rightVal;
-      if (op=="-") return leftVal - rightVal;
-      if (op=="*") return leftVal * rightVal;
-      if (op=="/") return leftVal / rightVal;
+   double Expression::apply(OpCode op, double leftVal, double rightVal)
+   {
+      switch (op)
+      {
+         case opAdd: return leftVal + rightVal;
+         case opSub: return leftVal - rightVal;
+         case opMul: return leftVal * rightVal;
+         case opDiv: return leftVal / rightVal;
+         default: break;
+      }
+      GPSTK_THROW(ExpressionException());
+   }
 
-      // else THROW exception
+   double Expression::apply(OpCode op, double rightVal)
+   {
+      switch (op)
+      {
+         case opCos: return ::cos(rightVal);
+         case opSin: return ::sin(rightVal);
+         case opTan: return ::tan(rightVal);
+         case opAcos: return ::acos(rightVal);
+         case opAsin: return ::asin(rightVal);
+         case opAtan: return ::atan(rightVal);
+         case opExp: return ::exp(rightVal);
+         case opAbs: return ::fabs(rightVal);
+         case opSqrt: return ::sqrt(rightVal);
+         case opLog: return ::log(rightVal);
+         case opLog10: return ::log10(rightVal);
+         default: break;
+      }
       GPSTK_THROW(ExpressionException());
+   }
 
+   bool Expression::ConstNode::compile(Expression& expr)
+   {
+      Instruction ins = { opConst, -1, number };
+      expr.program.push_back(ins);
+      return true;
    }
 
-   double Expression::FuncOpNode::getValue()
-      throw (ExpressionException) 
+   bool Expression::VarNode::compile(Expression& expr)
    {
-      // To get the value, compute the value of the right first
-      double rightVal = right->getValue();
-
-      if (op=="cos") return ::cos(rightVal);
-      if (op=="sin") return ::sin(rightVal);
-      if (op=="tan") return ::tan(rightVal);
-      if (op=="acos") return ::acos(rightVal);
-      if (op=="asin") return ::asin(rightVal);
-      if (op=="atan") return ::atan(rightVal);
-      if (op=="exp") return ::exp(rightVal);
-      if (op=="abs") return ::fabs(rightVal);
-      if (op=="sqrt") return ::sqrt(rightVal);
-      if (op=="log") return ::log(rightVal);
-      if (op=="log10") return ::log10(rightVal);
-
-      // else THROW exception
-      GPSTK_THROW(ExpressionException());
+      std::string key(StringUtils::upperCase(name));
+      std::map<std::string,int>::const_iterator it = expr.varIndex.find(key);
+      int slot;
+      if (it == expr.varIndex.end())
+      {
+         slot = expr.varNames.size();
+         expr.varIndex[key] = slot;
+         expr.varNames.push_back(name);
+      }
+      else
+         slot = it->second;
+
+      Instruction ins = { opVar, slot, 0.0 };
+      expr.program.push_back(ins);
+      return false;
+   }
+
+   bool Expression::BinOpNode::compile(Expression& expr)
+   {
+      bool leftConst = left->compile(expr);
+      bool rightConst = right->compile(expr);
+      OpCode code = opCode(op);
+
+         // fold, leaving the same value evaluate() would compute
+      if (leftConst && rightConst && code != opInvalid)
+      {
+         double rightVal = expr.program.back().number;
+         expr.program.pop_back();
+         Instruction& ins = expr.program.back();
+         ins.number = apply(code, ins.number, rightVal);
+         return true;
+      }
+
+      Instruction ins = { code, -1, 0.0 };
+      expr.program.push_back(ins);
+      return false;
+   }
+
+   bool Expression::FuncOpNode::compile(Expression& expr)
+   {
+      bool rightConst = right->compile(expr);
+      OpCode code = opCode(op);
+
+      if (rightConst && code != opInvalid)
+      {
+         Instruction& ins = expr.program.back();
+         ins.number = apply(code, ins.number);
+         return true;
+      }
+
+      Instruction ins = { code, -1, 0.0 };
+      expr.program.push_back(ins);
+      return false;
    }
 
    std::ostream& Expression::FuncOpNode::print(std::ostream& ostr) {
@@ -113,22 +190,171 @@ namespace gpstk
       return ostr;
    }
 
-   void Expression::VarNode::setValue(double newValue)         
+   void Expression::compile(void)
    {
-      value=newValue;
-      hasValue=true;
-   };
-         
-   double Expression::VarNode::getValue(void) 
+      program.clear();
+      varNames.clear();
+      varIndex.clear();
+      if (root != 0)
+         root->compile(*this);
+      varValues.assign(varNames.size(), 0.0);
+      varSet.assign(varNames.size(), false);
+
+         // every instruction but a function pushes or pops one value
+      int depth(0), maxd(0);
+      for (size_t i=0; i<program.size(); i++)
+      {
+         if (program[i].op == opConst || program[i].op == opVar)
+            depth++;
+         else if (program[i].op <= opDiv || program[i].op == opInvalid)
+            depth--;
+         if (depth > maxd)
+            maxd = depth;
+      }
+      maxDepth = maxd;
+      stack.resize(maxDepth);
+   }
+
+   void Expression::checkValues(void) const
+      throw (ExpressionException)
+   {
+      for (size_t i=0; i<varSet.size(); i++)
+      {
+         if (!varSet[i])
+         {
+            ExpressionException ee("Variable " + varNames[i] + " undefined.");
+            GPSTK_THROW(ee);
+         }
+      }
+   }
+
+   double Expression::evaluate(void)
       throw (ExpressionException)
    {
-      if (!hasValue) 
-      { 
-         ExpressionException ee("Variable " + name + " undefined."); 
+      checkValues();
+      if (program.empty())
+      {
+         ExpressionException ee("Empty expression");
          GPSTK_THROW(ee);
       }
-      
-      return value;
+
+      double *sp = &stack[0];
+      for (size_t i=0; i<program.size(); i++)
+      {
+         const Instruction& ins = program[i];
+         switch (ins.op)
+         {
+            case opConst: *sp++ = ins.number; break;
+            case opVar: *sp++ = varValues[ins.slot]; break;
+            case opAdd: sp--; sp[-1] += *sp; break;
+            case opSub: sp--; sp[-1] -= *sp; break;
+            case opMul: sp--; sp[-1] *= *sp; break;
+            case opDiv: sp--; sp[-1] /= *sp; break;
+            case opInvalid: GPSTK_THROW(ExpressionException());
+            default: sp[-1] = apply(ins.op, sp[-1]); break;
+         }
+      }
+      return stack[0];
+   }
+
+   void Expression::evaluate(const std::vector< std::vector<double> >& columns,
+                             std::vector<double>& results)
+      throw (ExpressionException)
+   {
+      if (columns.size() != varNames.size())
+      {
+         ExpressionException ee("Expected "
+                                + StringUtils::asString(varNames.size())
+                                + " columns, got "
+                                + StringUtils::asString(columns.size()));
+         GPSTK_THROW(ee);
+      }
+
+      size_t n(0);
+      bool haveColumn(false);
+      for (size_t k=0; k<columns.size(); k++)
+      {
+         if (columns[k].empty())
+         {
+            if (!varSet[k])
+            {
+               ExpressionException ee("Variable " + varNames[k]
+                                      + " undefined.");
+               GPSTK_THROW(ee);
+            }
+         }
+         else if (!haveColumn)
+         {
+            n = columns[k].size();
+            haveColumn = true;
+         }
+         else if (columns[k].size() != n)
+         {
+            ExpressionException ee("Column for " + varNames[k]
+                                   + " has the wrong length");
+            GPSTK_THROW(ee);
+         }
+      }
+
+      if (!haveColumn)
+      {
+         results.assign(1, evaluate());
+         return;
+      }
+      results.resize(n);
+
+         // Run the program over blocks of the series, each stack entry
+         // holding one block, so the dispatch is paid once per block.
+      const size_t blockSize(64);
+      std::vector<double> work(maxDepth * blockSize);
+      for (size_t b=0; b<n; b+=blockSize)
+      {
+         size_t m = std::min(blockSize, n-b);
+         double *top = &work[0];     // one past the top block
+         for (size_t i=0; i<program.size(); i++)
+         {
+            const Instruction& ins = program[i];
+            double *r = top - blockSize, *x = top - 2*blockSize;
+            size_t j;
+            switch (ins.op)
+            {
+               case opConst:
+                  std::fill(top, top+m, ins.number);
+                  top += blockSize;
+                  break;
+               case opVar:
+                  if (columns[ins.slot].empty())
+                     std::fill(top, top+m, varValues[ins.slot]);
+                  else
+                     std::copy(&columns[ins.slot][b],
+                               &columns[ins.slot][b]+m, top);
+                  top += blockSize;
+                  break;
+               case opAdd:
+                  for (j=0; j<m; j++) x[j] += r[j];
+                  top = r;
+                  break;
+               case opSub:
+                  for (j=0; j<m; j++) x[j] -= r[j];
+                  top = r;
+                  break;
+               case opMul:
+                  for (j=0; j<m; j++) x[j] *= r[j];
+                  top = r;
+                  break;
+               case opDiv:
+                  for (j=0; j<m; j++) x[j] /= r[j];
+                  top = r;
+                  break;
+               case opInvalid:
+                  GPSTK_THROW(ExpressionException());
+               default:
+                  for (j=0; j<m; j++) r[j] = apply(ins.op, r[j]);
+                  break;
+            }
+         }
+         std::copy(&work[0], &work[0]+m, &results[b]);
+      }
    }
    Expression::Token::Token(std::string iValue, int iPriority, 
                             bool isOp=false)
@@ -171,6 +397,7 @@ namespace gpstk
       dumpLists();
       tokenize(istr);
       buildExpressionTree();
+      compile();
    }
 
    Expression::Expression(void)
@@ -533,50 +760,44 @@ namespace gpstk
 
    bool Expression::set(const std::string name, double value)
    {
-      using namespace std;
-      
-      bool gotSet;
+      int slot = getVariableIndex(name);
+      if (slot < 0)
+         return false;
 
-      std::list<ExpNode *>::iterator i;
-      int t;
-      
-      for (t=0, i=eList.begin(); i!=eList.end(); t++, i++)
-      {
-         VarNode *vnode = dynamic_cast<VarNode *> (*i);
-         if (vnode!=0) 
-         {
-            if (StringUtils::upperCase(vnode->name) == 
-                StringUtils::upperCase(name))
-            {
-               vnode->setValue(value);
-               gotSet = true;
-            }
-         }
-      }
-
-      return gotSet;
+      varValues[slot] = value;
+      varSet[slot] = true;
+      return true;
    }
 
 
-   bool Expression::canEvaluate(void)
+   int Expression::getVariableIndex(const std::string& name) const
    {
-      using namespace std;
-      
-      bool areSet=true;
+      std::map<std::string,int>::const_iterator it =
+         varIndex.find(StringUtils::upperCase(name));
+      return (it == varIndex.end() ? -1 : it->second);
+   }
 
-      std::list<ExpNode *>::iterator i;
-      int t;
-      
-      for (t=0, i=eList.begin(); i!=eList.end(); t++, i++)
+
+   void Expression::setValue(int index, double value)
+      throw (ExpressionException)
+   {
+      if (index < 0 || index >= static_cast<int>(varValues.size()))
       {
-         VarNode *vnode = dynamic_cast<VarNode *> (*i);
-         if (vnode!=0) 
-         {
-            areSet &= vnode->hasValue;
-         }
+         ExpressionException ee("Invalid variable index "
+                                + StringUtils::asString(index));
+         GPSTK_THROW(ee);
       }
+      varValues[index] = value;
+      varSet[index] = true;
+   }
 
-      return areSet;
+
+   bool Expression::canEvaluate(void)
+   {
+      for (size_t i=0; i<varSet.size(); i++)
+         if (!varSet[i])
+            return false;
+      return true;
    }
     
    bool Expression::setGPSConstants(void)
@@ -47,6 +47,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
 #include "RinexObsHeader.hpp"
 #include "RinexObsData.hpp"
@@ -75,10 +76,26 @@ namespace gpstk
        *
        *     http://math.hws.edu/orr/s04/cpsc225/btrees/index.html
        *
+       * Once the tree is built it is compiled into a flat program for a
+       * stack machine. Sub-expressions that do not depend on a variable
+       * are folded into constants, and every distinct variable (ignoring
+       * case) is given a slot. The tree is kept only for print().
+       *
        * After the expression is instantiated, it can be evaluated. If the
        * expression contains variables, those must be set using the set
-       * operation for the expression to successfully evaluate. 
-       *
+       * operation for the expression to successfully evaluate. When the
+       * same expression is evaluated many times, look up the slot of each
+       * variable once with getVariableIndex() and use setValue(), or
+       * evaluate a whole series at once:
+       * @code
+       * Expression wl("wl1*L1 - wl2*L2");
+       * wl.setGPSConstants();
+       * std::vector< std::vector<double> > cols(wl.getVariableNames().size());
+       * cols[wl.getVariableIndex("L1")] = L1data;
+       * cols[wl.getVariableIndex("L2")] = L2data;
+       * std::vector<double> result;
+       * wl.evaluate(cols, result);
+       * @endcode
        */  
 
    NEW_EXCEPTION_CLASS(ExpressionException, Exception);
@@ -135,6 +152,30 @@ namespace gpstk
       bool set(const char* name, double value) 
          { return set (std::string(name),value); }
 
+         /**
+          * Get the slot of a variable, for use with setValue() and the
+          * columns of the batch evaluate(). Case is not important.
+          * @param name Name of the variable
+          * @return the slot, or -1 if the expression has no such variable.
+          */
+      int getVariableIndex(const std::string& name) const;
+
+         /**
+          * Names of the variables in the expression, in slot order, as
+          * spelled where each first appears.
+          */
+      const std::vector<std::string>& getVariableNames(void) const
+         { return varNames; }
+
+         /**
+          * Sets the variable in the given slot to the input value.
+          * @param index Slot of the variable, from getVariableIndex()
+          * @param value Value to set the variable to.
+          * @throw ExpressionException if index is not a valid slot.
+          */
+      void setValue(int index, double value)
+         throw (ExpressionException);
+
         /**
          * Sets multiple variables in the expression to constants associated
          * with GPS. Predefined variables include: PI; C (meters per 
@@ -173,9 +214,26 @@ namespace gpstk
           * Returns the numerical value of the expression. Note that
           * if the expression contains variables, those variables must
           * be set.
+          * @throw ExpressionException if a variable is not set, or if
+          *   the expression is empty.
           */
-      double evaluate(void)  throw (ExpressionException)
-         { return root->getValue(); }
+      double evaluate(void)  throw (ExpressionException);
+
+         /**
+          * Evaluates the expression over a series of values.
+          * @param columns one vector per variable, in slot order (see
+          *   getVariableIndex()). A column may be empty, in which case the
+          *   value given by set() or setValue() is used for the whole
+          *   series; all other columns must have the same length n.
+          * @param results output, resized to n (to 1 when every column
+          *   is empty).
+          * @throw ExpressionException if the number of columns is not the
+          *   number of variables, the columns have different lengths, or a
+          *   variable with an empty column has not been set.
+          */
+      void evaluate(const std::vector< std::vector<double> >& columns,
+                    std::vector<double>& results)
+         throw (ExpressionException);
 
          /**
           * Writes the expression out to a stream.
@@ -183,15 +241,39 @@ namespace gpstk
       void print(std::ostream& ostr) const {root->print(ostr);} 
 
       private:
+         // Instructions of the compiled program
+      enum OpCode
+      {
+         opConst,   // push number
+         opVar,     // push the value in slot
+         opAdd, opSub, opMul, opDiv,
+         opCos, opSin, opTan, opAcos, opAsin, opAtan,
+         opExp, opAbs, opSqrt, opLog, opLog10,
+         opInvalid  // an operator with no implementation, e.g. ^
+      };
+
+      struct Instruction
+      {
+         OpCode op;
+         int slot;
+         double number;
+      };
+
+         // Apply a binary (opAdd..opDiv) or function (opCos..opLog10) code
+      static double apply(OpCode op, double left, double right);
+      static double apply(OpCode op, double right);
+      static OpCode opCode(const std::string& op);
+
       // Represents a node of any type in an expression tree.
       class ExpNode {
          public:
 
          virtual ~ExpNode() {}
 
-         // Compute and return the numerical value of this node
-         virtual double getValue()
-            throw (ExpressionException) =0;
+         // Append the instructions for this node to expr.program. Return
+         // true if the value does not depend on a variable, in which case
+         // the instructions are a single opConst.
+         virtual bool compile(Expression& expr) =0;
          
   
          // Write out this node to a stream
@@ -206,8 +288,7 @@ namespace gpstk
             // Constructor.  Create a node to hold val.
             ConstNode( double theNum ): number(theNum) {}
 
-            double getValue()  throw (ExpressionException)
-               { return number; }
+            bool compile(Expression& expr);
 
             std::ostream& print(std::ostream& ostr) {
                ostr << number;
@@ -222,10 +303,10 @@ namespace gpstk
          public:
             // Constructor.  
 
-            VarNode(std::string theName ): name(theName), hasValue(false)
+            VarNode(std::string theName ): name(theName)
                 {}
 
-            double getValue()  throw (ExpressionException);
+            bool compile(Expression& expr);
 
             std::ostream& print(std::ostream& ostr) {
                ostr << name;
@@ -233,14 +314,6 @@ namespace gpstk
             }
 
             std::string name;  // The name of the varaible
-            bool hasValue;
-
-         void setValue(double newValue);
-
-        private:
-            double value;
-          
-         
       }; // end class VarNode
 
       // Represents a node that holds an operator.
@@ -251,8 +324,7 @@ namespace gpstk
             BinOpNode( const std::string& theOp, ExpNode *theLeft, ExpNode *theRight ):
                     op(theOp), left(theLeft), right(theRight){}
 
-            double getValue()
-               throw (ExpressionException);
+            bool compile(Expression& expr);
 
             std::ostream& print(std::ostream& ostr);
 
@@ -270,8 +342,7 @@ namespace gpstk
             FuncOpNode( const std::string& theOp, ExpNode *theRight ):
                     op(theOp), right(theRight){}
 
-            double getValue() 
-               throw (ExpressionException);
+            bool compile(Expression& expr);
 
             std::ostream& print(std::ostream& ostr);
 
@@ -329,6 +400,8 @@ namespace gpstk
          void defineOperators(void);
          void tokenize(const std::string& str);
          void buildExpressionTree(void);
+         void compile(void);
+         void checkValues(void) const throw (ExpressionException);
 
          int countResolvedTokens(void);   
       
@@ -339,6 +412,17 @@ namespace gpstk
          std::list<Token> tList;
          std::list<ExpNode *> eList;
          ExpNode *root;      
+
+            // the compiled program, and the stack depth it needs
+         std::vector<Instruction> program;
+         unsigned maxDepth;
+            // variable slots; varIndex is keyed by upper case name
+         std::vector<std::string> varNames;
+         std::map<std::string,int> varIndex;
+         std::vector<double> varValues;
+         std::vector<bool> varSet;
+            // work space for evaluate()
+         std::vector<double> stack;
    }; // End class expression
    
    
@@ -0,0 +1,259 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file AntexData_T.cpp Test the regular-grid phase center variations of
+/// AntexData against the maps they are built from, and AntennaStore lookup.
+
+#include <iostream>
+#include "AntennaStore.hpp"
+#include "TestUtil.hpp"
+#include "build_config.h"
+
+using namespace std;
+using namespace gpstk;
+
+class AntexData_T
+{
+public:
+   AntexData_T()
+   {
+      antexFile = getPathData() + getFileSep() + "test_input_antex.atx";
+   }
+   unsigned storeTest();
+   unsigned gridTest();
+   unsigned batchTest();
+
+private:
+      /// Load the test file, with satellites, into store.
+   void load(AntennaStore& store)
+   {
+      store.includeAllSatellites();
+      store.addANTEXfile(antexFile);
+   }
+      /// Azimuths and elevations (or nadir angles) on and between the grid
+      /// points, and beyond the range of zenith angles of the satellite.
+   void points(vector<double>& az, vector<double>& el)
+   {
+      az.clear();
+      el.clear();
+      for (double a = -20.; a <= 380.; a += 2.5)
+      {
+         for (double e = 0.; e <= 90.; e += 0.75)
+         {
+            az.push_back(a);
+            el.push_back(e);
+         }
+         az.push_back(a + 1.0/3.0);
+         el.push_back(45.0/7.0);
+      }
+   }
+
+   string antexFile;
+};
+
+
+unsigned AntexData_T ::
+storeTest()
+{
+   TUDEF("AntennaStore", "findAntenna");
+   AntennaStore store;
+   load(store);
+   TUASSERTE(unsigned, 3, store.size());
+
+   vector<string> names;
+   store.getNames(names);
+   for (unsigned i = 0; i < names.size(); i++)
+   {
+      const AntexData *ptr = store.findAntenna(names[i]);
+      TUASSERT(ptr != NULL);
+      TUASSERTE(string, names[i], ptr->name());
+      AntexData ad;
+      TUASSERT(store.getAntenna(names[i], ad));
+      TUASSERTE(string, names[i], ad.name());
+   }
+   TUASSERT(store.findAntenna("NOT AN ANTENNA") == NULL);
+
+      // copies have their own index
+   AntennaStore copy(store);
+   store.clear();
+   TUASSERT(store.findAntenna(names[0]) == NULL);
+   const AntexData *ptr = copy.findAntenna(names[0]);
+   TUASSERT(ptr != NULL);
+   if (ptr != NULL)
+      TUASSERTE(string, names[0], ptr->name());
+
+      // receivers not in the list are removed
+   vector<string> keep(1, "AOAD/M_B        NONE");
+   copy.includeReceivers(keep);
+   TUASSERT(copy.findAntenna(keep[0]) != NULL);
+   copy.includeReceivers(names = vector<string>());
+   TUASSERT(copy.findAntenna(keep[0]) == NULL);
+   TUASSERTE(unsigned, 2, copy.size());
+   TURETURN();
+}
+
+
+unsigned AntexData_T ::
+gridTest()
+{
+   TUDEF("AntexData", "getPhaseCenterVariation");
+   AntennaStore store;
+   load(store);
+   vector<string> names;
+   store.getNames(names);
+   vector<double> az, el;
+   points(az, el);
+
+   for (unsigned i = 0; i < names.size(); i++)
+   {
+      const AntexData& grid = *store.findAntenna(names[i]);
+         // the same antenna without grids interpolates the maps
+      AntexData maps(grid);
+      map<string, AntexData::antennaPCOandPCVData>::iterator it;
+      for (it = maps.freqPCVmap.begin(); it != maps.freqPCVmap.end(); it++)
+      {
+         TUASSERT(!it->second.PCVgrid.empty());
+         it->second.PCVgrid.clear();
+      }
+
+      for (it = maps.freqPCVmap.begin(); it != maps.freqPCVmap.end(); it++)
+      {
+         unsigned bad = 0;
+         for (unsigned j = 0; j < az.size(); j++)
+         {
+            double pg = grid.getPhaseCenterVariation(it->first, az[j], el[j]);
+            double pm = maps.getPhaseCenterVariation(it->first, az[j], el[j]);
+            if (pg != pm)
+               bad++;
+         }
+         TUASSERTE(unsigned, 0, bad);
+      }
+
+         // rebuilding restores the grids
+      maps.buildPCVGrids();
+      for (it = maps.freqPCVmap.begin(); it != maps.freqPCVmap.end(); it++)
+         TUASSERT(!it->second.PCVgrid.empty());
+   }
+
+      // irregular maps are not gridded
+   AntexData ad(*store.findAntenna("AOAD/M_B        NONE"));
+   AntexData::antennaPCOandPCVData& pcv = ad.freqPCVmap.begin()->second;
+   pcv.PCVvalue[7.5] = pcv.PCVvalue[5.0];
+   ad.buildPCVGrids();
+   TUASSERT(pcv.PCVgrid.empty());
+   TUASSERTFE(pcv.PCVvalue[5.0][30.0],
+              ad.getPhaseCenterVariation(ad.freqPCVmap.begin()->first, 5., 60.));
+   TURETURN();
+}
+
+
+unsigned AntexData_T ::
+batchTest()
+{
+   TUDEF("AntexData", "getPhaseCenterVariations");
+   AntennaStore store;
+   load(store);
+   vector<string> names;
+   store.getNames(names);
+   vector<double> az, el, pcvs;
+   points(az, el);
+
+   for (unsigned i = 0; i < names.size(); i++)
+   {
+      const AntexData& ad = *store.findAntenna(names[i]);
+      map<string, AntexData::antennaPCOandPCVData>::const_iterator it;
+      for (it = ad.freqPCVmap.begin(); it != ad.freqPCVmap.end(); it++)
+      {
+         ad.getPhaseCenterVariations(it->first, az, el, pcvs);
+         TUASSERTE(size_t, az.size(), pcvs.size());
+         unsigned bad = 0;
+         for (unsigned j = 0; j < az.size(); j++)
+         {
+            if (pcvs[j] != ad.getPhaseCenterVariation(it->first, az[j], el[j]))
+               bad++;
+         }
+         TUASSERTE(unsigned, 0, bad);
+      }
+   }
+
+   const AntexData& ad = *store.findAntenna(names[0]);
+   string freq(ad.freqPCVmap.begin()->first);
+   try
+   {
+      vector<double> shortEl(el.begin(), el.end()-1);
+      ad.getPhaseCenterVariations(freq, az, shortEl, pcvs);
+      TUFAIL("arrays of different lengths should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("arrays of different lengths");
+   }
+   try
+   {
+      el[3] = 91.;
+      ad.getPhaseCenterVariations(freq, az, el, pcvs);
+      TUFAIL("invalid elevation should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("invalid elevation");
+   }
+   try
+   {
+      ad.getPhaseCenterVariations("X99", az, el, pcvs);
+      TUFAIL("missing frequency should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("missing frequency");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   AntexData_T testClass;
+
+   errorTotal += testClass.storeTest();
+   errorTotal += testClass.gridTest();
+   errorTotal += testClass.batchTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,257 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file CompressedSparseMatrix_T.cpp Test CSRMatrix, CSCMatrix, SparseBuilder and
+/// the compressed column SRIF measurement update.
+
+#include <iostream>
+#include "CompressedSparseMatrix.hpp"
+#include "SRIFilter.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class CompressedSparseMatrix_T
+{
+public:
+   CompressedSparseMatrix_T() : seed(24680) {}
+   unsigned builderTest();
+   unsigned conversionTest();
+   unsigned productTest();
+   unsigned srifTest();
+
+private:
+   double random()
+   {
+      seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+      return double(seed) / 0x7fffffff - 0.5;
+   }
+      /// Partials like those of double differences from several stations: each
+      /// row depends on a few common states and on the states of one station.
+   Matrix<double> blockPartials(unsigned nsta, unsigned perSta, unsigned ncommon)
+   {
+      unsigned nrows(nsta*perSta), ncols(ncommon + 2*nsta);
+      Matrix<double> H(nrows, ncols, 0.);
+      for (unsigned s = 0; s < nsta; s++)
+      {
+         for (unsigned r = 0; r < perSta; r++)
+         {
+            unsigned i = s*perSta + r;
+            for (unsigned j = 0; j < ncommon; j++)
+               H(i,j) = random();
+            H(i,ncommon+2*s) = 1.;
+            H(i,ncommon+2*s+1) = random();
+         }
+      }
+      return H;
+   }
+
+   unsigned long seed;
+};
+
+
+unsigned CompressedSparseMatrix_T ::
+builderTest()
+{
+   TUDEF("SparseBuilder", "add");
+   SparseBuilder<double> B(3, 4);
+   B.add(2, 1, 5.);
+   B.add(0, 3, 1.);
+   B.add(2, 1, 2.);        // duplicate, summed
+   B.add(1, 0, 4.);
+   B.add(1, 2, 3.);
+   B.add(1, 2, -3.);       // sums to zero, not stored
+   TUASSERTE(unsigned, 6, B.datasize());
+   try
+   {
+      B.add(3, 0, 1.);
+      TUFAIL("add() out of range should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("add() out of range");
+   }
+
+   CSRMatrix<double> csr(B.toCSR());
+   CSCMatrix<double> csc(B.toCSC());
+   TUASSERTE(unsigned, 3, csr.datasize());
+   TUASSERTE(unsigned, 3, csc.datasize());
+   TUASSERTE(unsigned, 3, csr.rows());
+   TUASSERTE(unsigned, 4, csc.cols());
+   double expect[12] = { 0., 0., 0., 1.,
+                         4., 0., 0., 0.,
+                         0., 7., 0., 0. };
+   for (unsigned i = 0; i < 3; i++)
+   {
+      for (unsigned j = 0; j < 4; j++)
+      {
+         TUASSERTFE(expect[4*i+j], csr(i,j));
+         TUASSERTFE(expect[4*i+j], csc(i,j));
+      }
+   }
+      // CSR row pointers: one element in each row
+   TUASSERTE(unsigned, 0, csr.pointers()[0]);
+   TUASSERTE(unsigned, 1, csr.pointers()[1]);
+   TUASSERTE(unsigned, 2, csr.pointers()[2]);
+   TUASSERTE(unsigned, 3, csr.pointers()[3]);
+   TURETURN();
+}
+
+
+unsigned CompressedSparseMatrix_T ::
+conversionTest()
+{
+   TUDEF("CSRMatrix", "conversion");
+   Matrix<double> M(blockPartials(4, 5, 3));
+   SparseMatrix<double> SM(M);
+   CSRMatrix<double> csr(SM), csrM(M);
+   CSCMatrix<double> csc(SM), cscM(M), cscR(csr);
+   CSRMatrix<double> csrC(csc);
+   TUASSERTE(unsigned, SM.datasize(), csr.datasize());
+   TUASSERTE(unsigned, SM.datasize(), csc.datasize());
+   TUASSERTFE(M, Matrix<double>(csr));
+   TUASSERTFE(M, Matrix<double>(csrM));
+   TUASSERTFE(M, Matrix<double>(csc));
+   TUASSERTFE(M, Matrix<double>(cscM));
+   TUASSERTFE(M, Matrix<double>(cscR));
+   TUASSERTFE(M, Matrix<double>(csrC));
+   TUASSERTFE(transpose(M), Matrix<double>(transpose(csr)));
+   TUASSERTFE(transpose(M), Matrix<double>(transpose(csc)));
+   TURETURN();
+}
+
+
+unsigned CompressedSparseMatrix_T ::
+productTest()
+{
+   TUDEF("CSRMatrix", "operator*");
+   double eps = 1.e-14;
+   Matrix<double> M(blockPartials(3, 4, 2)), B(M.cols(), 3), L(2, M.rows());
+   Vector<double> V(M.cols());
+   for (unsigned i = 0; i < B.rows(); i++)
+   {
+      V(i) = random();
+      for (unsigned j = 0; j < B.cols(); j++)
+         B(i,j) = random();
+   }
+   for (unsigned i = 0; i < L.rows(); i++)
+      for (unsigned j = 0; j < L.cols(); j++)
+         L(i,j) = random();
+   CSRMatrix<double> csr(M);
+   CSCMatrix<double> csc(M), cscB(B);
+   TUASSERTFEPS(M*V, csr*V, eps);
+   TUASSERTFEPS(M*V, csc*V, eps);
+   TUASSERTFEPS(M*B, csr*B, eps);
+   TUASSERTFEPS(M*B, csc*B, eps);
+   TUASSERTFEPS(L*M, L*csc, eps);
+   TURETURN();
+}
+
+
+unsigned CompressedSparseMatrix_T ::
+srifTest()
+{
+   TUDEF("SRIFilter", "measurementUpdate");
+   Matrix<double> H(blockPartials(6, 5, 3));
+   Vector<double> D(H.rows());
+   for (unsigned i = 0; i < D.size(); i++)
+      D(i) = 10.*random();
+
+      // the compressed column update gives the same result as the SparseMatrix
+      // one, which it replaces
+   Matrix<double> Rs, Rc;
+   Vector<double> Zs, Zc, Ds(D), Dc(D);
+   SparseMatrix<double> SH(H);
+   SrifMU(Rs, Zs, SH, Ds, 0);
+   SrifMU(Rc, Zc, CSCMatrix<double>(H), Dc);
+   TUASSERTFE(Rs, Rc);
+   TUASSERTFE(Zs, Zc);
+   TUASSERTFE(Ds, Dc);
+
+      // and the same as the dense update, to rounding
+   double eps = 1.e-12;
+   Matrix<double> CM(H.rows(), H.rows(), 0.);
+   for (unsigned i = 0; i < H.rows(); i++)
+   {
+      CM(i,i) = 2. + random();
+      if (i > 0)
+         CM(i,i-1) = CM(i-1,i) = 0.3;
+   }
+   SRIFilter dense(H.cols()), sparse(H.cols()), compressed(H.cols());
+   Vector<double> Dd(D), Dsp(D), Dcp(D);
+   dense.measurementUpdate(H, Dd, CM);
+   sparse.measurementUpdate(SH, Dsp, SparseMatrix<double>(CM));
+   TUASSERTFEPS(Dd, Dsp, eps);
+   TUASSERTFEPS(dense.getR(), sparse.getR(), eps);
+   TUASSERTFEPS(dense.getZ(), sparse.getZ(), eps);
+
+   dense.zeroAll();
+   Dd = D;
+   dense.measurementUpdate(H, Dd);
+   compressed.measurementUpdate(CSCMatrix<double>(H), Dcp);
+   TUASSERTFEPS(Dd, Dcp, eps);
+   TUASSERTFEPS(dense.getR(), compressed.getR(), eps);
+   TUASSERTFEPS(dense.getZ(), compressed.getZ(), eps);
+
+   try
+   {
+      Vector<double> Dbad(D.size()+1);
+      compressed.measurementUpdate(CSCMatrix<double>(H), Dbad);
+      TUFAIL("measurementUpdate with wrong dimensions should throw");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("measurementUpdate with wrong dimensions");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   CompressedSparseMatrix_T testClass;
+
+   errorTotal += testClass.builderTest();
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.srifTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,199 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file EarthOrientationCache_T.cpp Test EarthOrientationCache against the full
+/// series evaluated by EarthOrientation.
+
+#include <iostream>
+#include <cmath>
+#include "EarthOrientationCache.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class EarthOrientationCache_T
+{
+public:
+   EarthOrientationCache_T()
+   {
+         // EOPs of the SOFA example, 2007/4/5 12h UTC
+      eo.xp = 0.0349282;
+      eo.yp = 0.4833163;
+      eo.UT1mUTC = -0.072073685;
+         // 2007/4/4 to 2007/4/8, not on grid nodes
+      for (int i = 0; i < 120; i++)
+      {
+         EphTime t;
+         t.setMJD(static_cast<long double>(54194.0 + 0.0317*i));
+         t.setTimeSystem(TimeSystem::UTC);
+         times.push_back(t);
+      }
+   }
+   unsigned matrixTest(IERSConvention conv);
+   unsigned batchTest();
+   unsigned errorTest();
+
+private:
+   double maxDiff(const Matrix<double>& A, const Matrix<double>& B)
+   {
+      double diff(0.0);
+      for (unsigned i = 0; i < A.rows(); i++)
+         for (unsigned j = 0; j < A.cols(); j++)
+            diff = max(diff, ::fabs(A(i,j)-B(i,j)));
+      return diff;
+   }
+
+   EarthOrientation eo;
+   vector<EphTime> times;
+};
+
+
+unsigned EarthOrientationCache_T ::
+matrixTest(IERSConvention conv)
+{
+   TUDEF("EarthOrientationCache", "ECEFtoInertial " + conv.asString());
+   double tol(1.0e-12);
+   EarthOrientationCache cache(conv, tol);
+   TUASSERT(cache.getStep() >= 1.0/64.0 && cache.getStep() <= 4.0);
+   TUASSERTE(unsigned, 0, cache.size());
+   eo.convention = conv;
+
+   double dECEF(0.0), dNut(0.0), dNPB(0.0);
+   for (unsigned i = 0; i < times.size(); i++)
+   {
+      dECEF = max(dECEF, maxDiff(cache.ECEFtoInertial(eo, times[i]),
+                                 eo.ECEFtoInertial(times[i])));
+      dNut = max(dNut, maxDiff(cache.NutationMatrix(times[i]),
+                               eo.NutationMatrix(times[i])));
+      dNPB = max(dNPB, maxDiff(cache.PreciseEarthRotation(times[i]),
+                               eo.PreciseEarthRotation(times[i])));
+   }
+      // matrix elements err by about the error in the angles
+   TUASSERT(dECEF < 4*tol);
+   TUASSERT(dNut < 4*tol);
+   TUASSERT(dNPB < 4*tol);
+      // four days of nodes, plus those for the interpolation
+   TUASSERT(cache.size() <= 4/cache.getStep() + 10);
+   TURETURN();
+}
+
+
+unsigned EarthOrientationCache_T ::
+batchTest()
+{
+   TUDEF("EarthOrientationCache", "batch");
+   EarthOrientationCache cache(IERSConvention::IERS2010);
+   eo.convention = IERSConvention::IERS2010;
+
+   vector<EarthOrientation> eos(times.size(), eo);
+   vector< Matrix<double> > rots;
+   cache.ECEFtoInertial(eos, times, rots);
+   TUASSERTE(size_t, times.size(), rots.size());
+   vector<double> X, Y, s;
+   cache.CIO(times, X, Y, s);
+   TUASSERTE(size_t, times.size(), s.size());
+
+   unsigned bad = 0;
+   for (unsigned i = 0; i < times.size(); i++)
+   {
+      double x, y, ss;
+      cache.CIO(times[i], x, y, ss);
+      if (maxDiff(rots[i], cache.ECEFtoInertial(eo, times[i])) != 0.0 ||
+          x != X[i] || y != Y[i] || ss != s[i])
+         bad++;
+   }
+   TUASSERTE(unsigned, 0, bad);
+
+      // X and Y are the bottom row of the NPB matrix
+   Matrix<double> NPB(eo.PreciseEarthRotation(times[0]));
+   TUASSERTFEPS(NPB(2,0), X[0], 1.e-10);
+   TUASSERTFEPS(NPB(2,1), Y[0], 1.e-10);
+   TURETURN();
+}
+
+
+unsigned EarthOrientationCache_T ::
+errorTest()
+{
+   TUDEF("EarthOrientationCache", "EarthOrientationCache");
+   try
+   {
+      EarthOrientationCache cache(IERSConvention::IERS1996);
+      TUFAIL("IERS1996 should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("IERS1996");
+   }
+   try
+   {
+      EarthOrientationCache cache(IERSConvention::IERS2003, 0.0);
+      TUFAIL("zero accuracy bound should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("zero accuracy bound");
+   }
+   try
+   {
+      EarthOrientationCache cache(IERSConvention::IERS2003);
+      eo.convention = IERSConvention::IERS2010;
+      cache.ECEFtoInertial(eo, times[0]);
+      TUFAIL("different conventions should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("different conventions");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   EarthOrientationCache_T testClass;
+
+   errorTotal += testClass.matrixTest(IERSConvention::IERS2003);
+   errorTotal += testClass.matrixTest(IERSConvention::IERS2010);
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,235 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Expression_T.cpp Test the compiled evaluation of Expression.
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include "Expression.hpp"
+#include "GNSSconstants.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class Expression_T
+{
+public:
+   unsigned evaluateTest();
+   unsigned variableTest();
+   unsigned batchTest();
+};
+
+
+unsigned Expression_T ::
+evaluateTest()
+{
+   TUDEF("Expression", "evaluate");
+
+   Expression e1("1+2*3");
+   TUASSERTFE(7.0, e1.evaluate());
+   Expression e2("(1+2)*3-4/8");
+   TUASSERTFE(8.5, e2.evaluate());
+      // same priority operators are grouped from the left
+   Expression e3("8-4-2");
+   TUASSERTFE(2.0, e3.evaluate());
+   Expression e4("1+sqrt(16)+cos(0)*abs(3-5)");
+   TUASSERTFE(7.0, e4.evaluate());
+   Expression e5("1.5e-3*2e+3");
+   TUASSERTFE(3.0, e5.evaluate());
+   Expression e6;
+   TUASSERTFE(0.0, e6.evaluate());
+
+      // a copy is built from the printed expression
+   Expression e7(e2);
+   TUASSERTFE(8.5, e7.evaluate());
+   ostringstream o2, o7;
+   e2.print(o2);
+   e7.print(o7);
+   TUASSERTE(string, o2.str(), o7.str());
+
+   try
+   {
+      Expression e("2^3");
+      e.evaluate();
+      TUFAIL("^ should throw");
+   }
+   catch (ExpressionException& e)
+   {
+      TUPASS("^");
+   }
+   try
+   {
+      Expression e("");
+      e.evaluate();
+      TUFAIL("An empty expression should throw");
+   }
+   catch (ExpressionException& e)
+   {
+      TUPASS("empty");
+   }
+   TURETURN();
+}
+
+
+unsigned Expression_T ::
+variableTest()
+{
+   TUDEF("Expression", "set");
+
+   Expression e("(C1+P2)/2 - c1*3");
+   TUASSERTE(size_t, 2, e.getVariableNames().size());
+   TUASSERTE(int, 0, e.getVariableIndex("c1"));
+   TUASSERTE(int, 1, e.getVariableIndex("P2"));
+   TUASSERTE(int, -1, e.getVariableIndex("L1"));
+   TUASSERT(!e.canEvaluate());
+   try
+   {
+      e.evaluate();
+      TUFAIL("unset variable should throw");
+   }
+   catch (ExpressionException& ex)
+   {
+      TUPASS("unset variable");
+   }
+
+   TUASSERT(e.set("C1", 4.0));
+   TUASSERT(!e.set("L1", 1.0));
+   TUASSERT(!e.canEvaluate());
+   e.setValue(e.getVariableIndex("p2"), 10.0);
+   TUASSERT(e.canEvaluate());
+   TUASSERTFE(-5.0, e.evaluate());
+   e.setValue(0, 2.0);
+   TUASSERTFE(0.0, e.evaluate());
+   try
+   {
+      e.setValue(2, 1.0);
+      TUFAIL("bad index should throw");
+   }
+   catch (ExpressionException& ex)
+   {
+      TUPASS("bad index");
+   }
+
+   Expression wl("wl1*L1 - wl2*L2");
+   TUASSERT(wl.setGPSConstants());
+   wl.set("L1", 100.0);
+   wl.set("L2", 80.0);
+   TUASSERTFE((C_MPS/L1_FREQ_GPS)*100.0 - (C_MPS/L2_FREQ_GPS)*80.0,
+              wl.evaluate());
+   TURETURN();
+}
+
+
+unsigned Expression_T ::
+batchTest()
+{
+   TUDEF("Expression", "evaluate");
+
+   Expression e("gamma*P1 - P2 + sqrt(100)*sin(x)");
+   e.set("gamma", 1.6);
+   int iP1 = e.getVariableIndex("P1"), iP2 = e.getVariableIndex("P2"),
+      ix = e.getVariableIndex("x");
+   vector< vector<double> > cols(e.getVariableNames().size());
+      // longer than one block, and not a multiple of it
+   for (unsigned i = 0; i < 150; i++)
+   {
+      cols[iP1].push_back(2.0e7 + 13.0*i);
+      cols[iP2].push_back(2.0e7 + 17.0*i);
+      cols[ix].push_back(0.01*i);
+   }
+
+   vector<double> result;
+   e.evaluate(cols, result);
+   TUASSERTE(size_t, 150, result.size());
+   unsigned bad = 0;
+   for (unsigned i = 0; i < result.size(); i++)
+   {
+      e.set("P1", cols[iP1][i]);
+      e.set("P2", cols[iP2][i]);
+      e.set("x", cols[ix][i]);
+      if (e.evaluate() != result[i])
+         bad++;
+   }
+   TUASSERTE(unsigned, 0, bad);
+
+      // gamma takes the value set, for every element
+   TUASSERT(cols[e.getVariableIndex("gamma")].empty());
+
+   try
+   {
+      cols[ix].pop_back();
+      e.evaluate(cols, result);
+      TUFAIL("short column should throw");
+   }
+   catch (ExpressionException& ex)
+   {
+      TUPASS("short column");
+   }
+   try
+   {
+      cols.pop_back();
+      e.evaluate(cols, result);
+      TUFAIL("missing column should throw");
+   }
+   catch (ExpressionException& ex)
+   {
+      TUPASS("missing column");
+   }
+
+   Expression c("1+1");
+   vector< vector<double> > none;
+   c.evaluate(none, result);
+   TUASSERTE(size_t, 1, result.size());
+   TUASSERTFE(2.0, result[0]);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Expression_T testClass;
+
+   errorTotal += testClass.evaluateTest();
+   errorTotal += testClass.variableTest();
+   errorTotal += testClass.batchTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
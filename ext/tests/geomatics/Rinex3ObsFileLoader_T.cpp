@@ -0,0 +1,293 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Rinex3ObsFileLoader_T.cpp Test the parallel and streaming modes of
+/// Rinex3ObsFileLoader against the sequential loader.
+
+#include <string>
+#include <vector>
+#include "Rinex3ObsFileLoader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "TestUtil.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+using namespace gpstk;
+
+//------------------------------------------------------------------------------------
+// configure a loader the same way for every test
+void configure(Rinex3ObsFileLoader& rofl, const vector<string>& files)
+{
+   rofl.reset(files);
+   rofl.loadObsID("GC1C");
+   rofl.loadObsID("GL1C");
+   rofl.loadObsID("GC2W");
+   rofl.loadObsID("GL2W");
+   rofl.saveTheData(true);
+}
+
+//------------------------------------------------------------------------------------
+// compare two loaders' results
+void compareLoaders(TestUtil& testFramework,
+                   const Rinex3ObsFileLoader& exp, const Rinex3ObsFileLoader& got)
+{
+   TUASSERTE(int, exp.getStoreSize(), got.getStoreSize());
+   TUASSERTE(CommonTime, exp.getDataBeginTime(), got.getDataBeginTime());
+   TUASSERTE(CommonTime, exp.getDataEndTime(), got.getDataEndTime());
+   TUASSERT(exp.getTotalObsCounts() == got.getTotalObsCounts());
+   TUASSERT(exp.getWantedSatObsCountMap() == got.getWantedSatObsCountMap());
+
+   const vector<Rinex3ObsData>& es(exp.getStore()), gs(got.getStore());
+   for(unsigned int i=0; i<es.size() && i<gs.size(); i++) {
+      TUASSERTE(CommonTime, es[i].time, gs[i].time);
+      TUASSERTE(size_t, es[i].obs.size(), gs[i].obs.size());
+      Rinex3ObsData::DataMap::const_iterator eit, git;
+      for(eit = es[i].obs.begin(), git = gs[i].obs.begin();
+          eit != es[i].obs.end() && git != gs[i].obs.end(); ++eit, ++git)
+      {
+         TUASSERTE(RinexSatID, eit->first, git->first);
+         TUASSERTE(size_t, eit->second.size(), git->second.size());
+         for(unsigned int j=0; j<eit->second.size() && j<git->second.size(); j++)
+            TUASSERTE(double, eit->second[j].data, git->second[j].data);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------------
+// write a copy of a file as another station, adding offset to every datum
+void writeStation(const string& infile, const string& outfile,
+                  const string& marker, double offset)
+{
+   Rinex3ObsStream istrm(infile.c_str()), ostrm(outfile.c_str(), ios::out);
+   Rinex3ObsHeader roh;
+   Rinex3ObsData rod;
+   istrm >> roh;
+   roh.markerName = marker;
+   ostrm << roh;
+   while(istrm >> rod) {
+      Rinex3ObsData::DataMap::iterator it;
+      for(it = rod.obs.begin(); it != rod.obs.end(); ++it)
+         for(unsigned int j=0; j<it->second.size(); j++)
+            if(it->second[j].data != 0.0) it->second[j].data += offset;
+      ostrm << rod;
+   }
+}
+
+//------------------------------------------------------------------------------------
+// count the SatPass made from a loader's store
+int countPasses(Rinex3ObsFileLoader& rofl)
+{
+   map<char, vector<string> > obstypes;
+   map<char, vector<int> > indexes;
+   vector<string> wanted(rofl.getWantedObsTypes());
+   for(unsigned int k=0; k<wanted.size(); k++) {
+      obstypes[wanted[k][0]].push_back(wanted[k].substr(1));
+      indexes[wanted[k][0]].push_back(k);
+   }
+   vector<SatPass> SPList;
+   return rofl.WriteSatPassList(obstypes, indexes, SPList);
+}
+
+//------------------------------------------------------------------------------------
+// load one station, and it with a copy of itself as a second station, whose
+// epochs all coincide with the first's
+void stationTest(TestUtil& testFramework, const string& file)
+{
+   string errmsg, msg;
+   string copy(getPathTestTemp() + getFileSep() + "Rinex3ObsFileLoader_ARL2.15o");
+   writeStation(file, copy, "ARL2", 1000.0);
+
+   Rinex3ObsFileLoader one;
+   configure(one, vector<string>(1, file));
+   one.loadFiles(errmsg, msg);
+   TUASSERT(one.getStoreSize() > 0);
+   TUASSERTE(size_t, 1, one.getStations().size());
+   const vector<Rinex3ObsData>& os(one.getStore());
+
+   for(int rev=0; rev<2; rev++) {
+      vector<string> files;
+      files.push_back(rev ? copy : file);
+      files.push_back(rev ? file : copy);
+      Rinex3ObsFileLoader two;
+      configure(two, files);
+      two.setThreads(2);
+      two.setMaxBufferedEpochs(4);
+      errmsg = "";
+      TUASSERTE(int, 2, two.loadFiles(errmsg, msg));
+      TUASSERTE(string, "", errmsg);
+      TUASSERTE(size_t, 2, two.getStations().size());
+      TUASSERTE(string, rev ? "ARL2" : "ARL1", two.getStations()[0]);
+      TUASSERTE(string, rev ? "ARL1" : "ARL2", two.getStations()[1]);
+      TUASSERTE(int, 2*one.getStoreSize(), two.getStoreSize());
+
+      // the store holds each (time, station) once, in that order, and each
+      // station's data are its own
+      const vector<Rinex3ObsData>& ts(two.getStore());
+      unsigned int nbad(0);
+      for(unsigned int i=0; i<ts.size() && i/2<os.size(); i++) {
+         unsigned int station(two.getStoreStation(i));
+         double offset(two.getStations()[station] == "ARL2" ? 1000.0 : 0.0);
+         if(station != i%2 || ts[i].time != os[i/2].time ||
+            ts[i].obs.size() != os[i/2].obs.size())
+         {
+            nbad++;
+            continue;
+         }
+         Rinex3ObsData::DataMap::const_iterator oit, tit;
+         for(oit = os[i/2].obs.begin(), tit = ts[i].obs.begin();
+             oit != os[i/2].obs.end(); ++oit, ++tit)
+         {
+            for(unsigned int j=0; j<oit->second.size(); j++) {
+               double d(oit->second[j].data);
+               if(tit->first != oit->first ||
+                  tit->second[j].data != (d == 0.0 ? d : d + offset))
+                  nbad++;
+            }
+         }
+      }
+      TUASSERTE(unsigned int, 0, nbad);
+
+      // each station's data go into passes of their own
+      TUASSERTE(int, 2*countPasses(one), countPasses(two));
+
+      // the callback is told the station of each epoch
+      Rinex3ObsFileLoader str;
+      configure(str, files);
+      str.setThreads(2);
+      vector<unsigned int> stations;
+      str.setEpochCallback([&stations](const Rinex3ObsData& rod, unsigned int s)
+         { stations.push_back(s); return true; });
+      str.loadFiles(errmsg, msg);
+      TUASSERTE(size_t, ts.size(), stations.size());
+      nbad = 0;
+      for(unsigned int i=0; i<stations.size() && i<ts.size(); i++)
+         if(stations[i] != two.getStoreStation(i)) nbad++;
+      TUASSERTE(unsigned int, 0, nbad);
+   }
+}
+
+//------------------------------------------------------------------------------------
+int main()
+{
+   TUDEF("Rinex3ObsFileLoader", "loadFiles");
+   string path(getPathData() + getFileSep()), errmsg, msg;
+   vector<string> files, reversed;
+   files.push_back(path + "arlm200a.15o");
+   files.push_back(path + "arlm200b.15o");
+   reversed.push_back(files[1]);
+   reversed.push_back(files[0]);
+
+   try {
+      // sequential load is the reference
+      Rinex3ObsFileLoader seq;
+      configure(seq, files);
+      TUASSERTE(int, 2, seq.loadFiles(errmsg, msg));
+      TUASSERTE(string, "", errmsg);
+      TUASSERT(seq.getStoreSize() > 0);
+
+      // parallel, with a small read-ahead limit, and with the files given
+      // out of order: the merge puts the epochs in time order
+      for(int rev=0; rev<2; rev++) {
+         Rinex3ObsFileLoader par;
+         configure(par, rev ? reversed : files);
+         par.setThreads(2);
+         par.setMaxBufferedEpochs(4);
+         errmsg = "";
+         TUASSERTE(int, 2, par.loadFiles(errmsg, msg));
+         TUASSERTE(string, "", errmsg);
+         TUASSERTE(double, seq.getDT(), par.getDT());
+         compareLoaders(testFramework, seq, par);
+      }
+
+      // more threads than files, and one thread
+      for(int nt=1; nt<=4; nt+=3) {
+         Rinex3ObsFileLoader par;
+         configure(par, files);
+         par.setThreads(nt);
+         errmsg = "";
+         par.loadFiles(errmsg, msg);
+         compareLoaders(testFramework, seq, par);
+      }
+
+      // streaming: epochs go to the callback, not the store
+      for(int nt=1; nt<=2; nt++) {
+         Rinex3ObsFileLoader str;
+         configure(str, files);
+         str.setThreads(nt);
+         vector<CommonTime> times;
+         str.setEpochCallback([&times](const Rinex3ObsData& rod, unsigned int s)
+            { times.push_back(rod.time); return true; });
+         errmsg = "";
+         str.loadFiles(errmsg, msg);
+         TUASSERTE(int, 0, str.getStoreSize());
+         TUASSERTE(size_t, seq.getStore().size(), times.size());
+         for(unsigned int i=0; i<times.size() && i<seq.getStore().size(); i++)
+            TUASSERTE(CommonTime, seq.getStore()[i].time, times[i]);
+         TUASSERT(seq.getTotalObsCounts() == str.getTotalObsCounts());
+
+         // and the callback can stop the load
+         Rinex3ObsFileLoader stop;
+         configure(stop, files);
+         stop.setThreads(nt);
+         int n(0);
+         stop.setEpochCallback([&n](const Rinex3ObsData& rod, unsigned int s)
+            { return ++n < 10; });
+         errmsg = "";
+         stop.loadFiles(errmsg, msg);
+         TUASSERTE(int, 10, n);
+      }
+
+      // limit on the number of epochs
+      Rinex3ObsFileLoader seqlim, parlim;
+      configure(seqlim, files);
+      seqlim.nEpochsToRead(150);
+      seqlim.loadFiles(errmsg, msg);
+      configure(parlim, files);
+      parlim.nEpochsToRead(150);
+      parlim.setThreads(2);
+      parlim.loadFiles(errmsg, msg);
+      compareLoaders(testFramework, seqlim, parlim);
+
+      // overlapping stations
+      stationTest(testFramework, files[0]);
+   }
+   catch(Exception& e) {
+      cout << e << endl;
+      TUFAIL("Unexpected exception");
+   }
+
+   TURETURN();
+}
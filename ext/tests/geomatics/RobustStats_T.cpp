@@ -0,0 +1,220 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file RobustStats_T.cpp Test the median, MAD and sliding quantile of
+/// RobustStats against sorted data.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "RobustStats.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class RobustStats_T
+{
+public:
+   RobustStats_T()
+   {
+      unsigned long seed = 12345;
+      for (int i = 0; i < 1001; i++)
+      {
+         seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+         data.push_back(double(seed) / 0x7fffffff - 0.5 + 0.001*i);
+            // repeated values
+         if (i % 97 == 0)
+            data.push_back(data.back());
+      }
+   }
+   unsigned medianTest();
+   unsigned madTest();
+   unsigned slidingTest();
+
+private:
+      /// quantile q of sorted data, as documented by SlidingQuantile
+   double sortedQuantile(vector<double> x, double q)
+   {
+      sort(x.begin(), x.end());
+      double h = q*(x.size()-1);
+      size_t k = size_t(::floor(h));
+      double f = h - k;
+      if (f == 0.0)
+         return x[k];
+      return (1.0-f)*x[k] + f*x[k+1];
+   }
+
+   vector<double> data;
+};
+
+
+unsigned RobustStats_T ::
+medianTest()
+{
+   TUDEF("Robust", "Median");
+
+   for (int n = 2; n < 40; n++)
+   {
+      vector<double> x(data.begin(), data.begin()+n), y(x);
+      double med = Robust::Median(&x[0], n);
+      TUASSERTE(double, sortedQuantile(y, 0.5), med);
+         // saved
+      TUASSERT(x == y);
+         // not saved, the array is sorted
+      double med2 = Robust::Median(&x[0], n, false);
+      TUASSERTE(double, med, med2);
+      sort(y.begin(), y.end());
+      TUASSERT(x == y);
+   }
+
+   double x[2] = { 1.0, 2.0 };
+   try
+   {
+      Robust::Median(x, 1);
+      TUFAIL("one datum should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("one datum");
+   }
+   TURETURN();
+}
+
+
+unsigned RobustStats_T ::
+madTest()
+{
+   TUDEF("Robust", "MedianAbsoluteDeviation");
+
+   for (int n = 2; n < (int)data.size(); n += 37)
+   {
+      vector<double> x(data.begin(), data.begin()+n), y(x);
+      double M, mad = Robust::MedianAbsoluteDeviation(&x[0], n, M);
+      TUASSERT(x == y);
+      double med = sortedQuantile(y, 0.5);
+      TUASSERTE(double, med, M);
+      for (int i = 0; i < n; i++)
+         y[i] = ::fabs(y[i]-med);
+      TUASSERTE(double, sortedQuantile(y, 0.5)/RobustTuningE, mad);
+
+      double M2, mad2 = Robust::MAD(&x[0], n, M2, false);
+      TUASSERTE(double, M, M2);
+      TUASSERTE(double, mad, mad2);
+   }
+   TURETURN();
+}
+
+
+unsigned RobustStats_T ::
+slidingTest()
+{
+   TUDEF("Robust", "SlidingQuantile");
+
+   const int width(25);
+   double quant[4] = { 0.5, 0.0, 0.25, 1.0 };
+   for (int q = 0; q < 4; q++)
+   {
+      Robust::SlidingQuantile<double> sq(quant[q]);
+      unsigned bad = 0;
+      for (int i = 0; i < (int)data.size(); i++)
+      {
+         sq.add(data[i]);
+         if (i >= width)
+            sq.remove(data[i-width]);
+         int n = min(i+1, width);
+         if (sq.size() != n)
+            bad++;
+         vector<double> w(data.begin()+i+1-n, data.begin()+i+1);
+         if (sq.value() != sortedQuantile(w, quant[q]))
+            bad++;
+            // and the median is that of Median()
+         if (quant[q] == 0.5 && n > 1 &&
+             sq.value() != Robust::Median(&w[0], n))
+            bad++;
+      }
+      TUASSERTE(unsigned, 0, bad);
+   }
+
+   Robust::SlidingQuantile<double> sq;
+   sq.add(1.0);
+   try
+   {
+      sq.remove(2.0);
+      TUFAIL("removing a value not in the window should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("remove");
+   }
+   sq.remove(1.0);
+   TUASSERTE(int, 0, sq.size());
+   try
+   {
+      sq.value();
+      TUFAIL("empty window should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("empty");
+   }
+   try
+   {
+      Robust::SlidingQuantile<double> bad(1.5);
+      TUFAIL("quantile > 1 should throw");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("quantile > 1");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   RobustStats_T testClass;
+
+   errorTotal += testClass.medianTest();
+   errorTotal += testClass.madTest();
+   errorTotal += testClass.slidingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
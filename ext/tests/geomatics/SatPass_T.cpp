@@ -0,0 +1,368 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S.
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SatPass_T.cpp Test the column storage of SatPass: obs type
+/// indexes, data access by index and by column, and the editing
+/// functions that move the columns together.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include "SatPass.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class SatPass_T
+{
+public:
+   SatPass_T()
+         : t0(GPSWeekSecond(1854, 345600.0, TimeSystem::GPS)),
+           dt(30.0)
+   {
+      ots.push_back("L1");
+      ots.push_back("L2");
+      ots.push_back("C1");
+      ots.push_back("P2");
+         // counts 0 to 9, then a gap of two epochs, then 12 to 14
+      for (int n = 0; n < 15; n++)
+         if (n != 10 && n != 11)
+            counts.push_back(n);
+   }
+
+   unsigned indexTest();
+   unsigned addDataTest();
+   unsigned accessTest();
+   unsigned trimAfterTest();
+   unsigned splitTest();
+   unsigned decimateTest();
+
+private:
+      /// The value stored for obs type k at count n
+   double value(int n, int k) const
+   { return 100.0*n + k; }
+
+      /// Fill sp with an epoch at each of counts.
+   void fill(SatPass& sp)
+   {
+      for (size_t i = 0; i < counts.size(); i++)
+      {
+         vector<double> data;
+         for (size_t k = 0; k < ots.size(); k++)
+            data.push_back(value(counts[i], k));
+         sp.addData(t0 + dt*counts[i], ots, data);
+      }
+   }
+
+      /** Count the epochs of sp at which any obs type differs from
+       * value(), reading by obs type index and by column. */
+   unsigned countBad(SatPass& sp)
+   {
+      unsigned bad = 0;
+      for (unsigned int i = 0; i < sp.size(); i++)
+      {
+         int n = int((sp.time(i) - t0) / dt + 0.5);
+         for (unsigned int k = 0; k < ots.size(); k++)
+         {
+            if (sp.data(i, k) != value(n, k) ||
+                sp.dataColumn(k)[i] != value(n, k))
+               bad++;
+         }
+      }
+      return bad;
+   }
+
+   Epoch t0;
+   double dt;
+   vector<string> ots;
+   vector<int> counts;
+};
+
+
+unsigned SatPass_T ::
+indexTest()
+{
+   TUDEF("SatPass", "getObsIndex");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   for (size_t k = 0; k < ots.size(); k++)
+   {
+      TUASSERTE(int, k, sp.getObsIndex(ots[k]));
+      TUASSERT(sp.hasType(ots[k]));
+   }
+   TUASSERTE(int, -1, sp.getObsIndex("P1"));
+   TUASSERT(!sp.hasType("P1"));
+
+      // the default obs types
+   SatPass sp2(RinexSatID(5, SatID::systemGPS), dt);
+   TUASSERTE(int, 0, sp2.getObsIndex("L1"));
+   TUASSERTE(int, 3, sp2.getObsIndex("P2"));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+addDataTest()
+{
+   TUDEF("SatPass", "addData");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp);
+   TUASSERTE(unsigned int, counts.size(), sp.size());
+   TUASSERTE(int, counts.size(), sp.getNgood());
+   TUASSERTE(Epoch, t0, sp.getFirstTime());
+   TUASSERTE(Epoch, t0 + dt*14, sp.getLastTime());
+   for (size_t k = 0; k < ots.size(); k++)
+      TUASSERTE(size_t, counts.size(), sp.dataColumn(k).size());
+
+      // the obs types may be given in any order
+   vector<string> rots(ots.rbegin(), ots.rend());
+   vector<double> data;
+   for (size_t k = 0; k < ots.size(); k++)
+      data.push_back(value(15, ots.size()-1-k));
+   TUASSERTE(int, counts.size(), sp.addData(t0 + dt*15, rots, data));
+   TUASSERTE(unsigned, 0, countBad(sp));
+
+      // out of order, and a gap longer than maxGap, are not added
+   TUASSERTE(int, -2, sp.addData(t0 + dt*15, ots, data));
+   TUASSERTE(int, -1, sp.addData(t0 + dt*15 + 2*sp.getMaxGap(), ots, data));
+   TUASSERTE(unsigned int, counts.size()+1, sp.size());
+
+      // an unknown obs type throws and adds nothing
+   vector<string> bots(ots);
+   bots[2] = "P1";
+   try
+   {
+      sp.addData(t0 + dt*16, bots, data);
+      TUFAIL("Expected an exception for an unknown obs type");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("unknown obs type");
+   }
+   TUASSERTE(unsigned int, counts.size()+1, sp.size());
+   TUASSERTE(size_t, counts.size()+1, sp.dataColumn(0).size());
+
+      // as does data of the wrong length
+   data.pop_back();
+   bots.pop_back();
+   try
+   {
+      sp.addData(t0 + dt*16, bots, data);
+      TUFAIL("Expected an exception for the wrong number of data");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("wrong number of data");
+   }
+   TUASSERTE(unsigned int, counts.size()+1, sp.size());
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+accessTest()
+{
+   TUDEF("SatPass", "data");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp);
+   TUASSERTE(unsigned, 0, countBad(sp));
+
+   int iL2 = sp.getObsIndex("L2");
+   for (unsigned int i = 0; i < sp.size(); i++)
+   {
+      TUASSERTFE(value(counts[i], iL2), sp.data(i, "L2"));
+      TUASSERTE(Epoch, t0 + dt*counts[i], sp.time(i));
+   }
+
+      // the accessors return references into the same column
+   sp.data(3, iL2) = -1.0;
+   TUASSERTFE(-1.0, sp.dataColumn(iL2)[3]);
+   TUASSERTFE(-1.0, sp.data(3, "L2"));
+   sp.dataColumn(iL2)[4] = -2.0;
+   TUASSERTFE(-2.0, sp.data(4, iL2));
+   sp.LLI(5, iL2) = 1;
+   sp.SSI(5, iL2) = 7;
+   TUASSERTE(unsigned short, 1, sp.LLI(5, "L2"));
+   TUASSERTE(unsigned short, 7, sp.SSI(5, "L2"));
+   TUASSERTE(unsigned short, 0, sp.LLI(5, "L1"));
+   const SatPass& csp(sp);
+   TUASSERTFE(-2.0, csp.dataColumn(iL2)[4]);
+
+   try
+   {
+      sp.data(sp.size(), 0);
+      TUFAIL("Expected an exception for an invalid epoch index");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("epoch index");
+   }
+   try
+   {
+      sp.data(0, ots.size());
+      TUFAIL("Expected an exception for an invalid obs type index");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("obs type index");
+   }
+   try
+   {
+      sp.dataColumn(ots.size());
+      TUFAIL("Expected an exception for an invalid column");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("column");
+   }
+   try
+   {
+      sp.data(0, "P1");
+      TUFAIL("Expected an exception for an unknown obs type");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("obs type");
+   }
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+trimAfterTest()
+{
+   TUDEF("SatPass", "trimAfter");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp);
+   sp.setFlag(1, SatPass::BAD);
+   sp.setFlag(7, SatPass::BAD);
+   TUASSERTE(int, -1, sp.trimAfter(t0));
+   TUASSERTE(int, 1, sp.trimAfter(t0 + dt*14));
+   TUASSERTE(unsigned int, counts.size(), sp.size());
+
+   TUASSERTE(int, 0, sp.trimAfter(t0 + dt*5));
+   TUASSERTE(unsigned int, 6, sp.size());
+   TUASSERTE(int, 5, sp.getNgood());
+   TUASSERTE(Epoch, t0 + dt*5, sp.getLastTime());
+   for (size_t k = 0; k < ots.size(); k++)
+      TUASSERTE(size_t, 6, sp.dataColumn(k).size());
+   TUASSERTE(unsigned, 0, countBad(sp));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+splitTest()
+{
+   TUDEF("SatPass", "split");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   SatPass sp2(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp);
+   sp.setFlag(2, SatPass::BAD);
+   sp.setFlag(11, SatPass::BAD);
+
+   TUASSERT(sp.split(12, sp2));
+   TUASSERTE(unsigned int, 10, sp.size());
+   TUASSERTE(unsigned int, 3, sp2.size());
+   TUASSERTE(Epoch, t0 + dt*9, sp.getLastTime());
+   TUASSERTE(Epoch, t0 + dt*12, sp2.getFirstTime());
+   TUASSERTE(Epoch, t0 + dt*14, sp2.getLastTime());
+   TUASSERTE(int, 9, sp.getNgood());
+   TUASSERTE(int, 2, sp2.getNgood());
+   TUASSERTE(unsigned short, SatPass::BAD, sp2.getFlag(1));
+   TUASSERTE(int, 2, sp2.getObsIndex("C1"));
+   for (size_t k = 0; k < ots.size(); k++)
+   {
+      TUASSERTE(size_t, 10, sp.dataColumn(k).size());
+      TUASSERTE(size_t, 3, sp2.dataColumn(k).size());
+   }
+   TUASSERTE(unsigned, 0, countBad(sp));
+   TUASSERTE(unsigned, 0, countBad(sp2));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+decimateTest()
+{
+   TUDEF("SatPass", "decimate");
+   SatPass sp(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp);
+   sp.setFlag(4, SatPass::BAD);
+
+      // keep the even counts 0,2,4,6,8,12,14
+   sp.decimate(2);
+   TUASSERTE(unsigned int, 7, sp.size());
+   TUASSERTFE(2*dt, sp.getDT());
+   TUASSERTE(int, 6, sp.getNgood());
+   TUASSERTE(unsigned short, SatPass::BAD, sp.getFlag(2));
+   TUASSERTE(Epoch, t0, sp.getFirstTime());
+   TUASSERTE(Epoch, t0 + dt*14, sp.getLastTime());
+   TUASSERTE(Epoch, t0 + dt*12, sp.time(5));
+   for (size_t k = 0; k < ots.size(); k++)
+      TUASSERTE(size_t, 7, sp.dataColumn(k).size());
+   TUASSERTE(unsigned, 0, countBad(sp));
+
+      // referenced to an earlier time, keep the counts 1,4,7,13
+   SatPass sp3(RinexSatID(5, SatID::systemGPS), dt, ots);
+   fill(sp3);
+   sp3.decimate(3, t0 - dt*2);
+   TUASSERTE(unsigned int, 4, sp3.size());
+   TUASSERTE(Epoch, t0 + dt, sp3.getFirstTime());
+   TUASSERTE(Epoch, t0 + dt*13, sp3.getLastTime());
+   TUASSERTE(Epoch, t0 + dt*7, sp3.time(2));
+   TUASSERTE(unsigned, 0, countBad(sp3));
+   TURETURN();
+}
+
+
+int main()
+{
+   SatPass_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.indexTest();
+   errorTotal += testClass.addDataTest();
+   errorTotal += testClass.accessTest();
+   errorTotal += testClass.trimAfterTest();
+   errorTotal += testClass.splitTest();
+   errorTotal += testClass.decimateTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,221 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SlidingStats_T.cpp Test SlidingStats and SlidingTwoSampleStats against
+/// statistics computed from scratch on each window.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include "SlidingStats.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class SlidingStats_T
+{
+public:
+   SlidingStats_T()
+   {
+         // a long phase-like series: large, ramping, with small noise
+      unsigned long seed = 12345;
+      double v(2.2e7);
+      for (int i = 0; i < 200000; i++)
+      {
+         seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+         v += 3.1 + 0.1*(double(seed) / 0x7fffffff - 0.5);
+         xdata.push_back(30.0*i);
+         data.push_back(v);
+      }
+   }
+   unsigned sumTest();
+   unsigned oneSampleTest();
+   unsigned twoSampleTest();
+
+private:
+   vector<double> xdata, data;
+};
+
+
+unsigned SlidingStats_T ::
+sumTest()
+{
+   TUDEF("CompensatedSum", "Add");
+
+      // 1 + many tiny terms, each lost in a plain sum
+   CompensatedSum<double> cs;
+   double plain(1.0);
+   cs.Add(1.0);
+   for (int i = 0; i < 1000000; i++)
+   {
+      cs.Add(1.0e-16);
+      plain += 1.0e-16;
+   }
+   TUASSERTE(double, 1.0, plain);
+   TUASSERTFEPS(1.0 + 1.0e-10, cs.Value(), 1.e-15);
+
+      // adding and removing the same terms leaves nothing
+   cs.Reset();
+   for (int i = 0; i < 1000; i++)
+      cs.Add(data[i]);
+   for (int i = 0; i < 1000; i++)
+      cs.Add(-data[i]);
+   TUASSERTE(double, 0.0, cs.Value());
+   TURETURN();
+}
+
+
+unsigned SlidingStats_T ::
+oneSampleTest()
+{
+   TUDEF("SlidingStats", "Variance");
+
+   const unsigned width(20);
+   SlidingStats<double> ss;
+   TUASSERTE(unsigned, 0, ss.N());
+   TUASSERTE(double, 0.0, ss.Average());
+
+   double maxAve(0.0), maxVar(0.0);
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      ss.Add(data[i]);
+      if (i >= width)
+         ss.Subtract(data[i-width]);
+      if (i % 997 != 0 || i < width)
+         continue;
+
+         // two-pass stats on the window
+      double ave(0.0), var(0.0);
+      for (unsigned j = i+1-width; j <= i; j++)
+         ave += data[j];
+      ave /= width;
+      for (unsigned j = i+1-width; j <= i; j++)
+         var += (data[j]-ave)*(data[j]-ave);
+      var /= (width-1);
+
+      maxAve = max(maxAve, ::fabs(ss.Average()-ave));
+      maxVar = max(maxVar, ::fabs(ss.Variance()-var)/var);
+   }
+   TUASSERTE(unsigned, width, ss.N());
+      // no drift over 200000 steps
+   TUASSERT(maxAve < 1.e-6);
+   TUASSERT(maxVar < 1.e-10);
+
+   ss.Subtract(data[0]);
+   ss.Reset();
+   TUASSERTE(unsigned, 0, ss.N());
+   ss.Add(5.0);
+   ss.Subtract(5.0);
+   TUASSERTE(unsigned, 0, ss.N());
+   TUASSERTE(double, 0.0, ss.Variance());
+   TURETURN();
+}
+
+
+unsigned SlidingStats_T ::
+twoSampleTest()
+{
+   TUDEF("SlidingTwoSampleStats", "Slope");
+
+   const unsigned width(50);
+   SlidingTwoSampleStats<double> sts;
+   double maxSlope(0.0), maxSig(0.0), maxEval(0.0), maxCorr(0.0);
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      sts.Add(xdata[i], data[i]);
+      if (i >= width)
+         sts.Subtract(xdata[i-width], data[i-width]);
+      if (i % 1009 != 0 || i < width)
+         continue;
+
+         // two-pass fit on the window
+      unsigned j0(i+1-width);
+      long double ax(0), ay(0), sxx(0), sxy(0), syy(0);
+      for (unsigned j = j0; j <= i; j++)
+      {
+         ax += xdata[j];
+         ay += data[j];
+      }
+      ax /= width;
+      ay /= width;
+      for (unsigned j = j0; j <= i; j++)
+      {
+         sxx += (xdata[j]-ax)*(xdata[j]-ax);
+         sxy += (xdata[j]-ax)*(data[j]-ay);
+         syy += (data[j]-ay)*(data[j]-ay);
+      }
+      long double slope(sxy/sxx);
+      long double sig(::sqrt(double((syy-slope*sxy)/(width-2))));
+      long double corr(sxy/::sqrt(double(sxx*syy)));
+
+      maxSlope = max(maxSlope, ::fabs(double(sts.Slope()-slope)));
+      maxSig = max(maxSig, ::fabs(double(sts.SigmaYX()-sig)));
+      maxCorr = max(maxCorr, ::fabs(double(sts.Correlation()-corr)));
+      maxEval = max(maxEval, ::fabs(double(sts.Evaluate(xdata[i]+15.0)
+                                     - (ay+slope*(xdata[i]+15.0-ax)))));
+   }
+   TUASSERTE(unsigned, width, sts.N());
+   TUASSERT(maxSlope < 1.e-12);
+   TUASSERT(maxSig < 1.e-8);
+   TUASSERT(maxCorr < 1.e-12);
+   TUASSERT(maxEval < 1.e-7);
+
+      // exact line
+   sts.Reset();
+   for (int i = 0; i < 10; i++)
+      sts.Add(i, 2.0*i + 1.0);
+   TUASSERTFEPS(2.0, sts.Slope(), 1.e-14);
+   TUASSERTFEPS(1.0, sts.Intercept(), 1.e-13);
+   TUASSERTFEPS(21.0, sts.Evaluate(10.0), 1.e-13);
+   TUASSERTFEPS(4.5, sts.AverageX(), 1.e-14);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SlidingStats_T testClass;
+
+   errorTotal += testClass.sumTest();
+   errorTotal += testClass.oneSampleTest();
+   errorTotal += testClass.twoSampleTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}